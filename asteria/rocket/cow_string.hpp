@@ -37,6 +37,7 @@ class basic_cow_string;
       arrays allocated externally.
  * 7. `data()` returns a null pointer if the string is empty.
  * 8. `erase()` and `substr()` cannot be called without arguments.
+ * 9. `substr()` may return a suffix that shares storage with the original string.
  */
 
 template<typename charT, typename traitsT>
@@ -333,6 +334,19 @@ class basic_cow_string
                                                static_cast<unsigned long long>(this->size()));
       }
 
+    // Check whether a suffix starting at `tpos` can share storage with this string.
+    // Small suffixes of large blocks are not shared, so they won't pin memory forever.
+    bool
+    do_can_share_suffix(size_type tpos)
+    const noexcept
+      {
+        auto tlen = this->size();
+        ROCKET_ASSERT(tpos < tlen);
+        if(!this->m_sth.data())
+          return true;
+        return tlen - tpos >= this->m_sth.capacity() / 2;
+      }
+
     // This function works the same way as `substr()`.
     // Ensure `tpos` is in `[0, size()]` and return `min(tn, size() - tpos)`.
     size_type
@@ -591,7 +605,7 @@ class basic_cow_string
     bool
     unique()
     const noexcept
-      { return this->m_sth.unique();  }
+      { return this->m_sth.unique() && (this->m_ptr == this->m_sth.data());  }
 
     // N.B. This is a non-standard extension.
     long
@@ -1394,8 +1408,15 @@ class basic_cow_string
         if((tpos == 0) && (tn >= this->size()))
           // Utilize reference counting.
           return basic_cow_string(*this, this->m_sth.as_allocator());
-        else
-          return basic_cow_string(*this, tpos, tn, this->m_sth.as_allocator());
+
+        if((tpos < this->size()) && (tn >= this->size() - tpos) && this->do_can_share_suffix(tpos)) {
+          // Share the null-terminated suffix. It will be copied upon modification.
+          basic_cow_string res(*this, this->m_sth.as_allocator());
+          res.m_ptr += tpos;
+          res.m_len -= tpos;
+          return res;
+        }
+        return basic_cow_string(*this, tpos, tn, this->m_sth.as_allocator());
       }
 
     int
@@ -294,8 +294,8 @@ class basic_tinybuf
           return this->do_call_overflow(s, n);
         }
         // Append the string to the put area.
-        traits_type::copy(this->m_pcur, s, k);
-        this->m_pcur += k;
+        traits_type::copy(this->m_pcur, s, n);
+        this->m_pcur += n;
         return *this;
       }
 
@@ -679,7 +679,8 @@ constexpr s_keywords[] =
   };
 
 bool
-do_accept_identifier_or_keyword(cow_vector<Token>& tokens, Line_Reader& reader, bool keywords_as_identifiers)
+do_accept_identifier_or_keyword(cow_vector<Token>& tokens, Line_Reader& reader, String_Pool& names,
+                                bool keywords_as_identifiers)
   {
     // identifier ::=
     //   PCRE([A-Za-z_][A-Za-z_0-9]*)
@@ -698,7 +699,7 @@ do_accept_identifier_or_keyword(cow_vector<Token>& tokens, Line_Reader& reader,
     }
     if(keywords_as_identifiers) {
       // Do not check for identifiers.
-      Token::S_identifier xtoken = { cow_string(reader.data(), tlen) };
+      Token::S_identifier xtoken = { names.intern(cow_string(reader.data(), tlen)) };
       return do_push_token(tokens, reader, tlen, ::std::move(xtoken));
     }
 #ifdef ROCKET_DEBUG
@@ -708,7 +709,7 @@ do_accept_identifier_or_keyword(cow_vector<Token>& tokens, Line_Reader& reader,
     for(;;) {
       if(range.first == range.second) {
         // No matching keyword has been found so far.
-        Token::S_identifier xtoken = { cow_string(reader.data(), tlen) };
+        Token::S_identifier xtoken = { names.intern(cow_string(reader.data(), tlen)) };
         return do_push_token(tokens, reader, tlen, ::std::move(xtoken));
       }
       const auto& cur = range.first[0];
@@ -739,6 +740,8 @@ reload(tinybuf& cbuf, const cow_string& file)
     tokens.swap(this->m_rtoks);
     tokens.clear();
 
+    // Identifiers are interned, so equal names share storage.
+    String_Pool names;
     // Save the position of an unterminated block comment.
     Tack bcomm;
     // Read source code line by line.
@@ -751,6 +754,18 @@ reload(tinybuf& cbuf, const cow_string& file)
 
       // Ensure this line is a valid UTF-8 string.
       while(reader.navail() != 0) {
+        // Skip ASCII characters in bulk, but still disallow null characters.
+        auto nascii = utf8_ascii_prefix(reader.data(), reader.navail());
+        if(nascii != 0) {
+          auto nptr = static_cast<const char*>(::std::memchr(reader.data(), 0, nascii));
+          if(nptr) {
+            reader.consume(static_cast<size_t>(nptr - reader.data()));
+            throw Parser_Error(parser_status_null_character_disallowed, reader.tell(), 1);
+          }
+          reader.consume(nascii);
+          continue;
+        }
+
         // Decode a code point.
         char32_t cp;
         auto tptr = reader.data();
@@ -807,7 +822,8 @@ reload(tinybuf& cbuf, const cow_string& file)
                          do_accept_punctuator(tokens, reader) ||
                          do_accept_string_literal(tokens, reader, '\"', true) ||
                          do_accept_string_literal(tokens, reader, '\'', this->m_opts.escapable_single_quotes) ||
-                         do_accept_identifier_or_keyword(tokens, reader, this->m_opts.keywords_as_identifiers);
+                         do_accept_identifier_or_keyword(tokens, reader, names,
+                                                         this->m_opts.keywords_as_identifiers);
         if(!token_got)
           throw Parser_Error(parser_status_token_character_unrecognized, reader.tell(), 1);
       }
@@ -159,6 +159,8 @@ class Global_Context;
 class Genius_Collector;
 class Random_Engine;
 class Loader_Lock;
+class Regex_Cache;
+class Format_Template;
 class Variadic_Arguer;
 class Instantiated_Function;
 class AIR_Node;
@@ -241,6 +241,340 @@ do_merge_blocks(V_array& output, Global_Context& global, cow_vector<Reference>&
     return opos;
   }
 
+// Arrays whose elements are all integers, or are all reals, can be processed in packed
+// form, which saves the type dispatch of the builtin comparison for every element.
+template<typename ElemT>
+ElemT
+do_get_packed(const Value& value);
+
+template<>
+V_integer
+do_get_packed<V_integer>(const Value& value)
+  {
+    return value.as_integer();
+  }
+
+template<>
+V_real
+do_get_packed<V_real>(const Value& value)
+  {
+    return value.as_real();
+  }
+
+Vtype
+do_get_packed_vtype(const V_array& data)
+  {
+    if(data.empty()) {
+      return vtype_null;
+    }
+    // All elements must have the same type as the first one.
+    auto vtype = data.front().vtype();
+    if((vtype != vtype_integer) && (vtype != vtype_real)) {
+      return vtype_null;
+    }
+    for(const auto& elem : data) {
+      if(elem.vtype() != vtype) {
+        return vtype_null;
+      }
+      // NaNs are unordered, which results in exceptions in the generic path.
+      if((vtype == vtype_real) && ::std::isnan(elem.as_real())) {
+        return vtype_null;
+      }
+    }
+    return vtype;
+  }
+
+template<typename ElemT>
+ElemT&
+do_open_packed(Value& value);
+
+template<>
+V_integer&
+do_open_packed<V_integer>(Value& value)
+  {
+    return value.open_integer();
+  }
+
+template<>
+V_real&
+do_open_packed<V_real>(Value& value)
+  {
+    return value.open_real();
+  }
+
+// This iterates over the payloads of elements of a packed array, so they can be sorted
+// in place. As all elements have the same type, moving payloads is equivalent to moving
+// elements, but touches a lot less memory.
+template<typename ElemT>
+class Packed_Iterator
+  {
+  public:
+    using iterator_category  = ::std::random_access_iterator_tag;
+    using value_type         = ElemT;
+    using pointer            = ElemT*;
+    using reference          = ElemT&;
+    using difference_type    = ptrdiff_t;
+
+  private:
+    Value* m_ptr;
+
+  public:
+    explicit constexpr
+    Packed_Iterator(Value* ptr)
+    noexcept
+      : m_ptr(ptr)
+      { }
+
+  public:
+    Value*
+    tell()
+    const noexcept
+      { return this->m_ptr;  }
+
+    reference
+    operator*()
+    const
+      { return do_open_packed<ElemT>(*(this->m_ptr));  }
+
+    pointer
+    operator->()
+    const
+      { return ::std::addressof(**this);  }
+
+    reference
+    operator[](difference_type off)
+    const
+      { return do_open_packed<ElemT>(this->m_ptr[off]);  }
+
+    Packed_Iterator&
+    operator+=(difference_type off)
+    noexcept
+      { return this->m_ptr += off, *this;  }
+
+    Packed_Iterator&
+    operator-=(difference_type off)
+    noexcept
+      { return this->m_ptr -= off, *this;  }
+
+    Packed_Iterator&
+    operator++()
+    noexcept
+      { return ++(this->m_ptr), *this;  }
+
+    Packed_Iterator&
+    operator--()
+    noexcept
+      { return --(this->m_ptr), *this;  }
+
+    Packed_Iterator
+    operator++(int)
+    noexcept
+      { return Packed_Iterator(this->m_ptr++);  }
+
+    Packed_Iterator
+    operator--(int)
+    noexcept
+      { return Packed_Iterator(this->m_ptr--);  }
+
+    Packed_Iterator
+    operator+(difference_type off)
+    const noexcept
+      { return Packed_Iterator(this->m_ptr + off);  }
+
+    Packed_Iterator
+    operator-(difference_type off)
+    const noexcept
+      { return Packed_Iterator(this->m_ptr - off);  }
+
+    difference_type
+    operator-(const Packed_Iterator& other)
+    const noexcept
+      { return this->m_ptr - other.m_ptr;  }
+
+    bool
+    operator==(const Packed_Iterator& other)
+    const noexcept
+      { return this->m_ptr == other.m_ptr;  }
+
+    bool
+    operator!=(const Packed_Iterator& other)
+    const noexcept
+      { return this->m_ptr != other.m_ptr;  }
+
+    bool
+    operator<(const Packed_Iterator& other)
+    const noexcept
+      { return this->m_ptr < other.m_ptr;  }
+
+    bool
+    operator>(const Packed_Iterator& other)
+    const noexcept
+      { return this->m_ptr > other.m_ptr;  }
+
+    bool
+    operator<=(const Packed_Iterator& other)
+    const noexcept
+      { return this->m_ptr <= other.m_ptr;  }
+
+    bool
+    operator>=(const Packed_Iterator& other)
+    const noexcept
+      { return this->m_ptr >= other.m_ptr;  }
+  };
+
+template<typename ElemT>
+inline
+Packed_Iterator<ElemT>
+operator+(ptrdiff_t off, const Packed_Iterator<ElemT>& rhs)
+noexcept
+  {
+    return rhs + off;
+  }
+
+template<typename ElemT>
+void
+do_restore_zero_signs(Packed_Iterator<ElemT> /*bpos*/, Packed_Iterator<ElemT> /*epos*/,
+                      const cow_vector<bool>& /*signs*/)
+  {
+    // Equal integers are identical.
+  }
+
+void
+do_restore_zero_signs(Packed_Iterator<V_real> bpos, Packed_Iterator<V_real> epos,
+                      const cow_vector<bool>& signs)
+  {
+    if(signs.empty())
+      return;
+
+    // Zeroes are contiguous after sorting, so write their signs back in their original
+    // order, which is what a stable sort would have produced.
+    auto zpos = ::std::lower_bound(bpos, epos, 0.0);
+    for(bool sign : signs)
+      *(zpos++) = sign ? -0.0 : 0.0;
+  }
+
+template<typename ElemT>
+void
+do_sort_packed(V_array& data, bool unique)
+  {
+    Packed_Iterator<ElemT> bpos(data.mut_data());
+    Packed_Iterator<ElemT> epos(data.mut_data() + data.size());
+    // Positive and negative zeroes compare equal but are distinguishable. If both are
+    // present, record their order, as an unstable sort may reorder them.
+    cow_vector<bool> signs;
+    if(::std::is_same<ElemT, V_real>::value) {
+      size_t nzero = 0;
+      size_t nneg = 0;
+      ::std::for_each(bpos, epos,
+          [&](const ElemT& val) { nzero += (val == 0);  nneg += (val == 0) && ::std::signbit(val);  });
+      if((nneg != 0) && (nneg != nzero)) {
+        signs.reserve(nzero);
+        ::std::for_each(bpos, epos,
+            [&](const ElemT& val) { if(val == 0) signs.emplace_back(::std::signbit(val));  });
+      }
+    }
+    ::std::sort(bpos, epos);
+    do_restore_zero_signs(bpos, epos, signs);
+    if(unique) {
+      // Keep the first element of each group of equal elements, like the generic path.
+      epos = ::std::unique(bpos, epos);
+      data.erase(static_cast<size_t>(epos.tell() - data.data()));
+    }
+  }
+
+bool
+do_sort_packed_opt(V_array& data, bool unique)
+  {
+    switch(weaken_enum(do_get_packed_vtype(data))) {
+      case vtype_integer:
+        do_sort_packed<V_integer>(data, unique);
+        return true;
+
+      case vtype_real:
+        do_sort_packed<V_real>(data, unique);
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+template<typename ElemT, typename PredT>
+opt<V_array::const_iterator>
+do_find_extremum_packed_opt(const V_array& data, Vtype vtype, PredT&& pred)
+  {
+    // Find the first element `qbest` such that `pred(*qbest, *it)` is false for all
+    // subsequent elements. If a non-packed element is encountered, the search fails.
+    auto qbest = data.begin();
+    auto best = do_get_packed<ElemT>(*qbest);
+    for(auto it = qbest + 1;  it != data.end();  ++it) {
+      if(it->vtype() != vtype) {
+        return nullopt;
+      }
+      auto val = do_get_packed<ElemT>(*it);
+      if(!pred(best, val)) {
+        continue;
+      }
+      qbest = it;
+      best = val;
+    }
+    return qbest;
+  }
+
+template<typename PredT>
+opt<V_array::const_iterator>
+do_find_extremum_packed_opt(const V_array& data, PredT&& pred)
+  {
+    if(data.empty()) {
+      return nullopt;
+    }
+    // Note that comparisons with NaNs yield `false`, as with the builtin comparison.
+    switch(weaken_enum(data.front().vtype())) {
+      case vtype_integer:
+        return do_find_extremum_packed_opt<V_integer>(data, vtype_integer, pred);
+
+      case vtype_real:
+        return do_find_extremum_packed_opt<V_real>(data, vtype_real, pred);
+
+      default:
+        return nullopt;
+    }
+  }
+
+template<typename ElemT>
+opt<bool>
+do_is_sorted_packed_opt(const V_array& data, Vtype vtype)
+  {
+    auto prev = do_get_packed<ElemT>(data.front());
+    for(auto it = data.begin() + 1;  it != data.end();  ++it) {
+      if(it->vtype() != vtype) {
+        return nullopt;
+      }
+      // Elements that are either greater or unordered break the order.
+      auto val = do_get_packed<ElemT>(*it);
+      if(!(prev <= val)) {
+        return false;
+      }
+      prev = val;
+    }
+    return true;
+  }
+
+opt<bool>
+do_is_sorted_packed_opt(const V_array& data)
+  {
+    switch(weaken_enum(data.front().vtype())) {
+      case vtype_integer:
+        return do_is_sorted_packed_opt<V_integer>(data, vtype_integer);
+
+      case vtype_real:
+        return do_is_sorted_packed_opt<V_real>(data, vtype_real);
+
+      default:
+        return nullopt;
+    }
+  }
+
 }  // namespace
 
 V_array
@@ -447,6 +781,12 @@ std_array_is_sorted(Global_Context& global, V_array data, optV_function comparat
       // If `data` contains no more than 2 elements, it is considered sorted.
       return true;
     }
+    if(!comparator) {
+      // Try the fast path for packed arrays.
+      auto qsorted = do_is_sorted_packed_opt(data);
+      if(qsorted)
+        return *qsorted;
+    }
     cow_vector<Reference> args;
     for(auto it = data.begin() + 1;  it != data.end();  ++it) {
       // Compare the two elements.
@@ -505,6 +845,11 @@ std_array_sort(Global_Context& global, V_array data, optV_function comparator)
       // Use reference counting as our advantage.
       return ::std::move(data);
     }
+    if(!comparator) {
+      // Try the fast path for packed arrays.
+      if(do_sort_packed_opt(data, false))
+        return ::std::move(data);
+    }
     // The Merge Sort algorithm requires `O(n)` space.
     V_array temp(data.size());
     // Merge blocks of exponential sizes.
@@ -525,6 +870,11 @@ std_array_sortu(Global_Context& global, V_array data, optV_function comparator)
       // Use reference counting as our advantage.
       return ::std::move(data);
     }
+    if(!comparator) {
+      // Try the fast path for packed arrays.
+      if(do_sort_packed_opt(data, true))
+        return ::std::move(data);
+    }
     // The Merge Sort algorithm requires `O(n)` space.
     V_array temp(data.size());
     // Merge blocks of exponential sizes.
@@ -549,6 +899,13 @@ std_array_max_of(Global_Context& global, V_array data, optV_function comparator)
       // Return `null` if `data` is empty.
       return nullptr;
     }
+    if(!comparator) {
+      // Try the fast path for packed arrays.
+      auto qpacked = do_find_extremum_packed_opt(data,
+                         [](const auto& lhs, const auto& rhs) { return lhs < rhs;  });
+      if(qpacked)
+        return **qpacked;
+    }
     cow_vector<Reference> args;
     for(auto it = qmax + 1;  it != data.end();  ++it) {
       // Compare `*qmax` with the other elements, ignoring unordered elements.
@@ -567,6 +924,13 @@ std_array_min_of(Global_Context& global, V_array data, optV_function comparator)
       // Return `null` if `data` is empty.
       return nullptr;
     }
+    if(!comparator) {
+      // Try the fast path for packed arrays.
+      auto qpacked = do_find_extremum_packed_opt(data,
+                         [](const auto& lhs, const auto& rhs) { return lhs > rhs;  });
+      if(qpacked)
+        return **qpacked;
+    }
     cow_vector<Reference> args;
     for(auto it = qmin + 1;  it != data.end();  ++it) {
       // Compare `*qmin` with the other elements, ignoring unordered elements.
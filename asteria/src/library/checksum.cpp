@@ -6,6 +6,16 @@
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/global_context.hpp"
 #include "../utilities.hpp"
+#include <fcntl.h>  // ::open(), ::posix_fadvise()
+#include <unistd.h>  // ::close(), ::read(), ::pread()
+#include <sys/stat.h>  // ::fstat()
+#include <atomic>
+#include <thread>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#  define ASTERIA_CHECKSUM_X86_  1
+#  include <immintrin.h>
+#endif
 
 namespace Asteria {
 namespace {
@@ -20,21 +30,300 @@ struct CRC32_Generator<valueT, divisorT, 8>
   : ::std::integral_constant<uint32_t, valueT>
   { };
 
-template<uint32_t divisorT, size_t... S>
+// The `sliceT`-th table maps a byte to its CRC with `sliceT` more zero bytes appended.
+template<uint32_t valueT, uint32_t divisorT, int sliceT>
+struct CRC32_Slice_Generator
+  : ::std::integral_constant<uint32_t,
+        (CRC32_Slice_Generator<valueT, divisorT, sliceT - 1>::value >> 8) ^
+        CRC32_Generator<uint8_t(CRC32_Slice_Generator<valueT, divisorT, sliceT - 1>::value),
+                        divisorT, 0>::value>
+  { };
+
+template<uint32_t valueT, uint32_t divisorT>
+struct CRC32_Slice_Generator<valueT, divisorT, 0>
+  : CRC32_Generator<valueT, divisorT, 0>
+  { };
+
+template<uint32_t divisorT, int sliceT, size_t... S>
 constexpr
 array<uint32_t, 256>
 do_CRC32_table_impl(const index_sequence<S...>&)
 noexcept
-  { return { CRC32_Generator<uint8_t(S), divisorT, 0>::value... };  }
+  { return { CRC32_Slice_Generator<uint8_t(S), divisorT, sliceT>::value... };  }
+
+template<uint32_t divisorT, size_t... K>
+constexpr
+array<uint32_t, 8, 256>
+do_CRC32_tables_impl(const index_sequence<K...>&)
+noexcept
+  { return { do_CRC32_table_impl<divisorT, int(K)>(::std::make_index_sequence<256>())... };  }
 
 template<uint32_t divisorT>
 constexpr
+array<uint32_t, 8, 256>
+do_CRC32_tables()
+noexcept
+  { return do_CRC32_tables_impl<divisorT>(::std::make_index_sequence<8>());  }
+
+constexpr auto s_iso3309_CRC32_tables = do_CRC32_tables<0xEDB88320>();
+constexpr auto s_castagnoli_CRC32_tables = do_CRC32_tables<0x82F63B78>();
+
+uint32_t
+do_CRC32_update(const array<uint32_t, 8, 256>& tables, uint32_t reg, const char* data, size_t size)
+noexcept
+  {
+    const auto p = reinterpret_cast<const uint8_t*>(data);
+    const auto n = size;
+    uint32_t r = reg;
+    size_t i = 0;
+
+    // Hash 8 bytes at a time, using one table per byte (slicing-by-8).
+    while(n - i >= 8) {
+      uint32_t w = r ^ (p[i] | uint32_t(p[i+1]) << 8 | uint32_t(p[i+2]) << 16 | uint32_t(p[i+3]) << 24);
+      r = tables[7][w & 0xFF] ^ tables[6][w >> 8 & 0xFF] ^ tables[5][w >> 16 & 0xFF] ^ tables[4][w >> 24] ^
+          tables[3][p[i+4]] ^ tables[2][p[i+5]] ^ tables[1][p[i+6]] ^ tables[0][p[i+7]];
+      i += 8;
+    }
+    // Hash remaining bytes one by one.
+    for(;  i < n;  ++i)
+      r = tables[0][((r ^ p[i]) & 0xFF)] ^ (r >> 8);
+    return r;
+  }
+
+#ifdef ASTERIA_CHECKSUM_X86_
+
+// These are selected at run time, so they must not be called unless the CPU supports them.
+inline
+bool
+do_cpu_has_sse42()
+noexcept
+  { return cpu_supports(cpu_feature_sse42);  }
+
+inline
+bool
+do_cpu_has_pclmul()
+noexcept
+  { return cpu_supports(cpu_feature_pclmul | cpu_feature_sse41);  }
+
+inline
+bool
+do_cpu_has_sha_ni()
+noexcept
+  { return cpu_supports(cpu_feature_sha_ni | cpu_feature_sse41);  }
+
+inline
+bool
+do_cpu_has_avx2()
+noexcept
+  { return cpu_supports(cpu_feature_avx2);  }
+
+// This multiplies two polynomials modulo the divisor. As in CRC registers, the most
+// significant bit is the coefficient of x^0.
+constexpr
+uint32_t
+do_CRC32_multiply(uint32_t a, uint32_t b, uint32_t divisor)
+noexcept
+  {
+    uint32_t r = 0;
+    for(uint32_t m = UINT32_C(1) << 31;  m != 0;  m >>= 1) {
+      if(a & m)
+        r ^= b;
+      b = (b >> 1) ^ (-(b & 1) & divisor);
+    }
+    return r;
+  }
+
+// This calculates x^(8n) modulo the divisor, which appends `n` zero bytes when multiplied.
+constexpr
+uint32_t
+do_CRC32_zero_bytes(size_t n, uint32_t divisor)
+noexcept
+  {
+    uint32_t r = UINT32_C(1) << 31;
+    for(size_t i = 0;  i != n * 8;  ++i)
+      r = (r >> 1) ^ (-(r & 1) & divisor);
+    return r;
+  }
+
+// The `k`-th table maps the `k`-th byte of a register to its contribution to the register
+// with `n` zero bytes appended.
+template<size_t... S>
+constexpr
 array<uint32_t, 256>
-do_CRC32_table()
+do_CRC32_shift_table_impl(uint32_t factor, uint32_t divisor, uint32_t bits, const index_sequence<S...>&)
+noexcept
+  { return { do_CRC32_multiply(factor, uint32_t(S) << bits, divisor)... };  }
+
+template<uint32_t divisorT, size_t nT, size_t... K>
+constexpr
+array<uint32_t, 4, 256>
+do_CRC32_shift_tables_impl(const index_sequence<K...>&)
+noexcept
+  {
+    return { do_CRC32_shift_table_impl(do_CRC32_zero_bytes(nT, divisorT), divisorT, uint32_t(K * 8),
+                                       ::std::make_index_sequence<256>())... };
+  }
+
+template<uint32_t divisorT, size_t nT>
+constexpr
+array<uint32_t, 4, 256>
+do_CRC32_shift_tables()
+noexcept
+  { return do_CRC32_shift_tables_impl<divisorT, nT>(::std::make_index_sequence<4>());  }
+
+inline
+uint32_t
+do_CRC32_shift(const array<uint32_t, 4, 256>& tables, uint32_t reg)
+noexcept
+  {
+    return tables[0][reg & 0xFF] ^ tables[1][reg >> 8 & 0xFF] ^
+           tables[2][reg >> 16 & 0xFF] ^ tables[3][reg >> 24];
+  }
+
+// Long inputs are hashed in three interleaved blocks, as the latency of the `crc32`
+// instruction is three times its reciprocal throughput.
+constexpr size_t s_CRC32C_long_block = 8192;
+constexpr size_t s_CRC32C_short_block = 256;
+constexpr auto s_CRC32C_long_shift_tables = do_CRC32_shift_tables<0x82F63B78, s_CRC32C_long_block>();
+constexpr auto s_CRC32C_short_shift_tables = do_CRC32_shift_tables<0x82F63B78, s_CRC32C_short_block>();
+
+__attribute__((__target__("sse4.2")))
+inline
+uint64_t
+do_CRC32C_sse42_word(uint64_t reg, const uint8_t* p)
+noexcept
+  {
+#ifdef __x86_64__
+    uint64_t word;
+    ::std::memcpy(&word, p, 8);
+    return _mm_crc32_u64(reg, word);
+#else
+    uint32_t words[2];
+    ::std::memcpy(words, p, 8);
+    return _mm_crc32_u32(_mm_crc32_u32(static_cast<uint32_t>(reg), words[0]), words[1]);
+#endif
+  }
+
+__attribute__((__target__("sse4.2")))
+inline
+void
+do_CRC32C_sse42_interleaved(uint32_t& reg, const uint8_t*& p, size_t& n, size_t block,
+                            const array<uint32_t, 4, 256>& shift_tables)
+noexcept
+  {
+    while(n >= block * 3) {
+      // The second and third blocks are hashed from zero, then the first two registers
+      // are shifted past the blocks that follow them.
+      uint64_t r0 = reg, r1 = 0, r2 = 0;
+      for(size_t i = 0;  i != block;  i += 8) {
+        r0 = do_CRC32C_sse42_word(r0, p + i);
+        r1 = do_CRC32C_sse42_word(r1, p + block + i);
+        r2 = do_CRC32C_sse42_word(r2, p + block * 2 + i);
+      }
+      reg = do_CRC32_shift(shift_tables, static_cast<uint32_t>(r0)) ^ static_cast<uint32_t>(r1);
+      reg = do_CRC32_shift(shift_tables, reg) ^ static_cast<uint32_t>(r2);
+      p += block * 3;
+      n -= block * 3;
+    }
+  }
+
+__attribute__((__target__("sse4.2")))
+uint32_t
+do_CRC32C_sse42(uint32_t reg, const char* data, size_t size)
+noexcept
+  {
+    auto p = reinterpret_cast<const uint8_t*>(data);
+    size_t n = size;
+    uint32_t r = reg;
+
+    do_CRC32C_sse42_interleaved(r, p, n, s_CRC32C_long_block, s_CRC32C_long_shift_tables);
+    do_CRC32C_sse42_interleaved(r, p, n, s_CRC32C_short_block, s_CRC32C_short_shift_tables);
+    while(n >= 8) {
+      r = static_cast<uint32_t>(do_CRC32C_sse42_word(r, p));
+      p += 8;
+      n -= 8;
+    }
+    while(n != 0) {
+      r = _mm_crc32_u8(r, *p);
+      p += 1;
+      n -= 1;
+    }
+    return r;
+  }
+
+__attribute__((__target__("pclmul")))
+inline
+void
+do_CRC32_pclmul_fold(__m128i& x, __m128i k, __m128i next)
 noexcept
-  { return do_CRC32_table_impl<divisorT>(::std::make_index_sequence<256>());  }
+  {
+    __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+    x = _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_xor_si128(lo, next));
+  }
+
+// This folds 64 bytes at a time with carry-less multiplication, then reduces the result
+// with Barrett reduction. `size` shall be a multiple of 16 and no less than 64.
+// https://www.intel.com/content/dam/www/public/us/en/documents/white-papers/fast-crc-computation-generic-polynomials-pclmulqdq-paper.pdf
+__attribute__((__target__("pclmul,sse4.1")))
+uint32_t
+do_CRC32_pclmul(uint32_t reg, const char* data, size_t size)
+noexcept
+  {
+    ROCKET_ASSERT(size >= 64);
+    ROCKET_ASSERT(size % 16 == 0);
+    auto p = reinterpret_cast<const __m128i*>(data);
+    size_t n = size / 16;
+
+    // These are powers of x modulo P for folding, followed by P and floor(x^64 / P) for
+    // Barrett reduction, all bit-reflected as in the paper.
+    const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+    const __m128i k5k0 = _mm_set_epi64x(0, 0x0163CD6124);
+    const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+
+    __m128i x1 = _mm_xor_si128(_mm_loadu_si128(p), _mm_cvtsi32_si128(static_cast<int>(reg)));
+    __m128i x2 = _mm_loadu_si128(p + 1);
+    __m128i x3 = _mm_loadu_si128(p + 2);
+    __m128i x4 = _mm_loadu_si128(p + 3);
+    p += 4;
+    n -= 4;
+
+    // Fold four blocks in parallel.
+    while(n >= 4) {
+      __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+      __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+      __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+      __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+      x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k1k2, 0x11), _mm_xor_si128(x5, _mm_loadu_si128(p)));
+      x2 = _mm_xor_si128(_mm_clmulepi64_si128(x2, k1k2, 0x11), _mm_xor_si128(x6, _mm_loadu_si128(p + 1)));
+      x3 = _mm_xor_si128(_mm_clmulepi64_si128(x3, k1k2, 0x11), _mm_xor_si128(x7, _mm_loadu_si128(p + 2)));
+      x4 = _mm_xor_si128(_mm_clmulepi64_si128(x4, k1k2, 0x11), _mm_xor_si128(x8, _mm_loadu_si128(p + 3)));
+      p += 4;
+      n -= 4;
+    }
+
+    // Fold them into one, followed by remaining blocks.
+    do_CRC32_pclmul_fold(x1, k3k4, x2);
+    do_CRC32_pclmul_fold(x1, k3k4, x3);
+    do_CRC32_pclmul_fold(x1, k3k4, x4);
+    while(n != 0) {
+      do_CRC32_pclmul_fold(x1, k3k4, _mm_loadu_si128(p));
+      p += 1;
+      n -= 1;
+    }
 
-constexpr auto s_iso3309_CRC32_table = do_CRC32_table<0xEDB88320>();
+    // Reduce 128 bits to 64 bits, then to 32 bits.
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), _mm_clmulepi64_si128(x1, k3k4, 0x10));
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 4),
+                       _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5k0, 0x00));
+    __m128i t = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), poly, 0x10);
+    t = _mm_clmulepi64_si128(_mm_and_si128(t, mask32), poly, 0x00);
+    x1 = _mm_xor_si128(x1, t);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+  }
+
+#endif  // ASTERIA_CHECKSUM_X86_
 
 class CRC32_Hasher
 final
@@ -64,17 +353,72 @@ final
       }
 
     void
-    update(const V_string& data)
+    update(const char* data, size_t size)
     noexcept
       {
-        const auto p = reinterpret_cast<const uint8_t*>(data.data());
-        const auto n = data.size();
-        uint32_t r = this->m_reg;
+#ifdef ASTERIA_CHECKSUM_X86_
+        if(do_cpu_has_pclmul() && (size >= 64)) {
+          // Fold whole blocks of 16 bytes. The remaining bytes are hashed below.
+          size_t nfold = size / 16 * 16;
+          this->m_reg = do_CRC32_pclmul(this->m_reg, data, nfold);
+          data += nfold;
+          size -= nfold;
+        }
+#endif
+        this->m_reg = do_CRC32_update(s_iso3309_CRC32_tables, this->m_reg, data, size);
+      }
 
-        // Hash bytes one by one.
-        for(size_t i = 0;  i < n;  ++i)
-          r = s_iso3309_CRC32_table[((r ^ p[i]) & 0xFF)] ^ (r >> 8);
-        this->m_reg = r;
+    V_integer
+    finish()
+    noexcept
+      {
+        // Get the checksum.
+        uint32_t ck = ~(this->m_reg);
+
+        // Reset internal states.
+        this->m_reg = UINT32_MAX;
+        return ck;
+      }
+  };
+
+class CRC32C_Hasher
+final
+  : public Abstract_Opaque
+  {
+  private:
+    uint32_t m_reg = UINT32_MAX;
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "CRC-32C hasher";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    CRC32C_Hasher*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override
+      {
+        auto qnew = ::rocket::make_unique<CRC32C_Hasher>(*this);
+        output.reset(qnew.get());
+        return qnew.release();
+      }
+
+    void
+    update(const char* data, size_t size)
+    noexcept
+      {
+#ifdef ASTERIA_CHECKSUM_X86_
+        if(do_cpu_has_sse42()) {
+          this->m_reg = do_CRC32C_sse42(this->m_reg, data, size);
+          return;
+        }
+#endif
+        this->m_reg = do_CRC32_update(s_castagnoli_CRC32_tables, this->m_reg, data, size);
       }
 
     V_integer
@@ -125,11 +469,11 @@ final
       }
 
     void
-    update(const V_string& data)
+    update(const char* data, size_t size)
     noexcept
       {
-        const auto p = reinterpret_cast<const uint8_t*>(data.data());
-        const auto n = data.size();
+        const auto p = reinterpret_cast<const uint8_t*>(data);
+        const auto n = size;
         uint32_t r = this->m_reg;
         // Hash bytes one by one.
         for(size_t i = 0;  i < n;  ++i) {
@@ -176,21 +520,16 @@ V_string&
 do_pdigits_impl(V_string& str, const WordT& ref)
   {
     static_assert(::std::is_unsigned<WordT>::value);
-    array<uint8_t, sizeof(WordT)> stor_le;
+    char digits[sizeof(WordT) * 2];
     uint64_t word = static_cast<uint64_t>(ref);
-    // Write the word in little-endian order.
-    for(size_t i = 0;  i < stor_le.size();  ++i) {
-      stor_le[i] = word & 0xFF;
+    // Write hexadecimal digits of bytes from the least significant one.
+    for(size_t i = 0;  i < sizeof(WordT);  ++i) {
+      size_t k = bigendT ? (sizeof(WordT) - 1 - i) : i;
+      ::std::memcpy(digits + k * 2, s_hex_digits[word & 0xFF].data(), 2);
       word >>= 8;
     }
-    // Append hexadecimal digits.
-    if(bigendT)
-      ::std::for_each(stor_le.rbegin(), stor_le.rend(),
-                      [&](uint8_t b) { str.append(s_hex_digits[b].data(), 2);  });
-    else
-      ::std::for_each(stor_le.begin(), stor_le.end(),
-                      [&](uint8_t b) { str.append(s_hex_digits[b].data(), 2);  });
-    return str;
+    // Append all digits at once.
+    return str.append(digits, sizeof(digits));
   }
 
 template<typename WordT>
@@ -407,11 +746,11 @@ final
       }
 
     void
-    update(const V_string& data)
+    update(const char* data, size_t size)
     noexcept
       {
-        auto bp = reinterpret_cast<const uint8_t*>(data.data());
-        auto ep = bp + data.size();
+        auto bp = reinterpret_cast<const uint8_t*>(data);
+        auto ep = bp + size;
         auto bc = this->m_chunk.mut_begin() + this->m_size % 64;
         auto ec = this->m_chunk.mut_end();
         ptrdiff_t n;
@@ -499,11 +838,497 @@ final
       }
   };
 
+constexpr array<uint32_t, 64> s_SHA256_K =
+  {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+  };
+
+#ifdef ASTERIA_CHECKSUM_X86_
+
+// These are building blocks of the SHA extensions.
+// https://www.intel.com/content/www/us/en/developer/articles/technical/intel-sha-extensions.html
+__attribute__((__target__("sha,sse4.1")))
+inline
+void
+do_sha1_ni_schedule(__m128i& w0, __m128i w1, __m128i w2, __m128i w3)
+noexcept
+  {
+    w0 = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w0, w1), w2), w3);
+  }
+
+template<int funcT>
+__attribute__((__target__("sha,sse4.1")))
+inline
+void
+do_sha1_ni_rounds(__m128i& abcd, __m128i& prev, __m128i w)
+noexcept
+  {
+    // `prev` is the value of `abcd` before the previous four rounds.
+    __m128i e = _mm_sha1nexte_epu32(prev, w);
+    prev = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e, funcT);
+  }
+
+__attribute__((__target__("sha,sse4.1")))
+inline
+void
+do_sha256_ni_schedule(__m128i& w0, __m128i w1, __m128i w2, __m128i w3)
+noexcept
+  {
+    w0 = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0, w1), _mm_alignr_epi8(w3, w2, 4)), w3);
+  }
+
+__attribute__((__target__("sha,sse4.1")))
+inline
+void
+do_sha256_ni_rounds(__m128i& abef, __m128i& cdgh, __m128i w, size_t i)
+noexcept
+  {
+    __m128i kw = _mm_add_epi32(w, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_SHA256_K.data() + i)));
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, kw);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(kw, 0x0E));
+  }
+
+// These consume `nchunks` chunks of 64 bytes from `p` with the SHA extensions.
+__attribute__((__target__("sha,sse4.1")))
+void
+do_sha1_ni(array<uint32_t, 5>& regs, const uint8_t* p, size_t nchunks)
+noexcept
+  {
+    const __m128i bswap = _mm_set_epi64x(0x0001020304050607, 0x08090A0B0C0D0E0F);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(regs.data())), 0x1B);
+    __m128i e = _mm_set_epi32(static_cast<int>(regs[4]), 0, 0, 0);
+
+    for(size_t i = 0;  i < nchunks;  ++i) {
+      const __m128i* q = reinterpret_cast<const __m128i*>(p + i * 64);
+      __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(q + 0), bswap);
+      __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(q + 1), bswap);
+      __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(q + 2), bswap);
+      __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(q + 3), bswap);
+      __m128i abcd_old = abcd;
+      __m128i prev = abcd;
+
+      // Unroll loops by hand. Each call performs four rounds.
+      // 0 * 20
+      abcd = _mm_sha1rnds4_epu32(abcd, _mm_add_epi32(e, w0), 0);
+      do_sha1_ni_rounds<0>(abcd, prev, w1);
+      do_sha1_ni_rounds<0>(abcd, prev, w2);
+      do_sha1_ni_rounds<0>(abcd, prev, w3);
+      do_sha1_ni_schedule(w0, w1, w2, w3);
+      do_sha1_ni_rounds<0>(abcd, prev, w0);
+
+      // 1
+      do_sha1_ni_schedule(w1, w2, w3, w0);
+      do_sha1_ni_rounds<1>(abcd, prev, w1);
+      do_sha1_ni_schedule(w2, w3, w0, w1);
+      do_sha1_ni_rounds<1>(abcd, prev, w2);
+      do_sha1_ni_schedule(w3, w0, w1, w2);
+      do_sha1_ni_rounds<1>(abcd, prev, w3);
+      do_sha1_ni_schedule(w0, w1, w2, w3);
+      do_sha1_ni_rounds<1>(abcd, prev, w0);
+      do_sha1_ni_schedule(w1, w2, w3, w0);
+      do_sha1_ni_rounds<1>(abcd, prev, w1);
+
+      // 2
+      do_sha1_ni_schedule(w2, w3, w0, w1);
+      do_sha1_ni_rounds<2>(abcd, prev, w2);
+      do_sha1_ni_schedule(w3, w0, w1, w2);
+      do_sha1_ni_rounds<2>(abcd, prev, w3);
+      do_sha1_ni_schedule(w0, w1, w2, w3);
+      do_sha1_ni_rounds<2>(abcd, prev, w0);
+      do_sha1_ni_schedule(w1, w2, w3, w0);
+      do_sha1_ni_rounds<2>(abcd, prev, w1);
+      do_sha1_ni_schedule(w2, w3, w0, w1);
+      do_sha1_ni_rounds<2>(abcd, prev, w2);
+
+      // 3
+      do_sha1_ni_schedule(w3, w0, w1, w2);
+      do_sha1_ni_rounds<3>(abcd, prev, w3);
+      do_sha1_ni_schedule(w0, w1, w2, w3);
+      do_sha1_ni_rounds<3>(abcd, prev, w0);
+      do_sha1_ni_schedule(w1, w2, w3, w0);
+      do_sha1_ni_rounds<3>(abcd, prev, w1);
+      do_sha1_ni_schedule(w2, w3, w0, w1);
+      do_sha1_ni_rounds<3>(abcd, prev, w2);
+      do_sha1_ni_schedule(w3, w0, w1, w2);
+      do_sha1_ni_rounds<3>(abcd, prev, w3);
+
+      // Accumulate the result.
+      e = _mm_sha1nexte_epu32(prev, e);
+      abcd = _mm_add_epi32(abcd, abcd_old);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(regs.mut_data()), _mm_shuffle_epi32(abcd, 0x1B));
+    regs[4] = static_cast<uint32_t>(_mm_extract_epi32(e, 3));
+  }
+
+__attribute__((__target__("sha,sse4.1")))
+void
+do_sha256_ni(array<uint32_t, 8>& regs, const uint8_t* p, size_t nchunks)
+noexcept
+  {
+    const __m128i bswap = _mm_set_epi64x(0x0C0D0E0F08090A0B, 0x0405060700010203);
+    __m128i t = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(regs.data())), 0xB1);
+    __m128i cdgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(regs.data() + 4)), 0x1B);
+    __m128i abef = _mm_alignr_epi8(t, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, t, 0xF0);
+
+    for(size_t i = 0;  i < nchunks;  ++i) {
+      const __m128i* q = reinterpret_cast<const __m128i*>(p + i * 64);
+      __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(q + 0), bswap);
+      __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(q + 1), bswap);
+      __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(q + 2), bswap);
+      __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(q + 3), bswap);
+      __m128i abef_old = abef;
+      __m128i cdgh_old = cdgh;
+
+      // Unroll loops by hand. Each call performs four rounds.
+      // 0 * 16
+      do_sha256_ni_rounds(abef, cdgh, w0,  0);
+      do_sha256_ni_rounds(abef, cdgh, w1,  4);
+      do_sha256_ni_rounds(abef, cdgh, w2,  8);
+      do_sha256_ni_rounds(abef, cdgh, w3, 12);
+
+      // 1 * 16
+      do_sha256_ni_schedule(w0, w1, w2, w3);
+      do_sha256_ni_rounds(abef, cdgh, w0, 16);
+      do_sha256_ni_schedule(w1, w2, w3, w0);
+      do_sha256_ni_rounds(abef, cdgh, w1, 20);
+      do_sha256_ni_schedule(w2, w3, w0, w1);
+      do_sha256_ni_rounds(abef, cdgh, w2, 24);
+      do_sha256_ni_schedule(w3, w0, w1, w2);
+      do_sha256_ni_rounds(abef, cdgh, w3, 28);
+
+      // 2 * 16
+      do_sha256_ni_schedule(w0, w1, w2, w3);
+      do_sha256_ni_rounds(abef, cdgh, w0, 32);
+      do_sha256_ni_schedule(w1, w2, w3, w0);
+      do_sha256_ni_rounds(abef, cdgh, w1, 36);
+      do_sha256_ni_schedule(w2, w3, w0, w1);
+      do_sha256_ni_rounds(abef, cdgh, w2, 40);
+      do_sha256_ni_schedule(w3, w0, w1, w2);
+      do_sha256_ni_rounds(abef, cdgh, w3, 44);
+
+      // 3 * 16
+      do_sha256_ni_schedule(w0, w1, w2, w3);
+      do_sha256_ni_rounds(abef, cdgh, w0, 48);
+      do_sha256_ni_schedule(w1, w2, w3, w0);
+      do_sha256_ni_rounds(abef, cdgh, w1, 52);
+      do_sha256_ni_schedule(w2, w3, w0, w1);
+      do_sha256_ni_rounds(abef, cdgh, w2, 56);
+      do_sha256_ni_schedule(w3, w0, w1, w2);
+      do_sha256_ni_rounds(abef, cdgh, w3, 60);
+
+      // Accumulate the result.
+      abef = _mm_add_epi32(abef, abef_old);
+      cdgh = _mm_add_epi32(cdgh, cdgh_old);
+    }
+
+    t = _mm_shuffle_epi32(abef, 0x1B);
+    cdgh = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(regs.mut_data()), _mm_blend_epi16(t, cdgh, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(regs.mut_data() + 4), _mm_alignr_epi8(cdgh, t, 8));
+  }
+
+// This describes a message in a lane. Full chunks are read from the message directly, and
+// the rest, which is padded, is read from `tail`.
+struct Hash_Lane
+  {
+    const uint8_t* body;
+    const uint8_t* tail;
+    size_t nbody;
+    size_t nchunks;
+
+    const uint8_t*
+    chunk(size_t c)
+    const noexcept
+      {
+        // After the last chunk, the last chunk is repeated, and its results are discarded.
+        if(c < this->nbody)
+          return this->body + c * 64;
+        return this->tail + (::rocket::min(c, this->nchunks - 1) - this->nbody) * 64;
+      }
+  };
+
+// These process eight messages with AVX2, one in each 32-bit lane. Registers are stored
+// transposed, that is, `regs[i][k]` is the `i`-th register of lane `k`.
+__attribute__((__target__("avx2")))
+inline
+__m256i
+do_rotl_x8(__m256i x, int bits)
+noexcept
+  {
+    return _mm256_or_si256(_mm256_slli_epi32(x, bits), _mm256_srli_epi32(x, 32 - bits));
+  }
+
+__attribute__((__target__("avx2")))
+inline
+void
+do_load_be_x8(__m256i* w, const uint8_t* const* ptrs, size_t offset)
+noexcept
+  {
+    // Load eight big-endian words from each lane, then transpose them.
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i r[8], t[8];
+    for(size_t k = 0;  k < 8;  ++k)
+      r[k] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptrs[k] + offset)),
+                                 bswap);
+    for(size_t k = 0;  k < 8;  k += 2) {
+      t[k] = _mm256_unpacklo_epi32(r[k], r[k+1]);
+      t[k+1] = _mm256_unpackhi_epi32(r[k], r[k+1]);
+    }
+    for(size_t k = 0;  k < 8;  k += 4) {
+      r[k] = _mm256_unpacklo_epi64(t[k], t[k+2]);
+      r[k+1] = _mm256_unpackhi_epi64(t[k], t[k+2]);
+      r[k+2] = _mm256_unpacklo_epi64(t[k+1], t[k+3]);
+      r[k+3] = _mm256_unpackhi_epi64(t[k+1], t[k+3]);
+    }
+    for(size_t k = 0;  k < 4;  ++k) {
+      w[k] = _mm256_permute2x128_si256(r[k], r[k+4], 0x20);
+      w[k+4] = _mm256_permute2x128_si256(r[k], r[k+4], 0x31);
+    }
+  }
+
+__attribute__((__target__("avx2")))
+void
+do_sha1_avx2_chunk(array<uint32_t, 5, 8>& regs, const uint8_t* const* ptrs)
+noexcept
+  {
+    __m256i r[5], w[16];
+    for(size_t i = 0;  i < 5;  ++i)
+      r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(regs[i].data()));
+    do_load_be_x8(w, ptrs, 0);
+    do_load_be_x8(w + 8, ptrs, 32);
+
+    // https://en.wikipedia.org/wiki/SHA-1
+    __m256i a = r[0], b = r[1], c = r[2], d = r[3], e = r[4];
+    for(size_t i = 0;  i < 80;  ++i) {
+      __m256i& x = w[i % 16];
+      if(i >= 16)
+        x = do_rotl_x8(_mm256_xor_si256(_mm256_xor_si256(w[(i-3)%16], w[(i-8)%16]),
+                                        _mm256_xor_si256(w[(i-14)%16], x)), 1);
+
+      __m256i f, k;
+      if(i < 20) {
+        f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+        k = _mm256_set1_epi32(0x5A827999);
+      }
+      else if(i < 40) {
+        f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+        k = _mm256_set1_epi32(0x6ED9EBA1);
+      }
+      else if(i < 60) {
+        f = _mm256_or_si256(_mm256_and_si256(b, _mm256_or_si256(c, d)), _mm256_and_si256(c, d));
+        k = _mm256_set1_epi32(static_cast<int>(0x8F1BBCDC));
+      }
+      else {
+        f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+        k = _mm256_set1_epi32(static_cast<int>(0xCA62C1D6));
+      }
+      __m256i t = _mm256_add_epi32(_mm256_add_epi32(do_rotl_x8(a, 5), f),
+                                   _mm256_add_epi32(_mm256_add_epi32(e, k), x));
+      e = d;
+      d = c;
+      c = do_rotl_x8(b, 30);
+      b = a;
+      a = t;
+    }
+
+    // Accumulate the result.
+    r[0] = _mm256_add_epi32(r[0], a);
+    r[1] = _mm256_add_epi32(r[1], b);
+    r[2] = _mm256_add_epi32(r[2], c);
+    r[3] = _mm256_add_epi32(r[3], d);
+    r[4] = _mm256_add_epi32(r[4], e);
+    for(size_t i = 0;  i < 5;  ++i)
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(regs.mut(i).mut_data()), r[i]);
+  }
+
+__attribute__((__target__("avx2")))
+void
+do_sha256_avx2_chunk(array<uint32_t, 8, 8>& regs, const uint8_t* const* ptrs)
+noexcept
+  {
+    __m256i r[8], w[16];
+    for(size_t i = 0;  i < 8;  ++i)
+      r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(regs[i].data()));
+    do_load_be_x8(w, ptrs, 0);
+    do_load_be_x8(w + 8, ptrs, 32);
+
+    // https://en.wikipedia.org/wiki/SHA-2
+    __m256i a = r[0], b = r[1], c = r[2], d = r[3], e = r[4], f = r[5], g = r[6], h = r[7];
+    for(size_t i = 0;  i < 64;  ++i) {
+      __m256i& x = w[i % 16];
+      if(i >= 16) {
+        __m256i t1 = w[(i-15)%16];
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(do_rotl_x8(t1, 14), do_rotl_x8(t1, 25)),
+                                      _mm256_srli_epi32(t1, 3));
+        __m256i t2 = w[(i-2)%16];
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(do_rotl_x8(t2, 13), do_rotl_x8(t2, 15)),
+                                      _mm256_srli_epi32(t2, 10));
+        x = _mm256_add_epi32(_mm256_add_epi32(x, w[(i-7)%16]), _mm256_add_epi32(s0, s1));
+      }
+
+      __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(do_rotl_x8(a, 10), do_rotl_x8(a, 19)),
+                                    do_rotl_x8(a, 30));
+      __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+      __m256i t2 = _mm256_add_epi32(s0, maj);
+      __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(do_rotl_x8(e, 7), do_rotl_x8(e, 21)),
+                                    do_rotl_x8(e, 26));
+      __m256i ch = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+      __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, s1),
+                                    _mm256_add_epi32(_mm256_add_epi32(ch, x),
+                                                     _mm256_set1_epi32(static_cast<int>(s_SHA256_K[i]))));
+      h = g;
+      g = f;
+      f = e;
+      e = _mm256_add_epi32(d, t1);
+      d = c;
+      c = b;
+      b = a;
+      a = _mm256_add_epi32(t1, t2);
+    }
+
+    // Accumulate the result.
+    r[0] = _mm256_add_epi32(r[0], a);
+    r[1] = _mm256_add_epi32(r[1], b);
+    r[2] = _mm256_add_epi32(r[2], c);
+    r[3] = _mm256_add_epi32(r[3], d);
+    r[4] = _mm256_add_epi32(r[4], e);
+    r[5] = _mm256_add_epi32(r[5], f);
+    r[6] = _mm256_add_epi32(r[6], g);
+    r[7] = _mm256_add_epi32(r[7], h);
+    for(size_t i = 0;  i < 8;  ++i)
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(regs.mut(i).mut_data()), r[i]);
+  }
+
+__attribute__((__target__("avx2")))
+void
+do_sha1_avx2_x8(array<uint32_t, 8, 5>& regs, const Hash_Lane* lanes)
+noexcept
+  {
+    array<uint32_t, 5, 8> t;
+    size_t nmax = 0;
+    for(size_t k = 0;  k < 8;  ++k) {
+      for(size_t i = 0;  i < 5;  ++i)
+        t.mut(i).mut(k) = regs[k][i];
+      nmax = ::rocket::max(nmax, lanes[k].nchunks);
+    }
+
+    for(size_t c = 0;  c < nmax;  ++c) {
+      const uint8_t* ptrs[8];
+      for(size_t k = 0;  k < 8;  ++k)
+        ptrs[k] = lanes[k].chunk(c);
+      do_sha1_avx2_chunk(t, ptrs);
+      for(size_t k = 0;  k < 8;  ++k)
+        if(c + 1 == lanes[k].nchunks)
+          for(size_t i = 0;  i < 5;  ++i)
+            regs.mut(k).mut(i) = t[i][k];
+    }
+  }
+
+__attribute__((__target__("avx2")))
+void
+do_sha256_avx2_x8(array<uint32_t, 8, 8>& regs, const Hash_Lane* lanes)
+noexcept
+  {
+    array<uint32_t, 8, 8> t;
+    size_t nmax = 0;
+    for(size_t k = 0;  k < 8;  ++k) {
+      for(size_t i = 0;  i < 8;  ++i)
+        t.mut(i).mut(k) = regs[k][i];
+      nmax = ::rocket::max(nmax, lanes[k].nchunks);
+    }
+
+    for(size_t c = 0;  c < nmax;  ++c) {
+      const uint8_t* ptrs[8];
+      for(size_t k = 0;  k < 8;  ++k)
+        ptrs[k] = lanes[k].chunk(c);
+      do_sha256_avx2_chunk(t, ptrs);
+      for(size_t k = 0;  k < 8;  ++k)
+        if(c + 1 == lanes[k].nchunks)
+          for(size_t i = 0;  i < 8;  ++i)
+            regs.mut(k).mut(i) = t[i][k];
+    }
+  }
+
+// Hashes all strings in `data` in `nlanesT` lanes, with a SHA-1 or SHA-256 function `compress`.
+// Messages are sorted by length, so lanes in the same batch finish at about the same time.
+template<size_t nlanesT, size_t nregsT, typename CompressT>
+V_array
+do_hash_many_lanes(const V_array& data, const array<uint32_t, nregsT>& init, CompressT&& compress)
+  {
+    // The upper half of a key is the number of chunks after padding, and the lower half is the
+    // index of the message. Sorting is skipped if messages are already in order.
+    cow_vector<uint64_t> keys;
+    keys.reserve(data.size());
+    for(size_t i = 0;  i < data.size();  ++i)
+      keys.emplace_back(static_cast<uint64_t>((data[i].as_string().size() + 72) / 64) << 32 | i);
+    auto kbegin = keys.mut_data();
+    auto kend = kbegin + keys.size();
+    if(!::std::is_sorted(kbegin, kend))
+      ::std::sort(kbegin, kend);
+
+    V_array result(data.size());
+    array<uint32_t, nlanesT, nregsT> regs;
+    array<uint8_t, nlanesT, 128> tails;
+    array<Hash_Lane, nlanesT> lanes;
+    for(size_t base = 0;  base < keys.size();  base += nlanesT) {
+      size_t nlanes = ::rocket::min(keys.size() - base, nlanesT);
+      for(size_t k = 0;  k < nlanes;  ++k) {
+        const auto& str = data[static_cast<size_t>(keys[base+k] & UINT32_MAX)].as_string();
+        auto& lane = lanes.mut(k);
+        lane.body = reinterpret_cast<const uint8_t*>(str.data());
+        lane.tail = tails[k].data();
+        lane.nbody = str.size() / 64;
+        lane.nchunks = static_cast<size_t>(keys[base+k] >> 32);
+        regs.mut(k) = init;
+
+        // Append a `0x80` byte and the number of bits in big-endian order to the last chunk.
+        auto tail = tails.mut(k).mut_data();
+        size_t nrem = str.size() % 64;
+        size_t ntail = (lane.nchunks - lane.nbody) * 64;
+        ::std::memcpy(tail, lane.body + lane.nbody * 64, nrem);
+        tail[nrem] = 0x80;
+        ::std::memset(tail + nrem + 1, 0, ntail - nrem - 9);
+        auto bits = static_cast<uint64_t>(str.size()) * 8;
+        for(size_t i = 1;  i <= 8;  ++i) {
+          tail[ntail - i] = static_cast<uint8_t>(bits);
+          bits >>= 8;
+        }
+      }
+      // Idle lanes repeat the first one, and their results are discarded.
+      for(size_t k = nlanes;  k < nlanesT;  ++k) {
+        lanes.mut(k) = lanes[0];
+        regs.mut(k) = init;
+      }
+      compress(regs, lanes.data());
+
+      for(size_t k = 0;  k < nlanes;  ++k) {
+        V_string ck;
+        ck.reserve(nregsT * 8);
+        ::rocket::for_each(regs[k], [&](uint32_t w) { do_pdigits_be(ck, w);  });
+        result.mut(static_cast<size_t>(keys[base+k] & UINT32_MAX)) = ::std::move(ck);
+      }
+    }
+    return result;
+  }
+
+#endif  // ASTERIA_CHECKSUM_X86_
+
 class SHA1_Hasher
 final
   : public Abstract_Opaque
   {
-  private:
+  public:
     static
     constexpr
     array<uint32_t, 5>
@@ -657,6 +1482,18 @@ final
         do_padd(this->m_regs, r);
       }
 
+    void
+    do_consume_chunks(const uint8_t* p, size_t n)
+    noexcept
+      {
+#ifdef ASTERIA_CHECKSUM_X86_
+        if(do_cpu_has_sha_ni())
+          return do_sha1_ni(this->m_regs, p, n);
+#endif
+        for(size_t i = 0;  i < n;  ++i)
+          this->do_consume_chunk(p + i * 64);
+      }
+
   public:
     tinyfmt&
     describe(tinyfmt& fmt)
@@ -678,11 +1515,11 @@ final
       }
 
     void
-    update(const V_string& data)
+    update(const char* data, size_t size)
     noexcept
       {
-        auto bp = reinterpret_cast<const uint8_t*>(data.data());
-        auto ep = bp + data.size();
+        auto bp = reinterpret_cast<const uint8_t*>(data);
+        auto ep = bp + size;
         auto bc = this->m_chunk.mut_begin() + this->m_size % 64;
         auto ec = this->m_chunk.mut_end();
         ptrdiff_t n;
@@ -702,15 +1539,16 @@ final
           }
           // Consume the last chunk.
           ROCKET_ASSERT(this->m_size % 64 == 0);
-          this->do_consume_chunk(this->m_chunk.data());
+          this->do_consume_chunks(this->m_chunk.data(), 1);
           bc = this->m_chunk.mut_begin();
         }
 
         // Consume as many chunks as possible; don't bother copying them.
-        while(ep - bp >= 64) {
-          this->do_consume_chunk(bp);
-          bp += 64;
-          this->m_size += 64;
+        if(ep - bp >= 64) {
+          n = (ep - bp) / 64;
+          this->do_consume_chunks(bp, static_cast<size_t>(n));
+          bp += n * 64;
+          this->m_size += static_cast<uint64_t>(n) * 64;
         }
 
         // Append any bytes remaining to the last chunk.
@@ -739,7 +1577,7 @@ final
         if(n < 8) {
           // Wrap.
           ::std::fill_n(bc, n, 0);
-          this->do_consume_chunk(this->m_chunk.data());
+          this->do_consume_chunks(this->m_chunk.data(), 1);
           bc = this->m_chunk.mut_begin();
         }
         n = ec - bc - 8;
@@ -756,7 +1594,7 @@ final
           bc[i] = bits & 0xFF;
           bits >>= 8;
         }
-        this->do_consume_chunk(this->m_chunk.data());
+        this->do_consume_chunks(this->m_chunk.data(), 1);
 
         // Get the checksum.
         V_string ck;
@@ -774,7 +1612,7 @@ class SHA256_Hasher
 final
   : public Abstract_Opaque
   {
-  private:
+  public:
     static
     constexpr
     array<uint32_t, 8>
@@ -900,6 +1738,18 @@ final
         do_padd(this->m_regs, r);
       }
 
+    void
+    do_consume_chunks(const uint8_t* p, size_t n)
+    noexcept
+      {
+#ifdef ASTERIA_CHECKSUM_X86_
+        if(do_cpu_has_sha_ni())
+          return do_sha256_ni(this->m_regs, p, n);
+#endif
+        for(size_t i = 0;  i < n;  ++i)
+          this->do_consume_chunk(p + i * 64);
+      }
+
   public:
     tinyfmt&
     describe(tinyfmt& fmt)
@@ -921,11 +1771,11 @@ final
       }
 
     void
-    update(const V_string& data)
+    update(const char* data, size_t size)
     noexcept
       {
-        auto bp = reinterpret_cast<const uint8_t*>(data.data());
-        auto ep = bp + data.size();
+        auto bp = reinterpret_cast<const uint8_t*>(data);
+        auto ep = bp + size;
         auto bc = this->m_chunk.mut_begin() + this->m_size % 64;
         auto ec = this->m_chunk.mut_end();
         ptrdiff_t n;
@@ -945,15 +1795,16 @@ final
           }
           // Consume the last chunk.
           ROCKET_ASSERT(this->m_size % 64 == 0);
-          this->do_consume_chunk(this->m_chunk.data());
+          this->do_consume_chunks(this->m_chunk.data(), 1);
           bc = this->m_chunk.mut_begin();
         }
 
         // Consume as many chunks as possible; don't bother copying them.
-        while(ep - bp >= 64) {
-          this->do_consume_chunk(bp);
-          bp += 64;
-          this->m_size += 64;
+        if(ep - bp >= 64) {
+          n = (ep - bp) / 64;
+          this->do_consume_chunks(bp, static_cast<size_t>(n));
+          bp += n * 64;
+          this->m_size += static_cast<uint64_t>(n) * 64;
         }
 
         // Append any bytes remaining to the last chunk.
@@ -967,8 +1818,8 @@ final
         ROCKET_ASSERT(bp == ep);
       }
 
-    V_string
-    finish()
+    array<uint32_t, 8>
+    finish_words()
     noexcept
       {
         // Finalize the hasher.
@@ -982,7 +1833,7 @@ final
         if(n < 8) {
           // Wrap.
           ::std::fill_n(bc, n, 0);
-          this->do_consume_chunk(this->m_chunk.data());
+          this->do_consume_chunks(this->m_chunk.data(), 1);
           bc = this->m_chunk.mut_begin();
         }
         n = ec - bc - 8;
@@ -999,20 +1850,336 @@ final
           bc[i] = bits & 0xFF;
           bits >>= 8;
         }
-        this->do_consume_chunk(this->m_chunk.data());
+        this->do_consume_chunks(this->m_chunk.data(), 1);
 
-        // Get the checksum.
-        V_string ck;
-        ck.reserve(this->m_regs.size() * 8);
-        ::rocket::for_each(this->m_regs, [&](uint32_t w) { do_pdigits_be(ck, w);  });
+        // Get the checksum as words.
+        auto regs = this->m_regs;
 
         // Reset internal states.
         this->m_regs = init();
         this->m_size = 0;
+        return regs;
+      }
+
+    V_string
+    finish()
+    noexcept
+      {
+        // Get the checksum.
+        V_string ck;
+        ck.reserve(64);
+        ::rocket::for_each(this->finish_words(), [&](uint32_t w) { do_pdigits_be(ck, w);  });
         return ck;
       }
   };
 
+// This is the default secret of XXH3, which is generated with a seed of zero.
+constexpr array<uint8_t, 192> s_XXH3_secret =
+  {
+    0xB8, 0xFE, 0x6C, 0x39, 0x23, 0xA4, 0x4B, 0xBE, 0x7C, 0x01, 0x81, 0x2C, 0xF7, 0x21, 0xAD, 0x1C,
+    0xDE, 0xD4, 0x6D, 0xE9, 0x83, 0x90, 0x97, 0xDB, 0x72, 0x40, 0xA4, 0xA4, 0xB7, 0xB3, 0x67, 0x1F,
+    0xCB, 0x79, 0xE6, 0x4E, 0xCC, 0xC0, 0xE5, 0x78, 0x82, 0x5A, 0xD0, 0x7D, 0xCC, 0xFF, 0x72, 0x21,
+    0xB8, 0x08, 0x46, 0x74, 0xF7, 0x43, 0x24, 0x8E, 0xE0, 0x35, 0x90, 0xE6, 0x81, 0x3A, 0x26, 0x4C,
+    0x3C, 0x28, 0x52, 0xBB, 0x91, 0xC3, 0x00, 0xCB, 0x88, 0xD0, 0x65, 0x8B, 0x1B, 0x53, 0x2E, 0xA3,
+    0x71, 0x64, 0x48, 0x97, 0xA2, 0x0D, 0xF9, 0x4E, 0x38, 0x19, 0xEF, 0x46, 0xA9, 0xDE, 0xAC, 0xD8,
+    0xA8, 0xFA, 0x76, 0x3F, 0xE3, 0x9C, 0x34, 0x3F, 0xF9, 0xDC, 0xBB, 0xC7, 0xC7, 0x0B, 0x4F, 0x1D,
+    0x8A, 0x51, 0xE0, 0x4B, 0xCD, 0xB4, 0x59, 0x31, 0xC8, 0x9F, 0x7E, 0xC9, 0xD9, 0x78, 0x73, 0x64,
+    0xEA, 0xC5, 0xAC, 0x83, 0x34, 0xD3, 0xEB, 0xC3, 0xC5, 0x81, 0xA0, 0xFF, 0xFA, 0x13, 0x63, 0xEB,
+    0x17, 0x0D, 0xDD, 0x51, 0xB7, 0xF0, 0xDA, 0x49, 0xD3, 0x16, 0x55, 0x26, 0x29, 0xD4, 0x68, 0x9E,
+    0x2B, 0x16, 0xBE, 0x58, 0x7D, 0x47, 0xA1, 0xFC, 0x8F, 0xF8, 0xB8, 0xD1, 0x7A, 0xD0, 0x31, 0xCE,
+    0x45, 0xCB, 0x3A, 0x8F, 0x95, 0x16, 0x04, 0x28, 0xAF, 0xD7, 0xFB, 0xCA, 0xBB, 0x4B, 0x40, 0x7E,
+  };
+
+class XXH3_64_Hasher
+final
+  : public Abstract_Opaque
+  {
+  private:
+    enum : uint64_t
+      {
+        prime32_1  = 0x9E3779B1,
+        prime32_2  = 0x85EBCA77,
+        prime32_3  = 0xC2B2AE3D,
+        prime64_1  = 0x9E3779B185EBCA87,
+        prime64_2  = 0xC2B2AE3D27D4EB4F,
+        prime64_3  = 0x165667B19E3779F9,
+        prime64_4  = 0x85EBCA77C2B2AE63,
+        prime64_5  = 0x27D4EB2F165667C5,
+        prime_mx1  = 0x165667919E3779F9,
+        prime_mx2  = 0x9FB21C651E98DF25,
+      };
+
+    static
+    constexpr
+    array<uint64_t, 8>
+    init()
+    noexcept
+      { return { prime32_3, prime64_1, prime64_2, prime64_3, prime64_4, prime32_2, prime64_5, prime32_1 };  }
+
+  private:
+    array<uint64_t, 8> m_accs = init();
+    uint64_t m_size = 0;
+    size_t m_nstripes = 0;  // number of stripes consumed in the current block
+    size_t m_nbuf = 0;
+    array<uint8_t, 256> m_chunk;
+
+  private:
+    static
+    uint64_t
+    do_read64(const uint8_t* p)
+    noexcept
+      {
+        // This is recognized by the compiler and made a single load.
+        return uint64_t(p[0])       | uint64_t(p[1]) <<  8 | uint64_t(p[2]) << 16 | uint64_t(p[3]) << 24 |
+               uint64_t(p[4]) << 32 | uint64_t(p[5]) << 40 | uint64_t(p[6]) << 48 | uint64_t(p[7]) << 56;
+      }
+
+    static
+    uint64_t
+    do_mul_fold64(uint64_t x, uint64_t y)
+    noexcept
+      {
+        // Calculate the 128-bit product, then XOR its halves.
+        uint64_t xl = x & 0xFFFFFFFF, xh = x >> 32;
+        uint64_t yl = y & 0xFFFFFFFF, yh = y >> 32;
+        uint64_t ll = xl * yl, lh = xl * yh, hl = xh * yl, hh = xh * yh;
+        uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + hl;
+        uint64_t lo = (mid << 32) | (ll & 0xFFFFFFFF);
+        uint64_t hi = hh + (lh >> 32) + (mid >> 32);
+        return lo ^ hi;
+      }
+
+    static
+    uint64_t
+    do_avalanche(uint64_t h)
+    noexcept
+      {
+        h ^= h >> 37;
+        h *= prime_mx1;
+        h ^= h >> 32;
+        return h;
+      }
+
+    static
+    uint64_t
+    do_mix16(const uint8_t* p, const uint8_t* s)
+    noexcept
+      {
+        return do_mul_fold64(do_read64(p) ^ do_read64(s), do_read64(p + 8) ^ do_read64(s + 8));
+      }
+
+    static
+    uint64_t
+    do_hash_short(const uint8_t* p, size_t n)
+    noexcept
+      {
+        // https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+        const auto s = s_XXH3_secret.data();
+        uint64_t h;
+
+        if(n == 0) {
+          h = do_read64(s + 56) ^ do_read64(s + 64);
+          // Use the avalanche function of XXH64.
+          h ^= h >> 33;
+          h *= prime64_2;
+          h ^= h >> 29;
+          h *= prime64_3;
+          h ^= h >> 32;
+          return h;
+        }
+
+        if(n <= 3) {
+          uint32_t lo, hi;
+          h = (uint32_t(p[0]) << 16 | uint32_t(p[n / 2]) << 24 | p[n - 1] | uint32_t(n) << 8) ^
+              (uint64_t(do_load_le(lo, s)) ^ do_load_le(hi, s + 4));
+          h ^= h >> 33;
+          h *= prime64_2;
+          h ^= h >> 29;
+          h *= prime64_3;
+          h ^= h >> 32;
+          return h;
+        }
+
+        if(n <= 8) {
+          uint32_t lo, hi;
+          h = (uint64_t(do_load_le(lo, p)) << 32 | do_load_le(hi, p + n - 4)) ^
+              (do_read64(s + 8) ^ do_read64(s + 16));
+          h ^= do_rotl(h, 49) ^ do_rotl(h, 24);
+          h *= prime_mx2;
+          h ^= (h >> 35) + n;
+          h *= prime_mx2;
+          h ^= h >> 28;
+          return h;
+        }
+
+        if(n <= 16) {
+          uint64_t lo = do_read64(p) ^ (do_read64(s + 24) ^ do_read64(s + 32));
+          uint64_t hi = do_read64(p + n - 8) ^ (do_read64(s + 40) ^ do_read64(s + 48));
+          uint64_t bswap = 0;
+          for(size_t i = 0;  i < 8;  ++i)
+            bswap = bswap << 8 | (lo >> i * 8 & 0xFF);
+          return do_avalanche(n + bswap + hi + do_mul_fold64(lo, hi));
+        }
+
+        h = n * prime64_1;
+        if(n <= 128) {
+          // Mix pairs of 16-byte blocks from both ends.
+          size_t m = (n - 1) / 32;
+          for(size_t i = m;  i != SIZE_MAX;  --i) {
+            h += do_mix16(p + i * 16, s + i * 32);
+            h += do_mix16(p + n - 16 - i * 16, s + i * 32 + 16);
+          }
+          return do_avalanche(h);
+        }
+
+        // Mix all 16-byte blocks, then the last one.
+        for(size_t i = 0;  i < 8;  ++i)
+          h += do_mix16(p + i * 16, s + i * 16);
+        h = do_avalanche(h);
+        for(size_t i = 8;  i < n / 16;  ++i)
+          h += do_mix16(p + i * 16, s + (i - 8) * 16 + 3);
+        h += do_mix16(p + n - 16, s + 119);
+        return do_avalanche(h);
+      }
+
+    static
+    void
+    do_accumulate(array<uint64_t, 8>& accs, const uint8_t* p, const uint8_t* s)
+    noexcept
+      {
+        // Consume a stripe of 64 bytes.
+        const auto a = accs.mut_data();
+        for(size_t i = 0;  i < 8;  ++i) {
+          uint64_t v = do_read64(p + i * 8);
+          uint64_t k = v ^ do_read64(s + i * 8);
+          a[i ^ 1] += v;
+          a[i] += (k & 0xFFFFFFFF) * (k >> 32);
+        }
+      }
+
+    void
+    do_consume_stripes(const uint8_t* p, size_t count)
+    noexcept
+      {
+        // A block consists of 16 stripes, after which accumulators are scrambled.
+        const auto s = s_XXH3_secret.data();
+        for(size_t i = 0;  i < count;  ++i) {
+          do_accumulate(this->m_accs, p + i * 64, s + this->m_nstripes * 8);
+          if(++(this->m_nstripes) != 16)
+            continue;
+          for(size_t j = 0;  j < 8;  ++j) {
+            uint64_t a = this->m_accs[j];
+            a ^= a >> 47;
+            a ^= do_read64(s + 128 + j * 8);
+            this->m_accs[j] = a * prime32_1;
+          }
+          this->m_nstripes = 0;
+        }
+      }
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "XXH3 hasher (64-bit)";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    XXH3_64_Hasher*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override
+      {
+        auto qnew = ::rocket::make_unique<XXH3_64_Hasher>(*this);
+        output.reset(qnew.get());
+        return qnew.release();
+      }
+
+    void
+    update(const char* data, size_t size)
+    noexcept
+      {
+        auto bp = reinterpret_cast<const uint8_t*>(data);
+        auto ep = bp + size;
+        this->m_size += size;
+
+        // If all data fit in the buffer, don't consume anything.
+        // The buffer is consumed only when more data follow it.
+        if(static_cast<size_t>(ep - bp) <= 256 - this->m_nbuf) {
+          ::std::copy(bp, ep, this->m_chunk.mut_data() + this->m_nbuf);
+          this->m_nbuf += static_cast<size_t>(ep - bp);
+          return;
+        }
+
+        // Fill and consume the buffer.
+        if(this->m_nbuf != 0) {
+          size_t n = 256 - this->m_nbuf;
+          ::std::copy_n(bp, n, this->m_chunk.mut_data() + this->m_nbuf);
+          bp += n;
+          this->do_consume_stripes(this->m_chunk.data(), 4);
+        }
+
+        // Consume data in place, but keep at least one byte for the buffer.
+        if(ep - bp > 256) {
+          do {
+            this->do_consume_stripes(bp, 4);
+            bp += 256;
+          }
+          while(ep - bp > 256);
+          // Save the last stripe, which may be needed by `finish()`.
+          ::std::copy_n(bp - 64, 64, this->m_chunk.mut_data() + 192);
+        }
+
+        // Append remaining bytes to the buffer.
+        ::std::copy(bp, ep, this->m_chunk.mut_data());
+        this->m_nbuf = static_cast<size_t>(ep - bp);
+      }
+
+    V_integer
+    finish()
+    noexcept
+      {
+        const auto s = s_XXH3_secret.data();
+        uint64_t h;
+
+        if(this->m_size <= 240) {
+          // Short input is hashed as a whole.
+          h = do_hash_short(this->m_chunk.data(), this->m_nbuf);
+        }
+        else {
+          // Consume buffered data except the last stripe.
+          array<uint8_t, 64> last;
+          size_t n = this->m_nbuf;
+          if(n >= 64) {
+            this->do_consume_stripes(this->m_chunk.data(), (n - 1) / 64);
+            ::std::copy_n(this->m_chunk.data() + n - 64, 64, last.mut_data());
+          }
+          else {
+            // Take the tail of the previous stripe.
+            ::std::copy_n(this->m_chunk.data() + 192 + n, 64 - n, last.mut_data());
+            ::std::copy_n(this->m_chunk.data(), n, last.mut_data() + 64 - n);
+          }
+          do_accumulate(this->m_accs, last.data(), s + 121);
+
+          // Merge accumulators.
+          h = this->m_size * prime64_1;
+          for(size_t i = 0;  i < 4;  ++i)
+            h += do_mul_fold64(this->m_accs[i * 2] ^ do_read64(s + 11 + i * 16),
+                               this->m_accs[i * 2 + 1] ^ do_read64(s + 19 + i * 16));
+          h = do_avalanche(h);
+        }
+
+        // Reset internal states.
+        this->m_accs = init();
+        this->m_size = 0;
+        this->m_nstripes = 0;
+        this->m_nbuf = 0;
+        return static_cast<V_integer>(h);
+      }
+  };
+
 template<typename HasherT>
 rcptr<HasherT>
 do_cast_hasher(V_opaque& h)
@@ -1024,6 +2191,149 @@ do_cast_hasher(V_opaque& h)
     return qh;
   }
 
+template<typename HasherT>
+auto
+do_hash_file(const V_string& path, const optV_integer& offset, const optV_integer& limit)
+  -> opt<decltype(::std::declval<HasherT&>().finish())>
+  {
+    if(offset && (*offset < 0))
+      ASTERIA_THROW("negative file offset (offset `$1`)", *offset);
+    int64_t roffset = offset.value_or(0);
+    int64_t ntlimit = ::rocket::max(limit.value_or(INT64_MAX), 0);
+
+    // Open the file for reading.
+    ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_RDONLY), ::close);
+    if(!fd) {
+      if(errno != ENOENT)
+        ASTERIA_THROW_SYSTEM_ERROR("open");
+      // The path denotes a non-existent file.
+      return nullopt;
+    }
+    // This is only a hint, so errors are ignored.
+    ::posix_fadvise(fd, roffset, 0, POSIX_FADV_SEQUENTIAL);
+
+    // Read data into a buffer which is reused for all blocks, and put them into the
+    // hasher directly. No script string is created for any block.
+    HasherT h;
+    V_string buf;
+    buf.append(0x10'0000, '\0');
+    ::ssize_t nread;
+    while(ntlimit > 0) {
+      size_t nreq = static_cast<size_t>(::rocket::min(ntlimit, static_cast<int64_t>(buf.size())));
+      if(offset) {
+        nread = ::pread(fd, buf.mut_data(), nreq, roffset);
+        if(nread < 0)
+          ASTERIA_THROW_SYSTEM_ERROR("pread");
+      }
+      else {
+        nread = ::read(fd, buf.mut_data(), nreq);
+        if(nread < 0)
+          ASTERIA_THROW_SYSTEM_ERROR("read");
+      }
+      // Check for EOF.
+      if(nread == 0)
+        break;
+      h.update(buf.data(), static_cast<size_t>(nread));
+      roffset += nread;
+      ntlimit -= nread;
+    }
+    return h.finish();
+  }
+
+// These implement the Merkle tree hash in RFC 6962, with leaves of a fixed size.
+constexpr size_t s_tree_leaf_size = 0x10'0000;
+
+// This is the minimum number of leaves that are hashed in parallel.
+constexpr size_t s_parallel_threshold = 4;
+
+using SHA256_Digest = array<uint8_t, 32>;
+
+SHA256_Digest
+do_finish_digest(SHA256_Hasher& h)
+noexcept
+  {
+    SHA256_Digest dg;
+    auto regs = h.finish_words();
+    for(size_t i = 0;  i < 32;  ++i)
+      dg[i] = static_cast<uint8_t>(regs[i / 4] >> (24 - i % 4 * 8));
+    return dg;
+  }
+
+SHA256_Digest
+do_hash_tree_node(const SHA256_Digest& left, const SHA256_Digest& right)
+noexcept
+  {
+    SHA256_Hasher h;
+    h.update("\x01", 1);
+    h.update(reinterpret_cast<const char*>(left.data()), left.size());
+    h.update(reinterpret_cast<const char*>(right.data()), right.size());
+    return do_finish_digest(h);
+  }
+
+V_string
+do_hash_tree_root(cow_vector<SHA256_Digest>& nodes)
+  {
+    // An empty tree has no leaves, and its hash is that of an empty string.
+    if(nodes.empty())
+      return SHA256_Hasher().finish();
+
+    // Combine adjacent pairs level by level. An odd node is promoted to the next level
+    // as is, which yields the same tree as RFC 6962.
+    auto p = nodes.mut_data();
+    size_t n = nodes.size();
+    while(n > 1) {
+      size_t m = 0;
+      for(size_t i = 0;  i + 1 < n;  i += 2)
+        p[m++] = do_hash_tree_node(p[i], p[i+1]);
+      if(n % 2 != 0)
+        p[m++] = p[n-1];
+      n = m;
+    }
+
+    // Get the checksum.
+    V_string ck;
+    ck.reserve(64);
+    ::rocket::for_each(p[0], [&](uint8_t b) { do_pdigits_be(ck, b);  });
+    return ck;
+  }
+
+template<typename FuncT>
+void
+do_parallel_for(size_t count, FuncT&& func)
+  {
+    // Starting threads is not worth it for a few tasks, which are performed serially.
+    // `func` shall not throw exceptions.
+    if(count < s_parallel_threshold) {
+      for(size_t i = 0;  i < count;  ++i)
+        func(i);
+      return;
+    }
+
+    // Tasks are taken by worker threads, as well as the current thread, in order.
+    ::std::atomic<size_t> next(0);
+    auto work = [&]{
+      for(;;) {
+        size_t i = next.fetch_add(1, ::std::memory_order_relaxed);
+        if(i >= count)
+          break;
+        func(i);
+      }
+    };
+
+    size_t nthrs = ::rocket::clamp(::std::thread::hardware_concurrency(), 1U, 32U);
+    ::rocket::static_vector<::std::thread, 31> workers;
+    try {
+      while(workers.size() + 1 < ::rocket::min(nthrs, count))
+        workers.emplace_back(work);
+    }
+    catch(::std::system_error& /*stdex*/) {
+      // Carry on with the threads that have been created, if any.
+    }
+    work();
+    for(auto it = workers.mut_begin();  it != workers.mut_end();  ++it)
+      it->join();
+  }
+
 }  // namespace
 
 V_opaque
@@ -1035,7 +2345,7 @@ std_checksum_crc32_new_private()
 void
 std_checksum_crc32_new_update(V_opaque& h, V_string data)
   {
-    return do_cast_hasher<CRC32_Hasher>(h)->update(data);
+    return do_cast_hasher<CRC32_Hasher>(h)->update(data.data(), data.size());
   }
 
 V_integer
@@ -1118,58 +2428,64 @@ V_integer
 std_checksum_crc32(V_string data)
   {
     CRC32_Hasher h;
-    h.update(data);
+    h.update(data.data(), data.size());
     return h.finish();
   }
 
+optV_integer
+std_checksum_crc32_file(V_string path, optV_integer offset, optV_integer limit)
+  {
+    return do_hash_file<CRC32_Hasher>(path, offset, limit);
+  }
+
 V_opaque
-std_checksum_fnv1a32_new_private()
+std_checksum_crc32c_new_private()
   {
-    return ::rocket::make_refcnt<FNV1a32_Hasher>();
+    return ::rocket::make_refcnt<CRC32C_Hasher>();
   }
 
 void
-std_checksum_fnv1a32_new_update(V_opaque& h, V_string data)
+std_checksum_crc32c_new_update(V_opaque& h, V_string data)
   {
-    return do_cast_hasher<FNV1a32_Hasher>(h)->update(data);
+    return do_cast_hasher<CRC32C_Hasher>(h)->update(data.data(), data.size());
   }
 
 V_integer
-std_checksum_fnv1a32_new_finish(V_opaque& h)
+std_checksum_crc32c_new_finish(V_opaque& h)
   {
-    return do_cast_hasher<FNV1a32_Hasher>(h)->finish();
+    return do_cast_hasher<CRC32C_Hasher>(h)->finish();
   }
 
 V_object
-std_checksum_fnv1a32_new()
+std_checksum_crc32c_new()
   {
     V_object result;
     //===================================================================
     // * private data
     //===================================================================
     result.insert_or_assign(::rocket::sref("$h"),
-      std_checksum_fnv1a32_new_private());
+      std_checksum_crc32c_new_private());
     //===================================================================
     // `.update(data)`
     //===================================================================
     result.insert_or_assign(::rocket::sref("update"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.checksum.fnv1a32_new().update(data)`
+`std.checksum.crc32c_new().update(data)`
 
   * Puts `data` into the hasher denoted by `this`, which shall be
     a byte string.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32_new().update"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.crc32c_new().update"));
     // Get the hasher.
     Reference_modifier::S_object_key xmod = { ::rocket::sref("$h") };
     self.zoom_in(::std::move(xmod));
     // Parse arguments.
     V_string data;
     if(reader.I().v(data).F()) {
-      std_checksum_fnv1a32_new_update(self.open().open_opaque(), ::std::move(data));
+      std_checksum_crc32c_new_update(self.open().open_opaque(), ::std::move(data));
       return self = Reference_root::S_void();
     }
     reader.throw_no_matching_function_call();
@@ -1181,7 +2497,7 @@ std_checksum_fnv1a32_new()
     result.insert_or_assign(::rocket::sref("finish"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.checksum.fnv1a32_new().finish()`
+`std.checksum.crc32c_new().finish()`
 
   * Extracts the checksum from the hasher denoted by `this`, then
     resets it, making it suitable for further data as if it had
@@ -1192,80 +2508,86 @@ std_checksum_fnv1a32_new()
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32_new().finish"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.crc32c_new().finish"));
     // Get the hasher.
     Reference_modifier::S_object_key xmod = { ::rocket::sref("$h") };
     self.zoom_in(::std::move(xmod));
     // Parse arguments.
     if(reader.I().F()) {
-      Reference_root::S_temporary xref = { std_checksum_fnv1a32_new_finish(self.open().open_opaque()) };
+      Reference_root::S_temporary xref = { std_checksum_crc32c_new_finish(self.open().open_opaque()) };
       return self = ::std::move(xref);
     }
     reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
-    // End of `std.checksum.fnv1a32_new()`
+    // End of `std.checksum.crc32c_new()`
     //===================================================================
     return result;
   }
 
 V_integer
-std_checksum_fnv1a32(V_string data)
+std_checksum_crc32c(V_string data)
   {
-    FNV1a32_Hasher h;
-    h.update(data);
+    CRC32C_Hasher h;
+    h.update(data.data(), data.size());
     return h.finish();
   }
 
+optV_integer
+std_checksum_crc32c_file(V_string path, optV_integer offset, optV_integer limit)
+  {
+    return do_hash_file<CRC32C_Hasher>(path, offset, limit);
+  }
+
 V_opaque
-std_checksum_md5_new_private()
+std_checksum_fnv1a32_new_private()
   {
-    return ::rocket::make_refcnt<MD5_Hasher>();
+    return ::rocket::make_refcnt<FNV1a32_Hasher>();
   }
 
 void
-std_checksum_md5_new_update(V_opaque& h, V_string data)
+std_checksum_fnv1a32_new_update(V_opaque& h, V_string data)
   {
-    return do_cast_hasher<MD5_Hasher>(h)->update(data);
+    return do_cast_hasher<FNV1a32_Hasher>(h)->update(data.data(), data.size());
   }
 
-V_string
-std_checksum_md5_new_finish(V_opaque& h)
+V_integer
+std_checksum_fnv1a32_new_finish(V_opaque& h)
   {
-    return do_cast_hasher<MD5_Hasher>(h)->finish();
+    return do_cast_hasher<FNV1a32_Hasher>(h)->finish();
   }
 
 V_object
-std_checksum_md5_new()
+std_checksum_fnv1a32_new()
   {
     V_object result;
     //===================================================================
     // * private data
     //===================================================================
     result.insert_or_assign(::rocket::sref("$h"),
-      std_checksum_md5_new_private());
+      std_checksum_fnv1a32_new_private());
     //===================================================================
     // `.update(data)`
     //===================================================================
     result.insert_or_assign(::rocket::sref("update"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.checksum.md5_new().update(data)`
+`std.checksum.fnv1a32_new().update(data)`
 
   * Puts `data` into the hasher denoted by `this`, which shall be
     a byte string.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.md5_new().update"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32_new().update"));
     // Get the hasher.
     Reference_modifier::S_object_key xmod = { ::rocket::sref("$h") };
     self.zoom_in(::std::move(xmod));
     // Parse arguments.
     V_string data;
     if(reader.I().v(data).F()) {
-      std_checksum_md5_new_update(self.open().open_opaque(), ::std::move(data));
+      std_checksum_fnv1a32_new_update(self.open().open_opaque(), ::std::move(data));
       return self = Reference_root::S_void();
     }
     reader.throw_no_matching_function_call();
@@ -1277,53 +2599,263 @@ std_checksum_md5_new()
     result.insert_or_assign(::rocket::sref("finish"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.checksum.md5_new().finish()`
+`std.checksum.fnv1a32_new().finish()`
 
   * Extracts the checksum from the hasher denoted by `this`, then
     resets it, making it suitable for further data as if it had
     just been created.
 
-  * Returns the checksum as a string of 32 hexadecimal digits in
-    uppercase.
+  * Returns the checksum as an integer, whose high-order 32 bits
+    are always zeroes.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.md5_new().finish"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32_new().finish"));
     // Get the hasher.
     Reference_modifier::S_object_key xmod = { ::rocket::sref("$h") };
     self.zoom_in(::std::move(xmod));
     // Parse arguments.
     if(reader.I().F()) {
-      Reference_root::S_temporary xref = { std_checksum_md5_new_finish(self.open().open_opaque()) };
+      Reference_root::S_temporary xref = { std_checksum_fnv1a32_new_finish(self.open().open_opaque()) };
       return self = ::std::move(xref);
     }
     reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
-    // End of `std.checksum.md5_new()`
+    // End of `std.checksum.fnv1a32_new()`
     //===================================================================
     return result;
   }
 
-V_string
-std_checksum_md5(V_string data)
+V_integer
+std_checksum_fnv1a32(V_string data)
   {
-    MD5_Hasher h;
-    h.update(data);
+    FNV1a32_Hasher h;
+    h.update(data.data(), data.size());
     return h.finish();
   }
 
+optV_integer
+std_checksum_fnv1a32_file(V_string path, optV_integer offset, optV_integer limit)
+  {
+    return do_hash_file<FNV1a32_Hasher>(path, offset, limit);
+  }
+
 V_opaque
-std_checksum_sha1_new_private()
+std_checksum_xxh3_64_new_private()
   {
-    return ::rocket::make_refcnt<SHA1_Hasher>();
+    return ::rocket::make_refcnt<XXH3_64_Hasher>();
+  }
+
+void
+std_checksum_xxh3_64_new_update(V_opaque& h, V_string data)
+  {
+    return do_cast_hasher<XXH3_64_Hasher>(h)->update(data.data(), data.size());
+  }
+
+V_integer
+std_checksum_xxh3_64_new_finish(V_opaque& h)
+  {
+    return do_cast_hasher<XXH3_64_Hasher>(h)->finish();
+  }
+
+V_object
+std_checksum_xxh3_64_new()
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$h"),
+      std_checksum_xxh3_64_new_private());
+    //===================================================================
+    // `.update(data)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("update"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.xxh3_64_new().update(data)`
+
+  * Puts `data` into the hasher denoted by `this`, which shall be
+    a byte string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.xxh3_64_new().update"));
+    // Get the hasher.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$h") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      std_checksum_xxh3_64_new_update(self.open().open_opaque(), ::std::move(data));
+      return self = Reference_root::S_void();
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.finish()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("finish"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.xxh3_64_new().finish()`
+
+  * Extracts the checksum from the hasher denoted by `this`, then
+    resets it, making it suitable for further data as if it had
+    just been created.
+
+  * Returns the checksum as an integer. All 64 bits are used, so
+    the result may be negative.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.xxh3_64_new().finish"));
+    // Get the hasher.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$h") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_checksum_xxh3_64_new_finish(self.open().open_opaque()) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.checksum.xxh3_64_new()`
+    //===================================================================
+    return result;
+  }
+
+V_integer
+std_checksum_xxh3_64(V_string data)
+  {
+    XXH3_64_Hasher h;
+    h.update(data.data(), data.size());
+    return h.finish();
+  }
+
+optV_integer
+std_checksum_xxh3_64_file(V_string path, optV_integer offset, optV_integer limit)
+  {
+    return do_hash_file<XXH3_64_Hasher>(path, offset, limit);
+  }
+
+V_opaque
+std_checksum_md5_new_private()
+  {
+    return ::rocket::make_refcnt<MD5_Hasher>();
+  }
+
+void
+std_checksum_md5_new_update(V_opaque& h, V_string data)
+  {
+    return do_cast_hasher<MD5_Hasher>(h)->update(data.data(), data.size());
+  }
+
+V_string
+std_checksum_md5_new_finish(V_opaque& h)
+  {
+    return do_cast_hasher<MD5_Hasher>(h)->finish();
+  }
+
+V_object
+std_checksum_md5_new()
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$h"),
+      std_checksum_md5_new_private());
+    //===================================================================
+    // `.update(data)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("update"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.md5_new().update(data)`
+
+  * Puts `data` into the hasher denoted by `this`, which shall be
+    a byte string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.md5_new().update"));
+    // Get the hasher.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$h") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      std_checksum_md5_new_update(self.open().open_opaque(), ::std::move(data));
+      return self = Reference_root::S_void();
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.finish()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("finish"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.md5_new().finish()`
+
+  * Extracts the checksum from the hasher denoted by `this`, then
+    resets it, making it suitable for further data as if it had
+    just been created.
+
+  * Returns the checksum as a string of 32 hexadecimal digits in
+    uppercase.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.md5_new().finish"));
+    // Get the hasher.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$h") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_checksum_md5_new_finish(self.open().open_opaque()) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.checksum.md5_new()`
+    //===================================================================
+    return result;
+  }
+
+V_string
+std_checksum_md5(V_string data)
+  {
+    MD5_Hasher h;
+    h.update(data.data(), data.size());
+    return h.finish();
+  }
+
+optV_string
+std_checksum_md5_file(V_string path, optV_integer offset, optV_integer limit)
+  {
+    return do_hash_file<MD5_Hasher>(path, offset, limit);
+  }
+
+V_opaque
+std_checksum_sha1_new_private()
+  {
+    return ::rocket::make_refcnt<SHA1_Hasher>();
   }
 
 void
 std_checksum_sha1_new_update(V_opaque& h, V_string data)
   {
-    return do_cast_hasher<SHA1_Hasher>(h)->update(data);
+    return do_cast_hasher<SHA1_Hasher>(h)->update(data.data(), data.size());
   }
 
 V_string
@@ -1406,10 +2938,37 @@ V_string
 std_checksum_sha1(V_string data)
   {
     SHA1_Hasher h;
-    h.update(data);
+    h.update(data.data(), data.size());
     return h.finish();
   }
 
+optV_string
+std_checksum_sha1_file(V_string path, optV_integer offset, optV_integer limit)
+  {
+    return do_hash_file<SHA1_Hasher>(path, offset, limit);
+  }
+
+V_array
+std_checksum_sha1_many(V_array data)
+  {
+#ifdef ASTERIA_CHECKSUM_X86_
+    // The SHA extensions are faster than AVX2 even for one message at a time, so hash
+    // messages in parallel lanes only without them, and if at least half will be busy.
+    if(!do_cpu_has_sha_ni() && do_cpu_has_avx2() && (data.size() >= 4))
+      return do_hash_many_lanes<8>(data, SHA1_Hasher::init(), do_sha1_avx2_x8);
+#endif
+    // Reuse one hasher for all messages, as `finish()` resets it.
+    SHA1_Hasher h;
+    V_array result;
+    result.reserve(data.size());
+    for(const auto& elem : data) {
+      const auto& str = elem.as_string();
+      h.update(str.data(), str.size());
+      result.emplace_back(h.finish());
+    }
+    return result;
+  }
+
 V_opaque
 std_checksum_sha256_new_private()
   {
@@ -1419,7 +2978,7 @@ std_checksum_sha256_new_private()
 void
 std_checksum_sha256_new_update(V_opaque& h, V_string data)
   {
-    return do_cast_hasher<SHA256_Hasher>(h)->update(data);
+    return do_cast_hasher<SHA256_Hasher>(h)->update(data.data(), data.size());
   }
 
 V_string
@@ -1502,10 +3061,117 @@ V_string
 std_checksum_sha256(V_string data)
   {
     SHA256_Hasher h;
-    h.update(data);
+    h.update(data.data(), data.size());
     return h.finish();
   }
 
+optV_string
+std_checksum_sha256_file(V_string path, optV_integer offset, optV_integer limit)
+  {
+    return do_hash_file<SHA256_Hasher>(path, offset, limit);
+  }
+
+V_array
+std_checksum_sha256_many(V_array data)
+  {
+#ifdef ASTERIA_CHECKSUM_X86_
+    // The SHA extensions are faster than AVX2 even for one message at a time, so hash
+    // messages in parallel lanes only without them, and if at least half will be busy.
+    if(!do_cpu_has_sha_ni() && do_cpu_has_avx2() && (data.size() >= 4))
+      return do_hash_many_lanes<8>(data, SHA256_Hasher::init(), do_sha256_avx2_x8);
+#endif
+    // Reuse one hasher for all messages, as `finish()` resets it.
+    SHA256_Hasher h;
+    V_array result;
+    result.reserve(data.size());
+    for(const auto& elem : data) {
+      const auto& str = elem.as_string();
+      h.update(str.data(), str.size());
+      result.emplace_back(h.finish());
+    }
+    return result;
+  }
+
+V_string
+std_checksum_sha256_tree(V_string data)
+  {
+    // Hash all leaves in parallel.
+    size_t nleaves = (data.size() + s_tree_leaf_size - 1) / s_tree_leaf_size;
+    cow_vector<SHA256_Digest> nodes;
+    nodes.append(nleaves);
+    auto p = nodes.mut_data();
+    do_parallel_for(nleaves,
+      [&](size_t i) {
+        size_t off = i * s_tree_leaf_size;
+        SHA256_Hasher h;
+        h.update("\x00", 1);
+        h.update(data.data() + off, ::rocket::min(data.size() - off, s_tree_leaf_size));
+        p[i] = do_finish_digest(h);
+      });
+    return do_hash_tree_root(nodes);
+  }
+
+optV_string
+std_checksum_sha256_tree_file(V_string path)
+  {
+    // Open the file for reading.
+    ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_RDONLY), ::close);
+    if(!fd) {
+      if(errno != ENOENT)
+        ASTERIA_THROW_SYSTEM_ERROR("open");
+      // The path denotes a non-existent file.
+      return nullopt;
+    }
+    struct ::stat stb;
+    if(::fstat(fd, &stb) != 0)
+      ASTERIA_THROW_SYSTEM_ERROR("fstat");
+
+    // Hash all leaves in parallel. Each leaf is read in small blocks on the stack, so
+    // no memory is allocated. Data beyond the initial size of the file are ignored.
+    uint64_t fsize = static_cast<uint64_t>(stb.st_size);
+    size_t nleaves = static_cast<size_t>((fsize + s_tree_leaf_size - 1) / s_tree_leaf_size);
+    cow_vector<SHA256_Digest> nodes;
+    nodes.append(nleaves);
+    auto p = nodes.mut_data();
+    ::std::atomic<int> err(0);
+    ::std::atomic<bool> trunc(false);
+    do_parallel_for(nleaves,
+      [&](size_t i) {
+        if((err.load(::std::memory_order_relaxed) != 0) || trunc.load(::std::memory_order_relaxed))
+          return;
+        uint64_t off = i * uint64_t(s_tree_leaf_size);
+        uint64_t end = ::rocket::min(off + s_tree_leaf_size, fsize);
+        SHA256_Hasher h;
+        h.update("\x00", 1);
+        char buf[0x1'0000];
+        while(off < end) {
+          auto nread = ::pread(fd, buf, static_cast<size_t>(::rocket::min(end - off, sizeof(buf))),
+                               static_cast<::off_t>(off));
+          if(nread < 0) {
+            if(errno == EINTR)
+              continue;
+            int zero = 0;
+            err.compare_exchange_strong(zero, errno);
+            return;
+          }
+          // Check for EOF, which happens if the file has been truncated. The leaf would
+          // be short, so the result would be meaningless.
+          if(nread == 0) {
+            trunc.store(true, ::std::memory_order_relaxed);
+            return;
+          }
+          h.update(buf, static_cast<size_t>(nread));
+          off += static_cast<uint64_t>(nread);
+        }
+        p[i] = do_finish_digest(h);
+      });
+    if(err != 0)
+      ASTERIA_THROW_SYSTEM_ERROR("pread", err);
+    if(trunc)
+      ASTERIA_THROW("file truncated while being read (path `$1`)", path);
+    return do_hash_tree_root(nodes);
+  }
+
 void
 create_bindings_checksum(V_object& result, API_Version /*version*/)
   {
@@ -1584,16 +3250,64 @@ create_bindings_checksum(V_object& result, API_Version /*version*/)
   }
       ));
     //===================================================================
-    // `std.checksum.fnv1a32_new()`
+    // `std.checksum.crc32_file()`
     //===================================================================
-    result.insert_or_assign(::rocket::sref("fnv1a32_new"),
+    result.insert_or_assign(::rocket::sref("crc32_file"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.checksum.fnv1a32_new()`
+`std.checksum.crc32_file(path, [offset], [limit])`
 
-  * Creates a 32-bit Fowler-Noll-Vo (a.k.a. FNV) hasher of the
-    32-bit FNV-1a variant. The FNV prime is `16777619` and the FNV
-    offset basis is `2166136261`.
+  * Calculates the CRC-32 checksum of the file at `path`, as if
+    this function was defined as
+
+    ```
+    std.checksum.crc32_file = func(path, offset, limit) {
+      var h = this.crc32_new();
+      if(std.filesystem.file_stream(path, func(off, data) { h.update(data);  },
+                                    offset, limit) == null)
+        return null;
+      return h.finish();
+    };
+    ```
+
+    Data are read in large blocks and put into the hasher directly
+    without creating any strings, so this function is expected to
+    be much more efficient, especially for large files.
+
+  * Returns the CRC-32 checksum as an integer, or `null` if the
+    file does not exist. The high-order 32 bits of the checksum
+    are always zeroes.
+
+  * Throws an exception if `offset` is negative, or a read error
+    occurs.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.crc32_file"));
+    // Parse arguments.
+    V_string path;
+    optV_integer offset;
+    optV_integer limit;
+    if(reader.I().v(path).o(offset).o(limit).F()) {
+      Reference_root::S_temporary xref = { std_checksum_crc32_file(::std::move(path), ::std::move(offset),
+                                                                 ::std::move(limit)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.crc32c_new()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("crc32c_new"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.crc32c_new()`
+
+  * Creates a CRC-32C hasher according to RFC 3720. The divisor is
+    `0x1EDC6F41` (or `0x82F63B78` in reverse form), also known as the
+    Castagnoli polynomial.
 
   * Returns the hasher as an object consisting of the following
     members:
@@ -1610,10 +3324,10 @@ create_bindings_checksum(V_object& result, API_Version /*version*/)
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32_new"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.crc32c_new"));
     // Parse arguments.
     if(reader.I().F()) {
-      Reference_root::S_temporary xref = { std_checksum_fnv1a32_new() };
+      Reference_root::S_temporary xref = { std_checksum_crc32c_new() };
       return self = ::std::move(xref);
     }
     // Fail.
@@ -1621,19 +3335,19 @@ create_bindings_checksum(V_object& result, API_Version /*version*/)
   }
       ));
     //===================================================================
-    // `std.checksum.fnv1a32()`
+    // `std.checksum.crc32c()`
     //===================================================================
-    result.insert_or_assign(::rocket::sref("fnv1a32"),
+    result.insert_or_assign(::rocket::sref("crc32c"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.checksum.fnv1a32(data)`
+`std.checksum.crc32c(data)`
 
-  * Calculates the 32-bit FNV-1a checksum of `data` which must be
-    a byte string, as if this function was defined as
+  * Calculates the CRC-32C checksum of `data` which must be of type
+    string, as if this function was defined as
 
     ```
-    std.checksum.fnv1a32 = func(data) {
-      var h = this.fnv1a32_new();
+    std.checksum.crc32c = func(data) {
+      var h = this.crc32c_new();
       h.update(data);
       return h.finish();
     };
@@ -1642,16 +3356,16 @@ create_bindings_checksum(V_object& result, API_Version /*version*/)
     This function is expected to be both more efficient and easier
     to use.
 
-  * Returns the 32-bit FNV-1a checksum as an integer. The
-    high-order 32 bits are always zeroes.
+  * Returns the CRC-32C checksum as an integer. The high-order 32
+    bits are always zeroes.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.crc32c"));
     // Parse arguments.
     V_string data;
     if(reader.I().v(data).F()) {
-      Reference_root::S_temporary xref = { std_checksum_fnv1a32(::std::move(data)) };
+      Reference_root::S_temporary xref = { std_checksum_crc32c(::std::move(data)) };
       return self = ::std::move(xref);
     }
     // Fail.
@@ -1659,7 +3373,299 @@ create_bindings_checksum(V_object& result, API_Version /*version*/)
   }
       ));
     //===================================================================
-    // `std.checksum.md5_new()`
+    // `std.checksum.crc32c_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("crc32c_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.crc32c_file(path, [offset], [limit])`
+
+  * Calculates the CRC-32C checksum of the file at `path`, as if
+    this function was defined as
+
+    ```
+    std.checksum.crc32c_file = func(path, offset, limit) {
+      var h = this.crc32c_new();
+      if(std.filesystem.file_stream(path, func(off, data) { h.update(data);  },
+                                    offset, limit) == null)
+        return null;
+      return h.finish();
+    };
+    ```
+
+    Data are read in large blocks and put into the hasher directly
+    without creating any strings, so this function is expected to
+    be much more efficient, especially for large files.
+
+  * Returns the CRC-32C checksum as an integer, or `null` if the
+    file does not exist. The high-order 32 bits of the checksum
+    are always zeroes.
+
+  * Throws an exception if `offset` is negative, or a read error
+    occurs.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.crc32c_file"));
+    // Parse arguments.
+    V_string path;
+    optV_integer offset;
+    optV_integer limit;
+    if(reader.I().v(path).o(offset).o(limit).F()) {
+      Reference_root::S_temporary xref = { std_checksum_crc32c_file(::std::move(path), ::std::move(offset),
+                                                                 ::std::move(limit)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.fnv1a32_new()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("fnv1a32_new"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.fnv1a32_new()`
+
+  * Creates a 32-bit Fowler-Noll-Vo (a.k.a. FNV) hasher of the
+    32-bit FNV-1a variant. The FNV prime is `16777619` and the FNV
+    offset basis is `2166136261`.
+
+  * Returns the hasher as an object consisting of the following
+    members:
+
+    * `update(data)`
+    * `finish()`
+
+    The function `update()` is used to put data into the hasher,
+    which shall be a byte string. After all data have been put, the
+    function `finish()` extracts the checksum as an integer (whose
+    high-order 32 bits are always zeroes), then resets the hasher,
+    making it suitable for further data as if it had just been
+    created.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32_new"));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_checksum_fnv1a32_new() };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.fnv1a32()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("fnv1a32"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.fnv1a32(data)`
+
+  * Calculates the 32-bit FNV-1a checksum of `data` which must be
+    a byte string, as if this function was defined as
+
+    ```
+    std.checksum.fnv1a32 = func(data) {
+      var h = this.fnv1a32_new();
+      h.update(data);
+      return h.finish();
+    };
+    ```
+
+    This function is expected to be both more efficient and easier
+    to use.
+
+  * Returns the 32-bit FNV-1a checksum as an integer. The
+    high-order 32 bits are always zeroes.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32"));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_checksum_fnv1a32(::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.fnv1a32_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("fnv1a32_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.fnv1a32_file(path, [offset], [limit])`
+
+  * Calculates the 32-bit FNV-1a checksum of the file at `path`,
+    as if this function was defined as
+
+    ```
+    std.checksum.fnv1a32_file = func(path, offset, limit) {
+      var h = this.fnv1a32_new();
+      if(std.filesystem.file_stream(path, func(off, data) { h.update(data);  },
+                                    offset, limit) == null)
+        return null;
+      return h.finish();
+    };
+    ```
+
+    Data are read in large blocks and put into the hasher directly
+    without creating any strings, so this function is expected to
+    be much more efficient, especially for large files.
+
+  * Returns the 32-bit FNV-1a checksum as an integer, or `null` if
+    the file does not exist. The high-order 32 bits of the
+    checksum are always zeroes.
+
+  * Throws an exception if `offset` is negative, or a read error
+    occurs.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.fnv1a32_file"));
+    // Parse arguments.
+    V_string path;
+    optV_integer offset;
+    optV_integer limit;
+    if(reader.I().v(path).o(offset).o(limit).F()) {
+      Reference_root::S_temporary xref = { std_checksum_fnv1a32_file(::std::move(path), ::std::move(offset),
+                                                                 ::std::move(limit)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.xxh3_64_new()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("xxh3_64_new"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.xxh3_64_new()`
+
+  * Creates a 64-bit XXH3 hasher. The seed is zero and the default
+    secret is used. XXH3 is a non-cryptographic hash function which
+    is faster than CRC-32 on long inputs.
+
+  * Returns the hasher as an object consisting of the following
+    members:
+
+    * `update(data)`
+    * `finish()`
+
+    The function `update()` is used to put data into the hasher,
+    which shall be a byte string. After all data have been put, the
+    function `finish()` extracts the checksum as a 64-bit integer
+    (which may be negative), then resets the hasher, making it
+    suitable for further data as if it had just been created.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.xxh3_64_new"));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_checksum_xxh3_64_new() };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.xxh3_64()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("xxh3_64"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.xxh3_64(data)`
+
+  * Calculates the 64-bit XXH3 checksum of `data` which must be a
+    byte string, as if this function was defined as
+
+    ```
+    std.checksum.xxh3_64 = func(data) {
+      var h = this.xxh3_64_new();
+      h.update(data);
+      return h.finish();
+    };
+    ```
+
+    This function is expected to be both more efficient and easier
+    to use.
+
+  * Returns the 64-bit XXH3 checksum as an integer, which may be
+    negative.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.xxh3_64"));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_checksum_xxh3_64(::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.xxh3_64_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("xxh3_64_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.xxh3_64_file(path, [offset], [limit])`
+
+  * Calculates the 64-bit XXH3 checksum of the file at `path`, as
+    if this function was defined as
+
+    ```
+    std.checksum.xxh3_64_file = func(path, offset, limit) {
+      var h = this.xxh3_64_new();
+      if(std.filesystem.file_stream(path, func(off, data) { h.update(data);  },
+                                    offset, limit) == null)
+        return null;
+      return h.finish();
+    };
+    ```
+
+    Data are read in large blocks and put into the hasher directly
+    without creating any strings, so this function is expected to
+    be much more efficient, especially for large files.
+
+  * Returns the 64-bit XXH3 checksum as an integer, which may be
+    negative, or `null` if the file does not exist.
+
+  * Throws an exception if `offset` is negative, or a read error
+    occurs.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.xxh3_64_file"));
+    // Parse arguments.
+    V_string path;
+    optV_integer offset;
+    optV_integer limit;
+    if(reader.I().v(path).o(offset).o(limit).F()) {
+      Reference_root::S_temporary xref = { std_checksum_xxh3_64_file(::std::move(path), ::std::move(offset),
+                                                                 ::std::move(limit)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.md5_new()`
     //===================================================================
     result.insert_or_assign(::rocket::sref("md5_new"),
       V_function(
@@ -1728,6 +3734,53 @@ create_bindings_checksum(V_object& result, API_Version /*version*/)
     }
     // Fail.
     reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.md5_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("md5_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.md5_file(path, [offset], [limit])`
+
+  * Calculates the MD5 checksum of the file at `path`, as if this
+    function was defined as
+
+    ```
+    std.checksum.md5_file = func(path, offset, limit) {
+      var h = this.md5_new();
+      if(std.filesystem.file_stream(path, func(off, data) { h.update(data);  },
+                                    offset, limit) == null)
+        return null;
+      return h.finish();
+    };
+    ```
+
+    Data are read in large blocks and put into the hasher directly
+    without creating any strings, so this function is expected to
+    be much more efficient, especially for large files.
+
+  * Returns the MD5 checksum as a string of 32 hexadecimal digits
+    in uppercase, or `null` if the file does not exist.
+
+  * Throws an exception if `offset` is negative, or a read error
+    occurs.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.md5_file"));
+    // Parse arguments.
+    V_string path;
+    optV_integer offset;
+    optV_integer limit;
+    if(reader.I().v(path).o(offset).o(limit).F()) {
+      Reference_root::S_temporary xref = { std_checksum_md5_file(::std::move(path), ::std::move(offset),
+                                                                 ::std::move(limit)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
@@ -1800,6 +3853,94 @@ create_bindings_checksum(V_object& result, API_Version /*version*/)
     }
     // Fail.
     reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.sha1_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("sha1_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.sha1_file(path, [offset], [limit])`
+
+  * Calculates the SHA-1 checksum of the file at `path`, as if
+    this function was defined as
+
+    ```
+    std.checksum.sha1_file = func(path, offset, limit) {
+      var h = this.sha1_new();
+      if(std.filesystem.file_stream(path, func(off, data) { h.update(data);  },
+                                    offset, limit) == null)
+        return null;
+      return h.finish();
+    };
+    ```
+
+    Data are read in large blocks and put into the hasher directly
+    without creating any strings, so this function is expected to
+    be much more efficient, especially for large files.
+
+  * Returns the SHA-1 checksum as a string of 40 hexadecimal
+    digits in uppercase, or `null` if the file does not exist.
+
+  * Throws an exception if `offset` is negative, or a read error
+    occurs.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.sha1_file"));
+    // Parse arguments.
+    V_string path;
+    optV_integer offset;
+    optV_integer limit;
+    if(reader.I().v(path).o(offset).o(limit).F()) {
+      Reference_root::S_temporary xref = { std_checksum_sha1_file(::std::move(path), ::std::move(offset),
+                                                                 ::std::move(limit)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.sha1_many()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("sha1_many"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.sha1_many(data)`
+
+  * Calculates the SHA-1 checksums of all elements of `data`, which
+    must be an array of strings, as if this function was defined as
+
+    ```
+    std.checksum.sha1_many = func(data) {
+      var r = [];
+      for(each k, v : data)
+        r[$] = this.sha1(v);
+      return r;
+    };
+    ```
+
+    This function is expected to be both more efficient and easier
+    to use.
+
+  * Returns an array of SHA-1 checksums, each of which is a string
+    of 40 hexadecimal digits in uppercase.
+
+  * Throws an exception if any element of `data` is not a string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.sha1_many"));
+    // Parse arguments.
+    V_array data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_checksum_sha1_many(::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
@@ -1872,6 +4013,166 @@ create_bindings_checksum(V_object& result, API_Version /*version*/)
     }
     // Fail.
     reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.sha256_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("sha256_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.sha256_file(path, [offset], [limit])`
+
+  * Calculates the SHA-256 checksum of the file at `path`, as if
+    this function was defined as
+
+    ```
+    std.checksum.sha256_file = func(path, offset, limit) {
+      var h = this.sha256_new();
+      if(std.filesystem.file_stream(path, func(off, data) { h.update(data);  },
+                                    offset, limit) == null)
+        return null;
+      return h.finish();
+    };
+    ```
+
+    Data are read in large blocks and put into the hasher directly
+    without creating any strings, so this function is expected to
+    be much more efficient, especially for large files.
+
+  * Returns the SHA-256 checksum as a string of 64 hexadecimal
+    digits in uppercase, or `null` if the file does not exist.
+
+  * Throws an exception if `offset` is negative, or a read error
+    occurs.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.sha256_file"));
+    // Parse arguments.
+    V_string path;
+    optV_integer offset;
+    optV_integer limit;
+    if(reader.I().v(path).o(offset).o(limit).F()) {
+      Reference_root::S_temporary xref = { std_checksum_sha256_file(::std::move(path), ::std::move(offset),
+                                                                 ::std::move(limit)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.sha256_many()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("sha256_many"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.sha256_many(data)`
+
+  * Calculates the SHA-256 checksums of all elements of `data`, which
+    must be an array of strings, as if this function was defined as
+
+    ```
+    std.checksum.sha256_many = func(data) {
+      var r = [];
+      for(each k, v : data)
+        r[$] = this.sha256(v);
+      return r;
+    };
+    ```
+
+    This function is expected to be both more efficient and easier
+    to use.
+
+  * Returns an array of SHA-256 checksums, each of which is a string
+    of 64 hexadecimal digits in uppercase.
+
+  * Throws an exception if any element of `data` is not a string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.sha256_many"));
+    // Parse arguments.
+    V_array data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_checksum_sha256_many(::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.sha256_tree()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("sha256_tree"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.sha256_tree(data)`
+
+  * Calculates the Merkle tree hash of `data`, which must be a byte
+    string, as specified in RFC 6962, section 2.1, with SHA-256 as
+    the hash function. `data` is divided into leaves of 1048576
+    bytes each, where the last leaf may be shorter. The hash of a
+    leaf is `SHA-256(0x00 || leaf)`. The hash of an internal node is
+    `SHA-256(0x01 || left || right)`, where `left` and `right` are
+    the 32-byte hashes of its children. For a tree of `n` leaves
+    where `n` > 1, the left subtree consists of the first `k`
+    leaves, where `k` is the largest power of two less than `n`. If
+    `data` is empty, the result is the SHA-256 checksum of an empty
+    string.
+
+    Leaves are hashed in parallel, so this function is expected to
+    be much faster than `sha256()` for large data on multi-core
+    machines. Be advised that results of these two functions are
+    different.
+
+  * Returns the tree hash as a string of 64 hexadecimal digits in
+    uppercase.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.sha256_tree"));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_checksum_sha256_tree(::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.checksum.sha256_tree_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("sha256_tree_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.checksum.sha256_tree_file(path)`
+
+  * Calculates the Merkle tree hash of the file at `path`, as if
+    all of its contents were passed to `sha256_tree()`. Leaves are
+    read and hashed in parallel.
+
+  * Returns the tree hash as a string of 64 hexadecimal digits in
+    uppercase, or `null` if the file does not exist.
+
+  * Throws an exception if a read error occurs, or if the file is
+    truncated while being read.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.checksum.sha256_tree_file"));
+    // Parse arguments.
+    V_string path;
+    if(reader.I().v(path).F()) {
+      Reference_root::S_temporary xref = { std_checksum_sha256_tree_file(::std::move(path)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
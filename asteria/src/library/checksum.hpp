@@ -28,6 +28,34 @@ std_checksum_crc32_new();
 V_integer
 std_checksum_crc32(V_string data);
 
+// `std.checksum.crc32_file`
+optV_integer
+std_checksum_crc32_file(V_string path, optV_integer offset, optV_integer limit);
+
+// `std.checksum.crc32c_new_private`
+V_opaque
+std_checksum_crc32c_new_private();
+
+// `std.checksum.crc32c_new_update`
+void
+std_checksum_crc32c_new_update(V_opaque& h, V_string data);
+
+// `std.checksum.crc32c_new_finish`
+V_integer
+std_checksum_crc32c_new_finish(V_opaque& h);
+
+// `std.checksum.crc32c_new`
+V_object
+std_checksum_crc32c_new();
+
+// `std.checksum.crc32c`
+V_integer
+std_checksum_crc32c(V_string data);
+
+// `std.checksum.crc32c_file`
+optV_integer
+std_checksum_crc32c_file(V_string path, optV_integer offset, optV_integer limit);
+
 // `std.checksum.fnv1a32_new_private`
 V_opaque
 std_checksum_fnv1a32_new_private();
@@ -48,6 +76,34 @@ std_checksum_fnv1a32_new();
 V_integer
 std_checksum_fnv1a32(V_string data);
 
+// `std.checksum.fnv1a32_file`
+optV_integer
+std_checksum_fnv1a32_file(V_string path, optV_integer offset, optV_integer limit);
+
+// `std.checksum.xxh3_64_new_private`
+V_opaque
+std_checksum_xxh3_64_new_private();
+
+// `std.checksum.xxh3_64_new_update`
+void
+std_checksum_xxh3_64_new_update(V_opaque& h, V_string data);
+
+// `std.checksum.xxh3_64_new_finish`
+V_integer
+std_checksum_xxh3_64_new_finish(V_opaque& h);
+
+// `std.checksum.xxh3_64_new`
+V_object
+std_checksum_xxh3_64_new();
+
+// `std.checksum.xxh3_64`
+V_integer
+std_checksum_xxh3_64(V_string data);
+
+// `std.checksum.xxh3_64_file`
+optV_integer
+std_checksum_xxh3_64_file(V_string path, optV_integer offset, optV_integer limit);
+
 // `std.checksum.md5_new_private`
 V_opaque
 std_checksum_md5_new_private();
@@ -68,6 +124,10 @@ std_checksum_md5_new();
 V_string
 std_checksum_md5(V_string data);
 
+// `std.checksum.md5_file`
+optV_string
+std_checksum_md5_file(V_string path, optV_integer offset, optV_integer limit);
+
 // `std.checksum.sha1_new_private`
 V_opaque
 std_checksum_sha1_new_private();
@@ -88,6 +148,14 @@ std_checksum_sha1_new();
 V_string
 std_checksum_sha1(V_string data);
 
+// `std.checksum.sha1_file`
+optV_string
+std_checksum_sha1_file(V_string path, optV_integer offset, optV_integer limit);
+
+// `std.checksum.sha1_many`
+V_array
+std_checksum_sha1_many(V_array data);
+
 // `std.checksum.sha256_new_private`
 V_opaque
 std_checksum_sha256_new_private();
@@ -108,6 +176,22 @@ std_checksum_sha256_new();
 V_string
 std_checksum_sha256(V_string data);
 
+// `std.checksum.sha256_file`
+optV_string
+std_checksum_sha256_file(V_string path, optV_integer offset, optV_integer limit);
+
+// `std.checksum.sha256_many`
+V_array
+std_checksum_sha256_many(V_array data);
+
+// `std.checksum.sha256_tree`
+V_string
+std_checksum_sha256_tree(V_string data);
+
+// `std.checksum.sha256_tree_file`
+optV_string
+std_checksum_sha256_tree_file(V_string path);
+
 // Create an object that is to be referenced as `std.checksum`.
 void
 create_bindings_checksum(V_object& result, API_Version version);
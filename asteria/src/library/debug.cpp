@@ -4,6 +4,7 @@
 #include "../precompiled.hpp"
 #include "debug.hpp"
 #include "../runtime/argument_reader.hpp"
+#include "../runtime/format_template.hpp"
 #include "../utilities.hpp"
 
 namespace Asteria {
@@ -20,11 +21,24 @@ std_debug_logf(V_string templ, cow_vector<Value> values)
           { return static_cast<const Value*>(ptr)->print(fmt);  },
         values.data() + i
       });
-    // Compose the string into a stream.
-    ::rocket::tinyfmt_str fmt;
+    // Write the string into standard error.
+    Log_Stream fmt(__FILE__, __LINE__);
     vformat(fmt, templ.data(), templ.size(), insts.data(), insts.size());
 
-    auto nput = write_log_to_stderr(__FILE__, __LINE__, fmt.extract_string());
+    auto nput = fmt.finish();
+    if(nput < 0)
+      return nullopt;
+    return static_cast<int64_t>(nput);
+  }
+
+optV_integer
+std_debug_logf(V_opaque templ, cow_vector<Value> values)
+  {
+    // Write the string into standard error without parsing the template.
+    Log_Stream fmt(__FILE__, __LINE__);
+    format_template_cast(templ)->render(fmt, values.data(), values.size());
+
+    auto nput = fmt.finish();
     if(nput < 0)
       return nullopt;
     return static_cast<int64_t>(nput);
@@ -35,11 +49,11 @@ std_debug_dump(Value value, optV_integer indent)
   {
     // Clamp the suggested indent so we don't produce overlong lines.
     size_t rindent = static_cast<size_t>(::rocket::clamp(indent.value_or(2), 0, 10));
-    // Format the value.
-    ::rocket::tinyfmt_str fmt;
+    // Format the value into standard error.
+    Log_Stream fmt(__FILE__, __LINE__);
     value.dump(fmt, rindent);
 
-    auto nput = write_log_to_stderr(__FILE__, __LINE__, fmt.extract_string());
+    auto nput = fmt.finish();
     if(nput < 0)
       return nullopt;
     return static_cast<int64_t>(nput);
@@ -58,7 +72,9 @@ create_bindings_debug(V_object& result, API_Version /*version*/)
 
   * Compose a string in the same way as `std.string.format()`, but
     instead of returning it, write it to standard error. A line
-    break is appended to terminate the line.
+    break is appended to terminate the line. `templ` may be either
+    a template string or a compiled template that has been returned
+    by `std.string.format_compile()`.
 
   * Returns the number of bytes written if the operation succeeds,
     or `null` otherwise.
@@ -73,6 +89,11 @@ create_bindings_debug(V_object& result, API_Version /*version*/)
       Reference_root::S_temporary xref = { std_debug_logf(templ, values) };
       return self = ::std::move(xref);
     }
+    V_opaque ctempl;
+    if(reader.I().v(ctempl).F(values)) {
+      Reference_root::S_temporary xref = { std_debug_logf(ctempl, values) };
+      return self = ::std::move(xref);
+    }
     // Fail.
     reader.throw_no_matching_function_call();
   }
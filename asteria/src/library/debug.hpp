@@ -12,6 +12,9 @@ namespace Asteria {
 optV_integer
 std_debug_logf(V_string templ, cow_vector<Value> values);
 
+optV_integer
+std_debug_logf(V_opaque templ, cow_vector<Value> values);
+
 // `std.debug.dump`
 optV_integer
 std_debug_dump(Value value, optV_integer indent);
@@ -4,6 +4,7 @@
 #include "../precompiled.hpp"
 #include "io.hpp"
 #include "../runtime/argument_reader.hpp"
+#include "../runtime/format_template.hpp"
 #include "../utilities.hpp"
 
 namespace Asteria {
@@ -54,23 +55,206 @@ do_recover(const IOF_Sentry& fp)
     return err;
   }
 
+size_t
+do_utf8_sequence_length(char lead)
+noexcept
+  {
+    // Invalid leading bytes are reported by the decoder.
+    uint32_t b = lead & 0xFF;
+    if((b < 0xC0) || (0xF8 <= b))
+      return 1;
+    return 2U + (b >= 0xE0) + (b >= 0xF0);
+  }
+
+// This stream converts UTF-8 text into wide characters and writes them through fixed
+// buffers, so formatted output is never composed in memory as a whole. A sequence
+// that is split between two blocks is completed by the next one.
+class UTF8_Stream
+final
+  : public tinyfmt
+  {
+  private:
+    class Buffer
+    final
+      : public tinybuf
+      {
+      private:
+        const IOF_Sentry& m_fp;
+        char m_raw[1024];  // put area
+        wchar_t m_wbuf[256];
+        size_t m_wlen = 0;
+        char m_part[4];  // incomplete sequence
+        size_t m_npart = 0;
+        size_t m_ncps = 0;
+        size_t m_offset = 0;  // bytes converted so far
+
+      public:
+        explicit
+        Buffer(const IOF_Sentry& fp)
+        noexcept
+          : m_fp(fp)
+          { }
+
+      private:
+        void
+        do_flush_wbuf()
+          {
+            // As `fputws()` takes null-terminated strings, null characters are written individually.
+            this->m_wbuf[this->m_wlen] = 0;
+            this->m_wlen = 0;
+            if(::fputws_unlocked(this->m_wbuf, this->m_fp) < 0)
+              ASTERIA_THROW_SYSTEM_ERROR("fputws_unlocked");
+          }
+
+        [[noreturn]]
+        void
+        do_throw_invalid()
+          {
+            // Write characters that have been converted so far.
+            this->do_flush_wbuf();
+            ASTERIA_THROW("invalid UTF-8 string (byte offset `$1`)", this->m_offset);
+          }
+
+        void
+        do_put_code_point(char32_t cp)
+          {
+            if(cp == 0) {
+              // Insert it into the output stream directly.
+              this->do_flush_wbuf();
+              if(::fputwc_unlocked(0, this->m_fp) == WEOF)
+                ASTERIA_THROW_SYSTEM_ERROR("fputwc_unlocked");
+            }
+            else {
+              // Reserve room for the terminator.
+              if(this->m_wlen == ::rocket::countof(this->m_wbuf) - 1)
+                this->do_flush_wbuf();
+              this->m_wbuf[this->m_wlen++] = static_cast<wchar_t>(cp);
+            }
+            this->m_ncps += 1;
+          }
+
+        void
+        do_convert(const char* str, size_t len)
+          {
+            size_t off = 0;
+            char32_t cp;
+            const char* pos;
+
+            // Complete a sequence that was split at the end of the previous block.
+            while((this->m_npart != 0) && (off < len)) {
+              this->m_part[this->m_npart++] = str[off++];
+              if(this->m_npart < do_utf8_sequence_length(this->m_part[0]))
+                continue;
+              pos = this->m_part;
+              if(!utf8_decode(cp, pos, this->m_npart))
+                this->do_throw_invalid();
+              this->do_put_code_point(cp);
+              this->m_offset += this->m_npart;
+              this->m_npart = 0;
+            }
+
+            while(off < len) {
+              // Reserve room for the terminator.
+              if(this->m_wlen == ::rocket::countof(this->m_wbuf) - 1)
+                this->do_flush_wbuf();
+              // Widen ASCII characters in bulk.
+              size_t nascii = ::rocket::min(len - off, ::rocket::countof(this->m_wbuf) - 1 - this->m_wlen);
+              nascii = utf8_ascii_prefix(str + off, nascii);
+              nascii = ::strnlen(str + off, nascii);
+              if(nascii != 0) {
+                for(size_t i = 0;  i < nascii;  ++i)
+                  this->m_wbuf[this->m_wlen + i] = static_cast<wchar_t>(str[off + i]);
+                this->m_wlen += nascii;
+                off += nascii;
+                // The return value is the number of code points rather than bytes.
+                this->m_ncps += nascii;
+                this->m_offset += nascii;
+                continue;
+              }
+              // Save an incomplete sequence for the next block.
+              if(len - off < do_utf8_sequence_length(str[off])) {
+                ::std::memcpy(this->m_part, str + off, len - off);
+                this->m_npart = len - off;
+                break;
+              }
+              // Decode a code point from `str`.
+              pos = str + off;
+              if(!utf8_decode(cp, pos, len - off))
+                this->do_throw_invalid();
+              this->do_put_code_point(cp);
+              this->m_offset += static_cast<size_t>(pos - (str + off));
+              off = static_cast<size_t>(pos - str);
+            }
+          }
+
+      protected:
+        tinybuf&
+        do_flush(const char*& /*gcur*/, const char*& /*gend*/, char*& pcur, char*& pend)
+        override
+          {
+            // Convert characters in the put area.
+            if(pcur)
+              this->do_convert(this->m_raw, static_cast<size_t>(pcur - this->m_raw));
+            pcur = this->m_raw;
+            pend = this->m_raw + sizeof(this->m_raw);
+            return *this;
+          }
+
+        tinybuf&
+        do_overflow(char*& pcur, char*& pend, const char* sadd, size_t nadd)
+        override
+          {
+            // Convert characters in the put area, followed by `sadd`.
+            if(pcur)
+              this->do_convert(this->m_raw, static_cast<size_t>(pcur - this->m_raw));
+            pcur = this->m_raw;
+            pend = this->m_raw + sizeof(this->m_raw);
+            this->do_convert(sadd, nadd);
+            return *this;
+          }
+
+      public:
+        size_t
+        finish()
+          {
+            // Convert all characters, which must not end with an incomplete sequence.
+            this->flush();
+            if(this->m_npart != 0)
+              this->do_throw_invalid();
+            this->do_flush_wbuf();
+            return this->m_ncps;
+          }
+      };
+
+  private:
+    mutable Buffer m_buf;
+
+  public:
+    explicit
+    UTF8_Stream(const IOF_Sentry& fp)
+    noexcept
+      : m_buf(fp)
+      { }
+
+  public:
+    Buffer&
+    get_tinybuf()
+    const override
+      { return this->m_buf;  }
+
+    // Writes all pending characters.
+    // Returns the number of code points that have been written.
+    size_t
+    finish()
+      { return this->m_buf.finish();  }
+  };
+
 size_t
 do_write_utf8_common(const IOF_Sentry& fp, const cow_string& text)
   {
-    size_t ncps = 0;
-    size_t off = 0;
-    while(off < text.size()) {
-      // Decode a code point from `text`.
-      char32_t cp;
-      if(!utf8_decode(cp, text, off))
-        ASTERIA_THROW("invalid UTF-8 string (text `$1`, byte offset `$2`)", text, off);
-      // Insert it into the output stream.
-      if(::fputwc_unlocked(static_cast<wchar_t>(cp), fp) == WEOF)
-        ASTERIA_THROW_SYSTEM_ERROR("fputwc_unlocked");
-      // The return value is the number of code points rather than bytes.
-      ncps += 1;
-    }
-    return ncps;
+    UTF8_Stream fmt(fp);
+    fmt.putn(text.data(), text.size());
+    return fmt.finish();
   }
 
 }  // namespace
@@ -230,11 +414,30 @@ std_io_putf(V_string templ, cow_vector<Value> values)
           { return static_cast<const Value*>(ptr)->print(fmt);  },
         values.data() + i
       });
-    // Compose the string into a stream.
-    ::rocket::tinyfmt_str fmt;
+    // Write the string through a stream.
+    UTF8_Stream fmt(fp);
     vformat(fmt, templ.data(), templ.size(), insts.data(), insts.size());
-    // Write the string now.
-    size_t ncps = do_write_utf8_common(fp, fmt.get_string());
+    size_t ncps = fmt.finish();
+    // Return the number of code points that have been written.
+    return static_cast<int64_t>(ncps);
+  }
+
+optV_integer
+std_io_putf(V_opaque templ, cow_vector<Value> values)
+  {
+    // Lock standard output for writing.
+    const IOF_Sentry fp(stdout);
+
+    // Check stream status.
+    if(::ferror_unlocked(fp))
+      ASTERIA_THROW("standard output failure (error bit set)");
+    if(::fwide(fp, +1) < 0)
+      ASTERIA_THROW("invalid text write to binary-oriented output");
+
+    // Write the string through a stream without parsing the template.
+    UTF8_Stream fmt(fp);
+    format_template_cast(templ)->render(fmt, values.data(), values.size());
+    size_t ncps = fmt.finish();
     // Return the number of code points that have been written.
     return static_cast<int64_t>(ncps);
   }
@@ -441,7 +644,9 @@ create_bindings_io(V_object& result, API_Version /*version*/)
 `std.io.putf(templ, ...)`
 
  * Compose a string in the same way as `std.string.format()`, but
-   instead of returning it, write it to standard output.
+   instead of returning it, write it to standard output. `templ`
+   may be either a template string or a compiled template that has
+   been returned by `std.string.format_compile()`.
 
  * Returns the number of UTF code points that have been written.
 
@@ -459,6 +664,11 @@ create_bindings_io(V_object& result, API_Version /*version*/)
       Reference_root::S_temporary xref = { std_io_putf(::std::move(templ), ::std::move(values)) };
       return self = ::std::move(xref);
     }
+    V_opaque ctempl;
+    if(reader.I().v(ctempl).F(values)) {
+      Reference_root::S_temporary xref = { std_io_putf(::std::move(ctempl), ::std::move(values)) };
+      return self = ::std::move(xref);
+    }
     // Fail.
     reader.throw_no_matching_function_call();
   }
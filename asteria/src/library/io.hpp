@@ -31,6 +31,9 @@ std_io_putln(V_string value);
 optV_integer
 std_io_putf(V_string templ, cow_vector<Value> values);
 
+optV_integer
+std_io_putf(V_opaque templ, cow_vector<Value> values);
+
 // `std.io.read`
 optV_string
 std_io_read(optV_integer limit);
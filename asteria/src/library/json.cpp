@@ -5,14 +5,127 @@
 #include "json.hpp"
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/global_context.hpp"
-#include "../compiler/token_stream.hpp"
 #include "../compiler/parser_error.hpp"
-#include "../compiler/enums.hpp"
 #include "../utilities.hpp"
+#include <fcntl.h>  // ::open()
+#include <unistd.h>  // ::write(), ::close()
+#include <locale.h>  // ::newlocale()
+#include <stdlib.h>  // ::strtod_l()
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__SSE2__))
+#  define ASTERIA_JSON_X86_  1
+#  include <immintrin.h>
+#endif
 
 namespace Asteria {
 namespace {
 
+class JSON_Writer
+  {
+  private:
+    // Output is accumulated here and written to `m_qstr` or `m_fd` in blocks, so small
+    // tokens do not go through any virtual or allocating function.
+    char m_stor[4096];
+    size_t m_size = 0;
+    V_string* m_qstr = nullptr;
+    int m_fd = -1;
+
+  public:
+    explicit
+    JSON_Writer(V_string& str)
+    noexcept
+      : m_qstr(::std::addressof(str))
+      { }
+
+    explicit
+    JSON_Writer(int fd)
+    noexcept
+      : m_fd(fd)
+      { }
+
+    JSON_Writer(const JSON_Writer&)
+      = delete;
+
+    JSON_Writer&
+    operator=(const JSON_Writer&)
+      = delete;
+
+  private:
+    void
+    do_write(const char* s, size_t n)
+      {
+        if(this->m_qstr) {
+          // Grow the string geometrically.
+          auto& str = *(this->m_qstr);
+          if(str.capacity() - str.size() < n)
+            str.reserve(::rocket::max(str.size() * 2, str.size() + n));
+          str.append(s, n);
+          return;
+        }
+        while(n != 0) {
+          ::ssize_t nwrtn = ::write(this->m_fd, s, n);
+          if(nwrtn < 0) {
+            if(errno == EINTR)
+              continue;
+            ASTERIA_THROW_SYSTEM_ERROR("write");
+          }
+          s += nwrtn;
+          n -= static_cast<size_t>(nwrtn);
+        }
+      }
+
+  public:
+    void
+    flush()
+      {
+        this->do_write(this->m_stor, this->m_size);
+        this->m_size = 0;
+      }
+
+    char*
+    reserve(size_t n)
+      {
+        // Get a buffer of `n` bytes, which is then committed by `accept()`.
+        ROCKET_ASSERT(n <= sizeof(this->m_stor));
+        if(sizeof(this->m_stor) - this->m_size < n)
+          this->flush();
+        return this->m_stor + this->m_size;
+      }
+
+    void
+    accept(size_t n)
+    noexcept
+      { this->m_size += n;  }
+
+    void
+    putc(char c)
+      {
+        *(this->reserve(1)) = c;
+        this->accept(1);
+      }
+
+    void
+    putn(const char* s, size_t n)
+      {
+        if(sizeof(this->m_stor) - this->m_size >= n) {
+          ::std::memcpy(this->m_stor + this->m_size, s, n);
+          this->m_size += n;
+          return;
+        }
+        // Write long strings directly.
+        this->flush();
+        if(n >= sizeof(this->m_stor) / 2)
+          return this->do_write(s, n);
+        ::std::memcpy(this->m_stor, s, n);
+        this->m_size = n;
+      }
+
+    template<size_t N>
+    void
+    puts(const char (&s)[N])
+      { this->putn(s, N - 1);  }
+  };
+
 class Indenter
   {
   public:
@@ -21,8 +134,8 @@ class Indenter
 
   public:
     virtual
-    tinyfmt&
-    break_line(tinyfmt& fmt)
+    void
+    break_line(JSON_Writer& out)
     const
       = 0;
 
@@ -58,10 +171,10 @@ final
       = default;
 
   public:
-    tinyfmt&
-    break_line(tinyfmt& fmt)
+    void
+    break_line(JSON_Writer& /*out*/)
     const override
-      { return fmt;  }
+      { }
 
     void
     increment_level()
@@ -94,10 +207,10 @@ final
       { }
 
   public:
-    tinyfmt&
-    break_line(tinyfmt& fmt)
+    void
+    break_line(JSON_Writer& out)
     const override
-      { return fmt << this->m_cur;  }
+      { out.putn(this->m_cur.data(), this->m_cur.size());  }
 
     void
     increment_level()
@@ -130,10 +243,20 @@ final
       { }
 
   public:
-    tinyfmt&
-    break_line(tinyfmt& fmt)
+    void
+    break_line(JSON_Writer& out)
     const override
-      { return fmt << pwrap(this->m_add, this->m_cur);  }
+      {
+        out.putc('\n');
+        // Write spaces in blocks.
+        static constexpr char s_spaces[] = "                                ";
+        size_t rem = this->m_cur;
+        while(rem != 0) {
+          size_t n = ::rocket::min(rem, sizeof(s_spaces) - 1);
+          out.putn(s_spaces, n);
+          rem -= n;
+        }
+      }
 
     void
     increment_level()
@@ -151,13 +274,295 @@ final
       { return this->m_add;  }
   };
 
-tinyfmt&
-do_quote_string(tinyfmt& fmt, const cow_string& str)
+#ifdef ASTERIA_JSON_X86_
+
+// SSE2 is always available on x86-64. AVX2 is selected at run time, so those kernels must not
+// be called unless the CPU supports them. Each kernel returns the number of leading bytes up
+// to the first one that it stops at, examining whole blocks only, and leaves the rest to the
+// scalar code that follows it.
+inline
+bool
+do_cpu_has_avx2()
+noexcept
+  { return cpu_supports(cpu_feature_avx2);  }
+
+// These stop at bytes that can't be written verbatim into a JSON string, which are control
+// characters, DEL, non-ASCII characters, quote marks and backslashes.
+inline
+uint32_t
+do_format_stops_sse2(__m128i c)
+noexcept
+  {
+    __m128i t = _mm_or_si128(_mm_cmplt_epi8(c, _mm_set1_epi8(0x20)), _mm_cmpeq_epi8(c, _mm_set1_epi8(0x7F)));
+    t = _mm_or_si128(t, _mm_cmpeq_epi8(c, _mm_set1_epi8('\"')));
+    t = _mm_or_si128(t, _mm_cmpeq_epi8(c, _mm_set1_epi8('\\')));
+    return static_cast<uint32_t>(_mm_movemask_epi8(t));
+  }
+
+__attribute__((__target__("avx2")))
+inline
+uint32_t
+do_format_stops_avx2(__m256i c)
+noexcept
+  {
+    __m256i t = _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), c),
+                                _mm256_cmpeq_epi8(c, _mm256_set1_epi8(0x7F)));
+    t = _mm256_or_si256(t, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\"')));
+    t = _mm256_or_si256(t, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\\')));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(t));
+  }
+
+// These stop at bytes that end a run of plain characters in a string literal, which are the
+// closing quote mark `head`, backslashes, LFs, null characters and non-ASCII characters.
+inline
+uint32_t
+do_string_stops_sse2(__m128i c, __m128i head)
+noexcept
+  {
+    __m128i t = _mm_or_si128(_mm_cmpeq_epi8(c, head), _mm_cmpeq_epi8(c, _mm_set1_epi8('\\')));
+    t = _mm_or_si128(t, _mm_cmpeq_epi8(c, _mm_set1_epi8('\n')));
+    t = _mm_or_si128(t, _mm_cmpeq_epi8(c, _mm_setzero_si128()));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(t, c)));
+  }
+
+__attribute__((__target__("avx2")))
+inline
+uint32_t
+do_string_stops_avx2(__m256i c, __m256i head)
+noexcept
+  {
+    __m256i t = _mm256_or_si256(_mm256_cmpeq_epi8(c, head), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\\')));
+    t = _mm256_or_si256(t, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n')));
+    t = _mm256_or_si256(t, _mm256_cmpeq_epi8(c, _mm256_setzero_si256()));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(t, c)));
+  }
+
+// These stop at bytes other than spaces, tabs, VTs, FFs and CRs. LFs are left to the caller,
+// which has to count lines.
+inline
+uint32_t
+do_space_stops_sse2(__m128i c)
+noexcept
+  {
+    __m128i t = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('\t' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('\r' + 1)));
+    t = _mm_andnot_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')), t);
+    t = _mm_or_si128(t, _mm_cmpeq_epi8(c, _mm_set1_epi8(' ')));
+    return static_cast<uint32_t>(_mm_movemask_epi8(t)) ^ 0xFFFFU;
+  }
+
+__attribute__((__target__("avx2")))
+inline
+uint32_t
+do_space_stops_avx2(__m256i c)
+noexcept
+  {
+    __m256i t = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('\t' - 1)),
+                                 _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), c));
+    t = _mm256_andnot_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n')), t);
+    t = _mm256_or_si256(t, _mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')));
+    return ~static_cast<uint32_t>(_mm256_movemask_epi8(t));
+  }
+
+size_t
+do_format_plain_span_sse2(const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = 0;
+    while(slen - nread >= 16) {
+      uint32_t stop = do_format_stops_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread)));
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_ctz(stop));
+      nread += 16;
+    }
+    return nread;
+  }
+
+__attribute__((__target__("avx2")))
+size_t
+do_format_plain_span_avx2(const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = 0;
+    while(slen - nread >= 32) {
+      uint32_t stop = do_format_stops_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr + nread)));
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_ctz(stop));
+      nread += 32;
+    }
+    return nread;
+  }
+
+size_t
+do_string_plain_span_sse2(const char* sptr, size_t slen, char head)
+noexcept
+  {
+    const __m128i vhead = _mm_set1_epi8(head);
+    size_t nread = 0;
+    while(slen - nread >= 16) {
+      uint32_t stop = do_string_stops_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread)), vhead);
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_ctz(stop));
+      nread += 16;
+    }
+    return nread;
+  }
+
+__attribute__((__target__("avx2")))
+size_t
+do_string_plain_span_avx2(const char* sptr, size_t slen, char head)
+noexcept
+  {
+    const __m256i vhead = _mm256_set1_epi8(head);
+    size_t nread = 0;
+    while(slen - nread >= 32) {
+      uint32_t stop = do_string_stops_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr + nread)), vhead);
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_ctz(stop));
+      nread += 32;
+    }
+    return nread;
+  }
+
+size_t
+do_space_span_sse2(const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = 0;
+    while(slen - nread >= 16) {
+      uint32_t stop = do_space_stops_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread)));
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_ctz(stop));
+      nread += 16;
+    }
+    return nread;
+  }
+
+__attribute__((__target__("avx2")))
+size_t
+do_space_span_avx2(const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = 0;
+    while(slen - nread >= 32) {
+      uint32_t stop = do_space_stops_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr + nread)));
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_ctz(stop));
+      nread += 32;
+    }
+    return nread;
+  }
+
+// These dispatch to the SIMD kernels above. Unlike the kernels, they may be called on any CPU.
+// Most runs are short, and AVX2 has a higher startup cost than SSE2, so AVX2 is only used
+// once a run has proven to be long.
+constexpr size_t s_avx2_threshold = 64;
+
+inline
+size_t
+do_format_plain_span(const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = do_format_plain_span_sse2(sptr, ::rocket::min(slen, s_avx2_threshold));
+    if(nread != s_avx2_threshold)
+      return nread;
+    if(do_cpu_has_avx2())
+      return nread + do_format_plain_span_avx2(sptr + nread, slen - nread);
+    return nread + do_format_plain_span_sse2(sptr + nread, slen - nread);
+  }
+
+inline
+size_t
+do_string_plain_span(const char* sptr, size_t slen, char head)
+noexcept
+  {
+    size_t nread = do_string_plain_span_sse2(sptr, ::rocket::min(slen, s_avx2_threshold), head);
+    if(nread != s_avx2_threshold)
+      return nread;
+    if(do_cpu_has_avx2())
+      return nread + do_string_plain_span_avx2(sptr + nread, slen - nread, head);
+    return nread + do_string_plain_span_sse2(sptr + nread, slen - nread, head);
+  }
+
+inline
+size_t
+do_space_span(const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = do_space_span_sse2(sptr, ::rocket::min(slen, s_avx2_threshold));
+    if(nread != s_avx2_threshold)
+      return nread;
+    if(do_cpu_has_avx2())
+      return nread + do_space_span_avx2(sptr + nread, slen - nread);
+    return nread + do_space_span_sse2(sptr + nread, slen - nread);
+  }
+
+#else  // ASTERIA_JSON_X86_
+
+// There are no SIMD kernels, so everything is left to scalar code.
+constexpr
+size_t
+do_format_plain_span(const char* /*sptr*/, size_t /*slen*/)
+noexcept
+  { return 0;  }
+
+constexpr
+size_t
+do_string_plain_span(const char* /*sptr*/, size_t /*slen*/, char /*head*/)
+noexcept
+  { return 0;  }
+
+constexpr
+size_t
+do_space_span(const char* /*sptr*/, size_t /*slen*/)
+noexcept
+  { return 0;  }
+
+#endif  // ASTERIA_JSON_X86_
+
+inline
+bool
+do_is_format_word_plain(uint64_t word)
+noexcept
+  {
+    // Check whether all of the 8 bytes are printable ASCII characters other than quote marks
+    // and backslashes, which can be written verbatim. This is a branchless test of each byte.
+    constexpr uint64_t ones = 0x01010101'01010101;
+    constexpr uint64_t highs = ones << 7;
+    // Check for bytes that are >= 0x7F, including DEL and non-ASCII characters.
+    uint64_t mask = (word | (word + ones)) & highs;
+    // Check for bytes that are < 0x20.
+    mask |= (word - 0x20 * ones) & ~word & highs;
+    for(uint64_t t : { word ^ ('\"' * ones), word ^ ('\\' * ones) })
+      mask |= (t - ones) & ~t & highs;
+    return mask == 0;
+  }
+
+void
+do_quote_string(JSON_Writer& out, const cow_string& str)
   {
     // Although JavaScript uses UCS-2 rather than UTF-16, the JSON specification adopts UTF-16.
-    fmt << '\"';
+    out.putc('\"');
     size_t offset = 0;
     while(offset < str.size()) {
+      // Write printable ASCII characters that need no escaping in bulk. Blocks are checked
+      // first, then words, then bytes.
+      auto rbeg = str.data() + offset;
+      auto eptr = str.data() + str.size();
+      auto rend = rbeg + do_format_plain_span(rbeg, static_cast<size_t>(eptr - rbeg));
+      while(eptr - rend >= 8) {
+        uint64_t word;
+        ::std::memcpy(&word, rend, 8);
+        if(!do_is_format_word_plain(word))
+          break;
+        rend += 8;
+      }
+      rend = ::std::find_if(rend, eptr,
+                 [](char c) { return (uint8_t(c) - 0x20U > 0x5EU) || (c == '\"') || (c == '\\');  });
+      if(rend != rbeg) {
+        out.putn(rbeg, static_cast<size_t>(rend - rbeg));
+        offset += static_cast<size_t>(rend - rbeg);
+        continue;
+      }
       // Convert UTF-8 to UTF-16.
       char32_t cp;
       if(!utf8_decode(cp, str, offset)) {
@@ -167,37 +572,37 @@ do_quote_string(tinyfmt& fmt, const cow_string& str)
       // Escape double quotes, backslashes, and control characters.
       switch(cp) {
         case '\"':
-          fmt << "\\\"";
+          out.puts("\\\"");
           break;
 
         case '\\':
-          fmt << "\\\\";
+          out.puts("\\\\");
           break;
 
         case '\b':
-          fmt << "\\b";
+          out.puts("\\b");
           break;
 
         case '\f':
-          fmt << "\\f";
+          out.puts("\\f");
           break;
 
         case '\n':
-          fmt << "\\n";
+          out.puts("\\n");
           break;
 
         case '\r':
-          fmt << "\\r";
+          out.puts("\\r");
           break;
 
         case '\t':
-          fmt << "\\t";
+          out.puts("\\t");
           break;
 
         default: {
           if((0x20 <= cp) && (cp <= 0x7E)) {
             // Write printable characters as is.
-            fmt << static_cast<char>(cp);
+            out.putc(static_cast<char>(cp));
             break;
           }
           // Encode the character in UTF-16.
@@ -205,30 +610,30 @@ do_quote_string(tinyfmt& fmt, const cow_string& str)
           char16_t* epos = ustr;
           utf16_encode(epos, cp);
           // Write code units.
-          ::rocket::ascii_numput nump;
           for(auto p = ustr;  p != epos;  ++p) {
-            nump.put_XU(*p, 4);
-            char seq[8] = { "\\u" };
-            ::std::memcpy(seq + 2, nump.data() + 2, 4);
-            fmt << ::rocket::sref(seq, 6);
+            auto seq = out.reserve(6);
+            seq[0] = '\\';
+            seq[1] = 'u';
+            for(int i = 0;  i < 4;  ++i)
+              seq[2 + i] = "0123456789ABCDEF"[*p >> (12 - i * 4) & 0xF];
+            out.accept(6);
           }
           break;
         }
       }
     }
-    fmt << '\"';
-    return fmt;
+    out.putc('\"');
   }
 
-tinyfmt&
-do_quote_object_key(tinyfmt& fmt, bool json5, const cow_string& name)
+void
+do_quote_object_key(JSON_Writer& out, bool json5, const cow_string& name)
   {
     if(json5 && name.size() && is_cctype(name[0], cctype_namei) &&
                 ::std::all_of(name.begin() + 1, name.end(),
                               [](char c) { return is_cctype(c, cctype_namei | cctype_digit);  }))
-      return fmt << name;
+      out.putn(name.data(), name.size());
     else
-      return do_quote_string(fmt, name);
+      do_quote_string(out, name);
   }
 
 V_object::const_iterator
@@ -242,17 +647,308 @@ do_find_uncensored(const V_object& object, V_object::const_iterator from)
         });
   }
 
-tinyfmt&
-do_format_scalar(tinyfmt& fmt, const Value& value, bool json5)
+// This is the Grisu2 algorithm by Florian Loitsch, which generates the shortest decimal
+// representation that converts back to the same double in all but a few rare cases, where it
+// is one digit longer. `f` and `e` denote the significand and the binary exponent.
+struct Diy_Fp
+  {
+    uint64_t f;
+    int e;
+  };
+
+constexpr Diy_Fp s_cached_powers[] =
+  {
+    { 0xFA8FD5A0081C0288, -1220 },  // 1.0e-348
+    { 0xBAAEE17FA23EBF76, -1193 },  // 1.0e-340
+    { 0x8B16FB203055AC76, -1166 },  // 1.0e-332
+    { 0xCF42894A5DCE35EA, -1140 },  // 1.0e-324
+    { 0x9A6BB0AA55653B2D, -1113 },  // 1.0e-316
+    { 0xE61ACF033D1A45DF, -1087 },  // 1.0e-308
+    { 0xAB70FE17C79AC6CA, -1060 },  // 1.0e-300
+    { 0xFF77B1FCBEBCDC4F, -1034 },  // 1.0e-292
+    { 0xBE5691EF416BD60C, -1007 },  // 1.0e-284
+    { 0x8DD01FAD907FFC3C,  -980 },  // 1.0e-276
+    { 0xD3515C2831559A83,  -954 },  // 1.0e-268
+    { 0x9D71AC8FADA6C9B5,  -927 },  // 1.0e-260
+    { 0xEA9C227723EE8BCB,  -901 },  // 1.0e-252
+    { 0xAECC49914078536D,  -874 },  // 1.0e-244
+    { 0x823C12795DB6CE57,  -847 },  // 1.0e-236
+    { 0xC21094364DFB5637,  -821 },  // 1.0e-228
+    { 0x9096EA6F3848984F,  -794 },  // 1.0e-220
+    { 0xD77485CB25823AC7,  -768 },  // 1.0e-212
+    { 0xA086CFCD97BF97F4,  -741 },  // 1.0e-204
+    { 0xEF340A98172AACE5,  -715 },  // 1.0e-196
+    { 0xB23867FB2A35B28E,  -688 },  // 1.0e-188
+    { 0x84C8D4DFD2C63F3B,  -661 },  // 1.0e-180
+    { 0xC5DD44271AD3CDBA,  -635 },  // 1.0e-172
+    { 0x936B9FCEBB25C996,  -608 },  // 1.0e-164
+    { 0xDBAC6C247D62A584,  -582 },  // 1.0e-156
+    { 0xA3AB66580D5FDAF6,  -555 },  // 1.0e-148
+    { 0xF3E2F893DEC3F126,  -529 },  // 1.0e-140
+    { 0xB5B5ADA8AAFF80B8,  -502 },  // 1.0e-132
+    { 0x87625F056C7C4A8B,  -475 },  // 1.0e-124
+    { 0xC9BCFF6034C13053,  -449 },  // 1.0e-116
+    { 0x964E858C91BA2655,  -422 },  // 1.0e-108
+    { 0xDFF9772470297EBD,  -396 },  // 1.0e-100
+    { 0xA6DFBD9FB8E5B88F,  -369 },  // 1.0e-092
+    { 0xF8A95FCF88747D94,  -343 },  // 1.0e-084
+    { 0xB94470938FA89BCF,  -316 },  // 1.0e-076
+    { 0x8A08F0F8BF0F156B,  -289 },  // 1.0e-068
+    { 0xCDB02555653131B6,  -263 },  // 1.0e-060
+    { 0x993FE2C6D07B7FAC,  -236 },  // 1.0e-052
+    { 0xE45C10C42A2B3B06,  -210 },  // 1.0e-044
+    { 0xAA242499697392D3,  -183 },  // 1.0e-036
+    { 0xFD87B5F28300CA0E,  -157 },  // 1.0e-028
+    { 0xBCE5086492111AEB,  -130 },  // 1.0e-020
+    { 0x8CBCCC096F5088CC,  -103 },  // 1.0e-012
+    { 0xD1B71758E219652C,   -77 },  // 1.0e-004
+    { 0x9C40000000000000,   -50 },  // 1.0e+004
+    { 0xE8D4A51000000000,   -24 },  // 1.0e+012
+    { 0xAD78EBC5AC620000,     3 },  // 1.0e+020
+    { 0x813F3978F8940984,    30 },  // 1.0e+028
+    { 0xC097CE7BC90715B3,    56 },  // 1.0e+036
+    { 0x8F7E32CE7BEA5C70,    83 },  // 1.0e+044
+    { 0xD5D238A4ABE98068,   109 },  // 1.0e+052
+    { 0x9F4F2726179A2245,   136 },  // 1.0e+060
+    { 0xED63A231D4C4FB27,   162 },  // 1.0e+068
+    { 0xB0DE65388CC8ADA8,   189 },  // 1.0e+076
+    { 0x83C7088E1AAB65DB,   216 },  // 1.0e+084
+    { 0xC45D1DF942711D9A,   242 },  // 1.0e+092
+    { 0x924D692CA61BE758,   269 },  // 1.0e+100
+    { 0xDA01EE641A708DEA,   295 },  // 1.0e+108
+    { 0xA26DA3999AEF774A,   322 },  // 1.0e+116
+    { 0xF209787BB47D6B85,   348 },  // 1.0e+124
+    { 0xB454E4A179DD1877,   375 },  // 1.0e+132
+    { 0x865B86925B9BC5C2,   402 },  // 1.0e+140
+    { 0xC83553C5C8965D3D,   428 },  // 1.0e+148
+    { 0x952AB45CFA97A0B3,   455 },  // 1.0e+156
+    { 0xDE469FBD99A05FE3,   481 },  // 1.0e+164
+    { 0xA59BC234DB398C25,   508 },  // 1.0e+172
+    { 0xF6C69A72A3989F5C,   534 },  // 1.0e+180
+    { 0xB7DCBF5354E9BECE,   561 },  // 1.0e+188
+    { 0x88FCF317F22241E2,   588 },  // 1.0e+196
+    { 0xCC20CE9BD35C78A5,   614 },  // 1.0e+204
+    { 0x98165AF37B2153DF,   641 },  // 1.0e+212
+    { 0xE2A0B5DC971F303A,   667 },  // 1.0e+220
+    { 0xA8D9D1535CE3B396,   694 },  // 1.0e+228
+    { 0xFB9B7CD9A4A7443C,   720 },  // 1.0e+236
+    { 0xBB764C4CA7A44410,   747 },  // 1.0e+244
+    { 0x8BAB8EEFB6409C1A,   774 },  // 1.0e+252
+    { 0xD01FEF10A657842C,   800 },  // 1.0e+260
+    { 0x9B10A4E5E9913129,   827 },  // 1.0e+268
+    { 0xE7109BFBA19C0C9D,   853 },  // 1.0e+276
+    { 0xAC2820D9623BF429,   880 },  // 1.0e+284
+    { 0x80444B5E7AA7CF85,   907 },  // 1.0e+292
+    { 0xBF21E44003ACDD2D,   933 },  // 1.0e+300
+    { 0x8E679C2F5E44FF8F,   960 },  // 1.0e+308
+    { 0xD433179D9C8CB841,   986 },  // 1.0e+316
+    { 0x9E19DB92B4E31BA9,  1013 },  // 1.0e+324
+    { 0xEB96BF6EBADF77D9,  1039 },  // 1.0e+332
+    { 0xAF87023B9BF0EE6B,  1066 },  // 1.0e+340
+  };
+
+inline
+Diy_Fp
+do_diy_normalize(Diy_Fp x)
+noexcept
+  {
+    while(!(x.f >> 63)) {
+      x.f <<= 1;
+      x.e--;
+    }
+    return x;
+  }
+
+inline
+Diy_Fp
+do_diy_multiply(const Diy_Fp& x, const Diy_Fp& y)
+noexcept
+  {
+    // Multiply two 64-bit values and get the high-order half, rounded.
+    uint64_t a = x.f >> 32;
+    uint64_t b = x.f & 0xFFFFFFFF;
+    uint64_t c = y.f >> 32;
+    uint64_t d = y.f & 0xFFFFFFFF;
+    uint64_t t = (b * d >> 32) + (a * d & 0xFFFFFFFF) + (b * c & 0xFFFFFFFF) + (1U << 31);
+    return { a * c + (a * d >> 32) + (b * c >> 32) + (t >> 32), x.e + y.e + 64 };
+  }
+
+inline
+void
+do_grisu_round(char* digits, size_t ndigits, uint64_t delta, uint64_t rest, uint64_t ten_kappa,
+               uint64_t wp_w)
+noexcept
+  {
+    // Move the last digit towards the exact value while it stays within the boundaries.
+    while((rest < wp_w) && (delta - rest >= ten_kappa) &&
+          ((rest + ten_kappa < wp_w) || (wp_w - rest > rest + ten_kappa - wp_w))) {
+      digits[ndigits - 1]--;
+      rest += ten_kappa;
+    }
+  }
+
+size_t
+do_grisu2(char* digits, int& exp10, double value)
+noexcept
+  {
+    // Decompose `value`, which shall be finite and positive.
+    uint64_t bits;
+    ::std::memcpy(&bits, &value, 8);
+    int bexp = static_cast<int>(bits >> 52);
+    Diy_Fp v = { bits & 0xFFFFF'FFFFFFFF, -1074 };
+    if(bexp != 0) {
+      v.f |= uint64_t(1) << 52;
+      v.e = bexp - 1075;
+    }
+
+    // Calculate the boundaries `m+` and `m-`, which are halfway between `v` and its neighbors.
+    Diy_Fp mp = do_diy_normalize({ (v.f << 1) + 1, v.e - 1 });
+    Diy_Fp mm = (v.f == (uint64_t(1) << 52)) ? Diy_Fp{ (v.f << 2) - 1, v.e - 2 }
+                                             : Diy_Fp{ (v.f << 1) - 1, v.e - 1 };
+    mm.f <<= mm.e - mp.e;
+    mm.e = mp.e;
+
+    // Get a cached power of ten, which scales the binary exponent of `m+` into [-60,-32].
+    double dk = (-61 - mp.e) * 0.30102999566398114 + 347;
+    int k = static_cast<int>(dk);
+    if(dk - k > 0.0)
+      k++;
+    size_t index = static_cast<size_t>((k >> 3) + 1);
+    exp10 = 348 - static_cast<int>(index << 3);
+    const auto& cp = s_cached_powers[index];
+
+    Diy_Fp w = do_diy_multiply(do_diy_normalize(v), cp);
+    Diy_Fp wp = do_diy_multiply(mp, cp);
+    Diy_Fp wm = do_diy_multiply(mm, cp);
+    wp.f--;
+    wm.f++;
+    uint64_t delta = wp.f - wm.f;
+
+    // Generate digits of `wp`, until the remaining part falls within `delta`.
+    static constexpr uint64_t s_pow10[] =
+      {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+        10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+        1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000,
+        10000000000000000000U,
+      };
+    int shift = -wp.e;
+    uint64_t one = uint64_t(1) << shift;
+    uint64_t wp_w = wp.f - w.f;
+    uint32_t p1 = static_cast<uint32_t>(wp.f >> shift);
+    uint64_t p2 = wp.f & (one - 1);
+    size_t ndigits = 0;
+    int kappa = 10;
+    while((kappa > 0) && (p1 < s_pow10[kappa - 1]))
+      kappa--;
+
+    while(kappa > 0) {
+      uint32_t d = static_cast<uint32_t>(p1 / s_pow10[kappa - 1]);
+      p1 %= static_cast<uint32_t>(s_pow10[kappa - 1]);
+      if(d || ndigits)
+        digits[ndigits++] = static_cast<char>('0' + d);
+      kappa--;
+      uint64_t rest = (uint64_t(p1) << shift) + p2;
+      if(rest <= delta) {
+        exp10 += kappa;
+        do_grisu_round(digits, ndigits, delta, rest, s_pow10[kappa] << shift, wp_w);
+        return ndigits;
+      }
+    }
+    for(;;) {
+      p2 *= 10;
+      delta *= 10;
+      uint32_t d = static_cast<uint32_t>(p2 >> shift);
+      if(d || ndigits)
+        digits[ndigits++] = static_cast<char>('0' + d);
+      p2 &= one - 1;
+      kappa--;
+      if(p2 < delta) {
+        exp10 += kappa;
+        do_grisu_round(digits, ndigits, delta, p2, one, (-kappa < 20) ? wp_w * s_pow10[-kappa] : 0);
+        return ndigits;
+      }
+    }
+  }
+
+void
+do_format_number(JSON_Writer& out, double value)
+  {
+    // Write the number in the same layout as `std::ascii_numput`, but with the shortest
+    // representation that converts back to the same value.
+    auto bptr = out.reserve(32);
+    auto ptr = bptr;
+    if(::std::signbit(value))
+      *(ptr++) = '-';
+    if(value == 0) {
+      *(ptr++) = '0';
+      out.accept(static_cast<size_t>(ptr - bptr));
+      return;
+    }
+
+    char digits[24];
+    int exp10;
+    size_t ndigits = do_grisu2(digits, exp10, ::std::fabs(value));
+    // Get the decimal exponent of the first digit.
+    int dexp = static_cast<int>(ndigits) + exp10 - 1;
+    if((dexp < -4) || (dexp >= 17)) {
+      // Write the number in scientific notation.
+      *(ptr++) = digits[0];
+      if(ndigits > 1) {
+        *(ptr++) = '.';
+        ::std::memcpy(ptr, digits + 1, ndigits - 1);
+        ptr += ndigits - 1;
+      }
+      *(ptr++) = 'e';
+      *(ptr++) = (dexp < 0) ? '-' : '+';
+      unsigned uexp = static_cast<unsigned>(::std::abs(dexp));
+      if(uexp >= 100)
+        *(ptr++) = static_cast<char>('0' + uexp / 100);
+      *(ptr++) = static_cast<char>('0' + uexp / 10 % 10);
+      *(ptr++) = static_cast<char>('0' + uexp % 10);
+    }
+    else if(dexp < 0) {
+      // Write the number in plain format, which starts with `0.`, followed by zeroes.
+      *(ptr++) = '0';
+      *(ptr++) = '.';
+      ::std::memset(ptr, '0', static_cast<size_t>(-1 - dexp));
+      ptr += -1 - dexp;
+      ::std::memcpy(ptr, digits, ndigits);
+      ptr += ndigits;
+    }
+    else if(static_cast<size_t>(dexp) >= ndigits - 1) {
+      // Write an integer, which is padded with zeroes.
+      ::std::memcpy(ptr, digits, ndigits);
+      ptr += ndigits;
+      ::std::memset(ptr, '0', static_cast<size_t>(dexp + 1) - ndigits);
+      ptr += static_cast<size_t>(dexp + 1) - ndigits;
+    }
+    else {
+      // Write the number in plain format, where the decimal point is in the middle.
+      size_t nint = static_cast<size_t>(dexp + 1);
+      ::std::memcpy(ptr, digits, nint);
+      ptr += nint;
+      *(ptr++) = '.';
+      ::std::memcpy(ptr, digits + nint, ndigits - nint);
+      ptr += ndigits - nint;
+    }
+    out.accept(static_cast<size_t>(ptr - bptr));
+  }
+
+void
+do_format_scalar(JSON_Writer& out, const Value& value, bool json5)
   {
     switch(weaken_enum(value.vtype())) {
       case vtype_boolean:
         // Write `true` or `false`.
-        return fmt << value.as_boolean();
+        if(value.as_boolean())
+          return out.puts("true");
+        else
+          return out.puts("false");
 
       case vtype_integer:
         // Write the integer in decimal.
-        return fmt << V_real(value.as_integer());
+        return do_format_number(out, V_real(value.as_integer()));
 
       case vtype_real: {
         // Is the value finite?
@@ -261,27 +957,27 @@ do_format_scalar(tinyfmt& fmt, const Value& value, bool json5)
             if(!json5)
               break;
             // JSON5 allows `Infinity` in ECMAScript form.
-            return fmt << "Infinity";
+            return out.puts("Infinity");
 
           case FP_NAN:
             if(!json5)
               break;
             // JSON5 allows `NaN` in ECMAScript form.
-            return fmt << "NaN";
+            return out.puts("NaN");
 
           default:
             // Write the real in decimal.
-            return fmt << value.as_real();
+            return do_format_number(out, value.as_real());
         }
         break;
       }
 
       case vtype_string:
         // Write the quoted string.
-        return do_quote_string(fmt, value.as_string());
+        return do_quote_string(out, value.as_string());
     }
     // Anything else is censored to `null`.
-    return fmt << "null";
+    return out.puts("null");
   }
 
 struct S_xformat_array
@@ -298,10 +994,9 @@ struct S_xformat_object
 
 using Xformat = variant<S_xformat_array, S_xformat_object>;
 
-V_string
-do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
+void
+do_format_nonrecursive(JSON_Writer& out, const Value& value, bool json5, Indenter& indent)
   {
-    ::rocket::tinyfmt_str fmt;
     // Transform recursion to iteration using a handwritten stack.
     auto qvalue = ::std::addressof(value);
     cow_vector<Xformat> stack;
@@ -310,12 +1005,12 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
       if(qvalue->is_array()){
         const auto& array = qvalue->as_array();
         // Open an array.
-        fmt << '[';
+        out.putc('[');
         auto curp = array.begin();
         if(curp != array.end()) {
           // Indent the body.
           indent.increment_level();
-          indent.break_line(fmt);
+          indent.break_line(out);
           // Decend into the array.
           S_xformat_array ctxa = { ::rocket::ref(array), curp };
           stack.emplace_back(::std::move(ctxa));
@@ -323,22 +1018,22 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
           continue;
         }
         // Write an empty array.
-        fmt << ']';
+        out.putc(']');
       }
       else if(qvalue->is_object()) {
         const auto& object = qvalue->as_object();
         // Open an object.
-        fmt << '{';
+        out.putc('{');
         auto curp = do_find_uncensored(object, object.begin());
         if(curp != object.end()) {
           // Indent the body.
           indent.increment_level();
-          indent.break_line(fmt);
+          indent.break_line(out);
           // Write the key followed by a colon.
-          do_quote_object_key(fmt, json5, curp->first);
-          fmt << ':';
+          do_quote_object_key(out, json5, curp->first);
+          out.putc(':');
           if(indent.has_indention())
-            fmt << ' ';
+            out.putc(' ');
           // Decend into the object.
           S_xformat_object ctxo = { ::rocket::ref(object), curp };
           stack.emplace_back(::std::move(ctxo));
@@ -346,17 +1041,17 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
           continue;
         }
         // Write an empty object.
-        fmt << '}';
+        out.putc('}');
       }
       else {
         // Just write a scalar value which is never recursive.
-        do_format_scalar(fmt, *qvalue, json5);
+        do_format_scalar(out, *qvalue, json5);
       }
       for(;;) {
         // Advance to the next element if any.
         if(stack.empty()) {
           // Finish the root value.
-          return fmt.extract_string();
+          return;
         }
         if(stack.back().index() == 0) {
           auto& ctxa = stack.mut_back().as<0>();
@@ -364,8 +1059,8 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
           auto curp = ++(ctxa.curp);
           if(curp != ctxa.refa->end()) {
             // Add a comma between elements.
-            fmt << ',';
-            indent.break_line(fmt);
+            out.putc(',');
+            indent.break_line(out);
             // Format the next element.
             ctxa.curp = curp;
             qvalue = ::std::addressof(*curp);
@@ -373,12 +1068,12 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
           }
           // Add a trailing comma.
           if(json5 && indent.has_indention())
-            fmt << ',';
+            out.putc(',');
           // Unindent the body.
           indent.decrement_level();
-          indent.break_line(fmt);
+          indent.break_line(out);
           // Finish this array.
-          fmt << ']';
+          out.putc(']');
         }
         else {
           auto& ctxo = stack.mut_back().as<1>();
@@ -386,13 +1081,13 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
           auto curp = do_find_uncensored(ctxo.refo, ++(ctxo.curp));
           if(curp != ctxo.refo->end()) {
             // Add a comma between elements.
-            fmt << ',';
-            indent.break_line(fmt);
+            out.putc(',');
+            indent.break_line(out);
             // Write the key followed by a colon.
-            do_quote_object_key(fmt, json5, curp->first);
-            fmt << ':';
+            do_quote_object_key(out, json5, curp->first);
+            out.putc(':');
             if(indent.has_indention())
-              fmt << ' ';
+              out.putc(' ');
             // Format the next value.
             ctxo.curp = curp;
             qvalue = ::std::addressof(curp->second);
@@ -400,12 +1095,12 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
           }
           // Add a trailing comma.
           if(json5 && indent.has_indention())
-            fmt << ',';
+            out.putc(',');
           // Unindent the body.
           indent.decrement_level();
-          indent.break_line(fmt);
+          indent.break_line(out);
           // Finish this array.
-          fmt << '}';
+          out.putc('}');
         }
         stack.pop_back();
       }
@@ -413,170 +1108,877 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter& indent)
   }
 
 V_string
-do_format_nonrecursive(const Value& value, bool json5, Indenter&& indent)
+do_format_string(const Value& value, bool json5, Indenter&& indent)
   {
-    return do_format_nonrecursive(value, json5, indent);
+    V_string str;
+    JSON_Writer out(str);
+    do_format_nonrecursive(out, value, json5, indent);
+    out.flush();
+    return str;
   }
 
-optV_string
-do_accept_identifier_opt(Token_Stream& tstrm, initializer_list<const char*> accept)
+void
+do_format_file(const V_string& path, const Value& value, bool json5, Indenter&& indent)
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok) {
-      return nullopt;
-    }
-    if(qtok->is_identifier()) {
-      auto name = qtok->as_identifier();
-      if(::rocket::is_any_of(name, accept)) {
-        tstrm.shift();
-        // A match has been found.
-        return ::std::move(name);
+    ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666), ::close);
+    if(!fd)
+      ASTERIA_THROW_SYSTEM_ERROR("open");
+    // Write data directly without building a string.
+    JSON_Writer out(fd.get());
+    do_format_nonrecursive(out, value, json5, indent);
+    out.flush();
+  }
+
+// This is a single-pass scanner over the raw bytes of a JSON string. It accepts the same
+// tokens that the lexer of Asteria does with `escapable_single_quotes`, `keywords_as_identifiers`
+// and `integers_as_reals`, but without building a token vector. Errors are reported as if they
+// came from the lexer, so messages carry line numbers and offsets within lines.
+class Text_Reader
+  {
+  private:
+    const char* m_rptr;  // read pointer
+    const char* m_eptr;  // end of text
+    const char* m_lptr;  // beginning of current line
+    int m_line = 1;
+    int m_lcol = 0;  // column of `m_lptr` in its line
+
+  public:
+    explicit
+    Text_Reader(const cow_string& text)
+      : m_rptr(text.data()), m_eptr(text.data() + text.size()), m_lptr(text.data())
+      {
+        // Discard the first line if it looks like a shebang.
+        if(::std::strncmp(this->m_rptr, "#!", 2) != 0)
+          return;
+        auto lf = static_cast<const char*>(::std::memchr(this->m_rptr, '\n', this->navail()));
+        this->m_rptr = lf ? lf : this->m_eptr;
+      }
+
+    // This constructor reads a fragment of a larger text, which starts at `line` and `column`.
+    Text_Reader(const char* bptr, const char* eptr, int line, int column)
+      : m_rptr(bptr), m_eptr(eptr), m_lptr(bptr), m_line(line), m_lcol(column)
+      { }
+
+  public:
+    Source_Location
+    tell(const char* ptr)
+    const noexcept
+      { return Source_Location(::rocket::sref("<JSON text>"), this->m_line,
+                               static_cast<int>(ptr - this->m_lptr) + this->m_lcol);  }
+
+    Source_Location
+    tell()
+    const noexcept
+      { return this->tell(this->m_rptr);  }
+
+    size_t
+    navail()
+    const noexcept
+      { return static_cast<size_t>(this->m_eptr - this->m_rptr);  }
+
+    const char*
+    data(size_t add = 0)
+    const noexcept
+      { return this->m_rptr + add;  }
+
+    const char*
+    end()
+    const noexcept
+      { return this->m_eptr;  }
+
+    char
+    peek(size_t add = 0)
+    const noexcept
+      {
+        // Like `Line_Reader`, return a null character at the end of a line.
+        if(add >= this->navail())
+          return 0;
+        char c = this->m_rptr[add];
+        return (c == '\n') ? '\0' : c;
+      }
+
+    void
+    consume(size_t add)
+    noexcept
+      { this->m_rptr += add;  }
+
+    void
+    check_utf8(const char* bptr, const char* eptr)
+    const
+      {
+        // Skip ASCII characters in bulk, but still disallow null characters.
+        auto tptr = bptr;
+        while(tptr != eptr) {
+          auto nascii = utf8_ascii_prefix(tptr, static_cast<size_t>(eptr - tptr));
+          if(nascii != 0) {
+            auto nptr = static_cast<const char*>(::std::memchr(tptr, 0, nascii));
+            if(nptr)
+              throw Parser_Error(parser_status_null_character_disallowed, this->tell(nptr), 1);
+            tptr += nascii;
+            continue;
+          }
+          // Decode a code point.
+          char32_t cp;
+          auto sptr = tptr;
+          if(!utf8_decode(cp, tptr, static_cast<size_t>(eptr - tptr)))
+            throw Parser_Error(parser_status_utf8_sequence_invalid, this->tell(sptr),
+                               static_cast<size_t>(eptr - sptr));
+          if(cp == 0)
+            throw Parser_Error(parser_status_null_character_disallowed, this->tell(sptr),
+                               static_cast<size_t>(tptr - sptr));
+        }
+      }
+
+    void
+    skip_spaces_and_comments()
+      {
+        while(this->m_rptr != this->m_eptr) {
+          char c = *(this->m_rptr);
+          if(c == '\n') {
+            // Start a new line.
+            this->m_rptr++;
+            this->m_lptr = this->m_rptr;
+            this->m_line++;
+            this->m_lcol = 0;
+            continue;
+          }
+          if(is_cctype(c, cctype_space)) {
+            // Skip a space, and those that follow it in blocks if possible.
+            this->m_rptr++;
+            this->m_rptr += do_space_span(this->m_rptr, this->navail());
+            continue;
+          }
+          if((c != '/') || (this->navail() < 2))
+            break;
+
+          if(this->m_rptr[1] == '/') {
+            // Start a line comment. Discard all remaining characters in this line.
+            auto lf = static_cast<const char*>(::std::memchr(this->m_rptr, '\n', this->navail()));
+            auto tptr = lf ? lf : this->m_eptr;
+            this->check_utf8(this->m_rptr, tptr);
+            this->m_rptr = tptr;
+            continue;
+          }
+          if(this->m_rptr[1] == '*') {
+            // Start a block comment. It may straddle multiple lines, which are checked one by
+            // one. If it is not closed, we just mark the first line.
+            auto bsloc = this->tell();
+            auto tptr = this->m_rptr + 2;
+            for(;;) {
+              auto lf = static_cast<const char*>(::std::memchr(tptr, '\n',
+                                                     static_cast<size_t>(this->m_eptr - tptr)));
+              auto lend = lf ? lf : this->m_eptr;
+              auto cptr = ::std::search(tptr, lend, "*/", "*/" + 2);
+              if(cptr != lend) {
+                // Finish this comment and resume from the end of it.
+                this->check_utf8(this->m_rptr, cptr);
+                this->m_rptr = cptr + 2;
+                break;
+              }
+              this->check_utf8(this->m_rptr, lend);
+              if(!lf)
+                throw Parser_Error(parser_status_block_comment_unclosed, bsloc, 2);
+
+              // Continue searching in the next line.
+              this->m_rptr = lf + 1;
+              this->m_lptr = this->m_rptr;
+              this->m_line++;
+              this->m_lcol = 0;
+              tptr = this->m_rptr;
+            }
+            continue;
+          }
+          break;
+        }
       }
+  };
+
+void
+do_check_token_start(const Text_Reader& reader)
+  {
+    if(reader.navail() == 0)
+      return;
+
+    // If the next character does not start a token, the lexer would have rejected it.
+    char c = *(reader.data());
+    if(c & 0x80) {
+      char32_t cp;
+      auto tptr = reader.data();
+      if(!utf8_decode(cp, tptr, reader.navail()))
+        throw Parser_Error(parser_status_utf8_sequence_invalid, reader.tell(), reader.navail());
+      throw Parser_Error(parser_status_token_character_unrecognized, reader.tell(), 1);
     }
-    return nullopt;
+    if(c == 0)
+      throw Parser_Error(parser_status_null_character_disallowed, reader.tell(), 1);
+
+    if(!is_cctype(c, cctype_namei | cctype_digit) && !::std::strchr("!%&()*+,-./:;<=>?[]^{|}~\'\"", c))
+      throw Parser_Error(parser_status_token_character_unrecognized, reader.tell(), 1);
+  }
+
+[[noreturn]]
+void
+do_throw_parser_error(const Text_Reader& reader, Parser_Status status)
+  {
+    do_check_token_start(reader);
+    throw Parser_Error(status, reader.tell(), ::rocket::min(reader.navail(), size_t(1)));
   }
 
-opt<Punctuator>
-do_accept_punctuator_opt(Token_Stream& tstrm, initializer_list<Punctuator> accept)
+opt<char>
+do_accept_punctuator_opt(Text_Reader& reader, initializer_list<char> accept)
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok) {
+    reader.skip_spaces_and_comments();
+    if(reader.navail() == 0) {
       return nullopt;
     }
-    if(qtok->is_punctuator()) {
-      auto punct = qtok->as_punctuator();
-      if(::rocket::is_any_of(punct, accept)) {
-        tstrm.shift();
-        // A match has been found.
-        return punct;
-      }
+    char punct = reader.peek();
+    if(::rocket::is_any_of(punct, accept)) {
+      reader.consume(1);
+      // A match has been found.
+      return punct;
     }
     return nullopt;
   }
 
+size_t
+do_get_identifier_length(const Text_Reader& reader)
+  {
+    // identifier ::=
+    //   PCRE([A-Za-z_][A-Za-z_0-9]*)
+    if(!is_cctype(reader.peek(), cctype_namei))
+      return 0;
+    size_t tlen = 1;
+    while(is_cctype(reader.peek(tlen), cctype_namei | cctype_digit))
+      tlen++;
+    return tlen;
+  }
+
+constexpr double s_decimal_powers[] =
+  {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+  };
+
 optV_real
-do_accept_number_opt(Token_Stream& tstrm)
+do_accept_fast_number_opt(Text_Reader& reader)
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok) {
+    // Plain decimal numbers, whose mantissas and powers of ten are both exactly representable
+    // as doubles, can be calculated with a single multiplication or division, which is correctly
+    // rounded. Anything else goes through the slow path.
+    size_t tlen = 0;
+    bool neg = false;
+    if(::rocket::is_any_of(reader.peek(), { '+', '-' })) {
+      neg = reader.peek() == '-';
+      tlen++;
+    }
+    if((reader.peek(tlen) == '0') && is_cctype(reader.peek(tlen + 1), cctype_alpha | cctype_digit))
       return nullopt;
+
+    // Accumulate significant digits.
+    uint64_t mant = 0;
+    int ndigits = 0;
+    int exp10 = 0;
+    while(is_cctype(reader.peek(tlen), cctype_digit)) {
+      if(++ndigits > 19)
+        return nullopt;
+      mant = mant * 10 + static_cast<uint32_t>(reader.peek(tlen) - '0');
+      tlen++;
     }
-    if(qtok->is_integer_literal()) {
-      auto val = qtok->as_integer_literal();
-      tstrm.shift();
-      // Convert integers to reals, as JSON does not have an integral type.
-      return V_real(val);
-    }
-    if(qtok->is_real_literal()) {
-      auto val = qtok->as_real_literal();
-      tstrm.shift();
-      // This real can be copied as is.
-      return V_real(val);
-    }
-    if(qtok->is_punctuator()) {
-      auto punct = qtok->as_punctuator();
-      if(::rocket::is_any_of(punct, { punctuator_add, punctuator_sub })) {
-        V_real sign = (punct == punctuator_sub) ? -1.0 : +1.0;
-        // Only `Infinity` and `NaN` are allowed.
-        // Please note that the tokenizer will have merged sign symbols into adjacent number literals.
-        qtok = tstrm.peek_opt(1);
-        if(!qtok) {
+    if(reader.peek(tlen) == '.') {
+      tlen++;
+      if(!is_cctype(reader.peek(tlen), cctype_digit))
+        return nullopt;
+      while(is_cctype(reader.peek(tlen), cctype_digit)) {
+        if(++ndigits > 19)
           return nullopt;
-        }
-        if(!qtok->is_identifier()) {
+        mant = mant * 10 + static_cast<uint32_t>(reader.peek(tlen) - '0');
+        exp10--;
+        tlen++;
+      }
+    }
+    if((reader.peek(tlen) | 0x20) == 'e') {
+      tlen++;
+      bool eneg = false;
+      if(::rocket::is_any_of(reader.peek(tlen), { '+', '-' })) {
+        eneg = reader.peek(tlen) == '-';
+        tlen++;
+      }
+      int eval = 0;
+      int nedigits = 0;
+      while(is_cctype(reader.peek(tlen), cctype_digit)) {
+        if(++nedigits > 3)
           return nullopt;
-        }
-        const auto& name = qtok->as_identifier();
-        if(name == "Infinity") {
-          tstrm.shift(2);
-          // Accept a signed `Infinity`.
-          return ::std::copysign(::std::numeric_limits<V_real>::infinity(), sign);
-        }
-        if(name == "NaN") {
-          tstrm.shift(2);
-          // Accept a signed `NaN`.
-          return ::std::copysign(::std::numeric_limits<V_real>::quiet_NaN(), sign);
-        }
+        eval = eval * 10 + (reader.peek(tlen) - '0');
+        tlen++;
       }
+      if(nedigits == 0)
+        return nullopt;
+      exp10 += eneg ? -eval : eval;
     }
-    return nullopt;
+    // Reject digit separators, suffixes and anything the slow path might interpret differently.
+    if(is_cctype(reader.peek(tlen), cctype_alpha | cctype_digit) ||
+       ::rocket::is_any_of(reader.peek(tlen), { '`', '.' }))
+      return nullopt;
+    if((mant > (uint64_t(1) << 53)) || (exp10 < -22) || (exp10 > 22))
+      return nullopt;
+
+    double val = static_cast<double>(mant);
+    if(exp10 < 0)
+      val /= s_decimal_powers[-exp10];
+    else
+      val *= s_decimal_powers[exp10];
+    reader.consume(tlen);
+    return neg ? -val : val;
   }
 
-optV_string
-do_accept_string_opt(Token_Stream& tstrm)
+template<typename SinkT>
+void
+do_collect_digits(SinkT& sink, const Text_Reader& reader, size_t& tlen, uint8_t mask)
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok) {
-      return nullopt;
-    }
-    if(qtok->is_string_literal()) {
-      auto val = qtok->as_string_literal();
-      tstrm.shift();
-      // This string literal can be copied as is in UTF-8.
-      return V_string(::std::move(val));
+    for(;;) {
+      char c = reader.peek(tlen);
+      if(c == '`') {
+        // Skip a digit separator.
+        tlen++;
+        continue;
+      }
+      if(!is_cctype(c, mask))
+        break;
+      // Collect a digit.
+      sink.push_back(c);
+      tlen++;
     }
-    return nullopt;
   }
 
-opt<Value>
-do_accept_scalar_opt(Token_Stream& tstrm)
+template<typename SinkT>
+size_t
+do_collect_number(SinkT& sink, const Text_Reader& reader, uint8_t& expch)
   {
-    auto qnum = do_accept_number_opt(tstrm);
-    if(qnum) {
-      // Accept a `Number`.
-      return *qnum;
-    }
-    auto qstr = do_accept_string_opt(tstrm);
-    if(qstr) {
-      // Accept a `String`.
-      return ::std::move(*qstr);
+    // numeric-literal ::=
+    //   number-sign-opt ( binary-literal | decimal-literal | hexadecimal-literal ) exponent-suffix-opt
+    // See the lexer for details. Characters other than digit separators are passed to `sink`,
+    // and the length of the literal is returned.
+    size_t tlen = 0;
+    // Look for an explicit sign symbol.
+    if(::rocket::is_any_of(reader.peek(), { '+', '-' })) {
+      sink.push_back(reader.peek());
+      tlen++;
     }
-    qstr = do_accept_identifier_opt(tstrm, { "true", "false", "Infinity", "NaN", "null" });
-    if(qstr) {
-      if(qstr->front() == 't') {
-        // Accept a `Boolean` of value `true`.
-        return true;
-      }
-      if(qstr->front() == 'f') {
-        // Accept a `Boolean` of value `false`.
-        return false;
+    // These are characterstics of the literal.
+    uint8_t mmask = cctype_digit;
+    expch = 'e';
+    // Get the mask of mantissa digits and tell which character initiates the exponent.
+    if(reader.peek(tlen) == '0') {
+      sink.push_back(reader.peek(tlen));
+      tlen++;
+      // Check the radix identifier.
+      if(::rocket::is_any_of(static_cast<uint8_t>(reader.peek(tlen) | 0x20), { 'b', 'x' })) {
+        sink.push_back(reader.peek(tlen));
+        tlen++;
+        // Accept the radix identifier.
+        mmask = cctype_xdigit;
+        expch = 'p';
       }
-      if(qstr->front() == 'I') {
-        // Accept a `Number` of value `Infinity`.
-        return ::std::numeric_limits<V_real>::infinity();
-      }
-      if(qstr->front() == 'N') {
-        // Accept a `Number` of value `NaN`.
-        return ::std::numeric_limits<V_real>::quiet_NaN();
+    }
+    // Accept the longest string composing the integral part.
+    do_collect_digits(sink, reader, tlen, mmask);
+    // Check for a radix point. If one exists, the fractional part shall follow.
+    if(reader.peek(tlen) == '.') {
+      sink.push_back(reader.peek(tlen));
+      tlen++;
+      do_collect_digits(sink, reader, tlen, mmask);
+    }
+    // Check for the exponent.
+    if(static_cast<uint8_t>(reader.peek(tlen) | 0x20) == expch) {
+      sink.push_back(reader.peek(tlen));
+      tlen++;
+      // Check for an optional sign symbol.
+      if(::rocket::is_any_of(reader.peek(tlen), { '+', '-' })) {
+        sink.push_back(reader.peek(tlen));
+        tlen++;
       }
-      // Accept an explicit `null`.
-      return nullptr;
+      do_collect_digits(sink, reader, tlen, cctype_digit);
     }
-    return nullopt;
+    // Accept numeric suffixes, which will definitely cause errors.
+    do_collect_digits(sink, reader, tlen, cctype_alpha | cctype_digit);
+    return tlen;
+  }
+
+V_real
+do_accept_slow_number(Text_Reader& reader)
+  {
+    cow_string tstr;
+    uint8_t expch;
+    size_t tlen = do_collect_number(tstr, reader, expch);
+    // Convert the token to a real.
+    ::rocket::ascii_numget numg;
+    const char* bp = tstr.c_str();
+    const char* ep = bp + tstr.size();
+    if(!numg.parse_F(bp, ep))
+      throw Parser_Error(parser_status_numeric_literal_invalid, reader.tell(), tlen);
+
+    if(bp != ep)
+      throw Parser_Error(parser_status_numeric_literal_suffix_invalid, reader.tell(), tlen);
+
+    V_real val;
+    numg.cast_F(val, -DBL_MAX, DBL_MAX);
+    if(numg.overflowed())
+      throw Parser_Error(parser_status_real_literal_overflow, reader.tell(), tlen);
+
+    if(numg.underflowed())
+      throw Parser_Error(parser_status_real_literal_underflow, reader.tell(), tlen);
+
+    if(!numg)
+      throw Parser_Error(parser_status_numeric_literal_invalid, reader.tell(), tlen);
+
+    // `ascii_numget` may be off by an ULP, so decimal numbers are converted again with
+    // `strtod()`, which is correctly rounded. The C locale ensures the radix point is `.`.
+    if(expch == 'e') {
+      static const ::locale_t s_c_locale = ::newlocale(LC_ALL_MASK, "C", nullptr);
+      if(s_c_locale)
+        val = ::strtod_l(tstr.c_str(), nullptr, s_c_locale);
+    }
+    reader.consume(tlen);
+    return val;
+  }
+
+optV_real
+do_accept_number_opt(Text_Reader& reader)
+  {
+    reader.skip_spaces_and_comments();
+    size_t tlen = ::rocket::is_any_of(reader.peek(), { '+', '-' });
+    if(is_cctype(reader.peek(tlen), cctype_digit)) {
+      // Accept a number literal, which may start with a sign symbol.
+      auto qval = do_accept_fast_number_opt(reader);
+      if(qval) {
+        return *qval;
+      }
+      return do_accept_slow_number(reader);
+    }
+    if(tlen == 0) {
+      return nullopt;
+    }
+    // Only `Infinity` and `NaN` are allowed to follow a standalone sign symbol. As in the
+    // lexer, spaces and comments may come in between.
+    Text_Reader saved = reader;
+    V_real sign = (reader.peek() == '-') ? -1.0 : +1.0;
+    reader.consume(1);
+    reader.skip_spaces_and_comments();
+    tlen = do_get_identifier_length(reader);
+    if((tlen == 8) && (::std::memcmp(reader.data(), "Infinity", 8) == 0)) {
+      reader.consume(tlen);
+      // Accept a signed `Infinity`.
+      return ::std::copysign(::std::numeric_limits<V_real>::infinity(), sign);
+    }
+    if((tlen == 3) && (::std::memcmp(reader.data(), "NaN", 3) == 0)) {
+      reader.consume(tlen);
+      // Accept a signed `NaN`.
+      return ::std::copysign(::std::numeric_limits<V_real>::quiet_NaN(), sign);
+    }
+    reader = saved;
+    return nullopt;
+  }
+
+inline
+bool
+do_is_string_word_plain(uint64_t word, uint64_t head)
+noexcept
+  {
+    // Check whether none of the 8 bytes is a quote mark, a backslash, an LF, a null character, or
+    // part of a non-ASCII character. This is a branchless test of each byte being zero.
+    constexpr uint64_t ones = 0x01010101'01010101;
+    constexpr uint64_t highs = ones << 7;
+    uint64_t mask = word & highs;
+    for(uint64_t t : { word, word ^ (head * ones), word ^ ('\\' * ones), word ^ ('\n' * ones) })
+      mask |= (t - ones) & ~t & highs;
+    return mask == 0;
+  }
+
+bool
+do_scan_string_opt(Text_Reader& reader, V_string* qval)
+  {
+    // string-literal ::=
+    //   PCRE("([^\\]|(\\([abfnrtveZ0'"?\\/]|(x[0-9A-Fa-f]{2})|(u[0-9A-Fa-f]{4})|(U[0-9A-Fa-f]{6}))))*?")
+    // The string is decoded into `*qval` if `qval` is not null. Otherwise, it is only checked.
+    reader.skip_spaces_and_comments();
+    char head = reader.peek();
+    if(!::rocket::is_any_of(head, { '\"', '\'' })) {
+      return false;
+    }
+    // Get a string literal.
+    size_t tlen = 1;
+    for(;;) {
+      // Copy plain characters in bulk. Blocks are checked first, then words, then bytes.
+      auto bptr = reader.data(tlen);
+      auto tptr = bptr + do_string_plain_span(bptr, static_cast<size_t>(reader.end() - bptr), head);
+      while(reader.end() - tptr >= 8) {
+        uint64_t word;
+        ::std::memcpy(&word, tptr, 8);
+        if(!do_is_string_word_plain(word, uint8_t(head)))
+          break;
+        tptr += 8;
+      }
+      while((tptr != reader.end()) && !(*tptr & 0x80) &&
+            !::rocket::is_any_of(*tptr, { head, '\\', '\n', '\0' }))
+        tptr++;
+      if(qval)
+        qval->append(bptr, tptr);
+      tlen += static_cast<size_t>(tptr - bptr);
+
+      // Read a character.
+      char next = reader.peek(tlen);
+      if(next == 0) {
+        if((tptr != reader.end()) && (*tptr == '\0'))
+          throw Parser_Error(parser_status_null_character_disallowed, reader.tell(tptr), 1);
+        throw Parser_Error(parser_status_string_literal_unclosed, reader.tell(), tlen);
+      }
+      if(next & 0x80) {
+        // Validate and copy a UTF-8 sequence.
+        char32_t cp;
+        if(!utf8_decode(cp, tptr, static_cast<size_t>(reader.end() - tptr)) || (cp == 0))
+          throw Parser_Error(parser_status_utf8_sequence_invalid, reader.tell(reader.data(tlen)), 1);
+        if(qval)
+          qval->append(reader.data(tlen), tptr);
+        tlen = static_cast<size_t>(tptr - reader.data());
+        continue;
+      }
+      tlen++;
+
+      // Check it.
+      if(next == head) {
+        // The end of this string is encountered. Finish.
+        break;
+      }
+
+      // Translate this escape sequence.
+      // Read the next charactter.
+      next = reader.peek(tlen);
+      if(next == 0)
+        throw Parser_Error(parser_status_escape_sequence_incomplete, reader.tell(), tlen);
+
+      tlen++;
+
+      // Translate it.
+      char temp[8];
+      char* tend = temp;
+      int xcnt = 0;
+      switch(next) {
+        case '\'':
+        case '\"':
+        case '\\':
+        case '?':
+        case '/':
+          *(tend++) = next;
+          break;
+
+        case 'a':
+          *(tend++) = '\a';
+          break;
+
+        case 'b':
+          *(tend++) = '\b';
+          break;
+
+        case 'f':
+          *(tend++) = '\f';
+          break;
+
+        case 'n':
+          *(tend++) = '\n';
+          break;
+
+        case 'r':
+          *(tend++) = '\r';
+          break;
+
+        case 't':
+          *(tend++) = '\t';
+          break;
+
+        case 'v':
+          *(tend++) = '\v';
+          break;
+
+        case '0':
+          *(tend++) = '\0';
+          break;
+
+        case 'Z':
+          *(tend++) = '\x1A';
+          break;
+
+        case 'e':
+          *(tend++) = '\x1B';
+          break;
+
+        case 'U':
+          xcnt += 2;
+          // Fallthrough
+        case 'u':
+          xcnt += 2;
+          // Fallthrough
+        case 'x': {
+          // How many hex digits are there?
+          xcnt += 2;
+          // Read hex digits.
+          char32_t cp = 0;
+          for(int i = 0;  i < xcnt;  ++i) {
+            // Read a hex digit.
+            char c = reader.peek(tlen);
+            if(c == 0)
+              throw Parser_Error(parser_status_escape_sequence_incomplete, reader.tell(), tlen);
+
+            if(!is_cctype(c, cctype_xdigit))
+              throw Parser_Error(parser_status_escape_sequence_invalid_hex, reader.tell(), tlen);
+
+            tlen++;
+            // Accumulate this digit.
+            cp *= 16;
+            cp += static_cast<uint32_t>((c <= '9') ? (c - '0') : ((c | 0x20) - 'a' + 10));
+          }
+          if(next == 'x') {
+            // Write the character verbatim.
+            *(tend++) = static_cast<char>(cp);
+            break;
+          }
+          // Write a Unicode code point.
+          if(!utf8_encode(tend, cp))
+            throw Parser_Error(parser_status_escape_utf_code_point_invalid, reader.tell(), tlen);
+
+          break;
+        }
+
+        default:
+          throw Parser_Error(parser_status_escape_sequence_unknown, reader.tell(), tlen);
+      }
+      if(qval)
+        qval->append(temp, tend);
+    }
+    reader.consume(tlen);
+    return true;
   }
 
 optV_string
-do_accept_key_opt(Token_Stream& tstrm)
+do_accept_string_opt(Text_Reader& reader)
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok) {
+    V_string val;
+    if(!do_scan_string_opt(reader, &val))
       return nullopt;
+    return ::std::move(val);
+  }
+
+opt<Value>
+do_accept_scalar_opt(Text_Reader& reader)
+  {
+    auto qnum = do_accept_number_opt(reader);
+    if(qnum) {
+      // Accept a `Number`.
+      return *qnum;
+    }
+    auto qstr = do_accept_string_opt(reader);
+    if(qstr) {
+      // Accept a `String`.
+      return ::std::move(*qstr);
+    }
+    size_t tlen = do_get_identifier_length(reader);
+    if(tlen == 4) {
+      if(::std::memcmp(reader.data(), "true", 4) == 0) {
+        reader.consume(tlen);
+        // Accept a `Boolean` of value `true`.
+        return true;
+      }
+      if(::std::memcmp(reader.data(), "null", 4) == 0) {
+        reader.consume(tlen);
+        // Accept an explicit `null`.
+        return nullptr;
+      }
+    }
+    if((tlen == 5) && (::std::memcmp(reader.data(), "false", 5) == 0)) {
+      reader.consume(tlen);
+      // Accept a `Boolean` of value `false`.
+      return false;
+    }
+    if((tlen == 8) && (::std::memcmp(reader.data(), "Infinity", 8) == 0)) {
+      reader.consume(tlen);
+      // Accept a `Number` of value `Infinity`.
+      return ::std::numeric_limits<V_real>::infinity();
     }
-    if(qtok->is_identifier()) {
-      auto name = qtok->as_identifier();
-      tstrm.shift();
+    if((tlen == 3) && (::std::memcmp(reader.data(), "NaN", 3) == 0)) {
+      reader.consume(tlen);
+      // Accept a `Number` of value `NaN`.
+      return ::std::numeric_limits<V_real>::quiet_NaN();
+    }
+    return nullopt;
+  }
+
+optV_string
+do_accept_key_opt(Text_Reader& reader, String_Pool& keys)
+  {
+    reader.skip_spaces_and_comments();
+    size_t tlen = do_get_identifier_length(reader);
+    if(tlen != 0) {
+      auto name = cow_string(reader.data(), tlen);
+      reader.consume(tlen);
       // Identifiers are allowed unquoted in JSON5.
-      return V_string(::std::move(name));
+      return keys.intern(name).rdstr();
     }
-    if(qtok->is_string_literal()) {
-      auto val = qtok->as_string_literal();
-      tstrm.shift();
-      // This string literal can be copied as is in UTF-8.
-      return V_string(::std::move(val));
+    auto qstr = do_accept_string_opt(reader);
+    if(qstr) {
+      // Keys are interned, as the same keys tend to appear many times.
+      return keys.intern(*qstr).rdstr();
     }
     return nullopt;
   }
 
+class Number_Checker
+  {
+  private:
+    enum State : uint8_t
+      {
+        state_start,       // nothing, or a sign
+        state_zero,        // a leading zero, which may start a radix identifier
+        state_int_empty,   // a radix identifier
+        state_int,         // digits of the integral part
+        state_frac_empty,  // a radix point
+        state_frac,        // digits of the fractional part
+        state_exp_empty,   // an exponent initiator, optionally followed by a sign
+        state_exp,         // digits of the exponent
+        state_suffix,      // a valid number followed by an invalid suffix
+        state_invalid,
+      };
+
+    State m_state = state_start;
+    uint8_t m_base = 10;
+    bool m_exp_sign = false;
+
+  public:
+    // This accepts characters in the same way as `ascii_numget::parse_F()`, but the value
+    // is not calculated, so range errors are not detected.
+    void
+    push_back(char c)
+    noexcept
+      {
+        if(this->m_state == state_start) {
+          if((c == '+') || (c == '-'))
+            return;
+          if(c == '0') {
+            this->m_state = state_zero;
+            return;
+          }
+          this->m_state = state_int_empty;
+        }
+        else if(this->m_state == state_zero) {
+          if(::rocket::is_any_of(static_cast<char>(c | 0x20), { 'b', 'x' })) {
+            this->m_base = ((c | 0x20) == 'b') ? 2 : 16;
+            this->m_state = state_int_empty;
+            return;
+          }
+          // The zero is a digit of the integral part.
+          this->m_state = state_int;
+        }
+
+        int dval = 99;
+        if(is_cctype(c, cctype_digit))
+          dval = c - '0';
+        else if(is_cctype(c, cctype_xdigit))
+          dval = (c | 0x20) - 'a' + 10;
+
+        bool is_exp = (c | 0x20) == ((this->m_base == 10) ? 'e' : 'p');
+        if((this->m_state == state_int_empty) || (this->m_state == state_int)) {
+          if(dval < this->m_base)
+            this->m_state = state_int;
+          else if(this->m_state == state_int_empty)
+            this->m_state = state_invalid;
+          else if(c == '.')
+            this->m_state = state_frac_empty;
+          else
+            this->m_state = is_exp ? state_exp_empty : state_suffix;
+        }
+        else if((this->m_state == state_frac_empty) || (this->m_state == state_frac)) {
+          if(dval < this->m_base)
+            this->m_state = state_frac;
+          else if(this->m_state == state_frac_empty)
+            this->m_state = state_invalid;
+          else
+            this->m_state = is_exp ? state_exp_empty : state_suffix;
+        }
+        else if(this->m_state == state_exp_empty) {
+          if(dval < 10)
+            this->m_state = state_exp;
+          else if(!this->m_exp_sign && ((c == '+') || (c == '-')))
+            this->m_exp_sign = true;
+          else
+            this->m_state = state_invalid;
+        }
+        else if(this->m_state == state_exp) {
+          if(dval >= 10)
+            this->m_state = state_suffix;
+        }
+      }
+
+    // Returns `parser_status_success` if the number is valid, or the error otherwise.
+    Parser_Status
+    status()
+    const noexcept
+      {
+        if(::rocket::is_any_of(this->m_state, { state_zero, state_int, state_frac, state_exp }))
+          return parser_status_success;
+        if(this->m_state == state_suffix)
+          return parser_status_numeric_literal_suffix_invalid;
+        return parser_status_numeric_literal_invalid;
+      }
+  };
+
+bool
+do_skip_number_opt(Text_Reader& reader)
+  {
+    reader.skip_spaces_and_comments();
+    size_t tlen = ::rocket::is_any_of(reader.peek(), { '+', '-' });
+    if(!is_cctype(reader.peek(tlen), cctype_digit)) {
+      // `Infinity` and `NaN` are not decoded anyway.
+      return static_cast<bool>(do_accept_number_opt(reader));
+    }
+    // Check the literal without calculating its value.
+    Number_Checker checker;
+    uint8_t expch;
+    tlen = do_collect_number(checker, reader, expch);
+    if(checker.status() != parser_status_success)
+      throw Parser_Error(checker.status(), reader.tell(), tlen);
+    reader.consume(tlen);
+    return true;
+  }
+
+void
+do_skip_scalar(Text_Reader& reader)
+  {
+    // Check a scalar value without decoding it.
+    if(do_skip_number_opt(reader)) {
+      return;
+    }
+    if(do_scan_string_opt(reader, nullptr)) {
+      return;
+    }
+    size_t tlen = do_get_identifier_length(reader);
+    for(auto word : { "true", "false", "null", "Infinity", "NaN" })
+      if((tlen == ::std::strlen(word)) && (::std::memcmp(reader.data(), word, tlen) == 0)) {
+        reader.consume(tlen);
+        return;
+      }
+    do_throw_parser_error(reader, parser_status_expression_expected);
+  }
+
+bool
+do_skip_key_opt(Text_Reader& reader)
+  {
+    // Check a key without interning it.
+    reader.skip_spaces_and_comments();
+    size_t tlen = do_get_identifier_length(reader);
+    if(tlen != 0) {
+      reader.consume(tlen);
+      return true;
+    }
+    return do_scan_string_opt(reader, nullptr);
+  }
+
 struct S_xparse_array
   {
     V_array array;
@@ -591,17 +1993,18 @@ struct S_xparse_object
 using Xparse = variant<S_xparse_array, S_xparse_object>;
 
 Value
-do_json_parse_nonrecursive(Token_Stream& tstrm)
+do_json_parse_nonrecursive(Text_Reader& reader)
   {
     Value value;
     // Implement a recursive descent parser without recursion.
     cow_vector<Xparse> stack;
+    String_Pool keys;
     for(;;) {
       // Accept a leaf value. No other things such as closed brackets are allowed.
-      auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_op, punctuator_brace_op });
-      if(kpunct == punctuator_bracket_op) {
+      auto kpunct = do_accept_punctuator_opt(reader, { '[', '{' });
+      if(kpunct == '[') {
         // An open bracket has been accepted.
-        kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl });
+        kpunct = do_accept_punctuator_opt(reader, { ']' });
         if(!kpunct) {
           // Descend into the new array.
           S_xparse_array ctxa = { nullopt };
@@ -611,19 +2014,18 @@ do_json_parse_nonrecursive(Token_Stream& tstrm)
         // Accept an empty array.
         value = V_array();
       }
-      else if(kpunct == punctuator_brace_op) {
+      else if(kpunct == '{') {
         // An open brace has been accepted.
-        kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl });
+        kpunct = do_accept_punctuator_opt(reader, { '}' });
         if(!kpunct) {
           // A key followed by a colon is expected.
-          auto qkey = do_accept_key_opt(tstrm);
+          auto qkey = do_accept_key_opt(reader, keys);
           if(!qkey) {
-            throw Parser_Error(parser_status_closed_brace_or_json5_key_expected, tstrm.next_sloc(),
-                               tstrm.next_length());
+            do_throw_parser_error(reader, parser_status_closed_brace_or_json5_key_expected);
           }
-          kpunct = do_accept_punctuator_opt(tstrm, { punctuator_colon });
+          kpunct = do_accept_punctuator_opt(reader, { ':' });
           if(!kpunct) {
-            throw Parser_Error(parser_status_colon_expected, tstrm.next_sloc(), tstrm.next_length());
+            do_throw_parser_error(reader, parser_status_colon_expected);
           }
           // Descend into a new object.
           S_xparse_object ctxo = { nullopt, ::std::move(*qkey) };
@@ -635,9 +2037,9 @@ do_json_parse_nonrecursive(Token_Stream& tstrm)
       }
       else {
         // Just accept a scalar value which is never recursive.
-        auto qvalue = do_accept_scalar_opt(tstrm);
+        auto qvalue = do_accept_scalar_opt(reader);
         if(!qvalue) {
-          throw Parser_Error(parser_status_expression_expected, tstrm.next_sloc(), tstrm.next_length());
+          do_throw_parser_error(reader, parser_status_expression_expected);
         }
         value = ::std::move(*qvalue);
       }
@@ -652,12 +2054,12 @@ do_json_parse_nonrecursive(Token_Stream& tstrm)
           // Append the value to its parent array.
           ctxa.array.emplace_back(::std::move(value));
           // Look for the next element.
-          kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl, punctuator_comma });
+          kpunct = do_accept_punctuator_opt(reader, { ']', ',' });
           if(!kpunct) {
-            throw Parser_Error(parser_status_comma_expected, tstrm.next_sloc(), tstrm.next_length());
+            do_throw_parser_error(reader, parser_status_comma_expected);
           }
-          if(*kpunct == punctuator_comma) {
-            kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl });
+          if(*kpunct == ',') {
+            kpunct = do_accept_punctuator_opt(reader, { ']' });
             if(!kpunct) {
               // The next element is expected to follow the comma.
               break;
@@ -672,23 +2074,21 @@ do_json_parse_nonrecursive(Token_Stream& tstrm)
           // Insert the value into its parent object.
           ctxo.object.insert_or_assign(::std::move(ctxo.key), ::std::move(value));
           // Look for the next element.
-          kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl, punctuator_comma });
+          kpunct = do_accept_punctuator_opt(reader, { '}', ',' });
           if(!kpunct) {
-            throw Parser_Error(parser_status_closed_brace_or_comma_expected, tstrm.next_sloc(),
-                               tstrm.next_length());
+            do_throw_parser_error(reader, parser_status_closed_brace_or_comma_expected);
           }
-          if(*kpunct == punctuator_comma) {
-            kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl });
+          if(*kpunct == ',') {
+            kpunct = do_accept_punctuator_opt(reader, { '}' });
             if(!kpunct) {
               // The next key is expected to follow the comma.
-              auto qkey = do_accept_key_opt(tstrm);
+              auto qkey = do_accept_key_opt(reader, keys);
               if(!qkey) {
-                throw Parser_Error(parser_status_closed_brace_or_json5_key_expected, tstrm.next_sloc(),
-                                   tstrm.next_length());
+                do_throw_parser_error(reader, parser_status_closed_brace_or_json5_key_expected);
               }
-              kpunct = do_accept_punctuator_opt(tstrm, { punctuator_colon });
+              kpunct = do_accept_punctuator_opt(reader, { ':' });
               if(!kpunct) {
-                throw Parser_Error(parser_status_colon_expected, tstrm.next_sloc(), tstrm.next_length());
+                do_throw_parser_error(reader, parser_status_colon_expected);
               }
               ctxo.key = ::std::move(*qkey);
               // The next value is expected to follow the colon.
@@ -704,68 +2104,1453 @@ do_json_parse_nonrecursive(Token_Stream& tstrm)
     }
   }
 
-}  // namespace
+inline
+bool
+do_is_scalar_char(char c)
+noexcept
+  {
+    // Numbers and keywords consist of these characters.
+    return is_cctype(c, cctype_alpha | cctype_digit) || ::rocket::is_any_of(c, { '_', '$', '+', '-', '.', '`' });
+  }
+
+struct S_xevent
+  {
+    char close;  // `]` or `}`
+    bool quiet;  // whether events are suppressed
+  };
+
+bool
+do_emit_event(Global_Context& global, const V_function& callback, const char* event,
+              Value&& value = V_null())
+  {
+    // Prepare arguments for the user-defined function.
+    cow_vector<Reference> args;
+    args.reserve(2);
+    Reference_root::S_temporary xref_event = { V_string(::rocket::sref(event)) };
+    args.emplace_back(::std::move(xref_event));
+    Reference_root::S_temporary xref_value = { ::std::move(value) };
+    args.emplace_back(::std::move(xref_value));
+    // Call the function. The enclosing subtree is skipped if it returns `false`.
+    auto self = callback.invoke(global, ::std::move(args));
+    if(self.is_void())
+      return true;
+    const auto& result = self.read();
+    return !result.is_boolean() || result.as_boolean();
+  }
+
+bool
+do_accept_key_event(Text_Reader& reader, String_Pool& keys, Global_Context& global,
+                    const V_function& callback, bool quiet)
+  {
+    // Accept a key followed by a colon. If the enclosing object is being skipped, the key is
+    // checked without being interned. Returns whether its value shall be reported.
+    optV_string qkey;
+    if(!quiet)
+      qkey = do_accept_key_opt(reader, keys);
+    if(quiet ? !do_skip_key_opt(reader) : !qkey) {
+      do_throw_parser_error(reader, parser_status_closed_brace_or_json5_key_expected);
+    }
+    auto kpunct = do_accept_punctuator_opt(reader, { ':' });
+    if(!kpunct) {
+      do_throw_parser_error(reader, parser_status_colon_expected);
+    }
+    return !quiet && do_emit_event(global, callback, "key", ::std::move(*qkey));
+  }
+
+void
+do_json_parse_events_nonrecursive(Text_Reader& reader, Global_Context& global,
+                                  const V_function& callback)
+  {
+    // This has the same structure as `do_json_parse_nonrecursive()`, but nothing other than
+    // scalar values is materialized. `quiet` is set when the current value shall be skipped.
+    cow_vector<S_xevent> stack;
+    String_Pool keys;
+    bool quiet = false;
+    for(;;) {
+      // Accept a leaf value. No other things such as closed brackets are allowed.
+      auto kpunct = do_accept_punctuator_opt(reader, { '[', '{' });
+      if(kpunct == '[') {
+        // An open bracket has been accepted.
+        quiet = quiet || !do_emit_event(global, callback, "start_array");
+        kpunct = do_accept_punctuator_opt(reader, { ']' });
+        if(!kpunct) {
+          // Descend into the new array.
+          S_xevent ctx = { ']', quiet };
+          stack.emplace_back(ctx);
+          continue;
+        }
+        // Accept an empty array.
+        if(!quiet)
+          do_emit_event(global, callback, "end_array");
+      }
+      else if(kpunct == '{') {
+        // An open brace has been accepted.
+        quiet = quiet || !do_emit_event(global, callback, "start_object");
+        kpunct = do_accept_punctuator_opt(reader, { '}' });
+        if(!kpunct) {
+          // Descend into a new object.
+          S_xevent ctx = { '}', quiet };
+          stack.emplace_back(ctx);
+          // A key followed by a colon is expected.
+          quiet = !do_accept_key_event(reader, keys, global, callback, quiet);
+          continue;
+        }
+        // Accept an empty object.
+        if(!quiet)
+          do_emit_event(global, callback, "end_object");
+      }
+      else {
+        // Just accept a scalar value which is never recursive.
+        if(quiet) {
+          // Check it without decoding it.
+          do_skip_scalar(reader);
+        }
+        else {
+          auto qvalue = do_accept_scalar_opt(reader);
+          if(!qvalue) {
+            do_throw_parser_error(reader, parser_status_expression_expected);
+          }
+          do_emit_event(global, callback, "scalar", ::std::move(*qvalue));
+        }
+      }
+      // Return to the parent array or object.
+      for(;;) {
+        if(stack.empty()) {
+          // The root value has been accepted.
+          return;
+        }
+        const auto& ctx = stack.back();
+        quiet = ctx.quiet;
+        if(ctx.close == ']') {
+          // Look for the next element.
+          kpunct = do_accept_punctuator_opt(reader, { ']', ',' });
+          if(!kpunct) {
+            do_throw_parser_error(reader, parser_status_comma_expected);
+          }
+          if(*kpunct == ',') {
+            kpunct = do_accept_punctuator_opt(reader, { ']' });
+            if(!kpunct) {
+              // The next element is expected to follow the comma.
+              break;
+            }
+            // An extra comma is allowed in JSON5.
+          }
+          // Pop the array.
+          if(!quiet)
+            do_emit_event(global, callback, "end_array");
+        }
+        else {
+          // Look for the next element.
+          kpunct = do_accept_punctuator_opt(reader, { '}', ',' });
+          if(!kpunct) {
+            do_throw_parser_error(reader, parser_status_closed_brace_or_comma_expected);
+          }
+          if(*kpunct == ',') {
+            kpunct = do_accept_punctuator_opt(reader, { '}' });
+            if(!kpunct) {
+              // The next key is expected to follow the comma.
+              quiet = !do_accept_key_event(reader, keys, global, callback, quiet);
+              // The next value is expected to follow the colon.
+              break;
+            }
+            // An extra comma is allowed in JSON5.
+          }
+          // Pop the object.
+          if(!quiet)
+            do_emit_event(global, callback, "end_object");
+        }
+        stack.pop_back();
+      }
+    }
+  }
+
+class JSON_Stream_Parser
+final
+  : public Abstract_Opaque
+  {
+  private:
+    enum Scan_Mode : uint8_t
+      {
+        scan_mode_normal         = 0,
+        scan_mode_string         = 1,
+        scan_mode_line_comment   = 2,
+        scan_mode_block_comment  = 3,
+        scan_mode_scalar         = 4,
+      };
+
+    struct Frame
+      {
+        size_t bpos;  // beginning of value
+        size_t epos;  // end of value
+        int line;
+        int column;
+      };
+
+    // This is the pending text, which begins with the first value that has not been parsed.
+    cow_string m_buf;
+    // These are complete top-level values that have been found but not parsed yet.
+    cow_vector<Frame> m_frames;
+    size_t m_fnext = 0;
+
+    // These describe the value being scanned.
+    size_t m_scan = 0;  // offset of the next character to scan
+    size_t m_vbeg = SIZE_MAX;  // beginning of the current value, or `SIZE_MAX` if none
+    int m_vline = 0;
+    int m_vcolumn = 0;
+    size_t m_depth = 0;  // number of open brackets and braces
+    Scan_Mode m_mode = scan_mode_normal;
+    Scan_Mode m_cret = scan_mode_normal;  // mode to return to after a comment
+    char m_quote = 0;  // delimiter of the current string
+    bool m_escape = false;  // whether the previous character was a backslash
+    bool m_sign = false;  // whether the current scalar consists of a sign only
+    bool m_cval = false;  // whether the current comment is inside a value
+    int m_line = 1;  // line number of `m_scan`
+    ptrdiff_t m_lbeg = 0;  // offset of the beginning of the current line
+
+  private:
+    void
+    do_begin_value(size_t pos)
+      {
+        if(this->m_vbeg != SIZE_MAX)
+          return;
+        this->m_vbeg = pos;
+        this->m_vline = this->m_line;
+        this->m_vcolumn = static_cast<int>(static_cast<ptrdiff_t>(pos) - this->m_lbeg);
+      }
+
+    void
+    do_end_value(size_t pos)
+      {
+        Frame frame = { this->m_vbeg, pos, this->m_vline, this->m_vcolumn };
+        this->m_frames.emplace_back(frame);
+        this->m_vbeg = SIZE_MAX;
+      }
+
+    void
+    do_begin_comment(size_t pos, Scan_Mode mode)
+      {
+        // A top-level comment is kept only until it ends, so it can be diagnosed at the end of
+        // input if it is not closed.
+        this->m_cret = this->m_mode;
+        this->m_cval = this->m_vbeg != SIZE_MAX;
+        this->do_begin_value(pos);
+        this->m_mode = mode;
+      }
+
+    void
+    do_end_comment()
+      {
+        this->m_mode = this->m_cret;
+        if(!this->m_cval)
+          this->m_vbeg = SIZE_MAX;
+      }
+
+    void
+    do_compact()
+      {
+        // Discard values that have been parsed, as well as spaces between values.
+        size_t base = ::rocket::min(this->m_vbeg, this->m_scan);
+        if(this->m_fnext != this->m_frames.size())
+          base = this->m_frames[this->m_fnext].bpos;
+        this->m_frames.erase(0, this->m_fnext);
+        this->m_fnext = 0;
+        if(base == 0)
+          return;
+
+        this->m_buf.erase(0, base);
+        for(size_t k = 0;  k != this->m_frames.size();  ++k) {
+          auto& frame = this->m_frames.mut(k);
+          frame.bpos -= base;
+          frame.epos -= base;
+        }
+        if(this->m_vbeg != SIZE_MAX)
+          this->m_vbeg -= base;
+        this->m_scan -= base;
+        this->m_lbeg -= static_cast<ptrdiff_t>(base);
+      }
+
+    bool
+    do_scan()
+      {
+        // Find the end of the next top-level value, which may be split between chunks.
+        size_t nframes = this->m_frames.size();
+        size_t pos = this->m_scan;
+        while((pos != this->m_buf.size()) && (this->m_frames.size() == nframes)) {
+          char c = this->m_buf[pos];
+          if((this->m_mode == scan_mode_scalar) && !do_is_scalar_char(c)) {
+            // A sign may be followed by `Infinity` or `NaN` after spaces and comments, so it
+            // does not end there. Otherwise, this character ends the current scalar.
+            if(!this->m_sign || !((c == '\n') || (c == '/') || is_cctype(c, cctype_space))) {
+              this->m_mode = scan_mode_normal;
+              this->do_end_value(pos);
+              continue;
+            }
+          }
+          if(c == '\n') {
+            // Start a new line.
+            this->m_line++;
+            this->m_lbeg = static_cast<ptrdiff_t>(pos + 1);
+          }
+
+          switch(this->m_mode) {
+            case scan_mode_string:
+              // Newlines are not allowed in strings. Let the parser diagnose them.
+              if(c == '\n') {
+                this->m_mode = scan_mode_normal;
+                if(this->m_depth == 0)
+                  this->do_end_value(pos);
+              }
+              else if(this->m_escape)
+                this->m_escape = false;
+              else if(c == '\\')
+                this->m_escape = true;
+              else if(c == this->m_quote) {
+                this->m_mode = scan_mode_normal;
+                if(this->m_depth == 0)
+                  this->do_end_value(pos + 1);
+              }
+              pos++;
+              continue;
+
+            case scan_mode_line_comment:
+              if(c == '\n')
+                this->do_end_comment();
+              pos++;
+              continue;
+
+            case scan_mode_block_comment:
+              if(c != '*') {
+                pos++;
+                continue;
+              }
+              if(pos + 1 == this->m_buf.size()) {
+                // Wait for the next character.
+                this->m_scan = pos;
+                return false;
+              }
+              if(this->m_buf[pos + 1] == '/') {
+                this->do_end_comment();
+                pos++;
+              }
+              pos++;
+              continue;
+
+            case scan_mode_scalar:
+              if(do_is_scalar_char(c)) {
+                // Continue this scalar.
+                this->m_sign = this->m_sign && ::rocket::is_any_of(c, { '+', '-' });
+                pos++;
+                continue;
+              }
+              break;
+
+            case scan_mode_normal:
+              break;
+          }
+
+          if((c == '\n') || is_cctype(c, cctype_space)) {
+            // Skip a space.
+            pos++;
+            continue;
+          }
+          if(c == '/') {
+            // Start a comment, if any.
+            if(pos + 1 == this->m_buf.size()) {
+              // Wait for the next character.
+              this->m_scan = pos;
+              return false;
+            }
+            char n = this->m_buf[pos + 1];
+            if(n == '/') {
+              this->do_begin_comment(pos, scan_mode_line_comment);
+              pos += 2;
+              continue;
+            }
+            if(n == '*') {
+              this->do_begin_comment(pos, scan_mode_block_comment);
+              pos += 2;
+              continue;
+            }
+          }
+          if(this->m_mode == scan_mode_scalar) {
+            // A sign followed by a slash is invalid. Let the parser diagnose it.
+            this->m_mode = scan_mode_normal;
+            this->do_end_value(pos);
+          }
+
+          if((c == '\"') || (c == '\'')) {
+            // Start a string.
+            this->do_begin_value(pos);
+            this->m_mode = scan_mode_string;
+            this->m_quote = c;
+            this->m_escape = false;
+          }
+          else if((c == '[') || (c == '{')) {
+            // Open an array or object.
+            this->do_begin_value(pos);
+            this->m_depth++;
+          }
+          else if(((c == ']') || (c == '}')) && (this->m_depth != 0)) {
+            // Close an array or object.
+            this->m_depth--;
+            if(this->m_depth == 0)
+              this->do_end_value(pos + 1);
+          }
+          else if(this->m_depth != 0) {
+            // Leave other characters in arrays and objects to the parser.
+          }
+          else if(do_is_scalar_char(c)) {
+            // Start a top-level scalar such as a number or keyword.
+            this->do_begin_value(pos);
+            this->m_mode = scan_mode_scalar;
+            this->m_sign = ::rocket::is_any_of(c, { '+', '-' });
+          }
+          else {
+            // This character is invalid. Let the parser diagnose it.
+            this->do_begin_value(pos);
+            this->do_end_value(pos + 1);
+          }
+          pos++;
+        }
+        this->m_scan = pos;
+        return this->m_frames.size() != nframes;
+      }
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "JSON stream parser";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    JSON_Stream_Parser*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override
+      {
+        auto qnew = ::rocket::make_unique<JSON_Stream_Parser>(*this);
+        output.reset(qnew.get());
+        return qnew.release();
+      }
+
+    void
+    feed(const V_string& text)
+      {
+        this->do_compact();
+        this->m_buf.append(text);
+      }
+
+    void
+    finish()
+      {
+        // Find all values that are complete. The last value is probably a number without a
+        // delimiter, or is incomplete, in which case the parser will report the error.
+        while(this->do_scan());
+        size_t bpos = ::rocket::min(this->m_vbeg, this->m_scan);
+        if(bpos != this->m_buf.size()) {
+          this->do_begin_value(bpos);
+          this->do_end_value(this->m_buf.size());
+        }
+        // Reset the scanner. Values that have been found are kept.
+        this->m_scan = this->m_buf.size();
+        this->m_vbeg = SIZE_MAX;
+        this->m_depth = 0;
+        this->m_mode = scan_mode_normal;
+        this->m_line = 1;
+        this->m_lbeg = static_cast<ptrdiff_t>(this->m_scan);
+      }
+
+    template<typename ParseT>
+    bool
+    parse_next(ParseT&& parse)
+      {
+        for(;;) {
+          if(this->m_fnext == this->m_frames.size()) {
+            // Values are scanned one by one, as they are requested.
+            this->m_frames.clear();
+            this->m_fnext = 0;
+            if(!this->do_scan())
+              return false;
+          }
+          // Discard this value before parsing it, so an invalid value will not block others.
+          // The buffer is shared, as `parse` may call `feed()` on this parser.
+          auto frame = this->m_frames[this->m_fnext++];
+          auto text = this->m_buf;
+          Text_Reader reader(text.data() + frame.bpos, text.data() + frame.epos,
+                             frame.line, frame.column);
+          try {
+            reader.skip_spaces_and_comments();
+            if(reader.navail() == 0)
+              continue;
+
+            // Parse a single value.
+            parse(reader);
+            reader.skip_spaces_and_comments();
+            do_check_token_start(reader);
+            if(reader.navail() != 0)
+              ASTERIA_THROW("excess text at end of JSON value");
+            return true;
+          }
+          catch(Parser_Error& except) {
+            ASTERIA_THROW("invalid JSON string: $3 (line $1, offset $2)", except.line(),
+                          except.offset(), describe_parser_status(except.status()));
+          }
+        }
+      }
+  };
+
+template<typename ParserT>
+rcptr<ParserT>
+do_cast_parser(V_opaque& h)
+  {
+    auto qh = h.open_opt<ParserT>();
+    if(!qh)
+      ASTERIA_THROW("invalid dynamic cast to type `$1` from type `$2`",
+                    typeid(ParserT).name(), h.type().name());
+    return qh;
+  }
+
+bool
+do_skip_string_unchecked_opt(Text_Reader& reader)
+  {
+    // Find the end of a string literal without decoding it. Escape sequences and UTF-8 are
+    // checked when it is decoded.
+    char head = reader.peek();
+    if(!::rocket::is_any_of(head, { '\"', '\'' })) {
+      return false;
+    }
+    size_t tlen = 1;
+    for(;;) {
+      auto bptr = reader.data(tlen);
+      auto tptr = bptr + do_string_plain_span(bptr, static_cast<size_t>(reader.end() - bptr), head);
+      tptr = ::std::find_if(tptr, reader.end(),
+                 [&](char c) { return (c == head) || (c == '\\') || (c == '\n');  });
+      tlen += static_cast<size_t>(tptr - bptr);
+
+      // Read a character.
+      char next = reader.peek(tlen);
+      if(next == 0)
+        throw Parser_Error(parser_status_string_literal_unclosed, reader.tell(), tlen);
+      tlen++;
+      if(next == head)
+        break;
+
+      // Skip the character after the backslash.
+      if(reader.peek(tlen) == 0)
+        throw Parser_Error(parser_status_escape_sequence_incomplete, reader.tell(), tlen);
+      tlen++;
+    }
+    reader.consume(tlen);
+    return true;
+  }
+
+void
+do_skip_scalar_unchecked(Text_Reader& reader)
+  {
+    // Find the end of a scalar value without decoding it.
+    reader.skip_spaces_and_comments();
+    if(do_skip_string_unchecked_opt(reader)) {
+      return;
+    }
+    if(::rocket::is_any_of(reader.peek(), { '+', '-' }) && !do_is_scalar_char(reader.peek(1))) {
+      // Only `Infinity` and `NaN` are allowed to follow a standalone sign symbol, which may
+      // be separated by spaces and comments.
+      reader.consume(1);
+      reader.skip_spaces_and_comments();
+    }
+    size_t tlen = 0;
+    while(do_is_scalar_char(reader.peek(tlen)))
+      tlen++;
+    if(tlen == 0)
+      do_throw_parser_error(reader, parser_status_expression_expected);
+    reader.consume(tlen);
+  }
+
+Value
+do_accept_scalar(Text_Reader& reader)
+  {
+    auto qvalue = do_accept_scalar_opt(reader);
+    if(!qvalue)
+      do_throw_parser_error(reader, parser_status_expression_expected);
+    return ::std::move(*qvalue);
+  }
+
+void
+do_skip_key_unchecked(Text_Reader& reader)
+  {
+    reader.skip_spaces_and_comments();
+    size_t tlen = do_get_identifier_length(reader);
+    if(tlen != 0) {
+      reader.consume(tlen);
+      return;
+    }
+    if(!do_skip_string_unchecked_opt(reader))
+      do_throw_parser_error(reader, parser_status_closed_brace_or_json5_key_expected);
+  }
+
+class JSON_Document
+final
+  : public Abstract_Opaque
+  {
+  private:
+    struct Node
+      {
+        char kind;  // `[` for arrays, `{` for objects, `:` for keys, and `=` for scalars
+        size_t bpos;  // offset of the beginning of this node
+        size_t epos;  // offset of the end of this node
+        size_t next;  // index of the node after this one and all its children
+        size_t count;  // number of elements of an array or members of an object
+        size_t first;  // index of the first entry of an array or object
+      };
+
+    struct Entry
+      {
+        size_t hash;  // hash of the key of an object member, or zero for an array element
+        size_t index;  // index of the key node of an object member, or of an array element
+      };
+
+    // The text is not copied. Each member of an object is a key node followed by its value.
+    // Scalars and keys are decoded only when they are accessed.
+    V_string m_text;
+    cow_vector<Node> m_tape;
+    // Entries of each array or object are stored contiguously, so elements can be located
+    // without walking through their siblings. Those of an object are sorted by hash.
+    cow_vector<Entry> m_entries;
+
+  public:
+    explicit
+    JSON_Document(const V_string& text)
+      : m_text(text)
+      { this->do_build_tape();  }
+
+  private:
+    void
+    do_push_node(char kind, const char* bptr)
+      {
+        // Grow the tape geometrically, as there may be a lot of nodes.
+        if(this->m_tape.size() == this->m_tape.capacity())
+          this->m_tape.reserve(this->m_tape.size() * 2 + 15);
+        size_t bpos = static_cast<size_t>(bptr - this->m_text.data());
+        Node node = { kind, bpos, bpos, this->m_tape.size() + 1, 0, 0 };
+        this->m_tape.emplace_back(node);
+      }
+
+    static
+    size_t
+    do_hash_bytes(const char* str, size_t len)
+    noexcept
+      {
+        // This is FNV-1a.
+        uint32_t hash = 0x811C9DC5;
+        for(size_t k = 0;  k != len;  ++k)
+          hash = (hash ^ uint8_t(str[k])) * 0x1000193;
+        return hash;
+      }
+
+    static
+    void
+    do_push_entry(cow_vector<Entry>& pending, size_t hash, size_t index)
+      {
+        if(pending.size() == pending.capacity())
+          pending.reserve(pending.size() * 2 + 15);
+        Entry entry = { hash, index };
+        pending.emplace_back(entry);
+      }
+
+    void
+    do_end_node(size_t index, const char* eptr)
+      {
+        auto& node = this->m_tape.mut(index);
+        node.epos = static_cast<size_t>(eptr - this->m_text.data());
+        node.next = this->m_tape.size();
+      }
+
+    void
+    do_end_container(size_t index, const char* eptr, cow_vector<Entry>& pending)
+      {
+        // Move entries of this array or object from `pending`. Its `first` field holds the
+        // number of pending entries when it was opened.
+        this->do_end_node(index, eptr);
+        auto& node = this->m_tape.mut(index);
+        size_t base = node.first;
+        node.first = this->m_entries.size();
+        if(node.kind == '{') {
+          // If there are duplicate keys, entries with the same hash are ordered by position.
+          ::std::sort(pending.mut_data() + base, pending.mut_data() + pending.size(),
+              [](const Entry& x, const Entry& y) { return (x.hash < y.hash) ||
+                                                          ((x.hash == y.hash) && (x.index < y.index));  });
+        }
+        size_t n = pending.size() - base;
+        if(this->m_entries.capacity() - this->m_entries.size() < n)
+          this->m_entries.reserve(::rocket::max(this->m_entries.size() * 2, this->m_entries.size() + n));
+        this->m_entries.append(pending.data() + base, pending.data() + pending.size());
+        pending.erase(base);
+      }
+
+    void
+    do_accept_key(Text_Reader& reader, cow_vector<Entry>& pending)
+      {
+        reader.skip_spaces_and_comments();
+        this->do_push_node(':', reader.data());
+        do_skip_key_unchecked(reader);
+        this->do_end_node(this->m_tape.size() - 1, reader.data());
+        size_t index = this->m_tape.size() - 1;
+        do_push_entry(pending, this->do_hash_key(this->m_tape[index]), index);
+        if(!do_accept_punctuator_opt(reader, { ':' }))
+          do_throw_parser_error(reader, parser_status_colon_expected);
+      }
+
+    void
+    do_build_tape()
+      try {
+        // This has the same structure as `do_json_parse_nonrecursive()`, but it records
+        // positions of values instead of constructing them.
+        Text_Reader reader(this->m_text);
+        reader.skip_spaces_and_comments();
+        if(reader.navail() == 0)
+          ASTERIA_THROW("empty JSON string");
+
+        // `stack` holds indices of open arrays and objects. `pending` holds entries of them.
+        cow_vector<size_t> stack;
+        cow_vector<Entry> pending;
+        for(;;) {
+          // Accept a leaf value. No other things such as closed brackets are allowed.
+          reader.skip_spaces_and_comments();
+          auto bptr = reader.data();
+          if(!stack.empty() && (this->m_tape[stack.back()].kind == '['))
+            do_push_entry(pending, 0, this->m_tape.size());
+          auto kpunct = do_accept_punctuator_opt(reader, { '[', '{' });
+          if(kpunct) {
+            // An open bracket or brace has been accepted.
+            this->do_push_node(*kpunct, bptr);
+            this->m_tape.mut_back().first = pending.size();
+            kpunct = do_accept_punctuator_opt(reader, { (*kpunct == '[') ? ']' : '}' });
+            if(!kpunct) {
+              // Descend into the new array or object.
+              stack.emplace_back(this->m_tape.size() - 1);
+              if(this->m_tape.back().kind == '{')
+                this->do_accept_key(reader, pending);
+              continue;
+            }
+            // Accept an empty array or object.
+            this->do_end_container(this->m_tape.size() - 1, reader.data(), pending);
+          }
+          else {
+            // Record a scalar value, whose validity is checked when it is decoded.
+            this->do_push_node('=', bptr);
+            do_skip_scalar_unchecked(reader);
+            this->do_end_node(this->m_tape.size() - 1, reader.data());
+          }
+          // Count the value in its parent array or object.
+          for(;;) {
+            if(stack.empty()) {
+              // Accept the root value.
+              reader.skip_spaces_and_comments();
+              do_check_token_start(reader);
+              if(reader.navail() != 0)
+                ASTERIA_THROW("excess text at end of JSON string");
+              return;
+            }
+            size_t index = stack.back();
+            this->m_tape.mut(index).count++;
+            char close = (this->m_tape[index].kind == '[') ? ']' : '}';
+            // Look for the next element.
+            kpunct = do_accept_punctuator_opt(reader, { close, ',' });
+            if(!kpunct) {
+              do_throw_parser_error(reader, (close == ']') ? parser_status_comma_expected
+                                                           : parser_status_closed_brace_or_comma_expected);
+            }
+            if(*kpunct == ',') {
+              kpunct = do_accept_punctuator_opt(reader, { close });
+              if(!kpunct) {
+                // The next element is expected to follow the comma.
+                if(close == '}')
+                  this->do_accept_key(reader, pending);
+                break;
+              }
+              // An extra comma is allowed in JSON5.
+            }
+            // Pop the array or object.
+            this->do_end_container(index, reader.data(), pending);
+            stack.pop_back();
+          }
+        }
+      }
+      catch(Parser_Error& except) {
+        ASTERIA_THROW("invalid JSON string: $3 (line $1, offset $2)", except.line(), except.offset(),
+                                                                      describe_parser_status(except.status()));
+      }
+
+    template<typename DecodeT>
+    auto
+    do_decode(const Node& node, DecodeT&& decode)
+    const
+      -> decltype(decode(::std::declval<Text_Reader&>()))
+      try {
+        Text_Reader reader(this->m_text.data() + node.bpos, this->m_text.data() + node.epos, 1, 0);
+        auto value = decode(reader);
+        reader.skip_spaces_and_comments();
+        do_check_token_start(reader);
+        if(reader.navail() != 0)
+          do_throw_parser_error(reader, parser_status_expression_expected);
+        return value;
+      }
+      catch(Parser_Error& except) {
+        // Calculate the location in the whole text, which is not done unless there is an error.
+        int line = 1;
+        auto lptr = this->m_text.data();
+        auto bptr = this->m_text.data() + node.bpos;
+        for(;;) {
+          auto lf = static_cast<const char*>(::std::memchr(lptr, '\n', static_cast<size_t>(bptr - lptr)));
+          if(!lf)
+            break;
+          lptr = lf + 1;
+          line++;
+        }
+        int offset = except.offset();
+        if(except.line() == 1)
+          offset += static_cast<int>(bptr - lptr);
+        ASTERIA_THROW("invalid JSON string: $3 (line $1, offset $2)", line + except.line() - 1, offset,
+                                                                      describe_parser_status(except.status()));
+      }
+
+    bool
+    do_key_equals(const Node& node, const V_string& key)
+    const
+      {
+        // Compare the key in place if there are no escape sequences.
+        auto bptr = this->m_text.data() + node.bpos;
+        auto eptr = this->m_text.data() + node.epos;
+        if(::rocket::is_any_of(*bptr, { '\"', '\'' })) {
+          bptr++;
+          eptr--;
+          if(::std::find(bptr, eptr, '\\') != eptr) {
+            auto qstr = this->do_decode(node, do_accept_string_opt);
+            return *qstr == key;
+          }
+        }
+        return (key.size() == static_cast<size_t>(eptr - bptr)) &&
+               (::std::memcmp(bptr, key.data(), key.size()) == 0);
+      }
+
+    V_string
+    do_decode_key(const Node& node)
+    const
+      {
+        if(!::rocket::is_any_of(this->m_text[node.bpos], { '\"', '\'' }))
+          return V_string(this->m_text.data() + node.bpos, node.epos - node.bpos);
+        return *(this->do_decode(node, do_accept_string_opt));
+      }
+
+    size_t
+    do_hash_key(const Node& node)
+    const
+      {
+        // Hash the key in place if there are no escape sequences, like `do_key_equals()`.
+        auto bptr = this->m_text.data() + node.bpos;
+        auto eptr = this->m_text.data() + node.epos;
+        if(::rocket::is_any_of(*bptr, { '\"', '\'' })) {
+          bptr++;
+          eptr--;
+          if(::std::find(bptr, eptr, '\\') != eptr) {
+            auto key = this->do_decode_key(node);
+            return do_hash_bytes(key.data(), key.size());
+          }
+        }
+        return do_hash_bytes(bptr, static_cast<size_t>(eptr - bptr));
+      }
+
+    const Node*
+    do_find(const cow_vector<Value>& path)
+    const
+      {
+        size_t index = 0;
+        for(const auto& elem : path) {
+          const auto& node = this->m_tape[index];
+          if(elem.is_integer()) {
+            // Look up an element in an array. Negative subscripts count from the end.
+            if(node.kind != '[')
+              return nullptr;
+            int64_t w = elem.as_integer();
+            if(w < 0)
+              w += static_cast<int64_t>(node.count);
+            if((w < 0) || (w >= static_cast<int64_t>(node.count)))
+              return nullptr;
+            index = this->m_entries[node.first + static_cast<size_t>(w)].index;
+          }
+          else if(elem.is_string()) {
+            // Look up a member in an object. If there are duplicate keys, the last one wins,
+            // as in `std.json.parse()`.
+            if(node.kind != '{')
+              return nullptr;
+            const auto& key = elem.as_string();
+            size_t hash = do_hash_bytes(key.data(), key.size());
+            // Find the end of entries whose hashes are not greater than `hash`.
+            auto bptr = this->m_entries.data() + node.first;
+            auto eptr = bptr + node.count;
+            while(bptr != eptr) {
+              auto mptr = bptr + (eptr - bptr) / 2;
+              if(mptr->hash <= hash)
+                bptr = mptr + 1;
+              else
+                eptr = mptr;
+            }
+            // Entries with the same hash are ordered by position, so search backwards.
+            auto lptr = this->m_entries.data() + node.first;
+            while((eptr != lptr) && (eptr[-1].hash == hash) && !this->do_key_equals(this->m_tape[eptr[-1].index], key))
+              eptr--;
+            if((eptr == lptr) || (eptr[-1].hash != hash))
+              return nullptr;
+            index = eptr[-1].index + 1;
+          }
+          else
+            ASTERIA_THROW("invalid JSON path element (value `$1`)", elem);
+        }
+        return this->m_tape.data() + index;
+      }
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "lazy JSON document";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    JSON_Document*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override
+      {
+        auto qnew = ::rocket::make_unique<JSON_Document>(*this);
+        output.reset(qnew.get());
+        return qnew.release();
+      }
+
+    Value
+    get(const cow_vector<Value>& path)
+    const
+      {
+        auto qnode = this->do_find(path);
+        if(!qnode)
+          return nullptr;
+        // Decode the value, including all its children.
+        if(qnode->kind == '=')
+          return this->do_decode(*qnode, do_accept_scalar);
+        return this->do_decode(*qnode, do_json_parse_nonrecursive);
+      }
+
+    optV_string
+    type(const cow_vector<Value>& path)
+    const
+      {
+        auto qnode = this->do_find(path);
+        if(!qnode)
+          return nullopt;
+        if(qnode->kind == '[')
+          return ::rocket::sref("array");
+        if(qnode->kind == '{')
+          return ::rocket::sref("object");
+        // Decode the scalar to check it.
+        auto value = this->do_decode(*qnode, do_accept_scalar);
+        return ::rocket::sref(describe_vtype(value.vtype()));
+      }
+
+    optV_integer
+    count(const cow_vector<Value>& path)
+    const
+      {
+        auto qnode = this->do_find(path);
+        if(!qnode || (qnode->kind == '='))
+          return nullopt;
+        return static_cast<int64_t>(qnode->count);
+      }
+
+    optV_array
+    keys(const cow_vector<Value>& path)
+    const
+      {
+        auto qnode = this->do_find(path);
+        if(!qnode || (qnode->kind != '{'))
+          return nullopt;
+        V_array keys;
+        keys.reserve(qnode->count);
+        size_t index = static_cast<size_t>(qnode - this->m_tape.data()) + 1;
+        for(size_t k = 0;  k != qnode->count;  ++k) {
+          keys.emplace_back(this->do_decode_key(this->m_tape[index]));
+          index = this->m_tape[index + 1].next;
+        }
+        return ::std::move(keys);
+      }
+  };
+
+rcptr<const JSON_Document>
+do_cast_document(const V_opaque& d)
+  {
+    auto qdoc = d.cast_opt<JSON_Document>();
+    if(!qdoc)
+      ASTERIA_THROW("invalid dynamic cast to type `$1` from type `$2`",
+                    typeid(JSON_Document).name(), d.type().name());
+    return qdoc;
+  }
+
+}  // namespace
+
+V_string
+std_json_format(Value value, optV_string indent)
+  {
+    // No line break is inserted if `indent` is null or empty.
+    return (!indent || indent->empty()) ? do_format_string(value, false, Indenter_none())
+                                        : do_format_string(value, false, Indenter_string(*indent));
+  }
+
+V_string
+std_json_format(Value value, V_integer indent)
+  {
+    // No line break is inserted if `indent` is non-positive.
+    return (indent <= 0) ? do_format_string(value, false, Indenter_none())
+                         : do_format_string(value, false, Indenter_spaces(indent));
+  }
+
+V_string
+std_json_format5(Value value, optV_string indent)
+  {
+    // No line break is inserted if `indent` is null or empty.
+    return (!indent || indent->empty()) ? do_format_string(value, true, Indenter_none())
+                                        : do_format_string(value, true, Indenter_string(*indent));
+  }
+
+V_string
+std_json_format5(Value value, V_integer indent)
+  {
+    // No line break is inserted if `indent` is non-positive.
+    return (indent <= 0) ? do_format_string(value, true, Indenter_none())
+                         : do_format_string(value, true, Indenter_spaces(indent));
+  }
+
+void
+std_json_format_to_file(V_string path, Value value, optV_string indent)
+  {
+    // No line break is inserted if `indent` is null or empty.
+    return (!indent || indent->empty()) ? do_format_file(path, value, false, Indenter_none())
+                                        : do_format_file(path, value, false, Indenter_string(*indent));
+  }
+
+void
+std_json_format_to_file(V_string path, Value value, V_integer indent)
+  {
+    // No line break is inserted if `indent` is non-positive.
+    return (indent <= 0) ? do_format_file(path, value, false, Indenter_none())
+                         : do_format_file(path, value, false, Indenter_spaces(indent));
+  }
+
+void
+std_json_format5_to_file(V_string path, Value value, optV_string indent)
+  {
+    // No line break is inserted if `indent` is null or empty.
+    return (!indent || indent->empty()) ? do_format_file(path, value, true, Indenter_none())
+                                        : do_format_file(path, value, true, Indenter_string(*indent));
+  }
+
+void
+std_json_format5_to_file(V_string path, Value value, V_integer indent)
+  {
+    // No line break is inserted if `indent` is non-positive.
+    return (indent <= 0) ? do_format_file(path, value, true, Indenter_none())
+                         : do_format_file(path, value, true, Indenter_spaces(indent));
+  }
+
+Value
+std_json_parse(V_string text)
+  try {
+    // We accept the same tokens as the lexer of Asteria here, allowing quite a few extensions
+    // e.g. binary numeric literals and comments. Text is scanned in place in a single pass.
+    Text_Reader reader(text);
+    reader.skip_spaces_and_comments();
+    if(reader.navail() == 0)
+      ASTERIA_THROW("empty JSON string");
+
+    // Parse a single value.
+    auto value = do_json_parse_nonrecursive(reader);
+    reader.skip_spaces_and_comments();
+    do_check_token_start(reader);
+    if(reader.navail() != 0)
+      ASTERIA_THROW("excess text at end of JSON string");
+    return value;
+  }
+  catch(Parser_Error& except) {
+    ASTERIA_THROW("invalid JSON string: $3 (line $1, offset $2)", except.line(), except.offset(),
+                                                                  describe_parser_status(except.status()));
+  }
+
+void
+std_json_parse_events(Global_Context& global, V_string text, V_function callback)
+  try {
+    // This is the same as `std_json_parse()`, except that values are reported as events.
+    Text_Reader reader(text);
+    reader.skip_spaces_and_comments();
+    if(reader.navail() == 0)
+      ASTERIA_THROW("empty JSON string");
+
+    // Parse a single value.
+    do_json_parse_events_nonrecursive(reader, global, callback);
+    reader.skip_spaces_and_comments();
+    do_check_token_start(reader);
+    if(reader.navail() != 0)
+      ASTERIA_THROW("excess text at end of JSON string");
+  }
+  catch(Parser_Error& except) {
+    ASTERIA_THROW("invalid JSON string: $3 (line $1, offset $2)", except.line(), except.offset(),
+                                                                  describe_parser_status(except.status()));
+  }
+
+V_opaque
+std_json_parser_new_private()
+  {
+    return ::rocket::make_refcnt<JSON_Stream_Parser>();
+  }
+
+void
+std_json_parser_new_feed(V_opaque& h, V_string text)
+  {
+    do_cast_parser<JSON_Stream_Parser>(h)->feed(text);
+  }
+
+optV_array
+std_json_parser_new_next(V_opaque& h)
+  {
+    V_array result;
+    auto parse = [&](Text_Reader& reader) { result.emplace_back(do_json_parse_nonrecursive(reader));  };
+    if(!do_cast_parser<JSON_Stream_Parser>(h)->parse_next(parse))
+      return nullopt;
+    return ::std::move(result);
+  }
+
+V_boolean
+std_json_parser_new_next_events(Global_Context& global, V_opaque& h, V_function callback)
+  {
+    auto parse = [&](Text_Reader& reader) { do_json_parse_events_nonrecursive(reader, global, callback);  };
+    return do_cast_parser<JSON_Stream_Parser>(h)->parse_next(parse);
+  }
 
-V_string
-std_json_format(Value value, optV_string indent)
+void
+std_json_parser_new_finish(V_opaque& h)
   {
-    // No line break is inserted if `indent` is null or empty.
-    return (!indent || indent->empty()) ? do_format_nonrecursive(value, false, Indenter_none())
-                                        : do_format_nonrecursive(value, false, Indenter_string(*indent));
+    do_cast_parser<JSON_Stream_Parser>(h)->finish();
   }
 
-V_string
-std_json_format(Value value, V_integer indent)
+V_object
+std_json_parser_new()
   {
-    // No line break is inserted if `indent` is non-positive.
-    return (indent <= 0) ? do_format_nonrecursive(value, false, Indenter_none())
-                         : do_format_nonrecursive(value, false, Indenter_spaces(indent));
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$p"),
+      std_json_parser_new_private());
+    //===================================================================
+    // `.feed(text)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("feed"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parser_new().feed(text)`
+
+  * Appends `text` to the input of the parser denoted by `this`.
+    Values, strings, comments and escape sequences may be split
+    between two consecutive chunks.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parser_new().feed"));
+    // Get the parser.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$p") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string text;
+    if(reader.I().v(text).F()) {
+      std_json_parser_new_feed(self.open().open_opaque(), ::std::move(text));
+      return self = Reference_root::S_void();
+    }
+    reader.throw_no_matching_function_call();
   }
+      ));
+    //===================================================================
+    // `.next()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("next"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parser_new().next()`
 
-V_string
-std_json_format5(Value value, optV_string indent)
+  * Parses the next complete value from the input of the parser
+    denoted by `this`. The value is discarded from the input before
+    it is parsed, so an invalid value does not prevent subsequent
+    ones from being parsed.
+
+  * Returns an array of the parsed value as its only element, or
+    `null` if no complete value is available.
+
+  * Throws an exception if the value is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    // No line break is inserted if `indent` is null or empty.
-    return (!indent || indent->empty()) ? do_format_nonrecursive(value, true, Indenter_none())
-                                        : do_format_nonrecursive(value, true, Indenter_string(*indent));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parser_new().next"));
+    // Get the parser.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$p") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_json_parser_new_next(self.open().open_opaque()) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
   }
+      ));
+    //===================================================================
+    // `.next_events()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("next_events"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parser_new().next_events(callback)`
 
-V_string
-std_json_format5(Value value, V_integer indent)
+  * Parses the next complete value from the input of the parser
+    denoted by `this`, reporting it to `callback` as events, like
+    `std.json.parse_events()`. The value is discarded from the input
+    before it is parsed.
+
+  * Returns `true` if a value has been parsed, or `false` if no
+    complete value is available.
+
+  * Throws an exception if the value is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& global) -> Reference&
   {
-    // No line break is inserted if `indent` is non-positive.
-    return (indent <= 0) ? do_format_nonrecursive(value, true, Indenter_none())
-                         : do_format_nonrecursive(value, true, Indenter_spaces(indent));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parser_new().next_events"));
+    // Get the parser.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$p") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_function callback;
+    if(reader.I().v(callback).F()) {
+      Reference_root::S_temporary xref = { std_json_parser_new_next_events(global, self.open().open_opaque(),
+                                                 ::std::move(callback)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.finish()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("finish"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parser_new().finish()`
+
+  * Marks the end of input of the parser denoted by `this`. A value
+    at the end of input that has no delimiter, such as a number, is
+    completed. If the input ends in the middle of a value, the
+    partial value is completed nevertheless, and the error will be
+    reported by `next()`. The parser is then reset, making it
+    suitable for further input as if it had just been created, but
+    values that have not been retrieved are kept.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parser_new().finish"));
+    // Get the parser.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$p") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    if(reader.I().F()) {
+      std_json_parser_new_finish(self.open().open_opaque());
+      return self = Reference_root::S_void();
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.json.parser_new()`
+    //===================================================================
+    return result;
+  }
+
+V_opaque
+std_json_parse_lazy_private(V_string text)
+  {
+    return ::rocket::make_refcnt<JSON_Document>(text);
   }
 
 Value
-std_json_parse(V_string text)
-  try {
-    // We reuse the lexer of Asteria here, allowing quite a few extensions e.g. binary numeric
-    // literals and comments.
-    Compiler_Options opts;
-    opts.escapable_single_quotes = true;
-    opts.keywords_as_identifiers = true;
-    opts.integers_as_reals = true;
-
-    // Tokenize the source string.
-    ::rocket::tinybuf_str cbuf;
-    cbuf.set_string(text, tinybuf::open_read);
-
-    Token_Stream tstrm(opts);
-    tstrm.reload(cbuf, ::rocket::sref("<JSON text>"));
-    if(tstrm.empty())
-      ASTERIA_THROW("empty JSON string");
+std_json_parse_lazy_get(const V_opaque& d, cow_vector<Value> path)
+  {
+    return do_cast_document(d)->get(path);
+  }
 
-    // Parse a single value.
-    auto value = do_json_parse_nonrecursive(tstrm);
-    if(!tstrm.empty())
-      ASTERIA_THROW("excess text at end of JSON string");
-    return value;
+optV_string
+std_json_parse_lazy_type(const V_opaque& d, cow_vector<Value> path)
+  {
+    return do_cast_document(d)->type(path);
   }
-  catch(Parser_Error& except) {
-    ASTERIA_THROW("invalid JSON string: $3 (line $1, offset $2)", except.line(), except.offset(),
-                                                                  describe_parser_status(except.status()));
+
+optV_integer
+std_json_parse_lazy_count(const V_opaque& d, cow_vector<Value> path)
+  {
+    return do_cast_document(d)->count(path);
+  }
+
+optV_array
+std_json_parse_lazy_keys(const V_opaque& d, cow_vector<Value> path)
+  {
+    return do_cast_document(d)->keys(path);
+  }
+
+V_object
+std_json_parse_lazy(V_string text)
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$d"),
+      std_json_parse_lazy_private(::std::move(text)));
+    //===================================================================
+    // `.get(...)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("get"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parse_lazy(text).get(...)`
+
+  * Looks up a value in the document denoted by `this`. Each
+    argument is either a string, which selects a member of an
+    object, or an integer, which selects an element of an array. A
+    negative integer counts from the end. If no argument is given,
+    the root value is selected. The value is decoded, together with
+    all its children.
+
+  * Returns the selected value, or `null` if it does not exist.
+
+  * Throws an exception if the value is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parse_lazy().get"));
+    // Get the document.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$d") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    cow_vector<Value> path;
+    if(reader.I().F(path)) {
+      Reference_root::S_temporary xref = { std_json_parse_lazy_get(self.read().as_opaque(), ::std::move(path)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.type(...)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("type"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parse_lazy(text).type(...)`
+
+  * Looks up a value in the document denoted by `this` like `get()`.
+    Arrays and objects are not decoded.
+
+  * Returns the type of the selected value as a string, like the
+    `typeof` operator, or `null` if it does not exist.
+
+  * Throws an exception if the value is an invalid scalar.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parse_lazy().type"));
+    // Get the document.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$d") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    cow_vector<Value> path;
+    if(reader.I().F(path)) {
+      Reference_root::S_temporary xref = { std_json_parse_lazy_type(self.read().as_opaque(), ::std::move(path)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.count(...)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("count"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parse_lazy(text).count(...)`
+
+  * Looks up a value in the document denoted by `this` like `get()`.
+
+  * Returns the number of elements of the selected array or members
+    of the selected object as an integer, or `null` if it does not
+    exist or is neither an array nor an object.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parse_lazy().count"));
+    // Get the document.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$d") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    cow_vector<Value> path;
+    if(reader.I().F(path)) {
+      Reference_root::S_temporary xref = { std_json_parse_lazy_count(self.read().as_opaque(), ::std::move(path)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.keys(...)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("keys"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parse_lazy(text).keys(...)`
+
+  * Looks up a value in the document denoted by `this` like `get()`.
+    Values of members are not decoded.
+
+  * Returns all keys of the selected object as an array of strings,
+    in the order in which they appear in the text, or `null` if it
+    does not exist or is not an object.
+
+  * Throws an exception if a key is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parse_lazy().keys"));
+    // Get the document.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$d") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    cow_vector<Value> path;
+    if(reader.I().F(path)) {
+      Reference_root::S_temporary xref = { std_json_parse_lazy_keys(self.read().as_opaque(), ::std::move(path)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.json.parse_lazy()`
+    //===================================================================
+    return result;
   }
 
 void
@@ -789,7 +3574,8 @@ create_bindings_json(V_object& result, API_Version /*version*/)
     set to an integer, it is clamped between `0` and `10`
     inclusively and this function behaves as if a string consisting
     of this number of spaces was set. Its default value is an empty
-    string.
+    string. Real numbers are written in a short form that converts
+    back to the same value exactly.
 
   * Returns the formatted text as a string.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
@@ -849,6 +3635,80 @@ create_bindings_json(V_object& result, API_Version /*version*/)
     }
     // Fail.
     reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.json.format_to_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("format_to_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.format_to_file(path, value, [indent])`
+
+  * Converts a value to a string in the JSON format, as if by
+    `format(value, indent)`, and writes it to the file denoted by
+    `path`. The file is created if it does not exist, and is
+    truncated otherwise. Text is written in blocks as it is
+    produced, without building a string for the whole value.
+
+  * Throws an exception if the file could not be opened or written.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.format_to_file"));
+    Argument_Reader::State state;
+    // Parse arguments.
+    V_string path;
+    Value value;
+    optV_string sindent;
+    if(reader.I().v(path).o(value).S(state).o(sindent).F()) {
+      std_json_format_to_file(::std::move(path), ::std::move(value), ::std::move(sindent));
+      return self = Reference_root::S_void();
+    }
+    V_integer nindent;
+    if(reader.L(state).v(nindent).F()) {
+      std_json_format_to_file(::std::move(path), ::std::move(value), ::std::move(nindent));
+      return self = Reference_root::S_void();
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.json.format5_to_file()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("format5_to_file"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.format5_to_file(path, value, [indent])`
+
+  * Converts a value to a string in the JSON5 format, as if by
+    `format5(value, indent)`, and writes it to the file denoted by
+    `path`. The file is created if it does not exist, and is
+    truncated otherwise. Text is written in blocks as it is
+    produced, without building a string for the whole value.
+
+  * Throws an exception if the file could not be opened or written.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.format5_to_file"));
+    Argument_Reader::State state;
+    // Parse arguments.
+    V_string path;
+    Value value;
+    optV_string sindent;
+    if(reader.I().v(path).o(value).S(state).o(sindent).F()) {
+      std_json_format5_to_file(::std::move(path), ::std::move(value), ::std::move(sindent));
+      return self = Reference_root::S_void();
+    }
+    V_integer nindent;
+    if(reader.L(state).v(nindent).F()) {
+      std_json_format5_to_file(::std::move(path), ::std::move(value), ::std::move(nindent));
+      return self = Reference_root::S_void();
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
@@ -860,9 +3720,9 @@ create_bindings_json(V_object& result, API_Version /*version*/)
 `std.json.parse(text)`
 
   * Parses a string containing data encoded in the JSON format and
-    converts it to a value. This function reuses the tokenizer of
-    Asteria and allows quite a few extensions, some of which are
-    also supported by JSON5:
+    converts it to a value. This function accepts the same tokens
+    as the tokenizer of Asteria and allows quite a few extensions,
+    some of which are also supported by JSON5:
 
     * Single-line and multiple-line comments are allowed.
     * Binary and hexadecimal numbers are allowed.
@@ -891,6 +3751,138 @@ create_bindings_json(V_object& result, API_Version /*version*/)
     }
     // Fail.
     reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.json.parse_events()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("parse_events"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parse_events(text, callback)`
+
+  * Parses a string containing data encoded in the JSON format like
+    `parse()`, but instead of constructing the value, invokes
+    `callback` with two arguments, the first of which is one of the
+    following event names:
+
+    * `"start_array"`
+    * `"end_array"`
+    * `"start_object"`
+    * `"key"`, with the key as the second argument
+    * `"end_object"`
+    * `"scalar"`, with the value as the second argument
+
+    The second argument is `null` for other events. If `callback`
+    returns `false` for a `"start_array"` or `"start_object"` event,
+    the array or object is skipped. If it returns `false` for a
+    `"key"` event, the value of that key is skipped. Skipped values
+    are still checked, but no events are generated for them, and no
+    arrays or objects are constructed. The return value is ignored
+    otherwise.
+
+  * Throws an exception if the string is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& global) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parse_events"));
+    // Parse arguments.
+    V_string text;
+    V_function callback;
+    if(reader.I().v(text).v(callback).F()) {
+      std_json_parse_events(global, ::std::move(text), ::std::move(callback));
+      return self = Reference_root::S_void();
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.json.parser_new()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("parser_new"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parser_new()`
+
+  * Creates an incremental parser for a sequence of values in the
+    JSON format, such as newline-delimited JSON. Values are accepted
+    in the same format as `parse()`, and are separated by spaces or
+    comments, which are not required between arrays, objects and
+    strings.
+
+  * Returns the parser as an object consisting of the following
+    members:
+
+    * `feed(text)`
+    * `next()`
+    * `next_events(callback)`
+    * `finish()`
+
+    The function `feed()` appends a chunk to the input. The function
+    `next()` returns the next complete value in an array, or `null`
+    if there is none, and `next_events()` reports the next complete
+    value as events, like `parse_events()`. After all chunks have
+    been fed, the function `finish()` completes the last value,
+    then resets the parser. Only values which have not been parsed
+    are held in memory. This allows large sequences, such as those
+    read in chunks by `std.filesystem.file_stream()`, to be parsed
+    without being loaded in memory entirely.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parser_new"));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_json_parser_new() };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.json.parse_lazy()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("parse_lazy"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.json.parse_lazy(text)`
+
+  * Parses a string containing data encoded in the JSON format like
+    `parse()`, but only the structure of the text is checked and
+    recorded. Members and elements are decoded when they are
+    accessed, so reading a few values from a large document is much
+    cheaper than converting all of it.
+
+  * Returns the document as an object consisting of the following
+    members:
+
+    * `get(...)`
+    * `type(...)`
+    * `count(...)`
+    * `keys(...)`
+
+    Each of them takes a path of keys and subscripts, with which a
+    value is looked up. The function `get()` converts the value to a
+    regular value. The functions `type()`, `count()` and `keys()`
+    inspect the value without converting it. As scalar values are
+    only checked when they are decoded, an invalid number or string
+    may not be diagnosed until it is accessed.
+
+  * Throws an exception if the string is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.json.parse_lazy"));
+    // Parse arguments.
+    V_string text;
+    if(reader.I().v(text).F()) {
+      Reference_root::S_temporary xref = { std_json_parse_lazy(::std::move(text)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
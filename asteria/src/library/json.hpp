@@ -22,10 +22,76 @@ std_json_format5(Value value, optV_string indent);
 V_string
 std_json_format5(Value value, V_integer indent);
 
+// `std.json.format_to_file`
+void
+std_json_format_to_file(V_string path, Value value, optV_string indent);
+
+void
+std_json_format_to_file(V_string path, Value value, V_integer indent);
+
+// `std.json.format5_to_file`
+void
+std_json_format5_to_file(V_string path, Value value, optV_string indent);
+
+void
+std_json_format5_to_file(V_string path, Value value, V_integer indent);
+
 // `std.json.parse`
 Value
 std_json_parse(V_string text);
 
+// `std.json.parse_events`
+void
+std_json_parse_events(Global_Context& global, V_string text, V_function callback);
+
+// `std.json.parser_new_private`
+V_opaque
+std_json_parser_new_private();
+
+// `std.json.parser_new_feed`
+void
+std_json_parser_new_feed(V_opaque& h, V_string text);
+
+// `std.json.parser_new_next`
+optV_array
+std_json_parser_new_next(V_opaque& h);
+
+// `std.json.parser_new_next_events`
+V_boolean
+std_json_parser_new_next_events(Global_Context& global, V_opaque& h, V_function callback);
+
+// `std.json.parser_new_finish`
+void
+std_json_parser_new_finish(V_opaque& h);
+
+// `std.json.parser_new`
+V_object
+std_json_parser_new();
+
+// `std.json.parse_lazy_private`
+V_opaque
+std_json_parse_lazy_private(V_string text);
+
+// `std.json.parse_lazy_get`
+Value
+std_json_parse_lazy_get(const V_opaque& d, cow_vector<Value> path);
+
+// `std.json.parse_lazy_type`
+optV_string
+std_json_parse_lazy_type(const V_opaque& d, cow_vector<Value> path);
+
+// `std.json.parse_lazy_count`
+optV_integer
+std_json_parse_lazy_count(const V_opaque& d, cow_vector<Value> path);
+
+// `std.json.parse_lazy_keys`
+optV_array
+std_json_parse_lazy_keys(const V_opaque& d, cow_vector<Value> path);
+
+// `std.json.parse_lazy`
+V_object
+std_json_parse_lazy(V_string text);
+
 // Create an object that is to be referenced as `std.json`.
 void
 create_bindings_json(V_object& result, API_Version version);
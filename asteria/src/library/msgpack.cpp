@@ -0,0 +1,766 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "msgpack.hpp"
+#include "../runtime/argument_reader.hpp"
+#include "../runtime/global_context.hpp"
+#include "../utilities.hpp"
+
+namespace Asteria {
+namespace {
+
+void
+do_append_bytes(V_string& str, const void* data, size_t size)
+  {
+    // Grow the string geometrically.
+    if(str.capacity() - str.size() < size)
+      str.reserve(::rocket::max(str.size() * 2, str.size() + size));
+    str.append(static_cast<const char*>(data), size);
+  }
+
+template<typename intT>
+void
+do_append_tagged(V_string& str, uint8_t tag, intT value)
+  {
+    // Write the tag byte, followed by `value` in big-endian order.
+    char bytes[1 + sizeof(value)];
+    bytes[0] = static_cast<char>(tag);
+    for(size_t i = 0;  i < sizeof(value);  ++i)
+      bytes[1 + i] = static_cast<char>(static_cast<uint64_t>(value) >> (sizeof(value) - 1 - i) * 8);
+    do_append_bytes(str, bytes, sizeof(bytes));
+  }
+
+void
+do_format_length(V_string& str, size_t len, uint8_t fix, size_t nfix, uint8_t tag8, uint8_t tag16,
+                 uint8_t tag32)
+  {
+    // Use the shortest form. A zero tag means the form is not available.
+    if(len < nfix) {
+      char ch = static_cast<char>(fix | len);
+      return do_append_bytes(str, &ch, 1);
+    }
+    if(tag8 && (len <= UINT8_MAX))
+      return do_append_tagged(str, tag8, static_cast<uint8_t>(len));
+    if(len <= UINT16_MAX)
+      return do_append_tagged(str, tag16, static_cast<uint16_t>(len));
+    if(len <= UINT32_MAX)
+      return do_append_tagged(str, tag32, static_cast<uint32_t>(len));
+    ASTERIA_THROW("MessagePack length overflow (length `$1`)", len);
+  }
+
+void
+do_format_integer(V_string& str, int64_t value)
+  {
+    // Use the shortest form.
+    if(value >= 0) {
+      if(value < 0x80) {
+        char ch = static_cast<char>(value);
+        return do_append_bytes(str, &ch, 1);
+      }
+      if(value <= UINT8_MAX)
+        return do_append_tagged(str, 0xCC, static_cast<uint8_t>(value));
+      if(value <= UINT16_MAX)
+        return do_append_tagged(str, 0xCD, static_cast<uint16_t>(value));
+      if(value <= UINT32_MAX)
+        return do_append_tagged(str, 0xCE, static_cast<uint32_t>(value));
+      return do_append_tagged(str, 0xCF, static_cast<uint64_t>(value));
+    }
+    if(value >= -32) {
+      char ch = static_cast<char>(value);
+      return do_append_bytes(str, &ch, 1);
+    }
+    if(value >= INT8_MIN)
+      return do_append_tagged(str, 0xD0, static_cast<int8_t>(value));
+    if(value >= INT16_MIN)
+      return do_append_tagged(str, 0xD1, static_cast<int16_t>(value));
+    if(value >= INT32_MIN)
+      return do_append_tagged(str, 0xD2, static_cast<int32_t>(value));
+    return do_append_tagged(str, 0xD3, value);
+  }
+
+bool
+do_is_valid_utf8(const V_string& value)
+noexcept
+  {
+    auto bptr = value.data();
+    auto eptr = bptr + value.size();
+    while(bptr != eptr) {
+      // Skip ASCII characters quickly.
+      if((*bptr & 0x80) == 0) {
+        bptr++;
+        continue;
+      }
+      char32_t cp;
+      if(!utf8_decode(cp, bptr, static_cast<size_t>(eptr - bptr)))
+        return false;
+    }
+    return true;
+  }
+
+void
+do_format_string(V_string& str, const V_string& bytes)
+  {
+    // Valid UTF-8 strings are written as `str`, and others are written as `bin`.
+    if(do_is_valid_utf8(bytes))
+      do_format_length(str, bytes.size(), 0xA0, 32, 0xD9, 0xDA, 0xDB);
+    else
+      do_format_length(str, bytes.size(), 0x00, 0, 0xC4, 0xC5, 0xC6);
+    do_append_bytes(str, bytes.data(), bytes.size());
+  }
+
+void
+do_format_scalar(V_string& str, const Value& value)
+  {
+    switch(weaken_enum(value.vtype())) {
+      case vtype_boolean:
+        // Write `true` or `false`.
+        return do_append_bytes(str, value.as_boolean() ? "\xC3" : "\xC2", 1);
+
+      case vtype_integer:
+        // Write the integer.
+        return do_format_integer(str, value.as_integer());
+
+      case vtype_real: {
+        // Write the real as a double-precision number.
+        double real = value.as_real();
+        uint64_t bits;
+        ::std::memcpy(&bits, &real, sizeof(bits));
+        return do_append_tagged(str, 0xCB, bits);
+      }
+
+      case vtype_string:
+        // Write the string.
+        return do_format_string(str, value.as_string());
+    }
+    // Anything else is censored to `nil`.
+    return do_append_bytes(str, "\xC0", 1);
+  }
+
+struct S_xformat_array
+  {
+    ref_to<const V_array> refa;
+    V_array::const_iterator curp;
+  };
+
+struct S_xformat_object
+  {
+    ref_to<const V_object> refo;
+    V_object::const_iterator curp;
+  };
+
+using Xformat = variant<S_xformat_array, S_xformat_object>;
+
+V_string
+do_format_nonrecursive(const Value& value)
+  {
+    V_string str;
+    // Transform recursion to iteration using a handwritten stack.
+    auto qvalue = ::std::addressof(value);
+    cow_vector<Xformat> stack;
+    for(;;) {
+      // Find a leaf value. `qvalue` must always point to a valid value here.
+      if(qvalue->is_array()){
+        const auto& array = qvalue->as_array();
+        // Write the number of elements.
+        do_format_length(str, array.size(), 0x90, 16, 0x00, 0xDC, 0xDD);
+        auto curp = array.begin();
+        if(curp != array.end()) {
+          // Decend into the array.
+          S_xformat_array ctxa = { ::rocket::ref(array), curp };
+          stack.emplace_back(::std::move(ctxa));
+          qvalue = ::std::addressof(*curp);
+          continue;
+        }
+      }
+      else if(qvalue->is_object()) {
+        const auto& object = qvalue->as_object();
+        // Write the number of key-value pairs.
+        do_format_length(str, object.size(), 0x80, 16, 0x00, 0xDE, 0xDF);
+        auto curp = object.begin();
+        if(curp != object.end()) {
+          // Write the key, which is always a string.
+          do_format_string(str, curp->first.rdstr());
+          // Decend into the object.
+          S_xformat_object ctxo = { ::rocket::ref(object), curp };
+          stack.emplace_back(::std::move(ctxo));
+          qvalue = ::std::addressof(curp->second);
+          continue;
+        }
+      }
+      else {
+        // Just write a scalar value which is never recursive.
+        do_format_scalar(str, *qvalue);
+      }
+      for(;;) {
+        // Advance to the next element if any.
+        if(stack.empty()) {
+          // Finish the root value.
+          return str;
+        }
+        if(stack.back().index() == 0) {
+          auto& ctxa = stack.mut_back().as<0>();
+          // Advance to the next element.
+          auto curp = ++(ctxa.curp);
+          if(curp != ctxa.refa->end()) {
+            qvalue = ::std::addressof(*curp);
+            break;
+          }
+        }
+        else {
+          auto& ctxo = stack.mut_back().as<1>();
+          // Advance to the next key-value pair.
+          auto curp = ++(ctxo.curp);
+          if(curp != ctxo.refo->end()) {
+            do_format_string(str, curp->first.rdstr());
+            qvalue = ::std::addressof(curp->second);
+            break;
+          }
+        }
+        stack.pop_back();
+      }
+    }
+  }
+
+class MsgPack_Reader
+  {
+  private:
+    const char* m_bptr;
+    const char* m_rptr;
+    const char* m_eptr;
+
+  public:
+    explicit
+    MsgPack_Reader(const char* bptr, size_t size)
+    noexcept
+      : m_bptr(bptr), m_rptr(bptr), m_eptr(bptr + size)
+      { }
+
+  public:
+    size_t
+    tell()
+    const noexcept
+      { return static_cast<size_t>(this->m_rptr - this->m_bptr);  }
+
+    size_t
+    avail()
+    const noexcept
+      { return static_cast<size_t>(this->m_eptr - this->m_rptr);  }
+
+    [[noreturn]]
+    void
+    throw_error(const char* msg)
+    const
+      {
+        ASTERIA_THROW("invalid MessagePack data: $1 (offset `$2`)", msg, this->tell());
+      }
+
+    uint8_t
+    peek()
+    const noexcept
+      {
+        ROCKET_ASSERT(this->avail() >= 1);
+        return static_cast<uint8_t>(this->m_rptr[0]);
+      }
+
+    template<typename intT>
+    intT
+    get_be(size_t off)
+    const noexcept
+      {
+        // Read an integer in big-endian order from `off` bytes after the read pointer.
+        ROCKET_ASSERT(this->avail() >= off + sizeof(intT));
+        uint64_t word = 0;
+        for(size_t i = 0;  i < sizeof(intT);  ++i)
+          word = (word << 8) | static_cast<uint8_t>(this->m_rptr[off + i]);
+        return static_cast<intT>(word);
+      }
+
+    const char*
+    data(size_t off)
+    const noexcept
+      { return this->m_rptr + off;  }
+
+    void
+    consume(size_t n)
+    noexcept
+      {
+        ROCKET_ASSERT(this->avail() >= n);
+        this->m_rptr += n;
+      }
+  };
+
+struct S_item
+  {
+    char kind;  // n: nil, b: boolean, i: integer, r: real, s: string, [: array, {: map
+    bool bval;
+    int64_t ival;
+    double rval;
+    const char* sptr;
+    size_t len;  // length of a string, or number of elements of an array or a map
+  };
+
+bool
+do_read_item(S_item& item, MsgPack_Reader& reader)
+  {
+    // Decode a scalar value, or the header of an array or a map, and consume it. If there
+    // is not enough data, `false` is returned and nothing is consumed.
+    if(reader.avail() < 1)
+      return false;
+    uint8_t tag = reader.peek();
+    size_t hlen = 1;
+    auto get_length = [&](size_t nbytes) {
+      hlen = 1 + nbytes;
+      if(reader.avail() < hlen)
+        return false;
+      switch(nbytes) {
+        case 1:
+          item.len = reader.get_be<uint8_t>(1);
+          break;
+        case 2:
+          item.len = reader.get_be<uint16_t>(1);
+          break;
+        default:
+          item.len = reader.get_be<uint32_t>(1);
+          break;
+      }
+      return true;
+    };
+
+    if((tag < 0x80) || (tag >= 0xE0)) {
+      // positive or negative fixint
+      item.kind = 'i';
+      item.ival = static_cast<int8_t>(tag);
+    }
+    else if(tag < 0x90) {
+      // fixmap
+      item.kind = '{';
+      item.len = tag & 0x0F;
+    }
+    else if(tag < 0xA0) {
+      // fixarray
+      item.kind = '[';
+      item.len = tag & 0x0F;
+    }
+    else if(tag < 0xC0) {
+      // fixstr
+      item.kind = 's';
+      item.len = tag & 0x1F;
+    }
+    else {
+      switch(tag) {
+        case 0xC0:
+          item.kind = 'n';
+          break;
+
+        case 0xC2:
+        case 0xC3:
+          item.kind = 'b';
+          item.bval = tag & 1;
+          break;
+
+        case 0xC4:
+        case 0xC5:
+        case 0xC6:
+        case 0xD9:
+        case 0xDA:
+        case 0xDB:
+          // bin 8/16/32 and str 8/16/32 are both read as strings.
+          item.kind = 's';
+          if(!get_length(size_t(1) << ((tag < 0xD9) ? (tag - 0xC4) : (tag - 0xD9))))
+            return false;
+          break;
+
+        case 0xCA: {
+          // float 32
+          hlen = 5;
+          if(reader.avail() < hlen)
+            return false;
+          uint32_t bits = reader.get_be<uint32_t>(1);
+          float fval;
+          ::std::memcpy(&fval, &bits, sizeof(fval));
+          item.kind = 'r';
+          item.rval = fval;
+          break;
+        }
+
+        case 0xCB: {
+          // float 64
+          hlen = 9;
+          if(reader.avail() < hlen)
+            return false;
+          uint64_t bits = reader.get_be<uint64_t>(1);
+          item.kind = 'r';
+          ::std::memcpy(&(item.rval), &bits, sizeof(item.rval));
+          break;
+        }
+
+        case 0xCC:
+        case 0xCD:
+        case 0xCE:
+        case 0xCF:
+        case 0xD0:
+        case 0xD1:
+        case 0xD2:
+        case 0xD3: {
+          // uint 8/16/32/64 and int 8/16/32/64
+          size_t nbytes = size_t(1) << (tag & 3);
+          hlen = 1 + nbytes;
+          if(reader.avail() < hlen)
+            return false;
+          uint64_t word;
+          switch(nbytes) {
+            case 1:
+              word = reader.get_be<uint8_t>(1);
+              break;
+            case 2:
+              word = reader.get_be<uint16_t>(1);
+              break;
+            case 4:
+              word = reader.get_be<uint32_t>(1);
+              break;
+            default:
+              word = reader.get_be<uint64_t>(1);
+              break;
+          }
+          if(tag >= 0xD0) {
+            // Sign-extend the value.
+            int shift = static_cast<int>(64 - nbytes * 8);
+            item.ival = static_cast<int64_t>(word << shift) >> shift;
+          }
+          else if(word > INT64_MAX) {
+            reader.throw_error("integer out of range");
+          }
+          else {
+            item.ival = static_cast<int64_t>(word);
+          }
+          item.kind = 'i';
+          break;
+        }
+
+        case 0xDC:
+        case 0xDD:
+          // array 16/32
+          item.kind = '[';
+          if(!get_length(size_t(2) << (tag - 0xDC)))
+            return false;
+          break;
+
+        case 0xDE:
+        case 0xDF:
+          // map 16/32
+          item.kind = '{';
+          if(!get_length(size_t(2) << (tag - 0xDE)))
+            return false;
+          break;
+
+        case 0xC7:
+        case 0xC8:
+        case 0xC9:
+        case 0xD4:
+        case 0xD5:
+        case 0xD6:
+        case 0xD7:
+        case 0xD8:
+          reader.throw_error("extension types not supported");
+
+        default:
+          reader.throw_error("invalid type byte");
+      }
+    }
+
+    if(item.kind == 's') {
+      // Make sure the payload is complete.
+      if(reader.avail() - hlen < item.len)
+        return false;
+      item.sptr = reader.data(hlen);
+      hlen += item.len;
+    }
+    reader.consume(hlen);
+    return true;
+  }
+
+size_t
+do_measure_nonrecursive(const V_string& data)
+  {
+    // Get the length of the first value in `data`, by counting elements that are yet to be
+    // read. If the value is incomplete, zero is returned.
+    MsgPack_Reader reader(data.data(), data.size());
+    uint64_t npending = 1;
+    while(npending != 0) {
+      S_item item;
+      if(!do_read_item(item, reader))
+        return 0;
+      npending--;
+      if(item.kind == '[')
+        npending += item.len;
+      else if(item.kind == '{')
+        npending += item.len * 2;
+    }
+    return reader.tell();
+  }
+
+V_string
+do_read_key(MsgPack_Reader& reader)
+  {
+    S_item item;
+    if(!do_read_item(item, reader))
+      reader.throw_error("unexpected end of data");
+    if(item.kind != 's')
+      reader.throw_error("map key not a string");
+    return V_string(item.sptr, item.len);
+  }
+
+struct S_xparse_array
+  {
+    V_array array;
+    size_t nrem;
+  };
+
+struct S_xparse_object
+  {
+    V_object object;
+    size_t nrem;
+    V_string key;
+  };
+
+using Xparse = variant<S_xparse_array, S_xparse_object>;
+
+Value
+do_parse_nonrecursive(MsgPack_Reader& reader)
+  {
+    Value value;
+    // Implement a recursive descent parser without recursion.
+    cow_vector<Xparse> stack;
+    for(;;) {
+      S_item item;
+      if(!do_read_item(item, reader))
+        reader.throw_error("unexpected end of data");
+      switch(item.kind) {
+        case '[': {
+          if(item.len != 0) {
+            // Descend into the new array. The number of elements has been checked against
+            // the length of data, so it is safe to reserve storage.
+            S_xparse_array ctxa = { nullopt, item.len };
+            ctxa.array.reserve(item.len);
+            stack.emplace_back(::std::move(ctxa));
+            continue;
+          }
+          // Accept an empty array.
+          value = V_array();
+          break;
+        }
+
+        case '{': {
+          if(item.len != 0) {
+            // Descend into a new object.
+            S_xparse_object ctxo = { nullopt, item.len, do_read_key(reader) };
+            stack.emplace_back(::std::move(ctxo));
+            continue;
+          }
+          // Accept an empty object.
+          value = V_object();
+          break;
+        }
+
+        case 'n':
+          value = V_null();
+          break;
+
+        case 'b':
+          value = V_boolean(item.bval);
+          break;
+
+        case 'i':
+          value = V_integer(item.ival);
+          break;
+
+        case 'r':
+          value = V_real(item.rval);
+          break;
+
+        default:
+          ROCKET_ASSERT(item.kind == 's');
+          value = V_string(item.sptr, item.len);
+          break;
+      }
+      // Insert the value into its parent array or object.
+      for(;;) {
+        if(stack.empty()) {
+          // Accept the root value.
+          return value;
+        }
+        if(stack.back().index() == 0) {
+          auto& ctxa = stack.mut_back().as<0>();
+          // Append the value to its parent array.
+          ctxa.array.emplace_back(::std::move(value));
+          if(--(ctxa.nrem) != 0)
+            break;
+          // Pop the array.
+          value = ::std::move(ctxa.array);
+        }
+        else {
+          auto& ctxo = stack.mut_back().as<1>();
+          // Insert the value into its parent object. Later keys override earlier ones.
+          ctxo.object.insert_or_assign(::std::move(ctxo.key), ::std::move(value));
+          if(--(ctxo.nrem) != 0) {
+            ctxo.key = do_read_key(reader);
+            break;
+          }
+          // Pop the object.
+          value = ::std::move(ctxo.object);
+        }
+        stack.pop_back();
+      }
+    }
+  }
+
+}  // namespace
+
+V_string
+std_msgpack_format(Value value)
+  {
+    return do_format_nonrecursive(value);
+  }
+
+Value
+std_msgpack_parse(V_string data)
+  {
+    // Check that `data` contains exactly one complete value before allocating anything.
+    size_t len = do_measure_nonrecursive(data);
+    MsgPack_Reader reader(data.data(), data.size());
+    if(len == 0) {
+      reader.consume(data.size());
+      reader.throw_error("unexpected end of data");
+    }
+    if(len != data.size()) {
+      reader.consume(len);
+      reader.throw_error("excess data");
+    }
+    return do_parse_nonrecursive(reader);
+  }
+
+optV_array
+std_msgpack_parse_prefix(V_string data)
+  {
+    // If `data` does not contain a complete value, more data will be needed.
+    size_t len = do_measure_nonrecursive(data);
+    if(len == 0)
+      return nullopt;
+    MsgPack_Reader reader(data.data(), len);
+    V_array pair;
+    pair.reserve(2);
+    pair.emplace_back(do_parse_nonrecursive(reader));
+    pair.emplace_back(V_integer(len));
+    return ::std::move(pair);
+  }
+
+void
+create_bindings_msgpack(V_object& result, API_Version /*version*/)
+  {
+    //===================================================================
+    // `std.msgpack.format()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("format"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.msgpack.format(value)`
+
+  * Encodes a value in the MessagePack format. Integers and reals
+    are kept distinct: integers are written in the shortest integer
+    form and reals are always written as 64-bit floats. Strings
+    that are valid UTF-8 are written as `str` and all other strings
+    are written as `bin`, so arbitrary bytes are preserved. Arrays
+    and objects are written as arrays and maps. Values of any other
+    types are censored to `nil`.
+
+  * Returns the encoded data as a byte string.
+
+  * Throws an exception if a string, an array or an object is too
+    large to be encoded.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.msgpack.format"));
+    // Parse arguments.
+    Value value;
+    if(reader.I().o(value).F()) {
+      Reference_root::S_temporary xref = { std_msgpack_format(::std::move(value)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.msgpack.parse()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("parse"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.msgpack.parse(data)`
+
+  * Decodes a value from a byte string in the MessagePack format.
+    Both `str` and `bin` are decoded as strings, and both 32-bit and
+    64-bit floats are decoded as reals. Map keys must be strings.
+    If a key appears more than once in a map, the last value wins.
+
+  * Returns the decoded value.
+
+  * Throws an exception if `data` is not a single valid value, if an
+    unsigned integer is larger than the maximum value of `integer`,
+    or if an extension type is encountered.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.msgpack.parse"));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_msgpack_parse(::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.msgpack.parse_prefix()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("parse_prefix"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.msgpack.parse_prefix(data)`
+
+  * Decodes the first value from a byte string in the MessagePack
+    format, like `parse()`, but ignores any data that follows it.
+    This can be used to decode a stream of values that arrive in
+    chunks: append chunks to a buffer, and remove each value from
+    the front of the buffer once it is complete.
+
+  * Returns an array of two elements, the first of which is the
+    decoded value and the second of which is the number of bytes
+    that it occupies. If `data` does not contain a complete value,
+    `null` is returned.
+
+  * Throws an exception if the data is not valid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.msgpack.parse_prefix"));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_msgpack_parse_prefix(::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.msgpack`
+    //===================================================================
+  }
+
+}  // namespace Asteria
@@ -0,0 +1,29 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_LIBRARY_MSGPACK_HPP_
+#define ASTERIA_LIBRARY_MSGPACK_HPP_
+
+#include "../fwd.hpp"
+
+namespace Asteria {
+
+// `std.msgpack.format`
+V_string
+std_msgpack_format(Value value);
+
+// `std.msgpack.parse`
+Value
+std_msgpack_parse(V_string data);
+
+// `std.msgpack.parse_prefix`
+optV_array
+std_msgpack_parse_prefix(V_string data);
+
+// Create an object that is to be referenced as `std.msgpack`.
+void
+create_bindings_msgpack(V_object& result, API_Version version);
+
+}  // namespace Asteria
+
+#endif
@@ -4,9 +4,17 @@
 #include "../precompiled.hpp"
 #include "string.hpp"
 #include "../runtime/argument_reader.hpp"
+#include "../runtime/global_context.hpp"
+#include "../runtime/regex_cache.hpp"
+#include "../runtime/format_template.hpp"
 #include "../utilities.hpp"
 #include <regex>
 
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#  define ASTERIA_STRING_X86_  1
+#  include <immintrin.h>
+#endif
+
 namespace Asteria {
 namespace {
 
@@ -158,17 +166,646 @@ do_find_and_replace(V_string& res, IterT tbegin, IterT tend, IterT pbegin, IterT
     return res;
   }
 
-template<typename IterT>
-opt<IterT> do_find_of_opt(IterT begin, IterT end, const V_string& set, bool match)
+// These are bitmaps of bytes for classification with SIMD instructions. Bit `j` of the
+// `i`-th byte is set if the byte `j << 4 | i` belongs to the set, and bit `j` of the
+// `(16 + i)`-th byte is set if the byte `(j + 8) << 4 | i` does.
+struct Byte_Bitmap
+  {
+    uint8_t rows[32];
+  };
+
+constexpr
+bool
+do_test_byte(const Byte_Bitmap& bmp, char c)
+noexcept
+  { return (bmp.rows[uint8_t(c) >> 7 << 4 | (uint8_t(c) & 15)] >> (uint8_t(c) >> 4 & 7)) & 1;  }
+
+constexpr
+void
+do_add_byte(Byte_Bitmap& bmp, char c)
+noexcept
+  {
+    uint8_t& row = bmp.rows[uint8_t(c) >> 7 << 4 | (uint8_t(c) & 15)];
+    row = static_cast<uint8_t>(row | 1 << (uint8_t(c) >> 4 & 7));
+  }
+
+#ifdef ASTERIA_STRING_X86_
+
+// These are selected at run time, so they must not be called unless the CPU supports them.
+// Each kernel processes whole blocks only and returns the number of bytes consumed, leaving
+// the rest to the scalar code that follows it.
+inline
+bool
+do_cpu_has_ssse3()
+noexcept
+  { return cpu_supports(cpu_feature_ssse3);  }
+
+inline
+bool
+do_cpu_has_avx2()
+noexcept
+  { return cpu_supports(cpu_feature_avx2);  }
+
+// http://0x80.pl/articles/simd-byte-lookup.html
+// This returns a mask of bytes in `c` that do not belong to the set. The two halves of the
+// bitmap are looked up separately, as `pshufb` yields zero for indices with the MSB set.
+__attribute__((__target__("ssse3")))
+inline
+uint32_t
+do_byte_misses_ssse3(__m128i lo_rows, __m128i hi_rows, __m128i c)
+noexcept
+  {
+    const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i r = _mm_or_si128(_mm_shuffle_epi8(lo_rows, c),
+                             _mm_shuffle_epi8(hi_rows, _mm_xor_si128(c, _mm_set1_epi8(-128))));
+    __m128i b = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(c, 4), nibble));
+    __m128i t = _mm_cmpeq_epi8(_mm_and_si128(r, b), _mm_setzero_si128());
+    return static_cast<uint32_t>(_mm_movemask_epi8(t));
+  }
+
+__attribute__((__target__("avx2")))
+inline
+uint32_t
+do_byte_misses_avx2(__m256i lo_rows, __m256i hi_rows, __m256i c)
+noexcept
+  {
+    const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i r = _mm256_or_si256(_mm256_shuffle_epi8(lo_rows, c),
+                                _mm256_shuffle_epi8(hi_rows, _mm256_xor_si256(c, _mm256_set1_epi8(-128))));
+    __m256i b = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(c, 4), nibble));
+    __m256i t = _mm256_cmpeq_epi8(_mm256_and_si256(r, b), _mm256_setzero_si256());
+    return static_cast<uint32_t>(_mm256_movemask_epi8(t));
+  }
+
+// These return the number of leading (or trailing) bytes in `[sptr, sptr + slen)` whose
+// membership is `member`.
+__attribute__((__target__("ssse3")))
+size_t
+do_byte_span_ssse3(const Byte_Bitmap& bmp, const char* sptr, size_t slen, bool member)
+noexcept
+  {
+    const __m128i lo_rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bmp.rows));
+    const __m128i hi_rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bmp.rows + 16));
+    const uint32_t flip = member ? 0U : 0xFFFFU;
+    size_t nread = 0;
+    while(slen - nread >= 16) {
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread));
+      uint32_t stop = do_byte_misses_ssse3(lo_rows, hi_rows, c) ^ flip;
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_ctz(stop));
+      nread += 16;
+    }
+    return nread;
+  }
+
+__attribute__((__target__("avx2")))
+size_t
+do_byte_span_avx2(const Byte_Bitmap& bmp, const char* sptr, size_t slen, bool member)
+noexcept
+  {
+    const __m256i lo_rows = _mm256_broadcastsi128_si256(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(bmp.rows)));
+    const __m256i hi_rows = _mm256_broadcastsi128_si256(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(bmp.rows + 16)));
+    const uint32_t flip = member ? 0U : UINT32_MAX;
+    size_t nread = 0;
+    while(slen - nread >= 32) {
+      __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr + nread));
+      uint32_t stop = do_byte_misses_avx2(lo_rows, hi_rows, c) ^ flip;
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_ctz(stop));
+      nread += 32;
+    }
+    return nread;
+  }
+
+__attribute__((__target__("ssse3")))
+size_t
+do_byte_rspan_ssse3(const Byte_Bitmap& bmp, const char* sptr, size_t slen, bool member)
+noexcept
+  {
+    const __m128i lo_rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bmp.rows));
+    const __m128i hi_rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bmp.rows + 16));
+    const uint32_t flip = member ? 0U : 0xFFFFU;
+    size_t nread = 0;
+    while(slen - nread >= 16) {
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + slen - nread - 16));
+      uint32_t stop = do_byte_misses_ssse3(lo_rows, hi_rows, c) ^ flip;
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_clz(stop)) - 16;
+      nread += 16;
+    }
+    return nread;
+  }
+
+__attribute__((__target__("avx2")))
+size_t
+do_byte_rspan_avx2(const Byte_Bitmap& bmp, const char* sptr, size_t slen, bool member)
+noexcept
+  {
+    const __m256i lo_rows = _mm256_broadcastsi128_si256(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(bmp.rows)));
+    const __m256i hi_rows = _mm256_broadcastsi128_si256(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(bmp.rows + 16)));
+    const uint32_t flip = member ? 0U : UINT32_MAX;
+    size_t nread = 0;
+    while(slen - nread >= 32) {
+      __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr + slen - nread - 32));
+      uint32_t stop = do_byte_misses_avx2(lo_rows, hi_rows, c) ^ flip;
+      if(stop != 0)
+        return nread + static_cast<uint32_t>(__builtin_clz(stop));
+      nread += 32;
+    }
+    return nread;
+  }
+
+// These dispatch to the SIMD kernels above. Unlike the kernels, they may be called on any CPU.
+size_t
+do_byte_span(const Byte_Bitmap& bmp, const char* sptr, size_t slen, bool member)
+noexcept
+  {
+    if(slen < 16)
+      return 0;
+    if(do_cpu_has_avx2())
+      return do_byte_span_avx2(bmp, sptr, slen, member);
+    if(do_cpu_has_ssse3())
+      return do_byte_span_ssse3(bmp, sptr, slen, member);
+    return 0;
+  }
+
+size_t
+do_byte_rspan(const Byte_Bitmap& bmp, const char* sptr, size_t slen, bool member)
+noexcept
+  {
+    if(slen < 16)
+      return 0;
+    if(do_cpu_has_avx2())
+      return do_byte_rspan_avx2(bmp, sptr, slen, member);
+    if(do_cpu_has_ssse3())
+      return do_byte_rspan_ssse3(bmp, sptr, slen, member);
+    return 0;
+  }
+
+#else  // ASTERIA_STRING_X86_
+
+// There are no SIMD kernels, so everything is left to scalar code.
+constexpr
+size_t
+do_byte_span(const Byte_Bitmap& /*bmp*/, const char* /*sptr*/, size_t /*slen*/, bool /*member*/)
+noexcept
+  { return 0;  }
+
+constexpr
+size_t
+do_byte_rspan(const Byte_Bitmap& /*bmp*/, const char* /*sptr*/, size_t /*slen*/, bool /*member*/)
+noexcept
+  { return 0;  }
+
+#endif  // ASTERIA_STRING_X86_
+
+// This is used to search for bytes in a set. Sets are tested in blocks with SIMD instructions
+// if possible. Otherwise, sets of one or two bytes are tested a word at a time, like `memchr()`;
+// larger ones are tested a byte at a time using the bitmap.
+class Byte_Set
+  {
+  private:
+    size_t m_size;
+    uintptr_t m_splats[2];
+    Byte_Bitmap m_bmp;
+
+  public:
+    explicit
+    Byte_Set(const V_string& set)
+      {
+        this->m_size = 0;
+        this->m_bmp = { };
+        for(char c : set) {
+          if(do_test_byte(this->m_bmp, c))
+            continue;
+          do_add_byte(this->m_bmp, c);
+          // Record the first two distinct bytes.
+          if(this->m_size < 2)
+            this->m_splats[this->m_size] = UINTPTR_MAX / 0xFF * uint8_t(c);
+          this->m_size++;
+        }
+        if(this->m_size == 1)
+          this->m_splats[1] = this->m_splats[0];
+      }
+
+  private:
+    static
+    uintptr_t
+    do_equal_mask(uintptr_t word, uintptr_t splat)
+    noexcept
+      {
+        // Get a mask where each byte is `0x80` if the corresponding byte in `word` equals that
+        // in `splat`, and is zero otherwise. This is exact, as no carry crosses bytes.
+        constexpr auto low7 = static_cast<uintptr_t>(UINTPTR_MAX / 0xFF * 0x7F);
+        uintptr_t x = word ^ splat;
+        return ~(((x & low7) + low7) | x) & ~low7;
+      }
+
+    bool
+    do_test_word(uintptr_t word, bool match)
+    const noexcept
+      {
+        // Check whether `word` contains a byte for which `test()` would return `match`.
+        uintptr_t eqm = do_equal_mask(word, this->m_splats[0]) | do_equal_mask(word, this->m_splats[1]);
+        return match ? (eqm != 0) : (eqm != UINTPTR_MAX / 0xFF * 0x80);
+      }
+
+  public:
+    bool
+    test(char c)
+    const noexcept
+      { return do_test_byte(this->m_bmp, c);  }
+
+    // Searches `[bptr, eptr)` for the first byte for which `test()` would return `match`.
+    const char*
+    find_opt(const char* bptr, const char* eptr, bool match)
+    const noexcept
+      {
+        auto tptr = bptr;
+        if(match && (this->m_size == 1))
+          return static_cast<const char*>(::std::memchr(tptr, static_cast<int>(this->m_splats[0] & 0xFF),
+                                                        static_cast<size_t>(eptr - tptr)));
+        // Skip blocks and words that can't contain such a byte.
+        tptr += do_byte_span(this->m_bmp, tptr, static_cast<size_t>(eptr - tptr), !match);
+        uintptr_t word;
+        if((this->m_size == 1) || (this->m_size == 2))
+          while(eptr - tptr >= static_cast<ptrdiff_t>(sizeof(word))) {
+            ::std::memcpy(&word, tptr, sizeof(word));
+            if(this->do_test_word(word, match))
+              break;
+            tptr += sizeof(word);
+          }
+        // Find the byte.
+        for(;;) {
+          if(tptr == eptr)
+            return nullptr;
+          if(this->test(*tptr) == match)
+            return tptr;
+          ++tptr;
+        }
+      }
+
+    // Searches `[bptr, eptr)` for the last byte for which `test()` would return `match`.
+    const char*
+    rfind_opt(const char* bptr, const char* eptr, bool match)
+    const noexcept
+      {
+        auto tptr = eptr;
+        // Skip blocks and words that can't contain such a byte.
+        tptr -= do_byte_rspan(this->m_bmp, bptr, static_cast<size_t>(tptr - bptr), !match);
+        uintptr_t word;
+        if((this->m_size == 1) || (this->m_size == 2))
+          while(tptr - bptr >= static_cast<ptrdiff_t>(sizeof(word))) {
+            ::std::memcpy(&word, tptr - sizeof(word), sizeof(word));
+            if(this->do_test_word(word, match))
+              break;
+            tptr -= sizeof(word);
+          }
+        // Find the byte.
+        for(;;) {
+          if(tptr == bptr)
+            return nullptr;
+          --tptr;
+          if(this->test(*tptr) == match)
+            return tptr;
+        }
+      }
+  };
+
+optV_integer
+do_find_of_opt(const V_string& text, const V_integer& from, const optV_integer& length,
+               const V_string& set, bool match)
+  {
+    auto range = do_slice(text, from, length);
+    auto bptr = text.data() + (range.first - text.begin());
+    auto qptr = Byte_Set(set).find_opt(bptr, bptr + (range.second - range.first), match);
+    if(!qptr) {
+      return nullopt;
+    }
+    return qptr - text.data();
+  }
+
+optV_integer
+do_rfind_of_opt(const V_string& text, const V_integer& from, const optV_integer& length,
+                const V_string& set, bool match)
+  {
+    auto range = do_slice(text, from, length);
+    auto bptr = text.data() + (range.first - text.begin());
+    auto qptr = Byte_Set(set).rfind_opt(bptr, bptr + (range.second - range.first), match);
+    if(!qptr) {
+      return nullopt;
+    }
+    return qptr - text.data();
+  }
+
+// https://en.wikipedia.org/wiki/Aho-Corasick_algorithm
+class Pattern_Set
+final
+  : public Abstract_Opaque
+  {
+  private:
+    // The transition table of the DFA, which has `m_nclasses` elements per state, is not
+    // built if it would exceed this number of elements. Instead, the trie is searched by
+    // following failure links, which is slower but takes memory proportional to the total
+    // length of all patterns.
+    static constexpr size_t s_max_dense = 0x40'0000;
+
+    cow_vector<size_t> m_lengths;
+    // Bytes that do not occur in any pattern are mapped to class zero, which keeps rows of
+    // the transition table short.
+    uint16_t m_classes[0x100];
+    size_t m_nclasses;
+    // These are indexed by states. The initial state is zero.
+    cow_vector<uint32_t> m_trans;  // `m_nclasses` elements per state, or empty
+    cow_vector<uint32_t> m_depths;
+    cow_vector<uint32_t> m_outputs;  // index of the longest pattern ending here plus one
+    // These are used only if `m_trans` is empty. Edges of state `q` are sorted by class and
+    // occupy `[m_first[q], m_first[q+1])` of `m_edges`, each of which is the class in the
+    // high-order half and the target state in the low-order half.
+    cow_vector<uint32_t> m_fails;
+    cow_vector<uint32_t> m_first;
+    cow_vector<uint64_t> m_edges;
+
+  public:
+    explicit
+    Pattern_Set(const cow_vector<V_string>& patterns)
+      {
+        // Assign byte classes.
+        ::std::fill_n(this->m_classes, 0x100, uint16_t(0));
+        size_t ncls = 1;
+        size_t total = 0;
+        for(const auto& str : patterns) {
+          if(str.empty())
+            ASTERIA_THROW("empty pattern not allowed");
+          total += str.size();
+          for(char c : str)
+            if(this->m_classes[uint8_t(c)] == 0)
+              this->m_classes[uint8_t(c)] = static_cast<uint16_t>(ncls++);
+        }
+        if(total >= 0x10000000)
+          ASTERIA_THROW("too many patterns (total length `$1`)", total);
+        this->m_nclasses = ncls;
+
+        // Build the trie. Children of a state are kept in a singly linked list. Zero denotes
+        // a missing child as the initial state can't be a child.
+        auto& depths = this->m_depths;
+        auto& outputs = this->m_outputs;
+        cow_vector<uint32_t> children;
+        cow_vector<uint32_t> siblings;
+        cow_vector<uint16_t> labels;
+        depths.reserve(total + 1);
+        outputs.reserve(total + 1);
+        children.reserve(total + 1);
+        siblings.reserve(total + 1);
+        labels.reserve(total + 1);
+        depths.emplace_back(0);
+        outputs.emplace_back(0);
+        children.emplace_back(0);
+        siblings.emplace_back(0);
+        labels.emplace_back(0);
+        auto find_child = [&](uint32_t q, uint16_t c) {
+          uint32_t r = children[q];
+          while((r != 0) && (labels[r] != c))
+            r = siblings[r];
+          return r;
+        };
+        this->m_lengths.reserve(patterns.size());
+        for(size_t i = 0;  i < patterns.size();  ++i) {
+          const auto& str = patterns[i];
+          uint32_t q = 0;
+          for(char c : str) {
+            uint16_t cls = this->m_classes[uint8_t(c)];
+            uint32_t r = find_child(q, cls);
+            if(r == 0) {
+              r = static_cast<uint32_t>(depths.size());
+              depths.emplace_back(depths[q] + 1);
+              outputs.emplace_back(0);
+              children.emplace_back(0);
+              siblings.emplace_back(children[q]);
+              labels.emplace_back(cls);
+              children.mut(q) = r;
+            }
+            q = r;
+          }
+          // If a pattern occurs more than once, the first one wins.
+          if(outputs[q] == 0)
+            outputs.mut(q) = static_cast<uint32_t>(i + 1);
+          this->m_lengths.emplace_back(str.size());
+        }
+
+        // Calculate failure links in breadth-first order.
+        size_t nstates = depths.size();
+        cow_vector<uint32_t> fails;
+        fails.append(nstates, 0);
+        cow_vector<uint32_t> queue;
+        queue.reserve(nstates);
+        queue.emplace_back(0);
+        auto poutputs = outputs.mut_data();
+        auto pfails = fails.mut_data();
+        for(size_t h = 0;  h < queue.size();  ++h) {
+          uint32_t q = queue[h];
+          for(uint32_t r = children[q];  r != 0;  r = siblings[r]) {
+            // This is the longest proper suffix of `r` that is also in the trie.
+            uint32_t f = 0;
+            if(q != 0)
+              for(uint32_t t = pfails[q];  ;  t = pfails[t])
+                if(((f = find_child(t, labels[r])) != 0) || (t == 0))
+                  break;
+            pfails[r] = f;
+            if(poutputs[r] == 0)
+              poutputs[r] = poutputs[f];
+            queue.emplace_back(r);
+          }
+        }
+
+        if(nstates * ncls <= s_max_dense) {
+          // Turn the trie into a DFA by replacing missing transitions with those of the
+          // failure states, which precede their referrers in breadth-first order.
+          auto& trans = this->m_trans;
+          trans.append(nstates * ncls, 0);
+          auto ptrans = trans.mut_data();
+          for(uint32_t q : queue) {
+            if(q != 0)
+              ::std::copy_n(ptrans + pfails[q] * ncls, ncls, ptrans + q * ncls);
+            for(uint32_t r = children[q];  r != 0;  r = siblings[r])
+              ptrans[q * ncls + labels[r]] = r;
+          }
+          return;
+        }
+
+        // Store edges of each state contiguously.
+        auto& first = this->m_first;
+        auto& edges = this->m_edges;
+        first.reserve(nstates + 1);
+        edges.reserve(nstates - 1);
+        for(uint32_t q = 0;  q != nstates;  ++q) {
+          first.emplace_back(static_cast<uint32_t>(edges.size()));
+          size_t k = edges.size();
+          for(uint32_t r = children[q];  r != 0;  r = siblings[r])
+            edges.emplace_back(uint64_t(labels[r]) << 32 | r);
+          ::std::sort(edges.mut_data() + k, edges.mut_data() + edges.size());
+        }
+        first.emplace_back(static_cast<uint32_t>(edges.size()));
+        this->m_fails = ::std::move(fails);
+      }
+
+  private:
+    uint32_t
+    do_transit(uint32_t q, char c)
+    const noexcept
+      {
+        size_t cls = this->m_classes[uint8_t(c)];
+        if(ROCKET_EXPECT(!this->m_trans.empty()))
+          return this->m_trans.data()[q * this->m_nclasses + cls];
+
+        // Bytes that do not occur in any pattern always lead to the initial state.
+        if(cls == 0)
+          return 0;
+        auto pfirst = this->m_first.data();
+        auto pedges = this->m_edges.data();
+        for(;;) {
+          auto bptr = pedges + pfirst[q];
+          auto eptr = pedges + pfirst[q+1];
+          auto tptr = ::std::lower_bound(bptr, eptr, uint64_t(cls) << 32);
+          if((tptr != eptr) && (*tptr >> 32 == cls))
+            return static_cast<uint32_t>(*tptr);
+          if(q == 0)
+            return 0;
+          q = this->m_fails.data()[q];
+        }
+      }
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "pattern set (" << this->m_lengths.size() << " patterns)";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    Pattern_Set*
+    clone_opt(rcptr<Abstract_Opaque>& /*output*/)
+    const override
+      {
+        // Compiled pattern sets are immutable, so they are always shared.
+        return nullptr;
+      }
+
+    size_t
+    size()
+    const noexcept
+      { return this->m_lengths.size();  }
+
+    size_t
+    pattern_length(size_t index)
+    const
+      { return this->m_lengths.at(index);  }
+
+    // Searches `[bptr, eptr)` for the leftmost match. If more than one pattern matches at the
+    // same position, the longest one is chosen. Upon success, `offset` receives the offset
+    // of the match from `bptr`, and `index` receives the subscript of the pattern.
+    bool
+    search(size_t& offset, size_t& index, const char* bptr, const char* eptr)
+    const noexcept
+      {
+        auto pdepths = this->m_depths.data();
+        auto poutputs = this->m_outputs.data();
+        size_t moff = SIZE_MAX;
+        uint32_t mout = 0;
+        uint32_t q = 0;
+        for(auto tptr = bptr;  tptr != eptr;  ++tptr) {
+          q = this->do_transit(q, *tptr);
+          // The current state denotes the longest suffix that may still grow into a match.
+          // If it begins past the match found so far, no better match is possible.
+          size_t pos = static_cast<size_t>(tptr - bptr) + 1;
+          if(pos - pdepths[q] > moff)
+            break;
+          uint32_t out = poutputs[q];
+          if(out == 0)
+            continue;
+          size_t off = pos - this->m_lengths[out - 1];
+          if(off <= moff) {
+            moff = off;
+            mout = out;
+          }
+        }
+        if(mout == 0)
+          return false;
+        offset = moff;
+        index = mout - 1;
+        return true;
+      }
+  };
+
+rcptr<const Pattern_Set>
+do_cast_pattern_set(const V_opaque& p)
+  {
+    auto qps = p.cast_opt<Pattern_Set>();
+    if(!qps)
+      ASTERIA_THROW("invalid dynamic cast to type `$1` from type `$2`",
+                    typeid(Pattern_Set).name(), p.type().name());
+    return qps;
+  }
+
+optV_array
+do_find_any_pattern(const Pattern_Set& ps, const V_string& text, V_integer from, const optV_integer& length)
+  {
+    auto range = do_slice(text, from, length);
+    auto bptr = text.data() + (range.first - text.begin());
+    size_t off, ind;
+    if(!ps.search(off, ind, bptr, bptr + (range.second - range.first)))
+      return nullopt;
+    // Return the offset, the length and the subscript of the pattern.
+    V_array res;
+    res.reserve(3);
+    res.emplace_back(static_cast<V_integer>(off) + (range.first - text.begin()));
+    res.emplace_back(static_cast<V_integer>(ps.pattern_length(ind)));
+    res.emplace_back(static_cast<V_integer>(ind));
+    return ::std::move(res);
+  }
+
+V_string
+do_find_and_replace_all(const Pattern_Set& ps, const V_string& text, V_integer from,
+                        const optV_integer& length, const cow_vector<V_string>& replacements)
+  {
+    if(replacements.size() != ps.size())
+      ASTERIA_THROW("number of replacements mismatch (`$1` patterns, `$2` replacements)",
+                    ps.size(), replacements.size());
+    auto range = do_slice(text, from, length);
+    V_string res;
+    res.append(text.begin(), range.first);
+    // Replace all matches in a single pass.
+    auto tptr = text.data() + (range.first - text.begin());
+    auto eptr = tptr + (range.second - range.first);
+    size_t off, ind;
+    while(ps.search(off, ind, tptr, eptr)) {
+      res.append(tptr, off);
+      res.append(replacements[ind]);
+      tptr += off + ps.pattern_length(ind);
+    }
+    res.append(tptr, static_cast<size_t>(eptr - tptr));
+    res.append(range.second, text.end());
+    return res;
+  }
+
+cow_vector<V_string>
+do_get_strings(const V_array& values)
   {
-    // Make a lookup table.
-    array<bool, 256> table = { };
-    ::rocket::for_each(set, [&](char c) { table[uint8_t(c)] = true;  });
-    // Search the range.
-    for(auto it = begin;  it != end;  ++it)
-      if(table[uint8_t(*it)] == match)
-        return ::std::move(it);
-    return nullopt;
+    cow_vector<V_string> strs;
+    strs.reserve(values.size());
+    for(const auto& elem : values)
+      strs.emplace_back(elem.as_string());
+    return strs;
   }
 
 V_string do_get_reject(const optV_string& reject)
@@ -230,7 +867,28 @@ constexpr char s_char_table[][2] =
 constexpr char s_base16_table[] = "00112233445566778899AaBbCcDdEeFf";
 constexpr char s_base32_table[] = "AaBbCcDdEeFfGgHhIiJjKkLlMmNnOoPpQqRrSsTtUuVvWwXxYyZz223344556677==";
 constexpr char s_base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/==";
-constexpr char s_spaces[] = " \f\n\r\t\v";
+
+// These tables map characters to digit values. Invalid characters are mapped to 0xFF.
+struct Digit_Table
+  {
+    uint8_t vals[256];
+  };
+
+constexpr
+Digit_Table
+do_make_digit_table(const char* digits, size_t ndigits, size_t step)
+  {
+    Digit_Table table = { };
+    for(size_t i = 0;  i < 256;  ++i)
+      table.vals[i] = 0xFF;
+    for(size_t i = 0;  i < ndigits;  ++i)
+      table.vals[uint8_t(digits[i])] = static_cast<uint8_t>(i / step);
+    return table;
+  }
+
+constexpr Digit_Table s_base16_digits = do_make_digit_table(s_base16_table, 32, 2);
+constexpr Digit_Table s_base32_digits = do_make_digit_table(s_base32_table, 64, 2);
+constexpr Digit_Table s_base64_digits = do_make_digit_table(s_base64_table, 64, 1);
 
 // http://www.faqs.org/rfcs/rfc3986.html
 // * Bit 0 indicates whether the character is a reserved character.
@@ -273,224 +931,2405 @@ do_is_url_query_char(char c)
 noexcept
   { return s_url_chars[uint8_t(c)] & 2;  }
 
-const char*
-do_xstrchr(const char* str, char c)
-noexcept
+// `accept` is a set of values in `s_url_chars`.
+constexpr
+Byte_Bitmap
+do_make_url_bitmap(uint32_t accept, char except)
   {
-    // If `c == 0`, this function returns a null pointer.
-    for(auto p = str;  *p != 0;  ++p)
-      if(*p == c)
-        return p;
-    return nullptr;
+    Byte_Bitmap bmp = { };
+    for(size_t c = 0;  c < 256;  ++c)
+      if(((accept >> s_url_chars[c]) & 1) && (c != uint8_t(except)))
+        do_add_byte(bmp, static_cast<char>(c));
+    return bmp;
   }
 
-template<bool queryT>
-V_string
-do_url_encode(const V_string& data, bool lcase)
+// These are characters that are copied verbatim by URL encoders and decoders.
+constexpr Byte_Bitmap s_url_encode_plain = do_make_url_bitmap(0b0100, '\0');
+constexpr Byte_Bitmap s_url_encode_query_plain = do_make_url_bitmap(0b1100, '\0');
+constexpr Byte_Bitmap s_url_decode_plain = do_make_url_bitmap(0b1110, '\0');
+constexpr Byte_Bitmap s_url_decode_query_plain = do_make_url_bitmap(0b1110, '+');
+
+#ifdef ASTERIA_STRING_X86_
+
+// These follow the same rules as the kernels for `Byte_Bitmap` above.
+
+// https://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+__attribute__((__target__("ssse3")))
+inline
+__m128i
+do_base64_encode_ssse3_block(__m128i in)
+noexcept
+  {
+    // Split 3 bytes into 4 indices of 6 bits.
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    __m128i idx = _mm_or_si128(t0, t1);
+    // Map indices to characters by adding offsets for their ranges.
+    __m128i r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    r = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+    r = _mm_shuffle_epi8(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                       '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                       '/' - 63, 'A', 0, 0), r);
+    return _mm_add_epi8(idx, r);
+  }
+
+__attribute__((__target__("ssse3")))
+size_t
+do_base64_encode_ssse3(char*& wptr, const char* sptr, size_t slen)
+noexcept
   {
-    V_string text = data;
-    // Only modify the string as needed, without causing copies on write.
     size_t nread = 0;
-    while(nread != text.size()) {
-      // Check whether this character has no special meaning.
-      char c = text[nread++];
-      if(queryT) {
-        // This is the only special case.
-        if(c == ' ') {
-          text.mut(nread - 1) = '+';
-          continue;
-        }
-        if(do_is_url_query_char(c))
-          continue;
-      }
-      else {
-        if(do_is_url_unreserved_char(c))
-          continue;
-      }
-      // Escape it.
-      char rep[3] = { '%', s_base16_table[((c >> 3) & 0x1E) + lcase],
-                           s_base16_table[((c << 1) & 0x1E) + lcase] };
-      // Replace this character with the escape string.
-      text.replace(nread - 1, 1, rep, 3);
-      nread += 2;
+    while(slen - nread >= 16) {
+      __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(wptr), do_base64_encode_ssse3_block(in));
+      wptr += 16;
+      nread += 12;
     }
-    return text;
+    return nread;
   }
 
-template<bool queryT>
-V_string do_url_decode(const V_string& text)
+__attribute__((__target__("avx2")))
+size_t
+do_base64_encode_avx2(char*& wptr, const char* sptr, size_t slen)
+noexcept
   {
-    V_string data = text;
-    // Only modify the string as needed, without causing copies on write.
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                             'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
     size_t nread = 0;
-    while(nread != data.size()) {
-      // Look for a character.
-      char c = data[nread++];
-      if(queryT) {
-        // This is the only special case.
-        if(c == '+') {
-          data.mut(nread - 1) = ' ';
-          continue;
-        }
-      }
-      if(c != '%') {
-        if(do_is_url_invalid_char(c)) {
-          ASTERIA_THROW("invalid character in URL (character `$1`)", c);
-        }
-        continue;
-      }
-      // Two hexadecimal characters shall follow.
-      if(data.size() - nread < 2) {
-        ASTERIA_THROW("no enough hexadecimal digits after `%`");
-      }
-      // Parse the first digit.
-      c = data[nread++];
-      const char* pos = do_xstrchr(s_base16_table, c);
-      if(!pos) {
-        ASTERIA_THROW("invalid hexadecimal digit (character `$1`)", c);
-      }
-      uint32_t reg = static_cast<uint32_t>(pos - s_base16_table) / 2 * 16;
-      // Parse the second digit.
-      c = data[nread++];
-      pos = do_xstrchr(s_base16_table, c);
-      if(!pos) {
-        ASTERIA_THROW("invalid hexadecimal digit (character `$1`)", c);
-      }
-      reg |= static_cast<uint32_t>(pos - s_base16_table) / 2;
-      // Replace this sequence with the decoded byte.
-      data.replace(nread - 3, 3, 1, static_cast<char>(reg));
-      nread -= 2;
+    while(slen - nread >= 28) {
+      // Each lane takes 12 bytes.
+      __m256i in = _mm256_inserti128_si256(
+                       _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread))),
+                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread + 12)), 1);
+      in = _mm256_shuffle_epi8(in, shuffle);
+      __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)),
+                                      _mm256_set1_epi32(0x04000040));
+      __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)),
+                                      _mm256_set1_epi32(0x01000010));
+      __m256i idx = _mm256_or_si256(t0, t1);
+      __m256i r = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+      r = _mm256_or_si256(r, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx),
+                                              _mm256_set1_epi8(13)));
+      r = _mm256_add_epi8(idx, _mm256_shuffle_epi8(offsets, r));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(wptr), r);
+      wptr += 32;
+      nread += 24;
+    }
+    return nread;
+  }
+
+// https://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+// These stop before the first group that contains a character other than a digit, such as
+// a whitespace or padding character. As at least 24 (or 48) characters are required, the
+// output buffer can hold 16 (or 32) bytes, although fewer are produced.
+__attribute__((__target__("ssse3")))
+size_t
+do_base64_decode_ssse3(char*& wptr, const char* sptr, size_t slen)
+noexcept
+  {
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                         0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2F);
+    size_t nread = 0;
+    while(slen - nread >= 24) {
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread));
+      __m128i hi = _mm_and_si128(_mm_srli_epi32(c, 4), mask_2f);
+      __m128i lo = _mm_and_si128(c, mask_2f);
+      __m128i t = _mm_and_si128(_mm_shuffle_epi8(lut_lo, lo), _mm_shuffle_epi8(lut_hi, hi));
+      auto bad = static_cast<uint32_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(t, _mm_setzero_si128())) & 0xFFFF);
+      // Map characters to values, then merge them into bytes.
+      __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(c, mask_2f), hi));
+      __m128i v = _mm_add_epi8(c, roll);
+      v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+      v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+      v = _mm_shuffle_epi8(v, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(wptr), v);
+      // Accept only complete groups before the first invalid character.
+      size_t ngroups = bad ? static_cast<uint32_t>(__builtin_ctz(bad)) / 4 : 4;
+      wptr += ngroups * 3;
+      nread += ngroups * 4;
+      if(ngroups != 4)
+        break;
     }
-    return data;
+    return nread;
   }
 
-template<bool bigendT, typename WordT>
-V_string&
-do_pack_one_impl(V_string& text, const V_integer& value)
+__attribute__((__target__("avx2")))
+size_t
+do_base64_decode_avx2(char*& wptr, const char* sptr, size_t slen)
+noexcept
   {
-    // Define temporary storage.
-    array<char, sizeof(WordT)> stor_le;
-    uint64_t word = static_cast<uint64_t>(value);
-    // Write it in little-endian order.
-    for(size_t i = 0;  i < stor_le.size();  ++i) {
-      stor_le[i] = static_cast<char>(word);
-      word >>= 8;
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+    size_t nread = 0;
+    while(slen - nread >= 48) {
+      __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr + nread));
+      __m256i hi = _mm256_and_si256(_mm256_srli_epi32(c, 4), mask_2f);
+      __m256i lo = _mm256_and_si256(c, mask_2f);
+      __m256i t = _mm256_and_si256(_mm256_shuffle_epi8(lut_lo, lo), _mm256_shuffle_epi8(lut_hi, hi));
+      auto bad = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(t, _mm256_setzero_si256())));
+      // Map characters to values, then merge them into bytes.
+      __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(c, mask_2f), hi));
+      __m256i v = _mm256_add_epi8(c, roll);
+      v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+      v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+      v = _mm256_shuffle_epi8(v, pack);
+      v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(wptr), v);
+      // Accept only complete groups before the first invalid character.
+      size_t ngroups = bad ? static_cast<uint32_t>(__builtin_ctz(bad)) / 4 : 8;
+      wptr += ngroups * 3;
+      nread += ngroups * 4;
+      if(ngroups != 8)
+        break;
     }
-    // Append this word.
-    if(bigendT)
-      text.append(stor_le.rbegin(), stor_le.rend());
+    return nread;
+  }
+
+__attribute__((__target__("ssse3")))
+size_t
+do_hex_encode_ssse3(char*& wptr, const char* sptr, size_t slen, bool rlowerc)
+noexcept
+  {
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                               rlowerc ? "0123456789abcdef" : "0123456789ABCDEF"));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t nread = 0;
+    while(slen - nread >= 16) {
+      __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread));
+      __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+      __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, nibble));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(wptr), _mm_unpacklo_epi8(hi, lo));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(wptr + 16), _mm_unpackhi_epi8(hi, lo));
+      wptr += 32;
+      nread += 16;
+    }
+    return nread;
+  }
+
+__attribute__((__target__("avx2")))
+size_t
+do_hex_encode_avx2(char*& wptr, const char* sptr, size_t slen, bool rlowerc)
+noexcept
+  {
+    const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                               rlowerc ? "0123456789abcdef" : "0123456789ABCDEF")));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t nread = 0;
+    while(slen - nread >= 32) {
+      // Reorder 64-bit words, as bytes are unpacked within lanes.
+      __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr + nread));
+      in = _mm256_permute4x64_epi64(in, 0xD8);
+      __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+      __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(in, nibble));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(wptr), _mm256_unpacklo_epi8(hi, lo));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(wptr + 32), _mm256_unpackhi_epi8(hi, lo));
+      wptr += 64;
+      nread += 32;
+    }
+    return nread;
+  }
+
+// These stop before the first pair that contains a character other than a hexadecimal
+// digit, such as a whitespace.
+__attribute__((__target__("ssse3")))
+size_t
+do_hex_decode_ssse3(char*& wptr, const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = 0;
+    while(slen - nread >= 16) {
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sptr + nread));
+      __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+      __m128i is_d = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+      __m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+      __m128i is_l = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+      auto bad = static_cast<uint32_t>(~_mm_movemask_epi8(_mm_or_si128(is_d, is_l)) & 0xFFFF);
+      // Merge pairs of digits into bytes.
+      __m128i v = _mm_or_si128(_mm_and_si128(is_d, d),
+                               _mm_and_si128(is_l, _mm_add_epi8(l, _mm_set1_epi8(10))));
+      v = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0110));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(wptr), _mm_packus_epi16(v, v));
+      // Accept only complete pairs before the first invalid character.
+      size_t npairs = bad ? static_cast<uint32_t>(__builtin_ctz(bad)) / 2 : 8;
+      wptr += npairs;
+      nread += npairs * 2;
+      if(npairs != 8)
+        break;
+    }
+    return nread;
+  }
+
+__attribute__((__target__("avx2")))
+size_t
+do_hex_decode_avx2(char*& wptr, const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = 0;
+    while(slen - nread >= 32) {
+      __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr + nread));
+      __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+      __m256i is_d = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+      __m256i l = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+      __m256i is_l = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+      auto bad = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_d, is_l)));
+      // Merge pairs of digits into bytes. Packing is done within lanes.
+      __m256i v = _mm256_or_si256(_mm256_and_si256(is_d, d),
+                                  _mm256_and_si256(is_l, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+      v = _mm256_maddubs_epi16(v, _mm256_set1_epi16(0x0110));
+      v = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0xD8);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(wptr), _mm256_castsi256_si128(v));
+      // Accept only complete pairs before the first invalid character.
+      size_t npairs = bad ? static_cast<uint32_t>(__builtin_ctz(bad)) / 2 : 16;
+      wptr += npairs;
+      nread += npairs * 2;
+      if(npairs != 16)
+        break;
+    }
+    return nread;
+  }
+
+// These dispatch to the SIMD kernels above. Unlike the kernels, they may be called on any CPU.
+size_t
+do_base64_encode_simd(char*& wptr, const char* sptr, size_t slen)
+noexcept
+  {
+    size_t nread = 0;
+    if(do_cpu_has_avx2())
+      nread += do_base64_encode_avx2(wptr, sptr, slen);
+    if(do_cpu_has_ssse3())
+      nread += do_base64_encode_ssse3(wptr, sptr + nread, slen - nread);
+    return nread;
+  }
+
+size_t
+do_base64_decode_simd(char*& wptr, const char* sptr, size_t slen)
+noexcept
+  {
+    if(do_cpu_has_avx2())
+      return do_base64_decode_avx2(wptr, sptr, slen);
+    if(do_cpu_has_ssse3())
+      return do_base64_decode_ssse3(wptr, sptr, slen);
+    return 0;
+  }
+
+size_t
+do_hex_encode_simd(char*& wptr, const char* sptr, size_t slen, bool rlowerc)
+noexcept
+  {
+    size_t nread = 0;
+    if(do_cpu_has_avx2())
+      nread += do_hex_encode_avx2(wptr, sptr, slen, rlowerc);
+    if(do_cpu_has_ssse3())
+      nread += do_hex_encode_ssse3(wptr, sptr + nread, slen - nread, rlowerc);
+    return nread;
+  }
+
+size_t
+do_hex_decode_simd(char*& wptr, const char* sptr, size_t slen)
+noexcept
+  {
+    if(do_cpu_has_avx2())
+      return do_hex_decode_avx2(wptr, sptr, slen);
+    if(do_cpu_has_ssse3())
+      return do_hex_decode_ssse3(wptr, sptr, slen);
+    return 0;
+  }
+
+#else  // ASTERIA_STRING_X86_
+
+// There are no SIMD kernels, so everything is left to scalar code.
+constexpr
+size_t
+do_base64_encode_simd(char*& /*wptr*/, const char* /*sptr*/, size_t /*slen*/)
+noexcept
+  { return 0;  }
+
+constexpr
+size_t
+do_base64_decode_simd(char*& /*wptr*/, const char* /*sptr*/, size_t /*slen*/)
+noexcept
+  { return 0;  }
+
+constexpr
+size_t
+do_hex_encode_simd(char*& /*wptr*/, const char* /*sptr*/, size_t /*slen*/, bool /*rlowerc*/)
+noexcept
+  { return 0;  }
+
+constexpr
+size_t
+do_hex_decode_simd(char*& /*wptr*/, const char* /*sptr*/, size_t /*slen*/)
+noexcept
+  { return 0;  }
+
+#endif  // ASTERIA_STRING_X86_
+
+// These functions append the result to `text` or `data`. Decoders are resumable, as states of
+// partial groups are passed in and out via `reg` (and `npad`).
+V_string&
+do_hex_encode(V_string& text, const char* sptr, size_t slen, bool rlowerc,
+              const char* dptr, size_t dlen, bool first)
+  {
+    if(slen == 0) {
+      return text;
+    }
+    // Allocate the output buffer in advance.
+    size_t ndelims = first ? (slen - 1) : slen;
+    size_t off = text.size();
+    char* wptr = text.append(slen * 2 + ndelims * dlen, '*').mut_data() + off;
+    // Encode source data. Without delimiters, blocks may be encoded with SIMD instructions.
+    size_t nread = 0;
+    if(dlen == 0)
+      nread = do_hex_encode_simd(wptr, sptr, slen, rlowerc);
+    for(;  nread != slen;  ++nread) {
+      // Insert a delimiter before every byte other than the first one.
+      if((nread != 0) || !first) {
+        ::std::memcpy(wptr, dptr, dlen);
+        wptr += dlen;
+      }
+      // Encode a byte.
+      uint32_t b = sptr[nread] & 0xFF;
+      *(wptr++) = s_base16_table[(b >> 4) * 2 + rlowerc];
+      *(wptr++) = s_base16_table[(b & 15) * 2 + rlowerc];
+    }
+    return text;
+  }
+
+V_string&
+do_hex_decode(V_string& data, const char* sptr, size_t slen, uint32_t& reg)
+  {
+    // Allocate the output buffer in advance. It will be truncated at the end.
+    size_t off = data.size();
+    char* wbase = data.append((slen + 1) / 2, '*').mut_data();
+    char* wptr = wbase + off;
+    // Decode source data.
+    size_t nread = 0;
+    while(nread != slen) {
+      if(reg == 1) {
+        // Decode blocks with SIMD instructions if possible.
+        size_t nblk = do_hex_decode_simd(wptr, sptr + nread, slen - nread);
+        nread += nblk;
+        if(nblk != 0)
+          continue;
+      }
+      if((reg == 1) && (slen - nread >= 2)) {
+        // Decode a complete group at once if possible.
+        uint32_t d0 = s_base16_digits.vals[uint8_t(sptr[nread+0])];
+        uint32_t d1 = s_base16_digits.vals[uint8_t(sptr[nread+1])];
+        if((d0 | d1) < 16) {
+          *(wptr++) = static_cast<char>(d0 << 4 | d1);
+          nread += 2;
+          continue;
+        }
+      }
+      // Read and identify a character.
+      char c = sptr[nread++];
+      if(is_cctype(c, cctype_space)) {
+        // The character is a whitespace.
+        if(reg != 1) {
+          ASTERIA_THROW("unpaired hexadecimal digit");
+        }
+        continue;
+      }
+      reg <<= 4;
+      // Decode a digit.
+      uint32_t dval = s_base16_digits.vals[uint8_t(c)];
+      if(dval == 0xFF) {
+        ASTERIA_THROW("invalid hexadecimal digit (character `$1`)", c);
+      }
+      reg |= dval;
+      // Decode the current group if it is complete.
+      if(!(reg & 0x1'00)) {
+        continue;
+      }
+      *(wptr++) = static_cast<char>(reg);
+      reg = 1;
+    }
+    data.erase(static_cast<size_t>(wptr - wbase));
+    return data;
+  }
+
+V_string&
+do_base64_encode(V_string& text, const char* sptr, size_t slen)
+  {
+    // Allocate the output buffer in advance, filled with padding characters.
+    size_t off = text.size();
+    char* wptr = text.append((slen + 2) / 3 * 4, s_base64_table[64]).mut_data() + off;
+    // These shall be operated in big-endian order.
+    uint32_t reg;
+    // Encode source data. Blocks may be encoded with SIMD instructions.
+    size_t nread = do_base64_encode_simd(wptr, sptr, slen);
+    while(slen - nread >= 3) {
+      // Read 3 consecutive bytes.
+      reg = 0;
+      for(size_t i = 0;  i < 3;  ++i)
+        reg = reg << 8 | (sptr[nread++] & 0xFF);
+      // Encode them.
+      for(size_t i = 0;  i < 4;  ++i)
+        *(wptr++) = s_base64_table[reg >> (18 - i * 6) & 63];
+    }
+    if(nread != slen) {
+      // Get the start of padding characters.
+      size_t m = slen - nread;
+      size_t p = (m * 8 + 5) / 6;
+      // Read all remaining bytes that cannot fill up a unit.
+      reg = 0;
+      for(size_t i = 0;  i < 3;  ++i)
+        reg = reg << 8 | ((i < m) ? (sptr[nread++] & 0xFF) : 0);
+      // Encode them. Padding characters have been filled.
+      for(size_t i = 0;  i < p;  ++i)
+        *(wptr++) = s_base64_table[reg >> (18 - i * 6) & 63];
+    }
+    return text;
+  }
+
+V_string&
+do_base64_decode(V_string& data, const char* sptr, size_t slen, uint32_t& reg, uint32_t& npad)
+  {
+    // Allocate the output buffer in advance. It will be truncated at the end.
+    size_t off = data.size();
+    char* wbase = data.append((slen + 3) / 4 * 3, '*').mut_data();
+    char* wptr = wbase + off;
+    // Decode source data.
+    size_t nread = 0;
+    while(nread != slen) {
+      if(reg == 1) {
+        // Decode blocks with SIMD instructions if possible.
+        size_t nblk = do_base64_decode_simd(wptr, sptr + nread, slen - nread);
+        nread += nblk;
+        if(nblk != 0)
+          continue;
+      }
+      if((reg == 1) && (slen - nread >= 4)) {
+        // Decode a complete group at once if possible.
+        uint32_t dreg = 0;
+        uint32_t dbad = 0;
+        for(size_t i = 0;  i < 4;  ++i) {
+          uint32_t dval = s_base64_digits.vals[uint8_t(sptr[nread+i])];
+          dbad |= dval;
+          dreg = dreg << 6 | (dval & 63);
+        }
+        if(dbad < 64) {
+          for(size_t i = 0;  i < 3;  ++i)
+            *(wptr++) = static_cast<char>(dreg >> (16 - i * 8));
+          nread += 4;
+          continue;
+        }
+      }
+      // Read and identify a character.
+      char c = sptr[nread++];
+      if(is_cctype(c, cctype_space)) {
+        // The character is a whitespace.
+        if(reg != 1) {
+          ASTERIA_THROW("incomplete base64 group");
+        }
+        continue;
+      }
+      reg <<= 6;
+      if(c == s_base64_table[64]) {
+        // The character is a padding character.
+        if(reg < 0x100) {
+          ASTERIA_THROW("unexpected base64 padding character");
+        }
+        npad += 1;
+      }
+      else {
+        // Decode a digit.
+        uint32_t dval = s_base64_digits.vals[uint8_t(c)];
+        if(dval == 0xFF) {
+          ASTERIA_THROW("invalid base64 digit (character `$1`)", c);
+        }
+        if(npad != 0) {
+          ASTERIA_THROW("unexpected base64 digit following padding character");
+        }
+        reg |= dval;
+      }
+      // Decode the current group if it is complete.
+      if(!(reg & 0x1'00'00'00)) {
+        continue;
+      }
+      size_t m = (24 - npad * 6) / 8;
+      size_t p = (m * 8 + 5) / 6;
+      if(p + npad != 4) {
+        ASTERIA_THROW("unexpected number of base64 padding characters (got `$1`)", npad);
+      }
+      for(size_t i = 0; i < m; ++i) {
+        reg <<= 8;
+        *(wptr++) = static_cast<char>(reg >> 24);
+      }
+      reg = 1;
+      npad = 0;
+    }
+    data.erase(static_cast<size_t>(wptr - wbase));
+    return data;
+  }
+
+// These are streaming encoders and decoders. Partial groups are carried from one chunk to
+// the next, so data of arbitrary sizes may be transcoded in constant memory.
+class Hex_Encoder
+final
+  : public Abstract_Opaque
+  {
+  private:
+    bool m_lowerc;
+    V_string m_delim;
+    bool m_first = true;
+
+  public:
+    explicit
+    Hex_Encoder(bool lowerc, const V_string& delim)
+      : m_lowerc(lowerc), m_delim(delim)
+      { }
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "hex encoder";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    Hex_Encoder*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override
+      {
+        auto qnew = ::rocket::make_unique<Hex_Encoder>(*this);
+        output.reset(qnew.get());
+        return qnew.release();
+      }
+
+    V_string
+    update(const V_string& data)
+      {
+        V_string text;
+        do_hex_encode(text, data.data(), data.size(), this->m_lowerc,
+                      this->m_delim.data(), this->m_delim.size(), this->m_first);
+        this->m_first &= data.empty();
+        return text;
+      }
+
+    V_string
+    finish()
+      {
+        // Reset internal states.
+        this->m_first = true;
+        return nullopt;
+      }
+  };
+
+class Hex_Decoder
+final
+  : public Abstract_Opaque
+  {
+  private:
+    uint32_t m_reg = 1;
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "hex decoder";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    Hex_Decoder*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override
+      {
+        auto qnew = ::rocket::make_unique<Hex_Decoder>(*this);
+        output.reset(qnew.get());
+        return qnew.release();
+      }
+
+    V_string
+    update(const V_string& text)
+      {
+        // Update states only if no exception is thrown.
+        V_string data;
+        uint32_t reg = this->m_reg;
+        do_hex_decode(data, text.data(), text.size(), reg);
+        this->m_reg = reg;
+        return data;
+      }
+
+    V_string
+    finish()
+      {
+        // Reset internal states.
+        uint32_t reg = ::std::exchange(this->m_reg, 1U);
+        if(reg != 1) {
+          ASTERIA_THROW("unpaired hexadecimal digit");
+        }
+        return nullopt;
+      }
+  };
+
+class Base64_Encoder
+final
+  : public Abstract_Opaque
+  {
+  private:
+    char m_carry[3];
+    size_t m_ncarry = 0;
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "base64 encoder";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    Base64_Encoder*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override
+      {
+        auto qnew = ::rocket::make_unique<Base64_Encoder>(*this);
+        output.reset(qnew.get());
+        return qnew.release();
+      }
+
+    V_string
+    update(const V_string& data)
+      {
+        V_string text;
+        size_t nread = 0;
+        // Complete the pending group, if any.
+        if(this->m_ncarry != 0) {
+          while((this->m_ncarry < 3) && (nread != data.size()))
+            this->m_carry[this->m_ncarry++] = data[nread++];
+          if(this->m_ncarry < 3)
+            return text;
+          do_base64_encode(text, this->m_carry, 3);
+          this->m_ncarry = 0;
+        }
+        // Encode all complete groups.
+        size_t nbulk = (data.size() - nread) / 3 * 3;
+        do_base64_encode(text, data.data() + nread, nbulk);
+        nread += nbulk;
+        // Save remaining bytes for the next call.
+        while(nread != data.size())
+          this->m_carry[this->m_ncarry++] = data[nread++];
+        return text;
+      }
+
+    V_string
+    finish()
+      {
+        // Encode the final group with padding characters, then reset internal states.
+        V_string text;
+        do_base64_encode(text, this->m_carry, ::std::exchange(this->m_ncarry, size_t(0)));
+        return text;
+      }
+  };
+
+class Base64_Decoder
+final
+  : public Abstract_Opaque
+  {
+  private:
+    uint32_t m_reg = 1;
+    uint32_t m_npad = 0;
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "base64 decoder";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    Base64_Decoder*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override
+      {
+        auto qnew = ::rocket::make_unique<Base64_Decoder>(*this);
+        output.reset(qnew.get());
+        return qnew.release();
+      }
+
+    V_string
+    update(const V_string& text)
+      {
+        // Update states only if no exception is thrown.
+        V_string data;
+        uint32_t reg = this->m_reg;
+        uint32_t npad = this->m_npad;
+        do_base64_decode(data, text.data(), text.size(), reg, npad);
+        this->m_reg = reg;
+        this->m_npad = npad;
+        return data;
+      }
+
+    V_string
+    finish()
+      {
+        // Reset internal states.
+        uint32_t reg = ::std::exchange(this->m_reg, 1U);
+        this->m_npad = 0;
+        if(reg != 1) {
+          ASTERIA_THROW("incomplete base64 group");
+        }
+        return nullopt;
+      }
+  };
+
+template<typename CodecT>
+rcptr<CodecT>
+do_cast_codec(V_opaque& h)
+  {
+    auto qh = h.open_opt<CodecT>();
+    if(!qh)
+      ASTERIA_THROW("invalid dynamic cast to type `$1` from type `$2`",
+                    typeid(CodecT).name(), h.type().name());
+    return qh;
+  }
+
+template<bool queryT>
+V_string
+do_url_encode(const V_string& data, bool lcase)
+  {
+    V_string text;
+    // Copy runs of characters that need no escaping as a whole.
+    // `bpos` is the beginning of the current run.
+    size_t bpos = 0;
+    size_t nread = 0;
+    while(nread != data.size()) {
+      // Skip characters that need no escaping, in blocks if possible.
+      nread += do_byte_span(queryT ? s_url_encode_query_plain : s_url_encode_plain,
+                            data.data() + nread, data.size() - nread, true);
+      if(nread == data.size())
+        break;
+      // Check whether this character has no special meaning.
+      char c = data[nread++];
+      if(queryT) {
+        // This is the only special case.
+        if(c == ' ') {
+          text.append(data.data() + bpos, nread - 1 - bpos);
+          text += '+';
+          bpos = nread;
+          continue;
+        }
+        if(do_is_url_query_char(c))
+          continue;
+      }
+      else {
+        if(do_is_url_unreserved_char(c))
+          continue;
+      }
+      // Escape it.
+      char rep[3] = { '%', s_base16_table[((c >> 3) & 0x1E) + lcase],
+                           s_base16_table[((c << 1) & 0x1E) + lcase] };
+      text.append(data.data() + bpos, nread - 1 - bpos);
+      text.append(rep, 3);
+      bpos = nread;
+    }
+    if(bpos == 0) {
+      // Nothing has been escaped. Make use of reference counting.
+      return data;
+    }
+    text.append(data.data() + bpos, data.size() - bpos);
+    return text;
+  }
+
+template<bool queryT>
+V_string do_url_decode(const V_string& text)
+  {
+    V_string data;
+    // Copy runs of characters that need no decoding as a whole.
+    // `bpos` is the beginning of the current run.
+    size_t bpos = 0;
+    size_t nread = 0;
+    while(nread != text.size()) {
+      // Skip characters that need no decoding, in blocks if possible.
+      nread += do_byte_span(queryT ? s_url_decode_query_plain : s_url_decode_plain,
+                            text.data() + nread, text.size() - nread, true);
+      if(nread == text.size())
+        break;
+      // Look for a character.
+      char c = text[nread++];
+      if(queryT) {
+        // This is the only special case.
+        if(c == '+') {
+          data.append(text.data() + bpos, nread - 1 - bpos);
+          data += ' ';
+          bpos = nread;
+          continue;
+        }
+      }
+      if(c != '%') {
+        if(do_is_url_invalid_char(c)) {
+          ASTERIA_THROW("invalid character in URL (character `$1`)", c);
+        }
+        continue;
+      }
+      // Two hexadecimal characters shall follow.
+      if(text.size() - nread < 2) {
+        ASTERIA_THROW("no enough hexadecimal digits after `%`");
+      }
+      // Parse the first digit.
+      c = text[nread++];
+      uint32_t dval = s_base16_digits.vals[uint8_t(c)];
+      if(dval == 0xFF) {
+        ASTERIA_THROW("invalid hexadecimal digit (character `$1`)", c);
+      }
+      uint32_t reg = dval * 16;
+      // Parse the second digit.
+      c = text[nread++];
+      dval = s_base16_digits.vals[uint8_t(c)];
+      if(dval == 0xFF) {
+        ASTERIA_THROW("invalid hexadecimal digit (character `$1`)", c);
+      }
+      reg |= dval;
+      // Replace this sequence with the decoded byte.
+      data.append(text.data() + bpos, nread - 3 - bpos);
+      data += static_cast<char>(reg);
+      bpos = nread;
+    }
+    if(bpos == 0) {
+      // Nothing has been decoded. Make use of reference counting.
+      return text;
+    }
+    data.append(text.data() + bpos, text.size() - bpos);
+    return data;
+  }
+
+template<bool bigendT, typename WordT>
+V_string&
+do_pack_one_impl(V_string& text, const V_integer& value)
+  {
+    // Define temporary storage.
+    array<char, sizeof(WordT)> stor_le;
+    uint64_t word = static_cast<uint64_t>(value);
+    // Write it in little-endian order.
+    for(size_t i = 0;  i < stor_le.size();  ++i) {
+      stor_le[i] = static_cast<char>(word);
+      word >>= 8;
+    }
+    // Append this word.
+    if(bigendT)
+      text.append(stor_le.rbegin(), stor_le.rend());
     else
       text.append(stor_le.begin(), stor_le.end());
     // Return  the output string.
     return text;
   }
 
-template<typename WordT>
-V_string&
-do_pack_one_be(V_string& text, const V_integer& value)
-  { return do_pack_one_impl<1, WordT>(text, value);  }
+template<typename WordT>
+V_string&
+do_pack_one_be(V_string& text, const V_integer& value)
+  { return do_pack_one_impl<1, WordT>(text, value);  }
+
+template<typename WordT>
+V_string&
+do_pack_one_le(V_string& text, const V_integer& value)
+  { return do_pack_one_impl<0, WordT>(text, value);  }
+
+template<bool bigendT, typename WordT>
+V_array
+do_unpack_impl(const V_string& text)
+  {
+    V_array values;
+    // Define temporary storage.
+    array<char, sizeof(WordT)> stor_be;
+    uint64_t word = 0;
+    // How many words will the result have?
+    auto nwords = text.size() / stor_be.size();
+    if(text.size() != nwords * stor_be.size()) {
+      ASTERIA_THROW("invalid source string length (`$1` not divisible by `$2`)", text.size(), stor_be.size());
+    }
+    values.reserve(nwords);
+    // Unpack integers.
+    for(size_t i = 0;  i < nwords;  ++i) {
+      // Read some bytes in big-endian order.
+      if(bigendT)
+        ::std::copy_n(text.data() + i * stor_be.size(), stor_be.size(), stor_be.mut_begin());
+      else
+        ::std::copy_n(text.data() + i * stor_be.size(), stor_be.size(), stor_be.mut_rbegin());
+      // Assemble the word.
+      for(const auto& byte : stor_be) {
+        word <<= 8;
+        word |= static_cast<uint8_t>(byte);
+      }
+      // Append the word.
+      values.emplace_back(V_integer(static_cast<WordT>(word)));
+    }
+    return values;
+  }
+
+template<typename WordT>
+V_array
+do_unpack_be(const V_string& text)
+  { return do_unpack_impl<1, WordT>(text);  }
+
+template<typename WordT>
+V_array
+do_unpack_le(const V_string& text)
+  { return do_unpack_impl<0, WordT>(text);  }
+
+// This is a compiled format string for `std.string.pack()` and `std.string.unpack()`.
+class Pack_Format
+final
+  : public Abstract_Opaque
+  {
+  private:
+    struct Item
+      {
+        char type;  // one of `bBhHiIqQfdsx`
+        bool bigend;
+        uint8_t width;  // number of bytes per value, or one for `s` and `x`
+        size_t count;  // repeat count, or number of bytes for `s` and `x`
+      };
+
+    cow_string m_format;
+    cow_vector<Item> m_items;
+    size_t m_nvalues = 0;
+    size_t m_nbytes = 0;
+
+  public:
+    explicit
+    Pack_Format(const cow_string& format)
+      : m_format(format)
+      {
+        // Values are big-endian by default.
+        bool bigend = true;
+        size_t off = 0;
+        while(off != format.size()) {
+          char c = format[off++];
+          // Skip spaces.
+          if(::rocket::is_any_of(c, { ' ', '\t', '\n', '\r' }))
+            continue;
+          // Set the byte order of subsequent values.
+          if(c == '<') {
+            bigend = false;
+            continue;
+          }
+          if((c == '>') || (c == '!')) {
+            bigend = true;
+            continue;
+          }
+          // Get the repeat count.
+          size_t count = 1;
+          if((c >= '0') && (c <= '9')) {
+            count = static_cast<uint8_t>(c - '0');
+            for(;;) {
+              if(off == format.size())
+                ASTERIA_THROW("repeat count not followed by a type (format `$1`)", format);
+              c = format[off++];
+              if((c < '0') || (c > '9'))
+                break;
+              count = count * 10 + static_cast<uint8_t>(c - '0');
+              if(count > 0x10000000)
+                ASTERIA_THROW("repeat count too large (format `$1`)", format);
+            }
+          }
+          // Get the type.
+          uint8_t width;
+          switch(c) {
+            case 'b':
+            case 'B':
+            case 's':
+            case 'x':
+              width = 1;
+              break;
+            case 'h':
+            case 'H':
+              width = 2;
+              break;
+            case 'i':
+            case 'I':
+            case 'f':
+              width = 4;
+              break;
+            case 'q':
+            case 'Q':
+            case 'd':
+              width = 8;
+              break;
+            default:
+              ASTERIA_THROW("invalid type `$2` in pack format (format `$1`)", format, c);
+          }
+          this->m_items.push_back({ c, bigend, width, count });
+          // Update the number of values and the number of bytes.
+          if(c == 's')
+            this->m_nvalues += 1;
+          else if(c != 'x')
+            this->m_nvalues += count;
+          this->m_nbytes += size_t(width) * count;
+          if(this->m_nbytes > 0x40000000)
+            ASTERIA_THROW("packed data too large (format `$1`)", format);
+        }
+      }
+
+  private:
+    static
+    void
+    do_store_word(char* wptr, uint64_t word, size_t width, bool bigend)
+    noexcept
+      {
+        for(size_t i = 0;  i < width;  ++i) {
+          wptr[bigend ? (width - 1 - i) : i] = static_cast<char>(word);
+          word >>= 8;
+        }
+      }
+
+    static
+    uint64_t
+    do_load_word(const char* rptr, size_t width, bool bigend)
+    noexcept
+      {
+        uint64_t word = 0;
+        for(size_t i = 0;  i < width;  ++i) {
+          word <<= 8;
+          word |= static_cast<uint8_t>(rptr[bigend ? i : (width - 1 - i)]);
+        }
+        return word;
+      }
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "pack format `" << this->m_format << "`";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    Pack_Format*
+    clone_opt(rcptr<Abstract_Opaque>& /*output*/)
+    const override
+      {
+        // Compiled formats are immutable, so they are always shared.
+        return nullptr;
+      }
+
+    V_string
+    pack(const cow_vector<Value>& values)
+    const
+      {
+        if(values.size() != this->m_nvalues)
+          ASTERIA_THROW("wrong number of values to pack (format `$1` expecting `$2`, got `$3`)",
+                        this->m_format, this->m_nvalues, values.size());
+        // Allocate the output string in one go.
+        V_string text;
+        text.append(this->m_nbytes, '\0');
+        auto wptr = text.mut_data();
+        auto qval = values.begin();
+        for(const auto& item : this->m_items) {
+          switch(item.type) {
+            case 'x':
+              // Padding bytes are zeroes.
+              wptr += item.count;
+              break;
+
+            case 's': {
+              // Copy the string, truncating or padding it with zeroes as necessary.
+              const auto& str = (qval++)->as_string();
+              ::std::memcpy(wptr, str.data(), ::rocket::min(str.size(), item.count));
+              wptr += item.count;
+              break;
+            }
+
+            case 'f':
+              for(size_t i = 0;  i < item.count;  ++i) {
+                float val = static_cast<float>((qval++)->convert_to_real());
+                uint32_t word;
+                ::std::memcpy(&word, &val, 4);
+                do_store_word(wptr, word, 4, item.bigend);
+                wptr += 4;
+              }
+              break;
+
+            case 'd':
+              for(size_t i = 0;  i < item.count;  ++i) {
+                double val = (qval++)->convert_to_real();
+                uint64_t word;
+                ::std::memcpy(&word, &val, 8);
+                do_store_word(wptr, word, 8, item.bigend);
+                wptr += 8;
+              }
+              break;
+
+            default:
+              // Integers are truncated.
+              for(size_t i = 0;  i < item.count;  ++i) {
+                auto word = static_cast<uint64_t>((qval++)->as_integer());
+                do_store_word(wptr, word, item.width, item.bigend);
+                wptr += item.width;
+              }
+              break;
+          }
+        }
+        return text;
+      }
+
+    V_array
+    unpack(const V_string& data, V_integer offset)
+    const
+      {
+        if((offset < 0) || (offset > data.ssize()))
+          ASTERIA_THROW("offset out of range (offset `$1`, data length `$2`)", offset, data.size());
+        if(data.size() - static_cast<size_t>(offset) < this->m_nbytes)
+          ASTERIA_THROW("source data too short (format `$1` expecting `$2` bytes at offset `$3`, length `$4`)",
+                        this->m_format, this->m_nbytes, offset, data.size());
+        V_array values;
+        values.reserve(this->m_nvalues);
+        auto rptr = data.data() + offset;
+        for(const auto& item : this->m_items) {
+          switch(item.type) {
+            case 'x':
+              rptr += item.count;
+              break;
+
+            case 's':
+              values.emplace_back(V_string(rptr, item.count));
+              rptr += item.count;
+              break;
+
+            case 'f':
+              for(size_t i = 0;  i < item.count;  ++i) {
+                auto word = static_cast<uint32_t>(do_load_word(rptr, 4, item.bigend));
+                float val;
+                ::std::memcpy(&val, &word, 4);
+                values.emplace_back(V_real(val));
+                rptr += 4;
+              }
+              break;
+
+            case 'd':
+              for(size_t i = 0;  i < item.count;  ++i) {
+                uint64_t word = do_load_word(rptr, 8, item.bigend);
+                double val;
+                ::std::memcpy(&val, &word, 8);
+                values.emplace_back(V_real(val));
+                rptr += 8;
+              }
+              break;
+
+            default: {
+              // Lowercase types are signed and uppercase ones are unsigned. Unsigned 64-bit
+              // integers wrap around.
+              int shift = 64 - item.width * 8;
+              bool sign = (item.type >= 'a');
+              for(size_t i = 0;  i < item.count;  ++i) {
+                uint64_t word = do_load_word(rptr, item.width, item.bigend) << shift;
+                if(sign)
+                  values.emplace_back(V_integer(static_cast<int64_t>(word) >> shift));
+                else
+                  values.emplace_back(V_integer(static_cast<int64_t>(word >> shift)));
+                rptr += item.width;
+              }
+              break;
+            }
+          }
+        }
+        return values;
+      }
+  };
+
+rcptr<const Pack_Format>
+do_cast_pack_format(const V_opaque& f)
+  {
+    auto qpf = f.cast_opt<Pack_Format>();
+    if(!qpf)
+      ASTERIA_THROW("invalid dynamic cast to type `$1` from type `$2`",
+                    typeid(Pack_Format).name(), f.type().name());
+    return qpf;
+  }
+
+V_string
+do_flip_case(const V_string& text, uint8_t lo, uint8_t hi)
+  {
+    // Use reference counting as our advantage.
+    V_string res = text;
+    char* wptr = nullptr;
+    // Check eight characters at a time. If the MSB of a byte is clear, adding `0x80 - lo` to it sets
+    // the MSB if and only if it is `lo` or greater. The sum cannot overflow into the next byte.
+    constexpr uint64_t ones = UINT64_MAX / 0xFF;
+    size_t i = 0;
+    while(res.size() - i >= 8) {
+      uint64_t word;
+      ::std::memcpy(&word, res.data() + i, 8);
+      uint64_t bits = word & ones * 0x7F;
+      uint64_t mask = (bits + ones * (0x80U - lo)) & ~(bits + ones * (0x7FU - hi)) & ~word & ones * 0x80;
+      if(mask) {
+        // Fork the string as needed.
+        if(ROCKET_UNEXPECT(!wptr)) {
+          wptr = res.mut_data();
+        }
+        // Flip bit 5 of all matching bytes.
+        word ^= mask >> 2;
+        ::std::memcpy(wptr + i, &word, 8);
+      }
+      i += 8;
+    }
+    // Translate remaining characters.
+    for(;  i < res.size();  ++i) {
+      uint8_t c = static_cast<uint8_t>(res[i]);
+      if((c < lo) || (hi < c)) {
+        continue;
+      }
+      // Fork the string as needed.
+      if(ROCKET_UNEXPECT(!wptr)) {
+        wptr = res.mut_data();
+      }
+      wptr[i] = static_cast<char>(c ^ 0x20);
+    }
+    return res;
+  }
+
+// This is a linear-time engine for regular expressions without backreferences or lookaheads.
+// Patterns are compiled into programs for a Pike VM, which runs all threads in lockstep, so
+// matching takes O(n*m) time for `n` characters and `m` instructions. Threads are ordered by
+// priority, which produces the same matches as the backtracking ECMAScript engine.
+enum Regex_Opcode : uint8_t
+  {
+    regex_op_char    = 0,  // match the character `ch`
+    regex_op_class   = 1,  // match a character in class `x`
+    regex_op_split   = 2,  // fork into `x` (preferred) and `y`
+    regex_op_jump    = 3,  // jump to `x`
+    regex_op_save    = 4,  // save the current position into slot `x`
+    regex_op_bol     = 5,  // assert beginning of text
+    regex_op_eol     = 6,  // assert end of text
+    regex_op_wordb   = 7,  // assert word boundary
+    regex_op_nwordb  = 8,  // assert non-word boundary
+    regex_op_match   = 9,  // accept the match
+  };
+
+struct Regex_Inst
+  {
+    Regex_Opcode op;
+    char ch;
+    uint32_t x;
+    uint32_t y;
+  };
+
+struct Regex_Class
+  {
+    uint32_t bits[8];
+
+    bool
+    test(char c)
+    const noexcept
+      { return (this->bits[uint8_t(c) / 32] >> (uint8_t(c) % 32)) & 1;  }
+
+    Regex_Class&
+    set(char c)
+    noexcept
+      { return this->bits[uint8_t(c) / 32] |= UINT32_C(1) << (uint8_t(c) % 32), *this;  }
+
+    Regex_Class&
+    merge(const Regex_Class& other, bool negative)
+    noexcept
+      {
+        for(size_t k = 0;  k < 8;  ++k)
+          this->bits[k] |= negative ? ~(other.bits[k]) : other.bits[k];
+        return *this;
+      }
+  };
+
+struct Regex_Node
+  {
+    enum Kind : uint8_t
+      {
+        kind_char    = 0,
+        kind_class   = 1,
+        kind_assert  = 2,
+        kind_concat  = 3,
+        kind_alter   = 4,
+        kind_group   = 5,
+        kind_repeat  = 6,
+      };
+
+    Kind kind;
+    char ch;
+    bool greedy;
+    uint32_t val;  // class, opcode of assertion, or group index
+    uint32_t rmin;
+    uint32_t rmax;
+    cow_vector<uint32_t> subs;
+  };
+
+// These are the maximum numbers of nested groups, of repetitions and of instructions.
+// Patterns that exceed them are handed over to the standard library.
+constexpr unsigned s_regex_max_depth = 64;
+constexpr uint32_t s_regex_max_repeat = 1000;
+constexpr size_t s_regex_max_insts = 10000;
+
+constexpr uint32_t s_regex_infinity = UINT32_MAX;
+
+// These are options for `Regex_Program::execute()`.
+enum : uint8_t
+  {
+    regex_exec_full      = 0x01,  // only a match of the entire text is accepted
+    regex_exec_anchored  = 0x02,  // only a match at the start position is accepted
+    regex_exec_not_null  = 0x04,  // empty matches are not accepted
+  };
+
+bool
+do_is_regex_word(char c)
+noexcept
+  {
+    return is_cctype(c, cctype_alpha | cctype_digit) || (c == '_');
+  }
+
+Regex_Class
+do_make_regex_class(char esc)
+noexcept
+  {
+    Regex_Class cls = { };
+    for(size_t k = 0;  k < 0x80;  ++k) {
+      char c = static_cast<char>(k);
+      switch(esc | 0x20) {
+        case 'd':
+          if(is_cctype(c, cctype_digit))
+            cls.set(c);
+          break;
+
+        case 'w':
+          if(do_is_regex_word(c))
+            cls.set(c);
+          break;
+
+        case 's':
+          if(is_cctype(c, cctype_space))
+            cls.set(c);
+          break;
+
+        default:
+          ASTERIA_TERMINATE("invalid character class escape (escape `$1`)", esc);
+      }
+    }
+    // Uppercase letters denote complementary classes.
+    if(esc & 0x20)
+      return cls;
+    Regex_Class ncls = { };
+    return ncls.merge(cls, true);
+  }
+
+class Regex_Program
+  {
+  private:
+    cow_vector<Regex_Inst> m_insts;
+    cow_vector<Regex_Class> m_classes;
+    size_t m_nslots = 0;
+    // This is the set of characters that may start a match.
+    Regex_Class m_first = { };
+
+    // These are used by the compiler.
+    cow_vector<Regex_Node> m_nodes;
+    const char* m_bptr = nullptr;
+    const char* m_eptr = nullptr;
+
+  private:
+    uint32_t
+    do_add_node(Regex_Node&& node)
+      {
+        this->m_nodes.emplace_back(::std::move(node));
+        return static_cast<uint32_t>(this->m_nodes.size() - 1);
+      }
+
+    uint32_t
+    do_add_class(const Regex_Class& cls)
+      {
+        this->m_classes.emplace_back(cls);
+        return static_cast<uint32_t>(this->m_classes.size() - 1);
+      }
+
+    bool
+    do_parse_hex(uint32_t& value, size_t ndigits)
+    noexcept
+      {
+        if(static_cast<size_t>(this->m_eptr - this->m_bptr) < ndigits)
+          return false;
+        value = 0;
+        for(size_t k = 0;  k < ndigits;  ++k) {
+          char c = *(this->m_bptr++);
+          if(!is_cctype(c, cctype_xdigit))
+            return false;
+          value = value * 16 + static_cast<uint32_t>((c <= '9') ? (c - '0') : ((c | 0x20) - 'a' + 10));
+        }
+        return true;
+      }
+
+    // Parses a character escape after a backslash. Character classes are not accepted.
+    bool
+    do_parse_char_escape(char& ch)
+    noexcept
+      {
+        if(this->m_bptr == this->m_eptr)
+          return false;
+        char c = *(this->m_bptr++);
+        uint32_t value;
+        switch(c) {
+          case 'f':
+            ch = '\f';
+            return true;
+
+          case 'n':
+            ch = '\n';
+            return true;
+
+          case 'r':
+            ch = '\r';
+            return true;
+
+          case 't':
+            ch = '\t';
+            return true;
+
+          case 'v':
+            ch = '\v';
+            return true;
+
+          case '0':
+            // Backreferences are not supported.
+            if((this->m_bptr != this->m_eptr) && is_cctype(*(this->m_bptr), cctype_digit))
+              return false;
+            ch = 0;
+            return true;
+
+          case 'c':
+            if((this->m_bptr == this->m_eptr) || !is_cctype(*(this->m_bptr), cctype_alpha))
+              return false;
+            ch = static_cast<char>(*(this->m_bptr++) % 32);
+            return true;
+
+          case 'x':
+            if(!this->do_parse_hex(value, 2))
+              return false;
+            ch = static_cast<char>(value);
+            return true;
+
+          case 'u':
+            // Only ASCII characters are supported.
+            if(!this->do_parse_hex(value, 4) || (value >= 0x80))
+              return false;
+            ch = static_cast<char>(value);
+            return true;
+
+          default:
+            // Other letters and digits may have special meanings.
+            if(is_cctype(c, cctype_alpha | cctype_digit))
+              return false;
+            ch = c;
+            return true;
+        }
+      }
+
+    bool
+    do_parse_bracket(uint32_t& out)
+      {
+        Regex_Class cls = { };
+        bool negative = false;
+        if((this->m_bptr != this->m_eptr) && (*(this->m_bptr) == '^')) {
+          this->m_bptr++;
+          negative = true;
+        }
+        // Empty classes are not supported.
+        if((this->m_bptr != this->m_eptr) && (*(this->m_bptr) == ']'))
+          return false;
+
+        for(;;) {
+          if(this->m_bptr == this->m_eptr)
+            return false;
+          char c = *(this->m_bptr++);
+          if(c == ']')
+            break;
+          // Character classes of POSIX are not supported.
+          if(c == '[')
+            return false;
+
+          if(c == '\\') {
+            if(this->m_bptr == this->m_eptr)
+              return false;
+            char esc = *(this->m_bptr);
+            if(::rocket::is_any_of(esc, { 'd', 'D', 'w', 'W', 's', 'S' })) {
+              this->m_bptr++;
+              cls.merge(do_make_regex_class(esc), false);
+              continue;
+            }
+            if(esc == 'b') {
+              // This is a backspace in brackets.
+              this->m_bptr++;
+              c = '\b';
+            }
+            else if(!this->do_parse_char_escape(c))
+              return false;
+          }
+
+          // Check for a range.
+          if((this->m_eptr - this->m_bptr < 2) || (this->m_bptr[0] != '-') || (this->m_bptr[1] == ']')) {
+            cls.set(c);
+            continue;
+          }
+          this->m_bptr++;
+          char d = *(this->m_bptr++);
+          if((d == '\\') && !this->do_parse_char_escape(d))
+            return false;
+          // Ranges must consist of ASCII characters.
+          if((uint8_t(c) >= 0x80) || (uint8_t(d) >= 0x80) || (d < c))
+            return false;
+          for(int k = c;  k <= d;  ++k)
+            cls.set(static_cast<char>(k));
+        }
+
+        if(negative) {
+          Regex_Class ncls = { };
+          cls = ncls.merge(cls, true);
+        }
+        Regex_Node node = { Regex_Node::kind_class, 0, false, this->do_add_class(cls), 0, 0, { } };
+        out = this->do_add_node(::std::move(node));
+        return true;
+      }
+
+    bool
+    do_parse_count(uint32_t& value)
+    noexcept
+      {
+        if((this->m_bptr == this->m_eptr) || !is_cctype(*(this->m_bptr), cctype_digit))
+          return false;
+        value = 0;
+        while((this->m_bptr != this->m_eptr) && is_cctype(*(this->m_bptr), cctype_digit)) {
+          value = value * 10 + static_cast<uint32_t>(*(this->m_bptr++) - '0');
+          if(value > s_regex_max_repeat)
+            return false;
+        }
+        return true;
+      }
 
-template<typename WordT>
-V_string&
-do_pack_one_le(V_string& text, const V_integer& value)
-  { return do_pack_one_impl<0, WordT>(text, value);  }
+    bool
+    do_is_nullable(uint32_t index)
+    const
+      {
+        const auto& node = this->m_nodes[index];
+        switch(node.kind) {
+          case Regex_Node::kind_char:
+          case Regex_Node::kind_class:
+            return false;
 
-template<bool bigendT, typename WordT>
-V_array
-do_unpack_impl(const V_string& text)
+          case Regex_Node::kind_assert:
+            return true;
+
+          case Regex_Node::kind_concat:
+            return ::std::all_of(node.subs.begin(), node.subs.end(),
+                                 [&](uint32_t k) { return this->do_is_nullable(k);  });
+
+          case Regex_Node::kind_alter:
+            return ::std::any_of(node.subs.begin(), node.subs.end(),
+                                 [&](uint32_t k) { return this->do_is_nullable(k);  });
+
+          case Regex_Node::kind_group:
+            return this->do_is_nullable(node.subs[0]);
+
+          case Regex_Node::kind_repeat:
+            return (node.rmin == 0) || this->do_is_nullable(node.subs[0]);
+
+          default:
+            ASTERIA_TERMINATE("invalid regex node kind (kind `$1`)", node.kind);
+        }
+      }
+
+    bool
+    do_parse_alternation(uint32_t& out, unsigned depth);
+
+    bool
+    do_parse_sequence(uint32_t& out, unsigned depth)
+      {
+        Regex_Node seq = { Regex_Node::kind_concat, 0, false, 0, 0, 0, { } };
+        while((this->m_bptr != this->m_eptr) && !::rocket::is_any_of(*(this->m_bptr), { '|', ')' })) {
+          char c = *(this->m_bptr++);
+          uint32_t atom;
+          bool quantifiable = true;
+
+          switch(c) {
+            case '^':
+            case '$': {
+              Regex_Node node = { Regex_Node::kind_assert, 0, false,
+                                  (c == '^') ? regex_op_bol : regex_op_eol, 0, 0, { } };
+              atom = this->do_add_node(::std::move(node));
+              quantifiable = false;
+              break;
+            }
+
+            case '.': {
+              // Any character other than line terminators
+              Regex_Class cls = { };
+              cls.merge(Regex_Class(), true);
+              cls.bits[0] &= ~((UINT32_C(1) << '\n') | (UINT32_C(1) << '\r'));
+              Regex_Node node = { Regex_Node::kind_class, 0, false, this->do_add_class(cls), 0, 0, { } };
+              atom = this->do_add_node(::std::move(node));
+              break;
+            }
+
+            case '(': {
+              uint32_t group = 0;
+              if((this->m_bptr != this->m_eptr) && (*(this->m_bptr) == '?')) {
+                // Only non-capturing groups are supported.
+                if((this->m_eptr - this->m_bptr < 2) || (this->m_bptr[1] != ':'))
+                  return false;
+                this->m_bptr += 2;
+              }
+              else {
+                // Groups are numbered by their opening parentheses.
+                // Note each capturing group occupies two slots.
+                group = static_cast<uint32_t>(this->m_nslots / 2);
+                this->m_nslots += 2;
+              }
+
+              uint32_t sub;
+              if(!this->do_parse_alternation(sub, depth + 1))
+                return false;
+              if((this->m_bptr == this->m_eptr) || (*(this->m_bptr) != ')'))
+                return false;
+              this->m_bptr++;
+
+              if(group == 0) {
+                atom = sub;
+                break;
+              }
+              Regex_Node node = { Regex_Node::kind_group, 0, false, group, 0, 0, { sub } };
+              atom = this->do_add_node(::std::move(node));
+              break;
+            }
+
+            case '[':
+              if(!this->do_parse_bracket(atom))
+                return false;
+              break;
+
+            case '\\': {
+              if(this->m_bptr == this->m_eptr)
+                return false;
+              char esc = *(this->m_bptr);
+              if(::rocket::is_any_of(esc, { 'd', 'D', 'w', 'W', 's', 'S' })) {
+                this->m_bptr++;
+                Regex_Node node = { Regex_Node::kind_class, 0, false,
+                                    this->do_add_class(do_make_regex_class(esc)), 0, 0, { } };
+                atom = this->do_add_node(::std::move(node));
+                break;
+              }
+              if((esc == 'b') || (esc == 'B')) {
+                this->m_bptr++;
+                Regex_Node node = { Regex_Node::kind_assert, 0, false,
+                                    (esc == 'b') ? regex_op_wordb : regex_op_nwordb, 0, 0, { } };
+                atom = this->do_add_node(::std::move(node));
+                quantifiable = false;
+                break;
+              }
+              if(!this->do_parse_char_escape(c))
+                return false;
+              Regex_Node node = { Regex_Node::kind_char, c, false, 0, 0, 0, { } };
+              atom = this->do_add_node(::std::move(node));
+              break;
+            }
+
+            case '*':
+            case '+':
+            case '?':
+            case '{':
+            case '}':
+            case ']':
+              // These have nothing to repeat or are handled differently by implementations.
+              return false;
+
+            default: {
+              Regex_Node node = { Regex_Node::kind_char, c, false, 0, 0, 0, { } };
+              atom = this->do_add_node(::std::move(node));
+              break;
+            }
+          }
+
+          // Parse an optional quantifier.
+          if((this->m_bptr != this->m_eptr) && ::rocket::is_any_of(*(this->m_bptr), { '*', '+', '?', '{' })) {
+            if(!quantifiable)
+              return false;
+
+            uint32_t rmin, rmax;
+            switch(*(this->m_bptr++)) {
+              case '*':
+                rmin = 0;
+                rmax = s_regex_infinity;
+                break;
+
+              case '+':
+                rmin = 1;
+                rmax = s_regex_infinity;
+                break;
+
+              case '?':
+                rmin = 0;
+                rmax = 1;
+                break;
+
+              default:
+                if(!this->do_parse_count(rmin))
+                  return false;
+                rmax = rmin;
+                if((this->m_bptr != this->m_eptr) && (*(this->m_bptr) == ',')) {
+                  this->m_bptr++;
+                  rmax = s_regex_infinity;
+                  if((this->m_bptr != this->m_eptr) && (*(this->m_bptr) != '}') && !this->do_parse_count(rmax))
+                    return false;
+                }
+                if((this->m_bptr == this->m_eptr) || (*(this->m_bptr) != '}'))
+                  return false;
+                this->m_bptr++;
+                if(rmax < rmin)
+                  return false;
+                break;
+            }
+            bool greedy = true;
+            if((this->m_bptr != this->m_eptr) && (*(this->m_bptr) == '?')) {
+              this->m_bptr++;
+              greedy = false;
+            }
+            // Empty iterations are handled specially by ECMAScript, which we don't support.
+            // This only matters when there are optional iterations, so `(a?){3}` is fine,
+            // but `(a?){2,3}` or `(a?)*` is not.
+            if((rmax != rmin) && this->do_is_nullable(atom))
+              return false;
+
+            Regex_Node node = { Regex_Node::kind_repeat, 0, greedy, 0, rmin, rmax, { atom } };
+            atom = this->do_add_node(::std::move(node));
+          }
+          seq.subs.emplace_back(atom);
+        }
+
+        if(seq.subs.size() == 1)
+          out = seq.subs[0];
+        else
+          out = this->do_add_node(::std::move(seq));
+        return true;
+      }
+
+    uint32_t
+    do_emit(Regex_Opcode op, uint32_t x = 0, uint32_t y = 0, char ch = 0)
+      {
+        Regex_Inst inst = { op, ch, x, y };
+        this->m_insts.emplace_back(inst);
+        return static_cast<uint32_t>(this->m_insts.size() - 1);
+      }
+
+    uint32_t
+    do_next_pc()
+    const noexcept
+      { return static_cast<uint32_t>(this->m_insts.size());  }
+
+    bool
+    do_generate(uint32_t index)
+      {
+        if(this->m_insts.size() > s_regex_max_insts)
+          return false;
+
+        const auto& node = this->m_nodes[index];
+        switch(node.kind) {
+          case Regex_Node::kind_char:
+            this->do_emit(regex_op_char, 0, 0, node.ch);
+            return true;
+
+          case Regex_Node::kind_class:
+            this->do_emit(regex_op_class, node.val);
+            return true;
+
+          case Regex_Node::kind_assert:
+            this->do_emit(static_cast<Regex_Opcode>(node.val));
+            return true;
+
+          case Regex_Node::kind_concat:
+            return ::std::all_of(node.subs.begin(), node.subs.end(),
+                                 [&](uint32_t k) { return this->do_generate(k);  });
+
+          case Regex_Node::kind_alter: {
+            // Each alternative but the last one is preceded by a split and followed by a jump.
+            cow_vector<uint32_t> jumps;
+            for(size_t k = 0;  k < node.subs.size() - 1;  ++k) {
+              uint32_t split = this->do_emit(regex_op_split, this->do_next_pc() + 1);
+              if(!this->do_generate(node.subs[k]))
+                return false;
+              jumps.emplace_back(this->do_emit(regex_op_jump));
+              this->m_insts.mut(split).y = this->do_next_pc();
+            }
+            if(!this->do_generate(node.subs.back()))
+              return false;
+            for(uint32_t pc : jumps)
+              this->m_insts.mut(pc).x = this->do_next_pc();
+            return true;
+          }
+
+          case Regex_Node::kind_group:
+            this->do_emit(regex_op_save, node.val * 2);
+            if(!this->do_generate(node.subs[0]))
+              return false;
+            this->do_emit(regex_op_save, node.val * 2 + 1);
+            return true;
+
+          case Regex_Node::kind_repeat: {
+            // Emit the body for the mandatory iterations.
+            for(uint32_t k = 0;  k < node.rmin;  ++k)
+              if(!this->do_generate(node.subs[0]))
+                return false;
+
+            if(node.rmax == s_regex_infinity) {
+              // Emit a loop.
+              uint32_t split = this->do_emit(regex_op_split);
+              if(!this->do_generate(node.subs[0]))
+                return false;
+              this->do_emit(regex_op_jump, split);
+              auto& inst = this->m_insts.mut(split);
+              inst.x = node.greedy ? split + 1 : this->do_next_pc();
+              inst.y = node.greedy ? this->do_next_pc() : split + 1;
+              return true;
+            }
+
+            // Emit the body for optional iterations, each of which may skip the rest.
+            cow_vector<uint32_t> splits;
+            for(uint32_t k = node.rmin;  k < node.rmax;  ++k) {
+              splits.emplace_back(this->do_emit(regex_op_split));
+              if(!this->do_generate(node.subs[0]))
+                return false;
+            }
+            for(uint32_t split : splits) {
+              auto& inst = this->m_insts.mut(split);
+              inst.x = node.greedy ? split + 1 : this->do_next_pc();
+              inst.y = node.greedy ? this->do_next_pc() : split + 1;
+            }
+            return true;
+          }
+
+          default:
+            ASTERIA_TERMINATE("invalid regex node kind (kind `$1`)", node.kind);
+        }
+      }
+
+    struct Thread_List
+      {
+        cow_vector<uint32_t> pcs;
+        cow_vector<size_t> slots;
+        cow_vector<size_t> marks;
+      };
+
+    struct Thread_Frame
+      {
+        uint32_t pc;
+        uint32_t slot;
+        size_t old;
+      };
+
+    void
+    do_add_thread(Thread_List& list, cow_vector<Thread_Frame>& stack, cow_vector<size_t>& slots,
+                  uint32_t pc0, const char* bptr, size_t pos, size_t len)
+    const
+      {
+        // Follow all instructions that consume no character.
+        // Threads are added in the order of priority.
+        constexpr uint32_t no_slot = UINT32_MAX;
+        stack.clear();
+        stack.push_back({ pc0, no_slot, 0 });
+        while(stack.size()) {
+          auto frame = stack.back();
+          stack.pop_back();
+          if(frame.slot != no_slot) {
+            // Restore a slot that was saved by a `save` instruction.
+            slots.mut(frame.slot) = frame.old;
+            continue;
+          }
+
+          uint32_t pc = frame.pc;
+          if(list.marks[pc] == pos + 1)
+            continue;
+          list.marks.mut(pc) = pos + 1;
+
+          const auto& inst = this->m_insts[pc];
+          switch(inst.op) {
+            case regex_op_jump:
+              stack.push_back({ inst.x, no_slot, 0 });
+              break;
+
+            case regex_op_split:
+              stack.push_back({ inst.y, no_slot, 0 });
+              stack.push_back({ inst.x, no_slot, 0 });
+              break;
+
+            case regex_op_save:
+              stack.push_back({ 0, inst.x, slots[inst.x] });
+              slots.mut(inst.x) = pos;
+              stack.push_back({ pc + 1, no_slot, 0 });
+              break;
+
+            case regex_op_bol:
+              if(pos == 0)
+                stack.push_back({ pc + 1, no_slot, 0 });
+              break;
+
+            case regex_op_eol:
+              if(pos == len)
+                stack.push_back({ pc + 1, no_slot, 0 });
+              break;
+
+            case regex_op_wordb:
+            case regex_op_nwordb: {
+              bool wprev = (pos != 0) && do_is_regex_word(bptr[pos-1]);
+              bool wnext = (pos != len) && do_is_regex_word(bptr[pos]);
+              if((wprev != wnext) == (inst.op == regex_op_wordb))
+                stack.push_back({ pc + 1, no_slot, 0 });
+              break;
+            }
+
+            case regex_op_char:
+            case regex_op_class:
+            case regex_op_match:
+              list.pcs.push_back(pc);
+              list.slots.append(slots.begin(), slots.end());
+              break;
+
+            default:
+              ASTERIA_TERMINATE("invalid regex opcode (opcode `$1`)", inst.op);
+          }
+        }
+      }
+
+  public:
+    size_t
+    slot_count()
+    const noexcept
+      { return this->m_nslots;  }
+
+    // Compiles `pattern`. If it is invalid or uses features that are not supported,
+    // `false` is returned, and `*this` shall not be used.
+    bool
+    compile(const cow_string& pattern)
+      {
+        this->m_bptr = pattern.data();
+        this->m_eptr = pattern.data() + pattern.size();
+        // Slots 0 and 1 denote the entire match.
+        this->m_nslots = 2;
+
+        uint32_t root;
+        if(!this->do_parse_alternation(root, 0))
+          return false;
+        if(this->m_bptr != this->m_eptr)
+          return false;
+
+        this->do_emit(regex_op_save, 0);
+        if(!this->do_generate(root))
+          return false;
+        this->do_emit(regex_op_save, 1);
+        this->do_emit(regex_op_match);
+
+        // Release memory that is no longer needed.
+        this->m_nodes.clear();
+        this->m_nodes.shrink_to_fit();
+
+        // Collect characters that may start a match. Assertions are ignored here.
+        // If the pattern may match an empty string, all characters are accepted.
+        cow_vector<bool> seen(this->m_insts.size(), false);
+        cow_vector<uint32_t> stack = { 0 };
+        while(stack.size()) {
+          uint32_t pc = stack.back();
+          stack.pop_back();
+          if(seen[pc])
+            continue;
+          seen.mut(pc) = true;
+
+          const auto& inst = this->m_insts[pc];
+          switch(inst.op) {
+            case regex_op_char:
+              this->m_first.set(inst.ch);
+              break;
+
+            case regex_op_class:
+              this->m_first.merge(this->m_classes[inst.x], false);
+              break;
+
+            case regex_op_split:
+              stack.push_back(inst.y);
+              stack.push_back(inst.x);
+              break;
+
+            case regex_op_jump:
+              stack.push_back(inst.x);
+              break;
+
+            case regex_op_match:
+              this->m_first.merge(Regex_Class(), true);
+              break;
+
+            case regex_op_save:
+            case regex_op_bol:
+            case regex_op_eol:
+            case regex_op_wordb:
+            case regex_op_nwordb:
+              stack.push_back(pc + 1);
+              break;
+
+            default:
+              ASTERIA_TERMINATE("invalid regex opcode (opcode `$1`)", inst.op);
+          }
+        }
+        return true;
+      }
+
+    // Searches `[bptr, bptr+len)` for the first match that starts at or after `start`. The
+    // characters before `start` are still examined by assertions. `opts` is a bitwise OR of
+    // `regex_exec_*` options. Upon success, `slots` receives offsets of all capturing groups
+    // from `bptr`, with `SIZE_MAX` for groups that matched nothing.
+    bool
+    execute(cow_vector<size_t>& slots, const char* bptr, size_t len, size_t start, uint8_t opts)
+    const
+      {
+        bool full = opts & regex_exec_full;
+        bool anchored = opts & (regex_exec_full | regex_exec_anchored);
+        bool not_null = opts & regex_exec_not_null;
+
+        size_t nslots = this->m_nslots;
+        Thread_List clist, nlist;
+        clist.marks.append(this->m_insts.size(), 0);
+        nlist.marks.append(this->m_insts.size(), 0);
+        cow_vector<Thread_Frame> stack;
+        cow_vector<size_t> work(nslots, SIZE_MAX);
+        bool matched = false;
+
+        this->do_add_thread(clist, stack, work, 0, bptr, start, len);
+        for(size_t pos = start;  ;  ++pos) {
+          if(clist.pcs.empty()) {
+            if(matched || anchored)
+              break;
+            // No thread is alive, so skip characters that can't start a match.
+            size_t next = pos;
+            while((next != len) && !this->m_first.test(bptr[next]))
+              next++;
+            if(next != pos) {
+              pos = next;
+              work.assign(nslots, SIZE_MAX);
+              this->do_add_thread(clist, stack, work, 0, bptr, pos, len);
+            }
+          }
+
+          nlist.pcs.clear();
+          nlist.slots.clear();
+          for(size_t k = 0;  k < clist.pcs.size();  ++k) {
+            uint32_t pc = clist.pcs[k];
+            const auto& inst = this->m_insts[pc];
+            const size_t* tslots = clist.slots.data() + k * nslots;
+
+            if(inst.op == regex_op_match) {
+              if(full && (pos != len))
+                continue;
+              if(not_null && (pos == tslots[0]))
+                continue;
+              // Accept this match. Threads of lower priority are discarded.
+              slots.assign(tslots, tslots + nslots);
+              matched = true;
+              break;
+            }
+            if(pos == len)
+              continue;
+            if((inst.op == regex_op_char) ? (bptr[pos] != inst.ch) : !this->m_classes[inst.x].test(bptr[pos]))
+              continue;
+            work.assign(tslots, tslots + nslots);
+            this->do_add_thread(nlist, stack, work, pc + 1, bptr, pos + 1, len);
+          }
+          if(pos == len)
+            break;
+
+          // If no match has been found, start a new thread from the next character,
+          // which has the lowest priority.
+          if(!matched && !anchored) {
+            work.assign(nslots, SIZE_MAX);
+            this->do_add_thread(nlist, stack, work, 0, bptr, pos + 1, len);
+          }
+          ::std::swap(clist, nlist);
+        }
+        return matched;
+      }
+  };
+
+bool
+Regex_Program::
+do_parse_alternation(uint32_t& out, unsigned depth)
   {
-    V_array values;
-    // Define temporary storage.
-    array<char, sizeof(WordT)> stor_be;
-    uint64_t word = 0;
-    // How many words will the result have?
-    auto nwords = text.size() / stor_be.size();
-    if(text.size() != nwords * stor_be.size()) {
-      ASTERIA_THROW("invalid source string length (`$1` not divisible by `$2`)", text.size(), stor_be.size());
+    if(depth > s_regex_max_depth)
+      return false;
+
+    Regex_Node alts = { Regex_Node::kind_alter, 0, false, 0, 0, 0, { } };
+    for(;;) {
+      uint32_t seq;
+      if(!this->do_parse_sequence(seq, depth))
+        return false;
+      alts.subs.emplace_back(seq);
+      if((this->m_bptr == this->m_eptr) || (*(this->m_bptr) != '|'))
+        break;
+      this->m_bptr++;
     }
-    values.reserve(nwords);
-    // Unpack integers.
-    for(size_t i = 0;  i < nwords;  ++i) {
-      // Read some bytes in big-endian order.
-      if(bigendT)
-        ::std::copy_n(text.data() + i * stor_be.size(), stor_be.size(), stor_be.mut_begin());
-      else
-        ::std::copy_n(text.data() + i * stor_be.size(), stor_be.size(), stor_be.mut_rbegin());
-      // Assemble the word.
-      for(const auto& byte : stor_be) {
-        word <<= 8;
-        word |= static_cast<uint8_t>(byte);
+
+    if(alts.subs.size() == 1)
+      out = alts.subs[0];
+    else
+      out = this->do_add_node(::std::move(alts));
+    return true;
+  }
+
+// Appends `fmt` to `res`, substituting `$&`, `$n`, `$nn`, `` $` ``, `$'` and `$$` in the way
+// of ECMAScript. `slots` denotes the current match in `[bptr, bptr+len)`, and `last` is the
+// end of the previous match, where the prefix begins.
+void
+do_format_regex_replacement(V_string& res, const char* bptr, size_t len, size_t last,
+                            const cow_vector<size_t>& slots, const V_string& fmt)
+  {
+    size_t ngroups = slots.size() / 2;
+    size_t pos = 0;
+    while(pos != fmt.size()) {
+      char c = fmt[pos++];
+      if((c != '$') || (pos == fmt.size())) {
+        res.push_back(c);
+        continue;
       }
-      // Append the word.
-      values.emplace_back(V_integer(static_cast<WordT>(word)));
+      c = fmt[pos];
+      if(c == '$') {
+        res.push_back('$');
+        pos++;
+      }
+      else if(c == '&') {
+        res.append(bptr + slots[0], bptr + slots[1]);
+        pos++;
+      }
+      else if(c == '`') {
+        res.append(bptr + last, bptr + slots[0]);
+        pos++;
+      }
+      else if(c == '\'') {
+        res.append(bptr + slots[1], bptr + len);
+        pos++;
+      }
+      else if(is_cctype(c, cctype_digit)) {
+        // Take at most two digits. Groups that don't exist or matched nothing yield nothing.
+        size_t index = static_cast<size_t>(c - '0');
+        pos++;
+        if((pos != fmt.size()) && is_cctype(fmt[pos], cctype_digit))
+          index = index * 10 + static_cast<size_t>(fmt[pos++] - '0');
+        if((index < ngroups) && (slots[index*2] != SIZE_MAX))
+          res.append(bptr + slots[index*2], bptr + slots[index*2+1]);
+      }
+      else
+        res.push_back('$');
     }
-    return values;
   }
 
-template<typename WordT>
-V_array
-do_unpack_be(const V_string& text)
-  { return do_unpack_impl<1, WordT>(text);  }
+class Regex_Pattern
+final
+  : public Abstract_Opaque
+  {
+  private:
+    cow_string m_pattern;
+    bool m_linear;
+    Regex_Program m_prog;
+    // This is created on demand if `m_linear` is set.
+    mutable uptr<::std::regex> m_stdre;
 
-template<typename WordT>
-V_array
-do_unpack_le(const V_string& text)
-  { return do_unpack_impl<0, WordT>(text);  }
+  public:
+    explicit
+    Regex_Pattern(const cow_string& pattern)
+      : m_pattern(pattern)
+      {
+        this->m_linear = this->m_prog.compile(pattern);
+        if(!this->m_linear)
+          this->do_get_std_regex();
+      }
 
-::std::regex
-do_make_regex(const V_string& pattern)
-  try {
-    return ::std::regex(pattern.data(), pattern.size());
-  }
-  catch(::std::regex_error& stdex) {
-    ASTERIA_THROW("invalid regular expression (text `$1`): $2", pattern, stdex.what());
-  }
+  private:
+    const ::std::regex&
+    do_get_std_regex()
+    const
+      try {
+        if(!this->m_stdre)
+          this->m_stdre = ::rocket::make_unique<::std::regex>(this->m_pattern.data(), this->m_pattern.size());
+        return *(this->m_stdre);
+      }
+      catch(::std::regex_error& stdex) {
+        ASTERIA_THROW("invalid regular expression (text `$1`): $2", this->m_pattern, stdex.what());
+      }
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override
+      { return fmt << "regular expression `" << this->m_pattern << "`";  }
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override
+      { return callback;  }
+
+    Regex_Pattern*
+    clone_opt(rcptr<Abstract_Opaque>& /*output*/)
+    const override
+      {
+        // Compiled patterns are immutable, so they are always shared.
+        return nullptr;
+      }
+
+    // Searches `[bptr, eptr)` for the first match, or checks whether it matches entirely if
+    // `full` is set. Upon success, `slots` receives offsets of capturing groups from `bptr`.
+    bool
+    search(cow_vector<size_t>& slots, const char* bptr, const char* eptr, bool full)
+    const
+      {
+        if(this->m_linear)
+          return this->m_prog.execute(slots, bptr, static_cast<size_t>(eptr - bptr), 0,
+                                      full ? regex_exec_full : 0);
+
+        ::std::cmatch matches;
+        if(full ? !::std::regex_match(bptr, eptr, matches, this->do_get_std_regex())
+                : !::std::regex_search(bptr, eptr, matches, this->do_get_std_regex()))
+          return false;
+        slots.clear();
+        for(const auto& m : matches) {
+          slots.emplace_back(m.matched ? static_cast<size_t>(m.first - bptr) : SIZE_MAX);
+          slots.emplace_back(m.matched ? static_cast<size_t>(m.second - bptr) : SIZE_MAX);
+        }
+        return true;
+      }
+
+    // Replaces all matches in `[bptr, eptr)` and appends the result to `res`. The format of
+    // `replacement` and the handling of empty matches are the same as `std::regex_replace()`.
+    V_string&
+    replace(V_string& res, const char* bptr, const char* eptr, const V_string& replacement)
+    const
+      {
+        if(!this->m_linear) {
+          ::std::regex_replace(::std::back_inserter(res), bptr, eptr, this->do_get_std_regex(),
+                               ::std::string(replacement.data(), replacement.size()));
+          return res;
+        }
+
+        size_t len = static_cast<size_t>(eptr - bptr);
+        cow_vector<size_t> slots;
+        size_t last = 0;  // end of the previous match
+        bool empty = false;
+        for(;;) {
+          size_t start = last;
+          if(empty) {
+            // After an empty match, try a non-empty one at the same position, then
+            // resume the search from the next character.
+            if(start == len)
+              break;
+            if(!this->m_prog.execute(slots, bptr, len, start, regex_exec_anchored | regex_exec_not_null) &&
+               !this->m_prog.execute(slots, bptr, len, start + 1, 0))
+              break;
+          }
+          else if(!this->m_prog.execute(slots, bptr, len, start, 0))
+            break;
+
+          res.append(bptr + last, bptr + slots[0]);
+          do_format_regex_replacement(res, bptr, len, last, slots, replacement);
+          last = slots[1];
+          empty = slots[0] == slots[1];
+        }
+        res.append(bptr + last, eptr);
+        return res;
+      }
+  };
 
-::std::string
-do_make_regex_replacement(const V_string& replacement)
+rcptr<const Regex_Pattern>
+do_get_regex(Global_Context& global, const V_string& pattern)
   {
-    return ::std::string(replacement.data(), replacement.size());
+    // Look for a cached pattern.
+    auto cache = global.regex_cache();
+    auto qre = ::rocket::dynamic_pointer_cast<const Regex_Pattern>(cache->get_opt(pattern));
+    if(qre)
+      return qre;
+    // Compile the pattern and put it into the cache.
+    auto qnew = ::rocket::make_refcnt<Regex_Pattern>(pattern);
+    cache->insert(pattern, qnew);
+    return qnew;
   }
 
-template<typename IterT>
-::std::sub_match<IterT>
-do_regex_search(IterT tbegin, IterT tend, const ::std::regex& pattern)
+rcptr<const Regex_Pattern>
+do_cast_regex(const V_opaque& r)
   {
-    ::std::sub_match<IterT> match;
-    ::std::match_results<IterT> matches;
-    if(::std::regex_search(tbegin, tend, matches, pattern))
-      match = matches[0];
-    return match;
+    auto qre = r.cast_opt<Regex_Pattern>();
+    if(!qre)
+      ASTERIA_THROW("invalid dynamic cast to type `$1` from type `$2`",
+                    typeid(Regex_Pattern).name(), r.type().name());
+    return qre;
   }
 
-template<typename IterT>
-::std::match_results<IterT>
-do_regex_match(IterT tbegin, IterT tend, const ::std::regex& pattern)
+opt<pair<V_integer, V_integer>>
+do_regex_find(const Regex_Pattern& re, const V_string& text, V_integer from, const optV_integer& length)
   {
-    ::std::match_results<IterT> matches;
-    ::std::regex_match(tbegin, tend, matches, pattern);
-    return matches;
+    auto range = do_slice(text, from, length);
+    auto offset = range.first - text.begin();
+    auto bptr = text.data() + offset;
+    cow_vector<size_t> slots;
+    if(!re.search(slots, bptr, bptr + (range.second - range.first), false))
+      return nullopt;
+    return ::std::make_pair(offset + static_cast<V_integer>(slots[0]),
+                            static_cast<V_integer>(slots[1] - slots[0]));
   }
 
-template<typename IterT>
-V_array
-do_regex_copy_matches(const ::std::match_results<IterT>& matches)
+optV_array
+do_regex_match(const Regex_Pattern& re, const V_string& text, V_integer from, const optV_integer& length)
   {
-    V_array rval(matches.size());
-    for(size_t i = 0;  i < matches.size();  ++i) {
-      const auto& m = matches[i];
-      if(m.matched)
-        rval.mut(i) = V_string(m.first, m.second);
+    auto range = do_slice(text, from, length);
+    auto bptr = text.data() + (range.first - text.begin());
+    cow_vector<size_t> slots;
+    if(!re.search(slots, bptr, bptr + (range.second - range.first), true))
+      return nullopt;
+    V_array rval(slots.size() / 2);
+    for(size_t i = 0;  i < rval.size();  ++i) {
+      if(slots[i*2] != SIZE_MAX)
+        rval.mut(i) = V_string(bptr + slots[i*2], bptr + slots[i*2+1]);
     }
     return rval;
   }
 
-template<typename IterT>
-V_string&
-do_regex_replace(V_string& res, IterT tbegin, IterT tend,
-                 const ::std::regex& pattern, const ::std::string& replacement)
+V_string
+do_regex_replace(const Regex_Pattern& re, const V_string& text, V_integer from, const optV_integer& length,
+                 const V_string& replacement)
   {
-    ::std::regex_replace(::std::back_inserter(res), tbegin, tend, pattern, replacement);
+    V_string res;
+    auto range = do_slice(text, from, length);
+    auto bptr = text.data() + (range.first - text.begin());
+    res.append(text.begin(), range.first);
+    re.replace(res, bptr, bptr + (range.second - range.first), replacement);
+    res.append(range.second, text.end());
     return res;
   }
 
@@ -504,7 +3343,9 @@ std_string_slice(V_string text, V_integer from, optV_integer length)
       // Use reference counting as our advantage.
       return text;
     }
-    return V_string(range.first, range.second);
+    // If the subrange is a suffix, it may share storage with `text`.
+    return text.substr(static_cast<size_t>(range.first - text.begin()),
+                       static_cast<size_t>(range.second - range.first));
   }
 
 V_string
@@ -583,47 +3424,25 @@ std_string_find_and_replace(V_string text, V_integer from, optV_integer length,
 optV_integer
 std_string_find_any_of(V_string text, V_integer from, optV_integer length, V_string accept)
   {
-    auto range = do_slice(text, from, length);
-    auto qit = do_find_of_opt(range.first, range.second, accept, true);
-    if(!qit) {
-      return nullopt;
-    }
-    return *qit - text.begin();
+    return do_find_of_opt(text, from, length, accept, true);
   }
 
 optV_integer
 std_string_find_not_of(V_string text, V_integer from, optV_integer length, V_string reject)
   {
-    auto range = do_slice(text, from, length);
-    auto qit = do_find_of_opt(range.first, range.second, reject, false);
-    if(!qit) {
-      return nullopt;
-    }
-    return *qit - text.begin();
+    return do_find_of_opt(text, from, length, reject, false);
   }
 
 optV_integer
 std_string_rfind_any_of(V_string text, V_integer from, optV_integer length, V_string accept)
   {
-    auto range = do_slice(text, from, length);
-    auto qit = do_find_of_opt(::std::make_reverse_iterator(range.second),
-                              ::std::make_reverse_iterator(range.first), accept, true);
-    if(!qit) {
-      return nullopt;
-    }
-    return text.rend() - *qit - 1;
+    return do_rfind_of_opt(text, from, length, accept, true);
   }
 
 optV_integer
 std_string_rfind_not_of(V_string text, V_integer from, optV_integer length, V_string reject)
   {
-    auto range = do_slice(text, from, length);
-    auto qit = do_find_of_opt(::std::make_reverse_iterator(range.second),
-                              ::std::make_reverse_iterator(range.first), reject, false);
-    if(!qit) {
-      return nullopt;
-    }
-    return text.rend() - *qit - 1;
+    return do_rfind_of_opt(text, from, length, reject, false);
   }
 
 V_string
@@ -641,20 +3460,23 @@ std_string_trim(V_string text, optV_string reject)
       // There is no byte to strip. Make use of reference counting.
       return text;
     }
-    // Get the index of the first byte to keep.
-    auto start = text.find_first_not_of(rchars);
-    if(start == V_string::npos) {
+    Byte_Set rset(rchars);
+    auto bptr = text.data();
+    auto eptr = bptr + text.size();
+    // Get the first byte to keep.
+    auto qstart = rset.find_opt(bptr, eptr, false);
+    if(!qstart) {
       // There is no byte to keep. Return an empty string.
       return nullopt;
     }
-    // Get the index of the last byte to keep.
-    auto end = text.find_last_not_of(rchars);
-    if((start == 0) && (end == text.size() - 1)) {
+    // Get the last byte to keep. It can't be before `qstart`.
+    auto qend = rset.rfind_opt(qstart, eptr, false);
+    if((qstart == bptr) && (qend == eptr - 1)) {
       // There is no byte to strip. Make use of reference counting.
       return text;
     }
     // Return the remaining part of `text`.
-    return text.substr(start, end + 1 - start);
+    return text.substr(static_cast<size_t>(qstart - bptr), static_cast<size_t>(qend + 1 - qstart));
   }
 
 V_string
@@ -665,18 +3487,20 @@ std_string_triml(V_string text, optV_string reject)
       // There is no byte to strip. Make use of reference counting.
       return text;
     }
-    // Get the index of the first byte to keep.
-    auto start = text.find_first_not_of(rchars);
-    if(start == V_string::npos) {
+    auto bptr = text.data();
+    auto eptr = bptr + text.size();
+    // Get the first byte to keep.
+    auto qstart = Byte_Set(rchars).find_opt(bptr, eptr, false);
+    if(!qstart) {
       // There is no byte to keep. Return an empty string.
       return nullopt;
     }
-    if(start == 0) {
+    if(qstart == bptr) {
       // There is no byte to strip. Make use of reference counting.
       return text;
     }
     // Return the remaining part of `text`.
-    return text.substr(start);
+    return text.substr(static_cast<size_t>(qstart - bptr));
   }
 
 V_string
@@ -687,18 +3511,20 @@ std_string_trimr(V_string text, optV_string reject)
       // There is no byte to strip. Make use of reference counting.
       return text;
     }
-    // Get the index of the last byte to keep.
-    auto end = text.find_last_not_of(rchars);
-    if(end == V_string::npos) {
+    auto bptr = text.data();
+    auto eptr = bptr + text.size();
+    // Get the last byte to keep.
+    auto qend = Byte_Set(rchars).rfind_opt(bptr, eptr, false);
+    if(!qend) {
       // There is no byte to keep. Return an empty string.
       return nullopt;
     }
-    if(end == text.size() - 1) {
+    if(qend == eptr - 1) {
       // There is no byte to strip. Make use of reference counting.
       return text;
     }
     // Return the remaining part of `text`.
-    return text.substr(0, end + 1);
+    return text.substr(0, static_cast<size_t>(qend + 1 - bptr));
   }
 
 V_string
@@ -738,70 +3564,55 @@ std_string_padr(V_string text, V_integer length, optV_string padding)
 V_string
 std_string_to_upper(V_string text)
   {
-    // Use reference counting as our advantage.
-    V_string res = text;
-    char* wptr = nullptr;
-    // Translate each character.
-    for(size_t i = 0;  i < res.size();  ++i) {
-      char c = res[i];
-      if((c < 'a') || ('z' < c)) {
-        continue;
-      }
-      // Fork the string as needed.
-      if(ROCKET_UNEXPECT(!wptr)) {
-        wptr = res.mut_data();
-      }
-      wptr[i] = static_cast<char>(c - 'a' + 'A');
-    }
-    return res;
+    return do_flip_case(text, 'a', 'z');
   }
 
 V_string
 std_string_to_lower(V_string text)
   {
-    // Use reference counting as our advantage.
-    V_string res = text;
-    char* wptr = nullptr;
-    // Translate each character.
-    for(size_t i = 0;  i < res.size();  ++i) {
-      char c = res[i];
-      if((c < 'A') || ('Z' < c)) {
-        continue;
-      }
-      // Fork the string as needed.
-      if(ROCKET_UNEXPECT(!wptr)) {
-        wptr = res.mut_data();
-      }
-      wptr[i] = static_cast<char>(c - 'A' + 'a');
-    }
-    return res;
+    return do_flip_case(text, 'A', 'Z');
   }
 
 V_string
 std_string_translate(V_string text, V_string inputs, optV_string outputs)
   {
-    // Use reference counting as our advantage.
-    V_string res = text;
-    char* wptr = nullptr;
-    // Translate each character.
-    for(size_t i = 0;  i < res.size();  ++i) {
-      char c = res[i];
-      auto ipos = inputs.find(c);
-      if(ipos == V_string::npos) {
+    // Build the translation table, where `-1` means the character is kept and `-2` means it is
+    // erased. Only the first occurrence of a character in `inputs` takes effect.
+    int table[256];
+    ::std::fill(table, table + 256, -1);
+    for(size_t ipos = 0;  ipos < inputs.size();  ++ipos) {
+      int& r = table[uint8_t(inputs[ipos])];
+      if(r != -1) {
         continue;
       }
-      // Fork the string as needed.
-      if(ROCKET_UNEXPECT(!wptr)) {
-        wptr = res.mut_data();
-      }
       if(!outputs || (ipos >= outputs->size())) {
-        // Erase the byte if there is no replacement.
-        // N.B. This must cause no reallocation.
-        res.erase(i--, 1);
+        r = -2;
+        continue;
+      }
+      r = uint8_t(outputs->data()[ipos]);
+    }
+
+    // Use reference counting as our advantage.
+    V_string res = text;
+    size_t i = 0;
+    while((i < res.size()) && (table[uint8_t(res[i])] == -1)) {
+      ++i;
+    }
+    if(i == res.size()) {
+      return res;
+    }
+    // Translate characters in place, compacting the string as bytes are erased.
+    // N.B. This must cause no reallocation.
+    char* wptr = res.mut_data();
+    size_t k = i;
+    for(;  i < res.size();  ++i) {
+      int r = table[uint8_t(wptr[i])];
+      if(r == -2) {
         continue;
       }
-      wptr[i] = outputs->data()[ipos];
+      wptr[k++] = (r == -1) ? wptr[i] : static_cast<char>(r);
     }
+    res.erase(k);
     return res;
   }
 
@@ -822,31 +3633,61 @@ std_string_explode(V_string text, optV_string delim, optV_integer limit)
     }
     if(!delim || delim->empty()) {
       // Split every byte.
-      segments.reserve(text.size());
-      for(size_t i = 0;  i < text.size();  ++i) {
+      size_t nsegs = static_cast<size_t>(::rocket::min(rlimit, text.size()));
+      segments.reserve(nsegs);
+      for(size_t i = 0;  i + 1 < nsegs;  ++i) {
         uint32_t b = text[i] & 0xFF;
         // Store a reference to the null-terminated string allocated statically.
         // Don't bother allocating a new buffer of only two characters.
         segments.emplace_back(V_string(::rocket::sref(s_char_table[b], 1)));
       }
+      if(nsegs == text.size())
+        segments.emplace_back(V_string(::rocket::sref(s_char_table[text.back() & 0xFF], 1)));
+      else
+        segments.emplace_back(text.substr(nsegs - 1));
       return segments;
     }
-    // Break `text` down.
-    auto bpos = text.begin();
-    auto epos = text.end();
-    for(;;) {
-      if(segments.size() + 1 >= rlimit) {
-        segments.emplace_back(V_string(bpos, epos));
-        break;
-      }
-      auto mpos = ::std::search(bpos, epos, delim->begin(), delim->end());
-      if(mpos == epos) {
-        segments.emplace_back(V_string(bpos, epos));
+    if(rlimit == 1) {
+      // The result comprises only `text`, which needn't be searched.
+      segments.emplace_back(::std::move(text));
+      return segments;
+    }
+    // Single-byte delimiters are searched for using `memchr()`. For longer ones, the table
+    // for the Boyer-Moore-Horspool algorithm is built only once.
+    uptr<BMH_Searcher> qsrch;
+    if(delim->size() > 1)
+      qsrch = ::rocket::make_unique<BMH_Searcher>(delim->begin(), delim->end());
+    auto bptr = text.data();
+    auto eptr = bptr + text.size();
+    auto do_find_delim_opt = [&](const char* tptr) -> const char*
+      {
+        if(!qsrch)
+          return static_cast<const char*>(::std::memchr(tptr, delim->front(), static_cast<size_t>(eptr - tptr)));
+        auto qmptr = qsrch->search_opt(tptr, eptr, delim->data());
+        return qmptr ? *qmptr : nullptr;
+      };
+    // Break `text` down. No more than `limit - 1` delimiters are searched for.
+    auto tptr = bptr;
+    while(segments.size() + 1 < rlimit) {
+      auto mptr = do_find_delim_opt(tptr);
+      if(!mptr)
         break;
+      if((segments.size() != 0) && (segments.size() == segments.capacity())) {
+        // Extrapolate the number of segments from the average length of those found so far,
+        // which avoids a separate counting pass and usually reallocates only once or twice.
+        size_t avg = static_cast<size_t>(tptr - bptr) / segments.size();
+        size_t nguess = segments.size() + static_cast<size_t>(eptr - tptr) / avg + 1;
+        nguess = ::rocket::max(nguess, segments.size() + segments.size() / 2);
+        segments.reserve(static_cast<size_t>(::rocket::min(nguess, rlimit)));
       }
-      segments.emplace_back(V_string(bpos, mpos));
-      bpos = mpos + delim->ssize();
+      segments.emplace_back(V_string(tptr, mptr));
+      tptr = mptr + delim->size();
     }
+    // The last segment is a suffix, which may share storage with `text`.
+    if(tptr == bptr)
+      segments.emplace_back(::std::move(text));
+    else
+      segments.emplace_back(text.substr(static_cast<size_t>(tptr - bptr)));
     return segments;
   }
 
@@ -859,8 +3700,19 @@ std_string_implode(V_array segments, optV_string delim)
       // Return an empty string.
       return text;
     }
+    if(nsegs == 1) {
+      // Share the storage of the only segment.
+      return segments.front().as_string();
+    }
+    // Calculate the length of the result, so the string can be allocated only once.
+    // This also ensures all segments are strings before anything is copied.
+    size_t dlen = delim ? delim->size() : 0;
+    size_t nchars = dlen * (nsegs - 1);
+    for(size_t i = 0;  i != nsegs;  ++i)
+      nchars += segments[i].as_string().size();
+    text.reserve(nchars);
     // Append the first string.
-    text = segments.front().as_string();
+    text.append(segments.front().as_string());
     // Any segment other than the first one follows a delimiter.
     for(size_t i = 1;  i != nsegs;  ++i) {
       if(delim) {
@@ -876,63 +3728,18 @@ std_string_hex_encode(V_string data, optV_boolean lowercase, optV_string delim)
   {
     V_string text;
     auto rdelim = delim ? ::rocket::sref(*delim) : ::rocket::sref("");
-    bool rlowerc = lowercase.value_or(false);
-    text.reserve(data.size() * (2 + rdelim.length()));
-    // These shall be operated in big-endian order.
-    uint32_t reg = 0;
-    // Encode source data.
-    size_t nread = 0;
-    while(nread != data.size()) {
-      // Insert a delimiter before every byte other than the first one.
-      if(!text.empty()) {
-        text += rdelim;
-      }
-      // Read a byte.
-      reg = data[nread++] & 0xFF;
-      reg <<= 24;
-      // Encode it.
-      for(size_t i = 0;  i < 2;  ++i) {
-        uint32_t b = ((reg >> 28) * 2 + rlowerc) & 0xFF;
-        reg <<= 4;
-        text += s_base16_table[b];
-      }
-    }
+    do_hex_encode(text, data.data(), data.size(), lowercase.value_or(false), rdelim.c_str(), rdelim.length(),
+                  true);
     return text;
   }
 
-V_string
-std_string_hex_decode(V_string text)
-  {
-    V_string data;
-    // These shall be operated in big-endian order.
-    uint32_t reg = 1;
-    // Decode source data.
-    size_t nread = 0;
-    while(nread != text.size()) {
-      // Read and identify a character.
-      char c = text[nread++];
-      const char* pos = do_xstrchr(s_spaces, c);
-      if(pos) {
-        // The character is a whitespace.
-        if(reg != 1) {
-          ASTERIA_THROW("unpaired hexadecimal digit");
-        }
-        continue;
-      }
-      reg <<= 4;
-      // Decode a digit.
-      pos = do_xstrchr(s_base16_table, c);
-      if(!pos) {
-        ASTERIA_THROW("invalid hexadecimal digit (character `$1`)", c);
-      }
-      reg |= static_cast<uint32_t>(pos - s_base16_table) / 2;
-      // Decode the current group if it is complete.
-      if(!(reg & 0x1'00)) {
-        continue;
-      }
-      data += static_cast<char>(reg);
-      reg = 1;
-    }
+V_string
+std_string_hex_decode(V_string text)
+  {
+    V_string data;
+    // These shall be operated in big-endian order.
+    uint32_t reg = 1;
+    do_hex_decode(data, text.data(), text.size(), reg);
     if(reg != 1) {
       ASTERIA_THROW("unpaired hexadecimal digit");
     }
@@ -944,47 +3751,32 @@ std_string_base32_encode(V_string data, optV_boolean lowercase)
   {
     V_string text;
     bool rlowerc = lowercase.value_or(false);
-    text.reserve((data.size() + 4) / 5 * 8);
+    // Allocate the output buffer in advance, filled with padding characters.
+    char* wptr = text.assign((data.size() + 4) / 5 * 8, s_base32_table[64]).mut_data();
     // These shall be operated in big-endian order.
-    uint64_t reg = 0;
+    uint64_t reg;
     // Encode source data.
     size_t nread = 0;
     while(data.size() - nread >= 5) {
       // Read 5 consecutive bytes.
-      for(size_t i = 0;  i < 5;  ++i) {
-        uint32_t b = data[nread++] & 0xFF;
-        reg <<= 8;
-        reg |= b;
-      }
-      reg <<= 24;
+      reg = 0;
+      for(size_t i = 0;  i < 5;  ++i)
+        reg = reg << 8 | (data[nread++] & 0xFF);
       // Encode them.
-      for(size_t i = 0;  i < 8;  ++i) {
-        uint32_t b = ((reg >> 59) * 2 + rlowerc) & 0xFF;
-        reg <<= 5;
-        text += s_base32_table[b];
-      }
+      for(size_t i = 0;  i < 8;  ++i)
+        *(wptr++) = s_base32_table[(reg >> (35 - i * 5) & 31) * 2 + rlowerc];
     }
     if(nread != data.size()) {
       // Get the start of padding characters.
       size_t m = data.size() - nread;
       size_t p = (m * 8 + 4) / 5;
       // Read all remaining bytes that cannot fill up a unit.
-      for(size_t i = 0;  i < m;  ++i) {
-        uint32_t b = data[nread++] & 0xFF;
-        reg <<= 8;
-        reg |= b;
-      }
-      reg <<= 64 - m * 8;
-      // Encode them.
-      for(size_t i = 0;  i < p;  ++i) {
-        uint32_t b = ((reg >> 59) * 2 + rlowerc) & 0xFF;
-        reg <<= 5;
-        text += s_base32_table[b];
-      }
-      // Fill padding characters.
-      for(size_t i = p;  i != 8;  ++i) {
-        text += s_base32_table[64];
-      }
+      reg = 0;
+      for(size_t i = 0;  i < 5;  ++i)
+        reg = reg << 8 | ((i < m) ? (data[nread++] & 0xFF) : 0);
+      // Encode them. Padding characters have been filled.
+      for(size_t i = 0;  i < p;  ++i)
+        *(wptr++) = s_base32_table[(reg >> (35 - i * 5) & 31) * 2 + rlowerc];
     }
     return text;
   }
@@ -993,16 +3785,34 @@ V_string
 std_string_base32_decode(V_string text)
   {
     V_string data;
+    // Allocate the output buffer in advance. It will be truncated at the end.
+    char* wbase = data.assign(text.size() / 8 * 5, '*').mut_data();
+    char* wptr = wbase;
     // These shall be operated in big-endian order.
     uint64_t reg = 1;
     uint32_t npad = 0;
     // Decode source data.
     size_t nread = 0;
     while(nread != text.size()) {
+      if((reg == 1) && (text.size() - nread >= 8)) {
+        // Decode a complete group at once if possible.
+        uint64_t dreg = 0;
+        uint32_t dbad = 0;
+        for(size_t i = 0;  i < 8;  ++i) {
+          uint32_t dval = s_base32_digits.vals[uint8_t(text[nread+i])];
+          dbad |= dval;
+          dreg = dreg << 5 | (dval & 31);
+        }
+        if(dbad < 32) {
+          for(size_t i = 0;  i < 5;  ++i)
+            *(wptr++) = static_cast<char>(dreg >> (32 - i * 8));
+          nread += 8;
+          continue;
+        }
+      }
       // Read and identify a character.
       char c = text[nread++];
-      const char* pos = do_xstrchr(s_spaces, c);
-      if(pos) {
+      if(is_cctype(c, cctype_space)) {
         // The character is a whitespace.
         if(reg != 1) {
           ASTERIA_THROW("incomplete base32 group");
@@ -1019,14 +3829,14 @@ std_string_base32_decode(V_string text)
       }
       else {
         // Decode a digit.
-        pos = do_xstrchr(s_base32_table, c);
-        if(!pos) {
+        uint32_t dval = s_base32_digits.vals[uint8_t(c)];
+        if(dval == 0xFF) {
           ASTERIA_THROW("invalid base32 digit (character `$1`)", c);
         }
         if(npad != 0) {
           ASTERIA_THROW("unexpected base32 digit following padding character");
         }
-        reg |= static_cast<uint32_t>(pos - s_base32_table) / 2;
+        reg |= dval;
       }
       // Decode the current group if it is complete.
       if(!(reg & 0x1'00'00'00'00'00)) {
@@ -1039,7 +3849,7 @@ std_string_base32_decode(V_string text)
       }
       for(size_t i = 0; i < m; ++i) {
         reg <<= 8;
-        data += static_cast<char>(reg >> 40);
+        *(wptr++) = static_cast<char>(reg >> 40);
       }
       reg = 1;
       npad = 0;
@@ -1047,6 +3857,7 @@ std_string_base32_decode(V_string text)
     if(reg != 1) {
       ASTERIA_THROW("incomplete base32 group");
     }
+    data.erase(static_cast<size_t>(wptr - wbase));
     return data;
   }
 
@@ -1054,48 +3865,7 @@ V_string
 std_string_base64_encode(V_string data)
   {
     V_string text;
-    text.reserve((data.size() + 2) / 3 * 4);
-    // These shall be operated in big-endian order.
-    uint32_t reg = 0;
-    // Encode source data.
-    size_t nread = 0;
-    while(data.size() - nread >= 3) {
-      // Read 3 consecutive bytes.
-      for(size_t i = 0;  i < 3;  ++i) {
-        uint32_t b = data[nread++] & 0xFF;
-        reg <<= 8;
-        reg |= b;
-      }
-      reg <<= 8;
-      // Encode them.
-      for(size_t i = 0;  i < 4;  ++i) {
-        uint32_t b = (reg >> 26) & 0xFF;
-        reg <<= 6;
-        text += s_base64_table[b];
-      }
-    }
-    if(nread != data.size()) {
-      // Get the start of padding characters.
-      size_t m = data.size() - nread;
-      size_t p = (m * 8 + 5) / 6;
-      // Read all remaining bytes that cannot fill up a unit.
-      for(size_t i = 0;  i < m;  ++i) {
-        uint32_t b = data[nread++] & 0xFF;
-        reg <<= 8;
-        reg |= b;
-      }
-      reg <<= 32 - m * 8;
-      // Encode them.
-      for(size_t i = 0;  i < p;  ++i) {
-        uint32_t b = (reg >> 26) & 0xFF;
-        reg <<= 6;
-        text += s_base64_table[b];
-      }
-      // Fill padding characters.
-      for(size_t i = p;  i != 4;  ++i) {
-        text += s_base64_table[64];
-      }
-    }
+    do_base64_encode(text, data.data(), data.size());
     return text;
   }
 
@@ -1106,58 +3876,382 @@ std_string_base64_decode(V_string text)
     // These shall be operated in big-endian order.
     uint32_t reg = 1;
     uint32_t npad = 0;
-    // Decode source data.
-    size_t nread = 0;
-    while(nread != text.size()) {
-      // Read and identify a character.
-      char c = text[nread++];
-      const char* pos = do_xstrchr(s_spaces, c);
-      if(pos) {
-        // The character is a whitespace.
-        if(reg != 1) {
-          ASTERIA_THROW("incomplete base64 group");
-        }
-        continue;
-      }
-      reg <<= 6;
-      if(c == s_base64_table[64]) {
-        // The character is a padding character.
-        if(reg < 0x100) {
-          ASTERIA_THROW("unexpected base64 padding character");
-        }
-        npad += 1;
-      }
-      else {
-        // Decode a digit.
-        pos = do_xstrchr(s_base64_table, c);
-        if(!pos) {
-          ASTERIA_THROW("invalid base64 digit (character `$1`)", c);
-        }
-        if(npad != 0) {
-          ASTERIA_THROW("unexpected base64 digit following padding character");
-        }
-        reg |= static_cast<uint32_t>(pos - s_base64_table);
-      }
-      // Decode the current group if it is complete.
-      if(!(reg & 0x1'00'00'00)) {
-        continue;
-      }
-      size_t m = (24 - npad * 6) / 8;
-      size_t p = (m * 8 + 5) / 6;
-      if(p + npad != 4) {
-        ASTERIA_THROW("unexpected number of base64 padding characters (got `$1`)", npad);
-      }
-      for(size_t i = 0; i < m; ++i) {
-        reg <<= 8;
-        data += static_cast<char>(reg >> 24);
-      }
-      reg = 1;
-      npad = 0;
+    do_base64_decode(data, text.data(), text.size(), reg, npad);
+    if(reg != 1) {
+      ASTERIA_THROW("incomplete base64 group");
+    }
+    return data;
+  }
+
+V_opaque
+std_string_hex_encoder_new_private(optV_boolean lowercase, optV_string delim)
+  {
+    return ::rocket::make_refcnt<Hex_Encoder>(lowercase.value_or(false), delim.value_or(::rocket::sref("")));
+  }
+
+V_string
+std_string_hex_encoder_new_update(V_opaque& h, V_string data)
+  {
+    return do_cast_codec<Hex_Encoder>(h)->update(data);
+  }
+
+V_string
+std_string_hex_encoder_new_finish(V_opaque& h)
+  {
+    return do_cast_codec<Hex_Encoder>(h)->finish();
+  }
+
+V_object
+std_string_hex_encoder_new(optV_boolean lowercase, optV_string delim)
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$c"),
+      std_string_hex_encoder_new_private(::std::move(lowercase), ::std::move(delim)));
+    //===================================================================
+    // `.update(data)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("update"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.hex_encoder_new([lowercase], [delim]).update(data)`
+
+  * Encodes `data`, which shall be a byte string, with the encoder
+    denoted by `this`.
+
+  * Returns encoded characters as a string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.hex_encoder_new().update"));
+    // Get the encoder.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$c") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_string_hex_encoder_new_update(self.open().open_opaque(),
+                                                 ::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.finish()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("finish"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.hex_encoder_new([lowercase], [delim]).finish()`
+
+  * Resets the encoder denoted by `this`, making it suitable for
+    further data as if it had just been created. As hexadecimal
+    encoding has no partial groups, nothing is written here.
+
+  * Returns an empty string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.hex_encoder_new().finish"));
+    // Get the encoder.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$c") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_string_hex_encoder_new_finish(self.open().open_opaque()) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.string.hex_encoder_new()`
+    //===================================================================
+    return result;
+  }
+
+V_opaque
+std_string_hex_decoder_new_private()
+  {
+    return ::rocket::make_refcnt<Hex_Decoder>();
+  }
+
+V_string
+std_string_hex_decoder_new_update(V_opaque& h, V_string text)
+  {
+    return do_cast_codec<Hex_Decoder>(h)->update(text);
+  }
+
+V_string
+std_string_hex_decoder_new_finish(V_opaque& h)
+  {
+    return do_cast_codec<Hex_Decoder>(h)->finish();
+  }
+
+V_object
+std_string_hex_decoder_new()
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$c"),
+      std_string_hex_decoder_new_private());
+    //===================================================================
+    // `.update(text)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("update"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.hex_decoder_new().update(text)`
+
+  * Decodes `text` with the decoder denoted by `this`. A trailing
+    unpaired digit is saved for the next chunk.
+
+  * Returns decoded bytes as a string.
+
+  * Throws an exception if the string is invalid, in which case
+    the decoder is left unchanged.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.hex_decoder_new().update"));
+    // Get the decoder.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$c") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string text;
+    if(reader.I().v(text).F()) {
+      Reference_root::S_temporary xref = { std_string_hex_decoder_new_update(self.open().open_opaque(),
+                                                 ::std::move(text)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.finish()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("finish"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.hex_decoder_new().finish()`
+
+  * Checks that no unpaired digit is pending in the decoder denoted
+    by `this`, then resets it, making it suitable for further data
+    as if it had just been created.
+
+  * Returns an empty string.
+
+  * Throws an exception if a digit has been left unpaired.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.hex_decoder_new().finish"));
+    // Get the decoder.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$c") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_string_hex_decoder_new_finish(self.open().open_opaque()) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.string.hex_decoder_new()`
+    //===================================================================
+    return result;
+  }
+
+V_opaque
+std_string_base64_encoder_new_private()
+  {
+    return ::rocket::make_refcnt<Base64_Encoder>();
+  }
+
+V_string
+std_string_base64_encoder_new_update(V_opaque& h, V_string data)
+  {
+    return do_cast_codec<Base64_Encoder>(h)->update(data);
+  }
+
+V_string
+std_string_base64_encoder_new_finish(V_opaque& h)
+  {
+    return do_cast_codec<Base64_Encoder>(h)->finish();
+  }
+
+V_object
+std_string_base64_encoder_new()
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$c"),
+      std_string_base64_encoder_new_private());
+    //===================================================================
+    // `.update(data)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("update"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.base64_encoder_new().update(data)`
+
+  * Encodes `data`, which shall be a byte string, with the encoder
+    denoted by `this`. Up to two trailing bytes are saved for the
+    next chunk.
+
+  * Returns encoded characters as a string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_encoder_new().update"));
+    // Get the encoder.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$c") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_string_base64_encoder_new_update(self.open().open_opaque(),
+                                                 ::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.finish()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("finish"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.base64_encoder_new().finish()`
+
+  * Encodes bytes that have been saved in the encoder denoted by
+    `this`, with padding characters, then resets it, making it
+    suitable for further data as if it had just been created.
+
+  * Returns encoded characters as a string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_encoder_new().finish"));
+    // Get the encoder.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$c") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_string_base64_encoder_new_finish(self.open().open_opaque()) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.string.base64_encoder_new()`
+    //===================================================================
+    return result;
+  }
+
+V_opaque
+std_string_base64_decoder_new_private()
+  {
+    return ::rocket::make_refcnt<Base64_Decoder>();
+  }
+
+V_string
+std_string_base64_decoder_new_update(V_opaque& h, V_string text)
+  {
+    return do_cast_codec<Base64_Decoder>(h)->update(text);
+  }
+
+V_string
+std_string_base64_decoder_new_finish(V_opaque& h)
+  {
+    return do_cast_codec<Base64_Decoder>(h)->finish();
+  }
+
+V_object
+std_string_base64_decoder_new()
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$c"),
+      std_string_base64_decoder_new_private());
+    //===================================================================
+    // `.update(text)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("update"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.base64_decoder_new().update(text)`
+
+  * Decodes `text` with the decoder denoted by `this`. Characters
+    that do not fill up a unit are saved for the next chunk.
+
+  * Returns decoded bytes as a string.
+
+  * Throws an exception if the string is invalid, in which case
+    the decoder is left unchanged.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_decoder_new().update"));
+    // Get the decoder.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$c") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string text;
+    if(reader.I().v(text).F()) {
+      Reference_root::S_temporary xref = { std_string_base64_decoder_new_update(self.open().open_opaque(),
+                                                 ::std::move(text)) };
+      return self = ::std::move(xref);
     }
-    if(reg != 1) {
-      ASTERIA_THROW("incomplete base64 group");
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.finish()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("finish"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.base64_decoder_new().finish()`
+
+  * Checks that no incomplete unit is pending in the decoder
+    denoted by `this`, then resets it, making it suitable for
+    further data as if it had just been created.
+
+  * Returns an empty string.
+
+  * Throws an exception if a unit has been left incomplete.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_decoder_new().finish"));
+    // Get the decoder.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$c") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_string_base64_decoder_new_finish(self.open().open_opaque()) };
+      return self = ::std::move(xref);
     }
-    return data;
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.string.base64_decoder_new()`
+    //===================================================================
+    return result;
   }
 
 V_string
@@ -1187,15 +4281,8 @@ std_string_url_decode_query(V_string text)
 V_boolean
 std_string_utf8_validate(V_string text)
   {
-    size_t offset = 0;
-    while(offset < text.size()) {
-      // Try decoding a code point.
-      char32_t cp;
-      if(!utf8_decode(cp, text, offset))
-        // This sequence is invalid.
-        return false;
-    }
-    return true;
+    size_t offset;
+    return utf8_validate(offset, text.data(), text.size());
   }
 
 V_string
@@ -1242,6 +4329,13 @@ std_string_utf8_decode(V_string text, optV_boolean permissive)
     code_points.reserve(text.size());
     size_t offset = 0;
     while(offset < text.size()) {
+      // Copy ASCII characters in bulk.
+      size_t nascii = utf8_ascii_prefix(text.data() + offset, text.size() - offset);
+      for(size_t i = 0;  i < nascii;  ++i)
+        code_points.emplace_back(V_integer(text[offset + i]));
+      offset += nascii;
+      if(offset == text.size())
+        break;
       // Try decoding a code point.
       char32_t cp;
       if(!utf8_decode(cp, text, offset)) {
@@ -1360,135 +4454,539 @@ std_string_unpack_32be(V_string text)
     return do_unpack_be<int32_t>(text);
   }
 
-V_string
-std_string_pack_32le(V_integer value)
+V_string
+std_string_pack_32le(V_integer value)
+  {
+    V_string text;
+    text.reserve(4);
+    do_pack_one_le<int32_t>(text, value);
+    return text;
+  }
+
+V_string
+std_string_pack_32le(V_array values)
+  {
+    V_string text;
+    text.reserve(values.size() * 4);
+    for(const auto& elem : values) {
+      do_pack_one_le<int32_t>(text, elem.as_integer());
+    }
+    return text;
+  }
+
+V_array
+std_string_unpack_32le(V_string text)
+  {
+    return do_unpack_le<int32_t>(text);
+  }
+
+V_string
+std_string_pack_64be(V_integer value)
+  {
+    V_string text;
+    text.reserve(8);
+    do_pack_one_be<int64_t>(text, value);
+    return text;
+  }
+
+V_string
+std_string_pack_64be(V_array values)
+  {
+    V_string text;
+    text.reserve(values.size() * 8);
+    for(const auto& elem : values) {
+      do_pack_one_be<int64_t>(text, elem.as_integer());
+    }
+    return text;
+  }
+
+V_array
+std_string_unpack_64be(V_string text)
+  {
+    return do_unpack_be<int64_t>(text);
+  }
+
+V_string
+std_string_pack_64le(V_integer value)
+  {
+    V_string text;
+    text.reserve(8);
+    do_pack_one_le<int64_t>(text, value);
+    return text;
+  }
+
+V_string
+std_string_pack_64le(V_array values)
+  {
+    V_string text;
+    text.reserve(values.size() * 8);
+    for(const auto& elem : values) {
+      do_pack_one_le<int64_t>(text, elem.as_integer());
+    }
+    return text;
+  }
+
+V_array
+std_string_unpack_64le(V_string text)
+  {
+    return do_unpack_le<int64_t>(text);
+  }
+
+V_string
+std_string_pack(V_string format, cow_vector<Value> values)
+  {
+    return Pack_Format(format).pack(values);
+  }
+
+V_array
+std_string_unpack(V_string format, V_string data, optV_integer offset)
+  {
+    return Pack_Format(format).unpack(data, offset.value_or(0));
+  }
+
+V_opaque
+std_string_pack_compile_private(V_string format)
+  {
+    return ::rocket::make_refcnt<Pack_Format>(format);
+  }
+
+V_string
+std_string_pack_compile_pack(const V_opaque& f, cow_vector<Value> values)
+  {
+    return do_cast_pack_format(f)->pack(values);
+  }
+
+V_array
+std_string_pack_compile_unpack(const V_opaque& f, V_string data, optV_integer offset)
+  {
+    return do_cast_pack_format(f)->unpack(data, offset.value_or(0));
+  }
+
+V_object
+std_string_pack_compile(V_string format)
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$f"),
+      std_string_pack_compile_private(::std::move(format)));
+    //===================================================================
+    // `.pack(...)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("pack"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.pack_compile(format).pack(...)`
+
+  * Packs all arguments according to the compiled format denoted by
+    `this`. This function behaves identically to
+    `std.string.pack()`.
+
+  * Returns the packed string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.pack_compile().pack"));
+    // Get the compiled format.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$f") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    cow_vector<Value> values;
+    if(reader.I().F(values)) {
+      Reference_root::S_temporary xref = { std_string_pack_compile_pack(self.read().as_opaque(),
+                                                                        ::std::move(values)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.unpack(data, [offset])`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("unpack"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.pack_compile(format).unpack(data, [offset])`
+
+  * Unpacks values from `data` according to the compiled format
+    denoted by `this`. This function behaves identically to
+    `std.string.unpack()`.
+
+  * Returns an array of unpacked values.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.pack_compile().unpack"));
+    // Get the compiled format.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$f") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string data;
+    optV_integer offset;
+    if(reader.I().v(data).o(offset).F()) {
+      Reference_root::S_temporary xref = { std_string_pack_compile_unpack(self.read().as_opaque(),
+                                                                          ::std::move(data), offset) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // End of `std.string.pack_compile()`
+    //===================================================================
+    return result;
+  }
+
+V_string
+std_string_format(V_string templ, cow_vector<Value> values)
+  {
+    // Prepare inserters.
+    cow_vector<::rocket::formatter> insts;
+    insts.reserve(values.size());
+    for(size_t i = 0;  i < values.size();  ++i)
+      insts.push_back({
+        [](tinyfmt& fmt, const void* ptr) -> tinyfmt&
+          { return static_cast<const Value*>(ptr)->print(fmt);  },
+        values.data() + i
+      });
+    // Compose the string into a stream.
+    ::rocket::tinyfmt_str fmt;
+    vformat(fmt, templ.data(), templ.size(), insts.data(), insts.size());
+    return fmt.extract_string();
+  }
+
+V_string
+std_string_format(V_opaque templ, cow_vector<Value> values)
+  {
+    return format_template_cast(templ)->render_string(values.data(), values.size());
+  }
+
+V_opaque
+std_string_format_compile(V_string templ)
+  {
+    return ::rocket::make_refcnt<Format_Template>(templ);
+  }
+
+opt<pair<V_integer, V_integer>>
+std_string_regex_find(Global_Context& global, V_string text, V_integer from, optV_integer length,
+                      V_string pattern)
+  {
+    return do_regex_find(*(do_get_regex(global, pattern)), text, from, length);
+  }
+
+optV_array
+std_string_regex_match(Global_Context& global, V_string text, V_integer from, optV_integer length,
+                       V_string pattern)
+  {
+    return do_regex_match(*(do_get_regex(global, pattern)), text, from, length);
+  }
+
+V_string
+std_string_regex_replace(Global_Context& global, V_string text, V_integer from, optV_integer length,
+                         V_string pattern, V_string replacement)
+  {
+    return do_regex_replace(*(do_get_regex(global, pattern)), text, from, length, replacement);
+  }
+
+V_opaque
+std_string_regex_compile_private(Global_Context& global, V_string pattern)
+  {
+    return ::rocket::const_pointer_cast<Regex_Pattern>(do_get_regex(global, pattern));
+  }
+
+opt<pair<V_integer, V_integer>>
+std_string_regex_compile_find(const V_opaque& r, V_string text, V_integer from, optV_integer length)
+  {
+    return do_regex_find(*(do_cast_regex(r)), text, from, length);
+  }
+
+optV_array
+std_string_regex_compile_match(const V_opaque& r, V_string text, V_integer from, optV_integer length)
+  {
+    return do_regex_match(*(do_cast_regex(r)), text, from, length);
+  }
+
+V_string
+std_string_regex_compile_replace(const V_opaque& r, V_string text, V_integer from, optV_integer length,
+                                 V_string replacement)
+  {
+    return do_regex_replace(*(do_cast_regex(r)), text, from, length, replacement);
+  }
+
+V_object
+std_string_regex_compile(Global_Context& global, V_string pattern)
+  {
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$r"),
+      std_string_regex_compile_private(global, ::std::move(pattern)));
+    //===================================================================
+    // `.find(text, [from, [length]])`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("find"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.regex_compile(pattern).find(text, [from, [length]])`
+
+  * Searches `text` for the first occurrence of the compiled
+    regular expression denoted by `this`. This function behaves
+    identically to `std.string.regex_find()`.
+
+  * Returns an array of two integers, the first of which
+    specifies the subscript of the matching sequence and the second
+    of which specifies its length. If the pattern is not found,
+    this function returns `null`.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.regex_compile().find"));
+    // Get the compiled pattern.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$r") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string text;
+    optV_integer from;
+    optV_integer length;
+    if(reader.I().v(text).o(from).o(length).F()) {
+      auto kpair = std_string_regex_compile_find(self.read().as_opaque(), ::std::move(text),
+                                                 from.value_or(0), length);
+      if(!kpair) {
+        return self = Reference_root::S_temporary();
+      }
+      // This function returns a `pair`, but we would like to return an array so convert it.
+      Reference_root::S_temporary xref = { { kpair->first, kpair->second } };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `.match(text, [from, [length]])`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("match"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.regex_compile(pattern).match(text, [from, [length]])`
+
+  * Checks whether the compiled regular expression denoted by
+    `this` matches the entire sequence `text`, or the subrange that
+    would be returned by `slice(text, from, length)`. This function
+    behaves identically to `std.string.regex_match()`.
+
+  * Returns an array of optional strings, or `null` if `text` does
+    not match the pattern.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.regex_compile().match"));
+    // Get the compiled pattern.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$r") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
     V_string text;
-    text.reserve(4);
-    do_pack_one_le<int32_t>(text, value);
-    return text;
+    optV_integer from;
+    optV_integer length;
+    if(reader.I().v(text).o(from).o(length).F()) {
+      Reference_root::S_temporary xref = { std_string_regex_compile_match(self.read().as_opaque(),
+                                                 ::std::move(text), from.value_or(0), length) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
   }
+      ));
+    //===================================================================
+    // `.replace(text, [from, [length]], replacement)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("replace"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.regex_compile(pattern).replace(text, [from, [length]], replacement)`
 
-V_string
-std_string_pack_32le(V_array values)
+  * Searches `text` and replaces all matches of the compiled
+    regular expression denoted by `this` with `replacement`. This
+    function behaves identically to `std.string.regex_replace()`.
+
+  * Returns the string with the pattern replaced. If `text` does
+    not contain the pattern, it is returned intact.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.regex_compile().replace"));
+    Argument_Reader::State state;
+    // Get the compiled pattern.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$r") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
     V_string text;
-    text.reserve(values.size() * 4);
-    for(const auto& elem : values) {
-      do_pack_one_le<int32_t>(text, elem.as_integer());
+    V_string replacement;
+    if(reader.I().v(text).S(state).v(replacement).F()) {
+      Reference_root::S_temporary xref = { std_string_regex_compile_replace(self.read().as_opaque(),
+                                                 ::std::move(text), 0, nullopt, ::std::move(replacement)) };
+      return self = ::std::move(xref);
     }
-    return text;
+    V_integer from;
+    if(reader.L(state).v(from).S(state).v(replacement).F()) {
+      Reference_root::S_temporary xref = { std_string_regex_compile_replace(self.read().as_opaque(),
+                                                 ::std::move(text), from, nullopt, ::std::move(replacement)) };
+      return self = ::std::move(xref);
+    }
+    optV_integer length;
+    if(reader.L(state).o(length).v(replacement).F()) {
+      Reference_root::S_temporary xref = { std_string_regex_compile_replace(self.read().as_opaque(),
+                                                 ::std::move(text), from, length, ::std::move(replacement)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
   }
-
-V_array
-std_string_unpack_32le(V_string text)
-  {
-    return do_unpack_le<int32_t>(text);
+      ));
+    //===================================================================
+    // End of `std.string.regex_compile()`
+    //===================================================================
+    return result;
   }
 
-V_string
-std_string_pack_64be(V_integer value)
+optV_array
+std_string_find_any_pattern(V_string text, V_integer from, optV_integer length, V_array patterns)
   {
-    V_string text;
-    text.reserve(8);
-    do_pack_one_be<int64_t>(text, value);
-    return text;
+    Pattern_Set ps(do_get_strings(patterns));
+    return do_find_any_pattern(ps, text, from, length);
   }
 
 V_string
-std_string_pack_64be(V_array values)
+std_string_find_and_replace_all(V_string text, V_integer from, optV_integer length, V_object mapping)
   {
-    V_string text;
-    text.reserve(values.size() * 8);
-    for(const auto& elem : values) {
-      do_pack_one_be<int64_t>(text, elem.as_integer());
+    cow_vector<V_string> patterns, replacements;
+    patterns.reserve(mapping.size());
+    replacements.reserve(mapping.size());
+    for(const auto& pair : mapping) {
+      patterns.emplace_back(pair.first.rdstr());
+      replacements.emplace_back(pair.second.as_string());
     }
-    return text;
+    Pattern_Set ps(patterns);
+    return do_find_and_replace_all(ps, text, from, length, replacements);
   }
 
-V_array
-std_string_unpack_64be(V_string text)
+V_opaque
+std_string_pattern_set_compile_private(V_array patterns)
   {
-    return do_unpack_be<int64_t>(text);
+    return ::rocket::make_refcnt<Pattern_Set>(do_get_strings(patterns));
   }
 
-V_string
-std_string_pack_64le(V_integer value)
+optV_array
+std_string_pattern_set_compile_find(const V_opaque& p, V_string text, V_integer from, optV_integer length)
   {
-    V_string text;
-    text.reserve(8);
-    do_pack_one_le<int64_t>(text, value);
-    return text;
+    return do_find_any_pattern(*(do_cast_pattern_set(p)), text, from, length);
   }
 
 V_string
-std_string_pack_64le(V_array values)
+std_string_pattern_set_compile_replace(const V_opaque& p, V_string text, V_integer from,
+                                       optV_integer length, V_array replacements)
   {
-    V_string text;
-    text.reserve(values.size() * 8);
-    for(const auto& elem : values) {
-      do_pack_one_le<int64_t>(text, elem.as_integer());
-    }
-    return text;
+    return do_find_and_replace_all(*(do_cast_pattern_set(p)), text, from, length,
+                                   do_get_strings(replacements));
   }
 
-V_array
-std_string_unpack_64le(V_string text)
+V_object
+std_string_pattern_set_compile(V_array patterns)
   {
-    return do_unpack_le<int64_t>(text);
-  }
+    V_object result;
+    //===================================================================
+    // * private data
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("$p"),
+      std_string_pattern_set_compile_private(::std::move(patterns)));
+    //===================================================================
+    // `.find(text, [from, [length]])`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("find"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.pattern_set_compile(patterns).find(text, [from, [length]])`
 
-V_string
-std_string_format(V_string templ, cow_vector<Value> values)
-  {
-    // Prepare inserters.
-    cow_vector<::rocket::formatter> insts;
-    insts.reserve(values.size());
-    for(size_t i = 0;  i < values.size();  ++i)
-      insts.push_back({
-        [](tinyfmt& fmt, const void* ptr) -> tinyfmt&
-          { return static_cast<const Value*>(ptr)->print(fmt);  },
-        values.data() + i
-      });
-    // Compose the string into a stream.
-    ::rocket::tinyfmt_str fmt;
-    vformat(fmt, templ.data(), templ.size(), insts.data(), insts.size());
-    return fmt.extract_string();
-  }
+  * Searches `text` for the first occurrence of any pattern in the
+    compiled set denoted by `this`. This function behaves
+    identically to `std.string.find_any_pattern()`.
 
-opt<pair<V_integer, V_integer>>
-std_string_regex_find(V_string text, V_integer from, optV_integer length, V_string pattern)
+  * Returns an array of three integers, which are the subscript of
+    the match, its length, and the subscript of the pattern in
+    `patterns`. If no pattern is found, this function returns
+    `null`.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    auto range = do_slice(text, from, length);
-    auto match = do_regex_search(range.first, range.second, do_make_regex(pattern));
-    if(!match.matched) {
-      return nullopt;
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.pattern_set_compile().find"));
+    // Get the compiled pattern set.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$p") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string text;
+    optV_integer from;
+    optV_integer length;
+    if(reader.I().v(text).o(from).o(length).F()) {
+      Reference_root::S_temporary xref = { std_string_pattern_set_compile_find(self.read().as_opaque(),
+                                                 ::std::move(text), from.value_or(0), length) };
+      return self = ::std::move(xref);
     }
-    return ::std::make_pair(match.first - text.begin(), match.second - match.first);
+    reader.throw_no_matching_function_call();
   }
+      ));
+    //===================================================================
+    // `.replace(text, [from, [length]], replacements)`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("replace"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.pattern_set_compile(patterns).replace(text, [from, [length]], replacements)`
 
-optV_array
-std_string_regex_match(V_string text, V_integer from, optV_integer length, V_string pattern)
+  * Searches `text` and replaces all occurrences of patterns in the
+    compiled set denoted by `this`. Each pattern is replaced with
+    the element in `replacements` with the same subscript, so both
+    arrays shall have the same length. This function behaves like
+    `std.string.find_and_replace_all()`.
+
+  * Returns the string with patterns replaced. If `text` does not
+    contain any pattern, it is returned intact.
+
+  * Throws an exception if `replacements` does not match
+    `patterns`.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    auto range = do_slice(text, from, length);
-    auto matches = do_regex_match(range.first, range.second, do_make_regex(pattern));
-    if(matches.empty()) {
-      return nullopt;
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.pattern_set_compile().replace"));
+    Argument_Reader::State state;
+    // Get the compiled pattern set.
+    Reference_modifier::S_object_key xmod = { ::rocket::sref("$p") };
+    self.zoom_in(::std::move(xmod));
+    // Parse arguments.
+    V_string text;
+    V_array replacements;
+    if(reader.I().v(text).S(state).v(replacements).F()) {
+      Reference_root::S_temporary xref = { std_string_pattern_set_compile_replace(self.read().as_opaque(),
+                                                 ::std::move(text), 0, nullopt, ::std::move(replacements)) };
+      return self = ::std::move(xref);
+    }
+    V_integer from;
+    if(reader.L(state).v(from).S(state).v(replacements).F()) {
+      Reference_root::S_temporary xref = { std_string_pattern_set_compile_replace(self.read().as_opaque(),
+                                                 ::std::move(text), from, nullopt, ::std::move(replacements)) };
+      return self = ::std::move(xref);
     }
-    return do_regex_copy_matches(matches);
+    optV_integer length;
+    if(reader.L(state).o(length).v(replacements).F()) {
+      Reference_root::S_temporary xref = { std_string_pattern_set_compile_replace(self.read().as_opaque(),
+                                                 ::std::move(text), from, length, ::std::move(replacements)) };
+      return self = ::std::move(xref);
+    }
+    reader.throw_no_matching_function_call();
   }
-
-V_string
-std_string_regex_replace(V_string text, V_integer from, optV_integer length, V_string pattern,
-                         V_string replacement)
-  {
-    V_string res;
-    auto range = do_slice(text, from, length);
-    res.append(text.begin(), range.first);
-    do_regex_replace(res, range.first, range.second, do_make_regex(pattern),
-                          do_make_regex_replacement(replacement));
-    res.append(range.second, text.end());
-    return res;
+      ));
+    //===================================================================
+    // End of `std.string.pattern_set_compile()`
+    //===================================================================
+    return result;
   }
 
 void
@@ -2502,12 +6000,146 @@ create_bindings_string(V_object& result, API_Version /*version*/)
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base32_encode"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base32_encode"));
+    // Parse arguments.
+    V_string data;
+    optV_boolean lowercase;
+    if(reader.I().v(data).o(lowercase).F()) {
+      Reference_root::S_temporary xref = { std_string_base32_encode(::std::move(data), lowercase) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.base32_decode()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("base32_decode"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.base32_decode(text)`
+
+  * Decodes data encoded in base32, as specified by IETF RFC 4648.
+    Whitespaces can be used to delimit encoding units; they shall
+    not occur between characters in the same unit. Consequently,
+    the number of non-whitespace characters must be a multiple of
+    eight. Invalid characters cause decode errors.
+
+  * Returns a string containing decoded bytes. If `text` is empty
+    or consists of only whitespaces, an empty string is returned.
+
+  * Throws an exception if the string is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base32_decode"));
+    // Parse arguments.
+    V_string text;
+    if(reader.I().v(text).F()) {
+      Reference_root::S_temporary xref = { std_string_base32_decode(::std::move(text)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.base64_encode()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("base64_encode"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.base64_encode(data)`
+
+  * Encodes all bytes in `data` according to the base64 encoding
+    specified by IETF RFC 4648. The length of encoded data is
+    always a multiple of 4; padding characters are mandatory.
+
+  * Returns the encoded string.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_encode"));
+    // Parse arguments.
+    V_string data;
+    if(reader.I().v(data).F()) {
+      Reference_root::S_temporary xref = { std_string_base64_encode(::std::move(data)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.base64_decode()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("base64_decode"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.base64_decode(text)`
+
+  * Decodes data encoded in base64, as specified by IETF RFC 4648.
+    Whitespaces can be used to delimit encoding units; they shall
+    not occur between characters in the same unit. Consequently,
+    the number of non-whitespace characters must be a multiple of
+    four. Invalid characters cause decode errors.
+
+  * Returns a string containing decoded bytes. If `text` is empty
+    or consists of only whitespaces, an empty string is returned.
+
+  * Throws an exception if the string is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_decode"));
+    // Parse arguments.
+    V_string text;
+    if(reader.I().v(text).F()) {
+      Reference_root::S_temporary xref = { std_string_base64_decode(::std::move(text)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.hex_encoder_new()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("hex_encoder_new"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.hex_encoder_new([lowercase], [delim])`
+
+  * Creates a streaming hexadecimal encoder. The arguments have the
+    same meanings as in `std.string.hex_encode()`. Delimiters are
+    inserted between bytes of different chunks as well, so the
+    concatenation of all results is identical to that of encoding
+    all input data at once.
+
+  * Returns the encoder as an object consisting of the following
+    members:
+
+    * `update(data)`
+    * `finish()`
+
+    The function `update()` transcodes a chunk and returns the
+    result. After all chunks have been put, the function `finish()`
+    returns the remaining output, then resets the encoder, making it
+    suitable for further data as if it had just been created. This
+    allows large payloads, such as those read in chunks by
+    `std.filesystem.file_stream()`, to be transcoded without being
+    loaded in memory entirely.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.hex_encoder_new"));
     // Parse arguments.
-    V_string data;
     optV_boolean lowercase;
-    if(reader.I().v(data).o(lowercase).F()) {
-      Reference_root::S_temporary xref = { std_string_base32_encode(::std::move(data), lowercase) };
+    optV_string delim;
+    if(reader.I().o(lowercase).o(delim).F()) {
+      Reference_root::S_temporary xref = { std_string_hex_encoder_new(::std::move(lowercase),
+                                                 ::std::move(delim)) };
       return self = ::std::move(xref);
     }
     // Fail.
@@ -2515,31 +6147,37 @@ create_bindings_string(V_object& result, API_Version /*version*/)
   }
       ));
     //===================================================================
-    // `std.string.base32_decode()`
+    // `std.string.hex_decoder_new()`
     //===================================================================
-    result.insert_or_assign(::rocket::sref("base32_decode"),
+    result.insert_or_assign(::rocket::sref("hex_decoder_new"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.string.base32_decode(text)`
+`std.string.hex_decoder_new()`
 
-  * Decodes data encoded in base32, as specified by IETF RFC 4648.
-    Whitespaces can be used to delimit encoding units; they shall
-    not occur between characters in the same unit. Consequently,
-    the number of non-whitespace characters must be a multiple of
-    eight. Invalid characters cause decode errors.
+  * Creates a streaming hexadecimal decoder. Input is accepted in
+    the same format as `std.string.hex_decode()`. A pair of digits
+    may be split between two consecutive chunks.
 
-  * Returns a string containing decoded bytes. If `text` is empty
-    or consists of only whitespaces, an empty string is returned.
+  * Returns the decoder as an object consisting of the following
+    members:
 
-  * Throws an exception if the string is invalid.
+    * `update(text)`
+    * `finish()`
+
+    The function `update()` transcodes a chunk and returns the
+    result. After all chunks have been put, the function `finish()`
+    returns the remaining output, then resets the decoder, making it
+    suitable for further data as if it had just been created. This
+    allows large payloads, such as those read in chunks by
+    `std.filesystem.file_stream()`, to be transcoded without being
+    loaded in memory entirely.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base32_decode"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.hex_decoder_new"));
     // Parse arguments.
-    V_string text;
-    if(reader.I().v(text).F()) {
-      Reference_root::S_temporary xref = { std_string_base32_decode(::std::move(text)) };
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_string_hex_decoder_new() };
       return self = ::std::move(xref);
     }
     // Fail.
@@ -2547,26 +6185,38 @@ create_bindings_string(V_object& result, API_Version /*version*/)
   }
       ));
     //===================================================================
-    // `std.string.base64_encode()`
+    // `std.string.base64_encoder_new()`
     //===================================================================
-    result.insert_or_assign(::rocket::sref("base64_encode"),
+    result.insert_or_assign(::rocket::sref("base64_encoder_new"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.string.base64_encode(data)`
-
-  * Encodes all bytes in `data` according to the base64 encoding
-    specified by IETF RFC 4648. The length of encoded data is
-    always a multiple of 4; padding characters are mandatory.
-
-  * Returns the encoded string.
+`std.string.base64_encoder_new()`
+
+  * Creates a streaming base64 encoder. Bytes that do not fill up
+    a unit are kept in the encoder until more data arrive, so the
+    concatenation of all results is identical to the result of
+    `std.string.base64_encode()` on all input data at once.
+
+  * Returns the encoder as an object consisting of the following
+    members:
+
+    * `update(data)`
+    * `finish()`
+
+    The function `update()` transcodes a chunk and returns the
+    result. After all chunks have been put, the function `finish()`
+    returns the remaining output, then resets the encoder, making it
+    suitable for further data as if it had just been created. This
+    allows large payloads, such as those read in chunks by
+    `std.filesystem.file_stream()`, to be transcoded without being
+    loaded in memory entirely.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_encode"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_encoder_new"));
     // Parse arguments.
-    V_string data;
-    if(reader.I().v(data).F()) {
-      Reference_root::S_temporary xref = { std_string_base64_encode(::std::move(data)) };
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_string_base64_encoder_new() };
       return self = ::std::move(xref);
     }
     // Fail.
@@ -2574,31 +6224,37 @@ create_bindings_string(V_object& result, API_Version /*version*/)
   }
       ));
     //===================================================================
-    // `std.string.base64_decode()`
+    // `std.string.base64_decoder_new()`
     //===================================================================
-    result.insert_or_assign(::rocket::sref("base64_decode"),
+    result.insert_or_assign(::rocket::sref("base64_decoder_new"),
       V_function(
 """""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-`std.string.base64_decode(text)`
+`std.string.base64_decoder_new()`
 
-  * Decodes data encoded in base64, as specified by IETF RFC 4648.
-    Whitespaces can be used to delimit encoding units; they shall
-    not occur between characters in the same unit. Consequently,
-    the number of non-whitespace characters must be a multiple of
-    four. Invalid characters cause decode errors.
+  * Creates a streaming base64 decoder. Input is accepted in the
+    same format as `std.string.base64_decode()`. A unit may be
+    split between two consecutive chunks.
 
-  * Returns a string containing decoded bytes. If `text` is empty
-    or consists of only whitespaces, an empty string is returned.
+  * Returns the decoder as an object consisting of the following
+    members:
 
-  * Throws an exception if the string is invalid.
+    * `update(text)`
+    * `finish()`
+
+    The function `update()` transcodes a chunk and returns the
+    result. After all chunks have been put, the function `finish()`
+    returns the remaining output, then resets the decoder, making it
+    suitable for further data as if it had just been created. This
+    allows large payloads, such as those read in chunks by
+    `std.filesystem.file_stream()`, to be transcoded without being
+    loaded in memory entirely.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
-    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_decode"));
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.base64_decoder_new"));
     // Parse arguments.
-    V_string text;
-    if(reader.I().v(text).F()) {
-      Reference_root::S_temporary xref = { std_string_base64_decode(::std::move(text)) };
+    if(reader.I().F()) {
+      Reference_root::S_temporary xref = { std_string_base64_decoder_new() };
       return self = ::std::move(xref);
     }
     // Fail.
@@ -3263,6 +6919,122 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     }
     // Fail.
     reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.pack()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("pack"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.pack(format, ...)`
+
+  * Packs all arguments following `format` into a string, like
+    `struct.pack()` in Python. `format` is a sequence of types, each
+    of which may be preceded by a decimal repeat count. Types are
+    as follows:
+
+    * `b` / `B`  8-bit integer
+    * `h` / `H`  16-bit integer
+    * `i` / `I`  32-bit integer
+    * `q` / `Q`  64-bit integer
+    * `f`        single-precision floating-point number
+    * `d`        double-precision floating-point number
+    * `s`        string of exactly `count` bytes
+    * `x`        zero byte that consumes no argument
+
+    Integers are truncated to their widths. Strings are truncated
+    or padded with zero bytes. `<` makes subsequent values
+    little-endian, and `>` or `!` makes them big-endian, which is
+    the default. Spaces are ignored.
+
+  * Returns the packed string.
+
+  * Throws an exception if `format` is invalid, or if the number of
+    arguments does not match it.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.pack"));
+    // Parse arguments.
+    V_string format;
+    cow_vector<Value> values;
+    if(reader.I().v(format).F(values)) {
+      Reference_root::S_temporary xref = { std_string_pack(::std::move(format), ::std::move(values)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.unpack()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("unpack"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.unpack(format, data, [offset])`
+
+  * Unpacks values from `data` beginning at `offset` according to
+    `format`, which is described in `pack()`. Lowercase integer
+    types are signed and uppercase ones are unsigned, except that
+    `Q` values wrap around as integers are 64-bit. Trailing bytes
+    in `data` are ignored. If `offset` is absent, it defaults to
+    zero.
+
+  * Returns an array of unpacked values.
+
+  * Throws an exception if `format` is invalid, or if `data` is
+    too short.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.unpack"));
+    // Parse arguments.
+    V_string format;
+    V_string data;
+    optV_integer offset;
+    if(reader.I().v(format).v(data).o(offset).F()) {
+      Reference_root::S_temporary xref = { std_string_unpack(::std::move(format), ::std::move(data), offset) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.pack_compile()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("pack_compile"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.pack_compile(format)`
+
+  * Compiles `format`, which is described in `pack()`, so it can
+    be used repeatedly without being parsed again.
+
+  * Returns a compiled format as an object consisting of the
+    following members:
+
+    * `pack(...)`
+    * `unpack(data, [offset])`
+
+    These functions behave identically to `pack()` and `unpack()`
+    respectively, except that `format` is omitted.
+
+  * Throws an exception if `format` is invalid.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.pack_compile"));
+    // Parse arguments.
+    V_string format;
+    if(reader.I().v(format).F()) {
+      Reference_root::S_temporary xref = { std_string_pack_compile(::std::move(format)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
@@ -3289,6 +7061,18 @@ create_bindings_string(V_object& result, API_Version /*version*/)
   * Throws an exception if `templ` contains invalid placeholder
     sequences, or when a placeholder sequence has no corresponding
     argument.
+
+`std.string.format(templ, ...)` (compiled)
+
+  * Compose a string according to the compiled template `templ`,
+    which has been returned by `format_compile()`. The result is
+    the same as if the original template string was passed, but
+    the template is not parsed again.
+
+  * Returns the composed string.
+
+  * Throws an exception when a placeholder sequence has no
+    corresponding argument.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
 *[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
   {
@@ -3300,6 +7084,42 @@ create_bindings_string(V_object& result, API_Version /*version*/)
       Reference_root::S_temporary xref = { std_string_format(::std::move(templ), ::std::move(values)) };
       return self = ::std::move(xref);
     }
+    V_opaque ctempl;
+    if(reader.I().v(ctempl).F(values)) {
+      Reference_root::S_temporary xref = { std_string_format(::std::move(ctempl), ::std::move(values)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.format_compile()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("format_compile"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.format_compile(templ)`
+
+  * Compiles the template string `templ`, which is described in
+    `format()`, so it can be used repeatedly without being parsed
+    again. The result can be passed to `std.string.format()`,
+    `std.io.putf()` and `std.debug.logf()` in place of `templ`.
+
+  * Returns the compiled template as an opaque value.
+
+  * Throws an exception if `templ` contains invalid placeholder
+    sequences.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.format_compile"));
+    // Parse arguments.
+    V_string templ;
+    if(reader.I().v(templ).F()) {
+      Reference_root::S_temporary xref = { std_string_format_compile(::std::move(templ)) };
+      return self = ::std::move(xref);
+    }
     // Fail.
     reader.throw_no_matching_function_call();
   }
@@ -3352,7 +7172,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
   * Throws an exception if `pattern` is not a valid regular
     expression.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& global) -> Reference&
   {
     Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.regex_find"));
     Argument_Reader::State state;
@@ -3360,7 +7180,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     V_string text;
     V_string pattern;
     if(reader.I().v(text).S(state).v(pattern).F()) {
-      auto kpair = std_string_regex_find(::std::move(text), 0, nullopt, ::std::move(pattern));
+      auto kpair = std_string_regex_find(global, ::std::move(text), 0, nullopt, ::std::move(pattern));
       if(!kpair) {
         return self = Reference_root::S_temporary();
       }
@@ -3370,7 +7190,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     }
     V_integer from;
     if(reader.L(state).v(from).S(state).v(pattern).F()) {
-      auto kpair = std_string_regex_find(::std::move(text), from, nullopt, ::std::move(pattern));
+      auto kpair = std_string_regex_find(global, ::std::move(text), from, nullopt, ::std::move(pattern));
       if(!kpair) {
         return self = Reference_root::S_temporary();
       }
@@ -3380,7 +7200,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     }
     optV_integer length;
     if(reader.L(state).o(length).v(pattern).F()) {
-      auto kpair = std_string_regex_find(::std::move(text), from, length, ::std::move(pattern));
+      auto kpair = std_string_regex_find(global, ::std::move(text), from, length, ::std::move(pattern));
       if(!kpair) {
         return self = Reference_root::S_temporary();
       }
@@ -3443,7 +7263,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
   * Throws an exception if `pattern` is not a valid regular
     expression.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& global) -> Reference&
   {
     Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.regex_match"));
     Argument_Reader::State state;
@@ -3451,19 +7271,19 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     V_string text;
     V_string pattern;
     if(reader.I().v(text).S(state).v(pattern).F()) {
-      Reference_root::S_temporary xref = { std_string_regex_match(::std::move(text), 0, nullopt,
+      Reference_root::S_temporary xref = { std_string_regex_match(global, ::std::move(text), 0, nullopt,
                                                                   ::std::move(pattern)) };
       return self = ::std::move(xref);
     }
     V_integer from;
     if(reader.L(state).v(from).S(state).v(pattern).F()) {
-      Reference_root::S_temporary xref = { std_string_regex_match(::std::move(text), from, nullopt,
+      Reference_root::S_temporary xref = { std_string_regex_match(global, ::std::move(text), from, nullopt,
                                                                   ::std::move(pattern)) };
       return self = ::std::move(xref);
     }
     optV_integer length;
     if(reader.L(state).o(length).v(pattern).F()) {
-      Reference_root::S_temporary xref = { std_string_regex_match(::std::move(text), from, length,
+      Reference_root::S_temporary xref = { std_string_regex_match(global, ::std::move(text), from, length,
                                                                   ::std::move(pattern)) };
       return self = ::std::move(xref);
     }
@@ -3517,7 +7337,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
   * Throws an exception if `pattern` is not a valid regular
     expression.
 )'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
-*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& global) -> Reference&
   {
     Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.regex_replace"));
     Argument_Reader::State state;
@@ -3526,24 +7346,250 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     V_string pattern;
     V_string replacement;
     if(reader.I().v(text).S(state).v(pattern).v(replacement).F()) {
-      Reference_root::S_temporary xref = { std_string_regex_replace(::std::move(text), 0, nullopt,
+      Reference_root::S_temporary xref = { std_string_regex_replace(global, ::std::move(text), 0, nullopt,
                                                           ::std::move(pattern), ::std::move(replacement)) };
       return self = ::std::move(xref);
     }
     V_integer from;
     if(reader.L(state).v(from).S(state).v(pattern).v(replacement).F()) {
-      Reference_root::S_temporary xref = { std_string_regex_replace(::std::move(text), from, nullopt,
+      Reference_root::S_temporary xref = { std_string_regex_replace(global, ::std::move(text), from, nullopt,
                                                            ::std::move(pattern), ::std::move(replacement)) };
       return self = ::std::move(xref);
     }
     optV_integer length;
     if(reader.L(state).o(length).v(pattern).v(replacement).F()) {
-      Reference_root::S_temporary xref = { std_string_regex_replace(::std::move(text), from, length,
+      Reference_root::S_temporary xref = { std_string_regex_replace(global, ::std::move(text), from, length,
                                                            ::std::move(pattern), ::std::move(replacement)) };
       return self = ::std::move(xref);
     }
     // Fail.
     reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.regex_compile()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("regex_compile"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.regex_compile(pattern)`
+
+  * Compiles the regular expression `pattern` so it can be used
+    repeatedly without being parsed again. Patterns passed to the
+    other `regex_*` functions are also cached, but only the most
+    recently used ones are kept.
+
+  * Returns a compiled pattern as an object consisting of the
+    following members:
+
+    * `find(text, [from, [length]])`
+    * `match(text, [from, [length]])`
+    * `replace(text, [from, [length]], replacement)`
+
+    These functions behave identically to `regex_find()`,
+    `regex_match()` and `regex_replace()` respectively, except
+    that the pattern is omitted.
+
+  * Throws an exception if `pattern` is not a valid regular
+    expression.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& global) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.regex_compile"));
+    // Parse arguments.
+    V_string pattern;
+    if(reader.I().v(pattern).F()) {
+      Reference_root::S_temporary xref = { std_string_regex_compile(global, ::std::move(pattern)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.find_any_pattern()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("find_any_pattern"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.find_any_pattern(text, patterns)`
+
+  * Searches `text` for the first occurrence of any string in the
+    array `patterns`. If more than one pattern matches at the same
+    position, the longest one is chosen. The cost of the search
+    does not depend on the number of patterns.
+
+  * Returns an array of three integers, which are the subscript of
+    the match, its length, and the subscript of the pattern in
+    `patterns`. If no pattern is found, this function returns
+    `null`.
+
+  * Throws an exception if any pattern is empty.
+
+`std.string.find_any_pattern(text, from, patterns)`
+
+  * Searches `text` for the first occurrence of any string in the
+    array `patterns`. The search operation is performed on the same
+    subrange that would be returned by `slice(text, from)`.
+
+  * Returns an array of three integers, which are the subscript of
+    the match, its length, and the subscript of the pattern in
+    `patterns`. If no pattern is found, this function returns
+    `null`.
+
+  * Throws an exception if any pattern is empty.
+
+`std.string.find_any_pattern(text, from, [length], patterns)`
+
+  * Searches `text` for the first occurrence of any string in the
+    array `patterns`. The search operation is performed on the same
+    subrange that would be returned by `slice(text, from, length)`.
+
+  * Returns an array of three integers, which are the subscript of
+    the match, its length, and the subscript of the pattern in
+    `patterns`. If no pattern is found, this function returns
+    `null`.
+
+  * Throws an exception if any pattern is empty.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.find_any_pattern"));
+    Argument_Reader::State state;
+    // Parse arguments.
+    V_string text;
+    V_array patterns;
+    if(reader.I().v(text).S(state).v(patterns).F()) {
+      Reference_root::S_temporary xref = { std_string_find_any_pattern(::std::move(text), 0, nullopt,
+                                                           ::std::move(patterns)) };
+      return self = ::std::move(xref);
+    }
+    V_integer from;
+    if(reader.L(state).v(from).S(state).v(patterns).F()) {
+      Reference_root::S_temporary xref = { std_string_find_any_pattern(::std::move(text), from, nullopt,
+                                                           ::std::move(patterns)) };
+      return self = ::std::move(xref);
+    }
+    optV_integer length;
+    if(reader.L(state).o(length).v(patterns).F()) {
+      Reference_root::S_temporary xref = { std_string_find_any_pattern(::std::move(text), from, length,
+                                                           ::std::move(patterns)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.find_and_replace_all()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("find_and_replace_all"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.find_and_replace_all(text, mapping)`
+
+  * Searches `text` and replaces all occurrences of keys of the
+    object `mapping` with their corresponding values, which shall
+    be strings. The text is scanned only once. If more than one key
+    matches at the same position, the longest one is replaced, and
+    replaced substrings are never searched again. This function
+    returns a new string without modifying `text`.
+
+  * Returns the string with keys replaced. If `text` does not
+    contain any key, it is returned intact.
+
+  * Throws an exception if any key is empty.
+
+`std.string.find_and_replace_all(text, from, mapping)`
+
+  * Searches `text` and replaces all occurrences of keys of the
+    object `mapping` with their corresponding values. The search
+    operation is performed on the same subrange that would be
+    returned by `slice(text, from)`. This function returns a new
+    string without modifying `text`.
+
+  * Returns the string with keys replaced. If `text` does not
+    contain any key, it is returned intact.
+
+  * Throws an exception if any key is empty.
+
+`std.string.find_and_replace_all(text, from, [length], mapping)`
+
+  * Searches `text` and replaces all occurrences of keys of the
+    object `mapping` with their corresponding values. The search
+    operation is performed on the same subrange that would be
+    returned by `slice(text, from, length)`. This function returns
+    a new string without modifying `text`.
+
+  * Returns the string with keys replaced. If `text` does not
+    contain any key, it is returned intact.
+
+  * Throws an exception if any key is empty.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.find_and_replace_all"));
+    Argument_Reader::State state;
+    // Parse arguments.
+    V_string text;
+    V_object mapping;
+    if(reader.I().v(text).S(state).v(mapping).F()) {
+      Reference_root::S_temporary xref = { std_string_find_and_replace_all(::std::move(text), 0, nullopt,
+                                                           ::std::move(mapping)) };
+      return self = ::std::move(xref);
+    }
+    V_integer from;
+    if(reader.L(state).v(from).S(state).v(mapping).F()) {
+      Reference_root::S_temporary xref = { std_string_find_and_replace_all(::std::move(text), from, nullopt,
+                                                           ::std::move(mapping)) };
+      return self = ::std::move(xref);
+    }
+    optV_integer length;
+    if(reader.L(state).o(length).v(mapping).F()) {
+      Reference_root::S_temporary xref = { std_string_find_and_replace_all(::std::move(text), from, length,
+                                                           ::std::move(mapping)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
+  }
+      ));
+    //===================================================================
+    // `std.string.pattern_set_compile()`
+    //===================================================================
+    result.insert_or_assign(::rocket::sref("pattern_set_compile"),
+      V_function(
+"""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+`std.string.pattern_set_compile(patterns)`
+
+  * Compiles the array of strings `patterns` into an automaton so
+    it can be used repeatedly without being built again.
+
+  * Returns a compiled pattern set as an object consisting of the
+    following members:
+
+    * `find(text, [from, [length]])`
+    * `replace(text, [from, [length]], replacements)`
+
+    The function `find()` behaves identically to
+    `find_any_pattern()` except that `patterns` is omitted. The
+    function `replace()` behaves like `find_and_replace_all()`,
+    except that each pattern is replaced with the element in the
+    array `replacements` with the same subscript.
+
+  * Throws an exception if any pattern is empty.
+)'''''''''''''''" """""""""""""""""""""""""""""""""""""""""""""""",
+*[](Reference& self, cow_vector<Reference>&& args, Global_Context& /*global*/) -> Reference&
+  {
+    Argument_Reader reader(::rocket::ref(args), ::rocket::sref("std.string.pattern_set_compile"));
+    // Parse arguments.
+    V_array patterns;
+    if(reader.I().v(patterns).F()) {
+      Reference_root::S_temporary xref = { std_string_pattern_set_compile(::std::move(patterns)) };
+      return self = ::std::move(xref);
+    }
+    // Fail.
+    reader.throw_no_matching_function_call();
   }
       ));
     //===================================================================
@@ -125,6 +125,70 @@ std_string_base64_encode(V_string data);
 V_string
 std_string_base64_decode(V_string text);
 
+// `std.string.hex_encoder_new_private`
+V_opaque
+std_string_hex_encoder_new_private(optV_boolean lowercase, optV_string delim);
+
+// `std.string.hex_encoder_new_update`
+V_string
+std_string_hex_encoder_new_update(V_opaque& h, V_string data);
+
+// `std.string.hex_encoder_new_finish`
+V_string
+std_string_hex_encoder_new_finish(V_opaque& h);
+
+// `std.string.hex_encoder_new`
+V_object
+std_string_hex_encoder_new(optV_boolean lowercase, optV_string delim);
+
+// `std.string.hex_decoder_new_private`
+V_opaque
+std_string_hex_decoder_new_private();
+
+// `std.string.hex_decoder_new_update`
+V_string
+std_string_hex_decoder_new_update(V_opaque& h, V_string text);
+
+// `std.string.hex_decoder_new_finish`
+V_string
+std_string_hex_decoder_new_finish(V_opaque& h);
+
+// `std.string.hex_decoder_new`
+V_object
+std_string_hex_decoder_new();
+
+// `std.string.base64_encoder_new_private`
+V_opaque
+std_string_base64_encoder_new_private();
+
+// `std.string.base64_encoder_new_update`
+V_string
+std_string_base64_encoder_new_update(V_opaque& h, V_string data);
+
+// `std.string.base64_encoder_new_finish`
+V_string
+std_string_base64_encoder_new_finish(V_opaque& h);
+
+// `std.string.base64_encoder_new`
+V_object
+std_string_base64_encoder_new();
+
+// `std.string.base64_decoder_new_private`
+V_opaque
+std_string_base64_decoder_new_private();
+
+// `std.string.base64_decoder_new_update`
+V_string
+std_string_base64_decoder_new_update(V_opaque& h, V_string text);
+
+// `std.string.base64_decoder_new_finish`
+V_string
+std_string_base64_decoder_new_finish(V_opaque& h);
+
+// `std.string.base64_decoder_new`
+V_object
+std_string_base64_decoder_new();
+
 // `std.string.url_encode`
 V_string
 std_string_url_encode(V_string data, optV_boolean lowercase);
@@ -241,22 +305,101 @@ std_string_pack_64le(V_array values);
 V_array
 std_string_unpack_64le(V_string text);
 
+// `std.string.pack`
+V_string
+std_string_pack(V_string format, cow_vector<Value> values);
+
+// `std.string.unpack`
+V_array
+std_string_unpack(V_string format, V_string data, optV_integer offset);
+
+// `std.string.pack_compile_private`
+V_opaque
+std_string_pack_compile_private(V_string format);
+
+// `std.string.pack_compile_pack`
+V_string
+std_string_pack_compile_pack(const V_opaque& f, cow_vector<Value> values);
+
+// `std.string.pack_compile_unpack`
+V_array
+std_string_pack_compile_unpack(const V_opaque& f, V_string data, optV_integer offset);
+
+// `std.string.pack_compile`
+V_object
+std_string_pack_compile(V_string format);
+
 // `std.string.format`
 V_string
 std_string_format(V_string templ, cow_vector<Value> values);
 
-// `std.stringval`.
+V_string
+std_string_format(V_opaque templ, cow_vector<Value> values);
+
+// `std.string.format_compile`
+V_opaque
+std_string_format_compile(V_string templ);
+
+// `std.string.regex_find`
 opt<pair<V_integer, V_integer>>
-std_string_regex_find(V_string text, V_integer from, optV_integer length, V_string pattern);
+std_string_regex_find(Global_Context& global, V_string text, V_integer from, optV_integer length,
+                      V_string pattern);
 
 // `std.string.regex_match`
 optV_array
-std_string_regex_match(V_string text, V_integer from, optV_integer length, V_string pattern);
+std_string_regex_match(Global_Context& global, V_string text, V_integer from, optV_integer length,
+                       V_string pattern);
 
 // `std.string.regex_replace`
 V_string
-std_string_regex_replace(V_string text, V_integer from, optV_integer length, V_string pattern,
-                         V_string replacement);
+std_string_regex_replace(Global_Context& global, V_string text, V_integer from, optV_integer length,
+                         V_string pattern, V_string replacement);
+
+// `std.string.regex_compile_private`
+V_opaque
+std_string_regex_compile_private(Global_Context& global, V_string pattern);
+
+// `std.string.regex_compile_find`
+opt<pair<V_integer, V_integer>>
+std_string_regex_compile_find(const V_opaque& r, V_string text, V_integer from, optV_integer length);
+
+// `std.string.regex_compile_match`
+optV_array
+std_string_regex_compile_match(const V_opaque& r, V_string text, V_integer from, optV_integer length);
+
+// `std.string.regex_compile_replace`
+V_string
+std_string_regex_compile_replace(const V_opaque& r, V_string text, V_integer from, optV_integer length,
+                                 V_string replacement);
+
+// `std.string.regex_compile`
+V_object
+std_string_regex_compile(Global_Context& global, V_string pattern);
+
+// `std.string.find_any_pattern`
+optV_array
+std_string_find_any_pattern(V_string text, V_integer from, optV_integer length, V_array patterns);
+
+// `std.string.find_and_replace_all`
+V_string
+std_string_find_and_replace_all(V_string text, V_integer from, optV_integer length, V_object mapping);
+
+// `std.string.pattern_set_compile_private`
+V_opaque
+std_string_pattern_set_compile_private(V_array patterns);
+
+// `std.string.pattern_set_compile_find`
+optV_array
+std_string_pattern_set_compile_find(const V_opaque& p, V_string text, V_integer from, optV_integer length);
+
+// `std.string.pattern_set_compile_replace`
+V_string
+std_string_pattern_set_compile_replace(const V_opaque& p, V_string text, V_integer from,
+                                       optV_integer length, V_array replacements);
+
+// `std.string.pattern_set_compile`
+V_object
+std_string_pattern_set_compile(V_array patterns);
 
 // Create an object that is to be referenced as `std.string`.
 void
@@ -2306,6 +2306,12 @@ do_apply_xop_ADD(Executive_Context& ctx, ParamU pu, const void* /*pv*/)
     }
     else if(lhs.is_string() && rhs.is_string()) {
       // For the `string` type, concatenate the operands in lexical order to create a new string.
+      if(assign) {
+        // Append to the target in place, which has amortized constant complexity.
+        // If the string is shared, it is copied only once and then owned by the target.
+        ctx.stack().open_top().open().open_string().append(rhs.as_string());
+        return air_status_next;
+      }
       auto& reg = rhs.open_string();
       reg = do_operator_ADD(lhs.as_string(), reg);
     }
@@ -0,0 +1,150 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "format_template.hpp"
+#include "../value.hpp"
+#include "../utilities.hpp"
+
+namespace Asteria {
+
+Format_Template::
+Format_Template(const cow_string& templ)
+  : m_templ(templ)
+  {
+    // Split the template. The syntax is the same with `rocket::vformat()`.
+    size_t bpos = 0;
+    for(;;) {
+      size_t ppos = templ.find('$', bpos);
+      if(ppos == cow_string::npos)
+        ppos = templ.size();
+      // Append the literal before the placeholder, if any.
+      if(ppos != bpos) {
+        this->m_segs.push_back({ 0, bpos, ppos - bpos });
+        this->m_nlits += ppos - bpos;
+      }
+      if(ppos == templ.size())
+        break;
+      // Parse the placeholder.
+      if(++ppos == templ.size())
+        ASTERIA_THROW("incomplete placeholder (dangling `$$`) in format template `$1`", templ);
+      size_t index = 0;
+      char ch = templ[ppos++];
+      if(ch == '$') {
+        // Write a plain dollar sign.
+        this->m_segs.push_back({ 0, ppos - 1, 1 });
+        this->m_nlits += 1;
+        bpos = ppos;
+        continue;
+      }
+      if(ch == '{') {
+        // Look for the terminator.
+        size_t epos = templ.find('}', ppos);
+        if(epos == cow_string::npos)
+          ASTERIA_THROW("incomplete placeholder (no matching `}`) in format template `$1`", templ);
+        if(epos == ppos)
+          ASTERIA_THROW("missing argument index in format template `$1`", templ);
+        if(epos - ppos > 3)
+          ASTERIA_THROW("too many digits in format template `$1`", templ);
+        // Collect digits.
+        while(ppos != epos) {
+          ch = templ[ppos++];
+          if((ch < '0') || ('9' < ch))
+            ASTERIA_THROW("invalid digit (character `$2`) in format template `$1`", templ, ch);
+          index = index * 10 + static_cast<uint8_t>(ch - '0');
+        }
+        ppos++;
+      }
+      else if(('0' <= ch) && (ch <= '9')) {
+        // Accept a single decimal digit.
+        index = static_cast<uint8_t>(ch - '0');
+      }
+      else
+        ASTERIA_THROW("invalid placeholder (sequence `$$$2`) in format template `$1`", templ, ch);
+      // Append the placeholder.
+      if(index == 0) {
+        this->m_segs.push_back({ 0, 0, templ.size() });
+        this->m_nlits += templ.size();
+      }
+      else {
+        this->m_segs.push_back({ index, 0, 0 });
+        this->m_nargs = ::rocket::max(this->m_nargs, index);
+      }
+      bpos = ppos;
+    }
+  }
+
+Format_Template::
+~Format_Template()
+  {
+  }
+
+tinyfmt&
+Format_Template::
+describe(tinyfmt& fmt)
+const
+  {
+    return fmt << "format template `" << this->m_templ << "`";
+  }
+
+Variable_Callback&
+Format_Template::
+enumerate_variables(Variable_Callback& callback)
+const
+  {
+    return callback;
+  }
+
+Format_Template*
+Format_Template::
+clone_opt(rcptr<Abstract_Opaque>& /*output*/)
+const
+  {
+    // Templates are immutable, so they are always shared.
+    return nullptr;
+  }
+
+tinyfmt&
+Format_Template::
+render(tinyfmt& fmt, const Value* pvals, size_t nvals)
+const
+  {
+    // Check arguments before writing anything.
+    if(this->m_nargs > nvals)
+      ASTERIA_THROW("no enough arguments (`$2` > `$3`) for format template `$1`",
+                    this->m_templ, this->m_nargs, nvals);
+    // Replace placeholders.
+    for(const auto& seg : this->m_segs) {
+      if(seg.index == 0)
+        fmt.putn(this->m_templ.data() + seg.off, seg.len);
+      else
+        pvals[seg.index - 1].print(fmt);
+    }
+    return fmt;
+  }
+
+cow_string
+Format_Template::
+render_string(const Value* pvals, size_t nvals)
+const
+  {
+    // Reserve space for literals, as well as some space for each placeholder.
+    cow_string str;
+    str.reserve(this->m_nlits + this->m_segs.size() * 8);
+    ::rocket::tinyfmt_str fmt;
+    fmt.set_string(::std::move(str));
+    this->render(fmt, pvals, nvals);
+    return fmt.extract_string();
+  }
+
+rcptr<const Format_Template>
+format_template_cast(const cow_opaque& opaq)
+  {
+    auto qtempl = opaq.cast_opt<Format_Template>();
+    if(!qtempl)
+      ASTERIA_THROW("invalid dynamic cast to type `$1` from type `$2`",
+                    typeid(Format_Template).name(), opaq.type().name());
+    return qtempl;
+  }
+
+}  // namespace Asteria
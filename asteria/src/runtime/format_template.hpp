@@ -0,0 +1,73 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_FORMAT_TEMPLATE_HPP_
+#define ASTERIA_RUNTIME_FORMAT_TEMPLATE_HPP_
+
+#include "../fwd.hpp"
+
+namespace Asteria {
+
+class Format_Template
+final
+  : public Abstract_Opaque
+  {
+  private:
+    struct Segment
+      {
+        size_t index;  // zero for a literal; otherwise, the subscript of an argument plus one
+        size_t off;
+        size_t len;
+      };
+
+    // This is the template string split into literals and placeholders, which is to be
+    // rendered without being parsed again. `$0` is stored as a literal of the whole template.
+    cow_string m_templ;
+    cow_vector<Segment> m_segs;
+    size_t m_nargs = 0;
+    size_t m_nlits = 0;
+
+  public:
+    explicit
+    Format_Template(const cow_string& templ);
+
+    ~Format_Template()
+    override;
+
+  public:
+    tinyfmt&
+    describe(tinyfmt& fmt)
+    const override;
+
+    Variable_Callback&
+    enumerate_variables(Variable_Callback& callback)
+    const override;
+
+    Format_Template*
+    clone_opt(rcptr<Abstract_Opaque>& output)
+    const override;
+
+    const cow_string&
+    get_template()
+    const noexcept
+      { return this->m_templ;  }
+
+    // Write the template with placeholders replaced by `nvals` values from `pvals`.
+    // An exception is thrown if a placeholder refers to a value that doesn't exist.
+    tinyfmt&
+    render(tinyfmt& fmt, const Value* pvals, size_t nvals)
+    const;
+
+    // Compose a string in one go.
+    cow_string
+    render_string(const Value* pvals, size_t nvals)
+    const;
+  };
+
+// Get a template from an opaque value, or throw an exception if it holds something else.
+rcptr<const Format_Template>
+format_template_cast(const cow_opaque& opaq);
+
+}  // namespace Asteria
+
+#endif
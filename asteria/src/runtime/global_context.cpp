@@ -6,6 +6,7 @@
 #include "genius_collector.hpp"
 #include "random_engine.hpp"
 #include "loader_lock.hpp"
+#include "regex_cache.hpp"
 #include "variable.hpp"
 #include "abstract_hooks.hpp"
 #include "../library/version.hpp"
@@ -20,6 +21,7 @@
 #include "../library/checksum.hpp"
 #include "../library/json.hpp"
 #include "../library/io.hpp"
+#include "../library/msgpack.hpp"
 #include "../utilities.hpp"
 
 namespace Asteria {
@@ -46,6 +48,7 @@ constexpr s_modules[] =
     { api_version_0001_0000,  "checksum",    create_bindings_checksum    },
     { api_version_0001_0000,  "json",        create_bindings_json        },
     { api_version_0001_0000,  "io",          create_bindings_io          },
+    { api_version_0001_0000,  "msgpack",     create_bindings_msgpack     },
   };
 
 struct Module_Comparator
@@ -122,6 +125,12 @@ initialize(API_Version version)
       ldrlk = ::rocket::make_refcnt<Loader_Lock>();
     this->m_ldrlk = ldrlk;
 
+    // Initialize the regular expression cache.
+    auto regxc = unerase_cast(this->m_regxc);
+    if(!regxc)
+      regxc = ::rocket::make_refcnt<Regex_Cache>();
+    this->m_regxc = regxc;
+
     // Initialize standard library modules.
 #ifdef ROCKET_DEBUG
     ROCKET_ASSERT(::std::is_sorted(begin(s_modules), end(s_modules), Module_Comparator()));
@@ -20,6 +20,7 @@ class Global_Context
     rcfwdp<Genius_Collector> m_gcoll;
     rcfwdp<Random_Engine> m_prng;
     rcfwdp<Loader_Lock> m_ldrlk;
+    rcfwdp<Regex_Cache> m_regxc;
     rcfwdp<Variable> m_vstd;
 
   public:
@@ -105,6 +106,12 @@ class Global_Context
     const noexcept
       { return unerase_cast<Loader_Lock>(this->m_ldrlk);  }
 
+    ASTERIA_INCOMPLET(Regex_Cache)
+    rcptr<Regex_Cache>
+    regex_cache()
+    const noexcept
+      { return unerase_cast<Regex_Cache>(this->m_regxc);  }
+
     ASTERIA_INCOMPLET(Variable)
     rcptr<Variable>
     std_variable()
@@ -0,0 +1,56 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.hpp"
+#include "regex_cache.hpp"
+#include "../utilities.hpp"
+
+namespace Asteria {
+namespace {
+
+// This is the maximum number of patterns to keep.
+constexpr size_t s_max_regexes = 64;
+
+}  // namespace
+
+Regex_Cache::
+~Regex_Cache()
+  {
+  }
+
+rcptr<Abstract_Opaque>
+Regex_Cache::
+get_opt(const cow_string& pattern)
+  {
+    auto qelem = this->m_regexes.find_mut(phsh_string(pattern));
+    if(qelem == this->m_regexes.mut_end())
+      return nullptr;
+    // Mark this pattern as most recently used.
+    qelem->second.stamp = ++(this->m_stamp);
+    return qelem->second.regex;
+  }
+
+Regex_Cache&
+Regex_Cache::
+insert(const cow_string& pattern, const rcptr<Abstract_Opaque>& regex)
+  {
+    if(this->m_regexes.size() >= s_max_regexes) {
+      // Evict the least recently used pattern.
+      auto qold = ::std::min_element(this->m_regexes.begin(), this->m_regexes.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.second.stamp < rhs.second.stamp;  });
+      this->m_regexes.erase(qold);
+    }
+    this->m_regexes.insert_or_assign(phsh_string(pattern), Entry{ regex, ++(this->m_stamp) });
+    return *this;
+  }
+
+Regex_Cache&
+Regex_Cache::
+clear()
+noexcept
+  {
+    this->m_regexes.clear();
+    return *this;
+  }
+
+}  // namespace Asteria
@@ -0,0 +1,64 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_REGEX_CACHE_HPP_
+#define ASTERIA_RUNTIME_REGEX_CACHE_HPP_
+
+#include "../fwd.hpp"
+
+namespace Asteria {
+
+class Regex_Cache
+final
+  : public Rcfwd<Regex_Cache>
+  {
+  private:
+    struct Entry
+      {
+        rcptr<Abstract_Opaque> regex;
+        uint64_t stamp;
+      };
+
+    // Compiled patterns are opaque to the runtime. They are created and used by the
+    // `std.string` module. When the cache is full, the least recently used one is evicted.
+    cow_dictionary<Entry> m_regexes;
+    uint64_t m_stamp = 0;
+
+  public:
+    Regex_Cache()
+    noexcept
+      = default;
+
+    ~Regex_Cache()
+    override;
+
+    Regex_Cache(const Regex_Cache&)
+      = delete;
+
+    Regex_Cache&
+    operator=(const Regex_Cache&)
+      = delete;
+
+  public:
+    size_t
+    size()
+    const noexcept
+      { return this->m_regexes.size();  }
+
+    // Get the compiled form of `pattern` and mark it as most recently used.
+    // If `pattern` is not found, a null pointer is returned.
+    rcptr<Abstract_Opaque>
+    get_opt(const cow_string& pattern);
+
+    // Put the compiled form of `pattern` into the cache.
+    Regex_Cache&
+    insert(const cow_string& pattern, const rcptr<Abstract_Opaque>& regex);
+
+    Regex_Cache&
+    clear()
+    noexcept;
+  };
+
+}  // namespace Asteria
+
+#endif
@@ -7,6 +7,7 @@
 #include <stdio.h>  // ::fwrite(), stderr
 #include <errno.h>  // errno
 #include <string.h>  // ::strerror_r()
+#include <atomic>
 
 namespace Asteria {
 namespace {
@@ -55,16 +56,108 @@ constexpr char s_escapes[][8] =
     "\\xF8",  "\\xF9",  "\\xFA",  "\\xFB",  "\\xFC",  "\\xFD",  "\\xFE",  "\\xFF",
   };
 
+uint32_t
+do_detect_cpu_features()
+noexcept
+  {
+    uint32_t features = 0;
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("ssse3"))
+      features |= cpu_feature_ssse3;
+    if(__builtin_cpu_supports("sse4.1"))
+      features |= cpu_feature_sse41;
+    if(__builtin_cpu_supports("sse4.2"))
+      features |= cpu_feature_sse42;
+    if(__builtin_cpu_supports("pclmul"))
+      features |= cpu_feature_pclmul;
+    if(__builtin_cpu_supports("avx2"))
+      features |= cpu_feature_avx2;
+    if(__builtin_cpu_supports("sha"))
+      features |= cpu_feature_sha_ni;
+#endif
+    return features;
+  }
+
+::std::atomic<uint32_t> s_cpu_feature_mask(UINT32_MAX);
+
 }  // namespace
 
+Log_Stream::Buffer::
+~Buffer()
+  = default;
+
+tinybuf&
+Log_Stream::Buffer::
+do_flush(const char*& /*gcur*/, const char*& /*gend*/, char*& pcur, char*& pend)
+  {
+    // Escape characters in the put area.
+    if(pcur)
+      this->write_escaped(this->m_raw, static_cast<size_t>(pcur - this->m_raw));
+    pcur = this->m_raw;
+    pend = this->m_raw + sizeof(this->m_raw);
+    return *this;
+  }
+
+tinybuf&
+Log_Stream::Buffer::
+do_overflow(char*& pcur, char*& pend, const char* sadd, size_t nadd)
+  {
+    // Escape characters in the put area, followed by `sadd`.
+    if(pcur)
+      this->write_escaped(this->m_raw, static_cast<size_t>(pcur - this->m_raw));
+    this->write_escaped(sadd, nadd);
+    pcur = this->m_raw;
+    pend = this->m_raw + sizeof(this->m_raw);
+    return *this;
+  }
+
+void
+Log_Stream::Buffer::
+write_escaped(const char* str, size_t len)
+  {
+    // Neutralize control characters. That is ['\x00','\x1F'] and '\x7F'.
+    size_t off = 0;
+    while(off < len) {
+      // Copy printable characters in bulk.
+      size_t n = 0;
+      while((off + n < len) && (static_cast<uint8_t>(str[off + n] - 0x20) < 0x5F))
+        n++;
+      if(n != 0) {
+        this->write_raw(str + off, n);
+        off += n;
+        continue;
+      }
+      size_t ch = str[off++] & 0xFF;
+      if(ch <= 0x1F)
+        this->write_raw(s_lcchars[ch], ::std::strlen(s_lcchars[ch]));
+      else if(ch == 0x7F)
+        this->write_raw("[DEL]", 5);
+      else
+        this->write_raw(str + off - 1, 1);
+    }
+  }
+
 ptrdiff_t
-write_log_to_stderr(const char* file, long line, cow_string&& msg)
-noexcept
+Log_Stream::Buffer::
+finish()
   {
-    ::rocket::tinyfmt_str fmt;
-    fmt.set_string(cow_string(1023, '/'));
-    fmt.clear_string();
+    this->flush();
+    this->write_raw("\n", 1);
+
+    // Write the line now. `fwrite()` locks the stream, so the line is never interleaved
+    // with output from other threads.
+    size_t nput = ::fwrite(this->m_line.data(), 1, this->m_line.size(), stderr);
+    if(nput != this->m_line.size())
+      return -1;
 
+    // Return the number of characters that have been written.
+    return static_cast<ptrdiff_t>(nput);
+  }
+
+Log_Stream::
+Log_Stream(const char* file, long line)
+  {
     // Append the timestamp.
     ::timespec ts;
     ::clock_gettime(CLOCK_REALTIME, &ts);
@@ -73,37 +166,38 @@ noexcept
 
     // 'yyyy-mmmm-dd HH:MM:SS.sss'
     ::rocket::ascii_numput nump;
-    fmt << nump.put_DU(static_cast<uint64_t>(tr.tm_year + 1900), 4);
-    fmt << '-' << nump.put_DU(static_cast<uint64_t>(tr.tm_mon + 1), 2);
-    fmt << '-' << nump.put_DU(static_cast<uint64_t>(tr.tm_mday), 2);
-    fmt << ' ' << nump.put_DU(static_cast<uint64_t>(tr.tm_hour), 2);
-    fmt << ':' << nump.put_DU(static_cast<uint64_t>(tr.tm_min), 2);
-    fmt << ':' << nump.put_DU(static_cast<uint64_t>(tr.tm_sec), 2);
-    fmt << '.' << nump.put_DU(static_cast<uint64_t>(ts.tv_nsec), 9);
+    auto put_num = [&](char sep, uint64_t value, size_t width) {
+      if(sep)
+        this->m_buf.write_raw(&sep, 1);
+      nump.put_DU(value, width);
+      this->m_buf.write_raw(nump.data(), nump.size());
+    };
+    put_num(0, static_cast<uint64_t>(tr.tm_year + 1900), 4);
+    put_num('-', static_cast<uint64_t>(tr.tm_mon + 1), 2);
+    put_num('-', static_cast<uint64_t>(tr.tm_mday), 2);
+    put_num(' ', static_cast<uint64_t>(tr.tm_hour), 2);
+    put_num(':', static_cast<uint64_t>(tr.tm_min), 2);
+    put_num(':', static_cast<uint64_t>(tr.tm_sec), 2);
+    put_num('.', static_cast<uint64_t>(ts.tv_nsec), 9);
 
     // Append the file name and line number, followed by a line feed.
-    fmt << " @ " << file << ':' << line << "\n\t";
-
-    // Neutralize control characters. That is ['\x00','\x1F'] and '\x7F'.
-    for(size_t i = 0;  i < msg.size();  ++i) {
-      size_t ch = msg[i] & 0xFF;
-      if(ch <= 0x1F)
-        fmt << s_lcchars[ch];
-      else if(ch == 0x7F)
-        fmt << "[DEL]";
-      else
-        fmt << static_cast<char>(ch);
-    }
-    fmt << '\n';
+    this->m_buf.write_raw(" @ ", 3);
+    this->m_buf.write_raw(file, ::std::strlen(file));
+    put_num(':', static_cast<uint64_t>(line), 1);
+    this->m_buf.write_raw("\n\t", 2);
+  }
 
-    // Write the string now.
-    // Note the string cannot be empty so a return value of zero always indicates failure.
-    size_t nput = ::fwrite(fmt.get_c_string(), 1, fmt.get_length(), stderr);
-    if(nput == 0)
-      return -1;
+Log_Stream::
+~Log_Stream()
+  = default;
 
-    // Return the number of characters that have been written.
-    return static_cast<ptrdiff_t>(nput);
+ptrdiff_t
+write_log_to_stderr(const char* file, long line, cow_string&& msg)
+noexcept
+  {
+    Log_Stream fmt(file, line);
+    fmt.putn(msg.data(), msg.size());
+    return fmt.finish();
   }
 
 bool
@@ -230,6 +324,53 @@ utf8_decode(char32_t& cp, const cow_string& text, size_t& offset)
     return true;
   }
 
+size_t
+utf8_ascii_prefix(const char* str, size_t len)
+noexcept
+  {
+    size_t off = 0;
+    // Test four words at a time, as most text is pure ASCII.
+    constexpr auto mask = static_cast<uintptr_t>(UINTPTR_MAX / 0xFF * 0x80);
+    uintptr_t words[4];
+    while(len - off >= sizeof(words)) {
+      ::std::memcpy(words, str + off, sizeof(words));
+      if((words[0] | words[1] | words[2] | words[3]) & mask)
+        break;
+      off += sizeof(words);
+    }
+    while(len - off >= sizeof(words[0])) {
+      ::std::memcpy(words, str + off, sizeof(words[0]));
+      if(words[0] & mask)
+        break;
+      off += sizeof(words[0]);
+    }
+    // Find the first non-ASCII byte, if any.
+    while((off != len) && !(str[off] & 0x80))
+      off++;
+    return off;
+  }
+
+bool
+utf8_validate(size_t& offset, const char* str, size_t len)
+noexcept
+  {
+    size_t off = 0;
+    for(;;) {
+      // Skip ASCII characters in bulk.
+      off += utf8_ascii_prefix(str + off, len - off);
+      if(off == len)
+        return true;
+      // Decode a multi-byte sequence.
+      char32_t cp;
+      const char* pos = str + off;
+      if(!utf8_decode(cp, pos, len - off)) {
+        offset = off;
+        return false;
+      }
+      off = static_cast<size_t>(pos - str);
+    }
+  }
+
 bool
 utf16_encode(char16_t*& pos, char32_t cp)
 noexcept
@@ -418,6 +559,36 @@ noexcept
     return seed;
   }
 
+bool
+cpu_supports(uint32_t features)
+noexcept
+  {
+    static const uint32_t s_detected = do_detect_cpu_features();
+    uint32_t enabled = s_detected & s_cpu_feature_mask.load(::std::memory_order_relaxed);
+    return (enabled & features) == features;
+  }
+
+uint32_t
+cpu_set_feature_mask(uint32_t mask)
+noexcept
+  {
+    return s_cpu_feature_mask.exchange(mask, ::std::memory_order_relaxed);
+  }
+
+phsh_string
+String_Pool::
+intern(const cow_string& str)
+  {
+    phsh_string key(str);
+    // Look for an existent string.
+    auto qstr = this->m_strs.find(key);
+    if(qstr != this->m_strs.end())
+      return qstr->first;
+    // Add the new string to the pool.
+    this->m_strs.try_emplace(key, true);
+    return key;
+  }
+
 void
 throw_system_error(const char* func, int err)
   {
@@ -15,6 +15,82 @@ ptrdiff_t
 write_log_to_stderr(const char* file, long line, cow_string&& msg)
 noexcept;
 
+// This stream composes a log message and writes it to standard error as a single line.
+// The header is composed by the constructor, and `finish()` appends the terminating
+// line feed and writes the line at once, so nothing is written if formatting throws an
+// exception. Control characters in the message are neutralized as in
+// `write_log_to_stderr()`.
+class Log_Stream
+final
+  : public tinyfmt
+  {
+  private:
+    class Buffer
+    final
+      : public tinybuf
+      {
+      private:
+        char m_raw[256];  // put area, not escaped
+        cow_string m_line;  // escaped
+
+      public:
+        Buffer()
+        noexcept
+          = default;
+
+        ~Buffer()
+        override;
+
+      protected:
+        tinybuf&
+        do_flush(const char*& gcur, const char*& gend, char*& pcur, char*& pend)
+        override;
+
+        tinybuf&
+        do_overflow(char*& pcur, char*& pend, const char* sadd, size_t nadd)
+        override;
+
+      public:
+        void
+        write_raw(const char* str, size_t len)
+          { this->m_line.append(str, len);  }
+
+        void
+        write_escaped(const char* str, size_t len);
+
+        ptrdiff_t
+        finish();
+      };
+
+  private:
+    mutable Buffer m_buf;
+
+  public:
+    Log_Stream(const char* file, long line);
+
+    ~Log_Stream()
+    override;
+
+    Log_Stream(const Log_Stream&)
+      = delete;
+
+    Log_Stream&
+    operator=(const Log_Stream&)
+      = delete;
+
+  public:
+    Buffer&
+    get_tinybuf()
+    const override
+      { return this->m_buf;  }
+
+    // Appends the line feed and writes the line.
+    // Returns the number of bytes written, or `-1` if a write error has occurred.
+    ptrdiff_t
+    finish()
+      { return this->m_buf.finish();  }
+  };
+
 template<typename... ParamsT>
 ROCKET_NOINLINE
 cow_string
@@ -52,6 +128,17 @@ noexcept;
 bool
 utf8_decode(char32_t& cp, const cow_string& text, size_t& offset);
 
+// Returns the number of leading ASCII characters in `str`. Bytes are checked a word at a time.
+size_t
+utf8_ascii_prefix(const char* str, size_t len)
+noexcept;
+
+// Checks whether `str` is a valid UTF-8 string.
+// Upon failure, `offset` is set to the beginning of the first invalid sequence.
+bool
+utf8_validate(size_t& offset, const char* str, size_t len)
+noexcept;
+
 // UTF-16 conversion functions
 bool
 utf16_encode(char16_t*& pos, char32_t cp)
@@ -160,6 +247,42 @@ uint64_t
 generate_random_seed()
 noexcept;
 
+// CPU features
+// These are detected at run time. Functions that have optimized code paths for them must
+// call `cpu_supports()` before using them, as features may be disabled for testing.
+enum : uint32_t
+  {
+    cpu_feature_ssse3   = 0x0001,
+    cpu_feature_sse41   = 0x0002,
+    cpu_feature_sse42   = 0x0004,
+    cpu_feature_pclmul  = 0x0008,
+    cpu_feature_avx2    = 0x0010,
+    cpu_feature_sha_ni  = 0x0020,
+  };
+
+// Checks whether all features in `features` are supported by the CPU and enabled.
+bool
+cpu_supports(uint32_t features)
+noexcept;
+
+// Enables only features in `mask` and returns the previous mask. This exists so fallback
+// code paths can be tested on machines where faster ones are available.
+uint32_t
+cpu_set_feature_mask(uint32_t mask)
+noexcept;
+
+// String interning
+// Equal strings obtained from the same pool share storage, so they can be compared by pointers.
+class String_Pool
+  {
+  private:
+    cow_dictionary<bool> m_strs;  // values are unused
+
+  public:
+    phsh_string
+    intern(const cow_string& str);
+  };
+
 // The second overload takes the error code from `errno`.
 [[noreturn]]
 void
@@ -33,6 +33,20 @@ noexcept
                                         : compare_equal;
   }
 
+struct S_xprint_array
+  {
+    ref_to<const V_array> refa;
+    V_array::const_iterator curp;
+  };
+
+struct S_xprint_object
+  {
+    ref_to<const V_object> refo;
+    V_object::const_iterator curp;
+  };
+
+using Xprint = variant<S_xprint_array, S_xprint_object>;
+
 }  // namespace
 
 bool
@@ -287,67 +301,119 @@ Value::
 print(tinyfmt& fmt, bool escape)
 const
   {
-    switch(this->vtype()) {
-      case vtype_null:
-        // null
-        return fmt << "null";
-
-      case vtype_boolean:
-        // true
-        return fmt << this->m_stor.as<vtype_boolean>();
-
-      case vtype_integer:
-        // 42
-        return fmt << this->m_stor.as<vtype_integer>();
-
-      case vtype_real:
-        // 123.456
-        return fmt << this->m_stor.as<vtype_real>();
-
-      case vtype_string:
-        if(!escape)
-          // hello
-          return fmt << this->m_stor.as<vtype_string>();
-        else
-          // "hello"
-          return fmt << quote(this->m_stor.as<vtype_string>());
-
-      case vtype_opaque:
-        // <opaque> [[`my opaque`]]
-        return fmt << "<opaque> [[`" << this->m_stor.as<vtype_opaque>() << "`]]";
-
-      case vtype_function:
-        // <function> [[`my function`]]
-        return fmt << "<function> [[`" << this->m_stor.as<vtype_function>() << "`]]";
+    // Transform recursion to iteration using a handwritten stack.
+    auto qval = this;
+    cow_vector<Xprint> stack;
+    for(;;) {
+      // Find a leaf value. `qval` must always point to a valid value here.
+      switch(qval->vtype()) {
+        case vtype_null:
+          // null
+          fmt << "null";
+          break;
+
+        case vtype_boolean:
+          // true
+          fmt << qval->m_stor.as<vtype_boolean>();
+          break;
+
+        case vtype_integer:
+          // 42
+          fmt << qval->m_stor.as<vtype_integer>();
+          break;
+
+        case vtype_real:
+          // 123.456
+          fmt << qval->m_stor.as<vtype_real>();
+          break;
+
+        case vtype_string:
+          // Strings within arrays and objects are always escaped.
+          if(!escape && stack.empty())
+            // hello
+            fmt << qval->m_stor.as<vtype_string>();
+          else
+            // "hello"
+            fmt << quote(qval->m_stor.as<vtype_string>());
+          break;
+
+        case vtype_opaque:
+          // <opaque> [[`my opaque`]]
+          fmt << "<opaque> [[`" << qval->m_stor.as<vtype_opaque>() << "`]]";
+          break;
+
+        case vtype_function:
+          // <function> [[`my function`]]
+          fmt << "<function> [[`" << qval->m_stor.as<vtype_function>() << "`]]";
+          break;
+
+        case vtype_array: {
+          const auto& altr = qval->m_stor.as<vtype_array>();
+          // [ 1, 2, 3, ]
+          fmt << '[';
+          auto curp = altr.begin();
+          if(curp != altr.end()) {
+            fmt << ' ';
+            // Descend into the array.
+            S_xprint_array ctxa = { ::rocket::ref(altr), curp };
+            stack.emplace_back(::std::move(ctxa));
+            qval = ::std::addressof(*curp);
+            continue;
+          }
+          fmt << " ]";
+          break;
+        }
 
-      case vtype_array: {
-        const auto& altr = this->m_stor.as<vtype_array>();
-        // [ 1, 2, 3, ]
-        fmt << '[';
-        for(size_t i = 0;  i < altr.size();  ++i) {
-          fmt << ' ';
-          altr[i].print(fmt, true);
-          fmt << ',';
+        case vtype_object: {
+          const auto& altr = qval->m_stor.as<vtype_object>();
+          // { "one" = 1, "two" = 2, "three" = 3, }
+          fmt << '{';
+          auto curp = altr.begin();
+          if(curp != altr.end()) {
+            fmt << ' ' << quote(curp->first) << " = ";
+            // Descend into the object.
+            S_xprint_object ctxo = { ::rocket::ref(altr), curp };
+            stack.emplace_back(::std::move(ctxo));
+            qval = ::std::addressof(curp->second);
+            continue;
+          }
+          fmt << " }";
+          break;
         }
-        fmt << " ]";
-        return fmt;
-      }
 
-      case vtype_object: {
-        const auto& altr = this->m_stor.as<vtype_object>();
-        // { "one" = 1, "two" = 2, "three" = 3, }
-        fmt << '{';
-        for(auto q = altr.begin();  q != altr.end();  ++q) {
-          fmt << ' ' << quote(q->first) << " = ";
-          q->second.print(fmt, true);
-          fmt << ',';
+        default:
+          ASTERIA_TERMINATE("invalid value type (vtype `$1`)", qval->vtype());
+      }
+      for(;;) {
+        // Advance to the next element if any.
+        if(stack.empty())
+          return fmt;
+
+        fmt << ',';
+        if(stack.back().index() == 0) {
+          auto& ctxa = stack.mut_back().as<0>();
+          auto curp = ++(ctxa.curp);
+          if(curp != ctxa.refa->end()) {
+            fmt << ' ';
+            // Print the next element.
+            qval = ::std::addressof(*curp);
+            break;
+          }
+          fmt << " ]";
         }
-        fmt << " }";
-        return fmt;
+        else {
+          auto& ctxo = stack.mut_back().as<1>();
+          auto curp = ++(ctxo.curp);
+          if(curp != ctxo.refo->end()) {
+            fmt << ' ' << quote(curp->first) << " = ";
+            // Print the next value.
+            qval = ::std::addressof(curp->second);
+            break;
+          }
+          fmt << " }";
+        }
+        stack.pop_back();
       }
-
-      default:
-        ASTERIA_TERMINATE("invalid value type (vtype `$1`)", this->vtype());
     }
   }
 
@@ -356,82 +422,135 @@ Value::
 dump(tinyfmt& fmt, size_t indent, size_t hanging)
 const
   {
-    switch(this->vtype()) {
-      case vtype_null:
-        // null
-        return fmt << "null";
+    // Transform recursion to iteration using a handwritten stack.
+    auto qval = this;
+    cow_vector<Xprint> stack;
+    for(;;) {
+      // Find a leaf value. `qval` must always point to a valid value here.
+      // Each level of nesting is indented further by `indent`.
+      size_t qhang = hanging + stack.size() * indent;
+      switch(qval->vtype()) {
+        case vtype_null:
+          // null
+          fmt << "null";
+          break;
+
+        case vtype_boolean:
+          // boolean true
+          fmt << "boolean " << qval->m_stor.as<vtype_boolean>();
+          break;
+
+        case vtype_integer:
+          // integer 42
+          fmt << "integer " << qval->m_stor.as<vtype_integer>();
+          break;
+
+        case vtype_real:
+          // real 123.456
+          fmt << "real " << qval->m_stor.as<vtype_real>();
+          break;
+
+        case vtype_string: {
+          const auto& altr = qval->m_stor.as<vtype_string>();
+          // string(5) "hello"
+          fmt << "string(" << altr.size() << ") " << quote(altr);
+          break;
+        }
 
-      case vtype_boolean:
-        // boolean true
-        return fmt << "boolean " << this->m_stor.as<vtype_boolean>();
+        case vtype_opaque: {
+          const auto& altr = qval->m_stor.as<vtype_opaque>();
+          // opaque(0x123456) [[`my opaque`]]
+          fmt << "opaque(" << altr.ptr() << ") [[`" << altr << "`]]";
+          break;
+        }
 
-      case vtype_integer:
-        // integer 42
-        return fmt << "integer " << this->m_stor.as<vtype_integer>();
+        case vtype_function: {
+          const auto& altr = qval->m_stor.as<vtype_function>();
+          // function(0x123456) [[`my function`]]
+          fmt << "function(" << altr.ptr() << ") [[`" << altr << "`]]";
+          break;
+        }
 
-      case vtype_real:
-        // real 123.456
-        return fmt << "real " << this->m_stor.as<vtype_real>();
-
-      case vtype_string: {
-        const auto& altr = this->m_stor.as<vtype_string>();
-        // string(5) "hello"
-        fmt << "string(" << altr.size() << ") " << quote(altr);
-        return fmt;
-      }
+        case vtype_array: {
+          const auto& altr = qval->m_stor.as<vtype_array>();
+          // array(3) =
+          //  [
+          //   0 = integer 1;
+          //   1 = integer 2;
+          //   2 = integer 3;
+          //  ]
+          fmt << "array(" << altr.size() << ")";
+          fmt << pwrap(indent, qhang + 1) << '[';
+          auto curp = altr.begin();
+          if(curp != altr.end()) {
+            fmt << pwrap(indent, qhang + indent) << size_t(0) << " = ";
+            // Descend into the array.
+            S_xprint_array ctxa = { ::rocket::ref(altr), curp };
+            stack.emplace_back(::std::move(ctxa));
+            qval = ::std::addressof(*curp);
+            continue;
+          }
+          fmt << pwrap(indent, qhang + 1) << ']';
+          break;
+        }
 
-      case vtype_opaque: {
-        const auto& altr = this->m_stor.as<vtype_opaque>();
-        // opaque(0x123456) [[`my opaque`]]
-        fmt << "opaque(" << altr.ptr() << ") [[`" << altr << "`]]";
-        return fmt;
-      }
+        case vtype_object: {
+          const auto& altr = qval->m_stor.as<vtype_object>();
+          // object(3) =
+          //  {
+          //   "one" = integer 1;
+          //   "two" = integer 2;
+          //   "three" = integer 3;
+          //  }
+          fmt << "object(" << altr.size() << ")";
+          fmt << pwrap(indent, qhang + 1) << '{';
+          auto curp = altr.begin();
+          if(curp != altr.end()) {
+            fmt << pwrap(indent, qhang + indent) << quote(curp->first) << " = ";
+            // Descend into the object.
+            S_xprint_object ctxo = { ::rocket::ref(altr), curp };
+            stack.emplace_back(::std::move(ctxo));
+            qval = ::std::addressof(curp->second);
+            continue;
+          }
+          fmt << pwrap(indent, qhang + 1) << '}';
+          break;
+        }
 
-      case vtype_function: {
-        const auto& altr = this->m_stor.as<vtype_function>();
-        // function(0x123456) [[`my function`]]
-        fmt << "function(" << altr.ptr() << ") [[`" << altr << "`]]";
-        return fmt;
+        default:
+          ASTERIA_TERMINATE("invalid value type (vtype `$1`)", qval->vtype());
       }
-
-      case vtype_array: {
-        const auto& altr = this->m_stor.as<vtype_array>();
-        // array(3) =
-        //  [
-        //   0 = integer 1;
-        //   1 = integer 2;
-        //   2 = integer 3;
-        //  ]
-        fmt << "array(" << altr.size() << ")";
-        fmt << pwrap(indent, hanging + 1) << '[';
-        for(size_t i = 0;  i < altr.size();  ++i) {
-          fmt << pwrap(indent, hanging + indent) << i << " = ";
-          altr[i].dump(fmt, indent, hanging + indent) << ';';
+      for(;;) {
+        // Advance to the next element if any.
+        if(stack.empty())
+          return fmt;
+
+        fmt << ';';
+        qhang = hanging + (stack.size() - 1) * indent;
+        if(stack.back().index() == 0) {
+          auto& ctxa = stack.mut_back().as<0>();
+          auto curp = ++(ctxa.curp);
+          if(curp != ctxa.refa->end()) {
+            fmt << pwrap(indent, qhang + indent) << static_cast<size_t>(curp - ctxa.refa->begin()) << " = ";
+            // Dump the next element.
+            qval = ::std::addressof(*curp);
+            break;
+          }
+          fmt << pwrap(indent, qhang + 1) << ']';
         }
-        fmt << pwrap(indent, hanging + 1) << ']';
-        return fmt;
-      }
-
-      case vtype_object: {
-        const auto& altr = this->m_stor.as<vtype_object>();
-        // object(3) =
-        //  {
-        //   "one" = integer 1;
-        //   "two" = integer 2;
-        //   "three" = integer 3;
-        //  }
-        fmt << "object(" << altr.size() << ")";
-        fmt << pwrap(indent, hanging + 1) << '{';
-        for(auto q = altr.begin();  q != altr.end();  ++q) {
-          fmt << pwrap(indent, hanging + indent) << quote(q->first) << " = ";
-          q->second.dump(fmt, indent, hanging + indent) << ';';
+        else {
+          auto& ctxo = stack.mut_back().as<1>();
+          auto curp = ++(ctxo.curp);
+          if(curp != ctxo.refo->end()) {
+            fmt << pwrap(indent, qhang + indent) << quote(curp->first) << " = ";
+            // Dump the next value.
+            qval = ::std::addressof(curp->second);
+            break;
+          }
+          fmt << pwrap(indent, qhang + 1) << '}';
         }
-        fmt << pwrap(indent, hanging + 1) << '}';
-        return fmt;
+        stack.pop_back();
       }
-
-      default:
-        ASTERIA_TERMINATE("invalid value type (vtype `$1`)", this->vtype());
     }
   }
 
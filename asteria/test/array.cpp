@@ -206,6 +206,39 @@ int main()
         assert std.array.sortu(["abb","baa","aaa","bbb","aba","bab","aab","bba"], func(x, y) = std.string.compare(x, y, 2))
                             == ["aaa","abb","baa","bbb"];
 
+        assert std.array.sort([1.5,-0.0,1,-2.5]) == [-2.5,-0.0,1,1.5];
+        assert std.array.sort([1.5,-0.0,0.0,-2.5,0.0]) == [-2.5,-0.0,0.0,0.0,1.5];
+        assert __sign std.array.sort([0.0,-0.0])[0] == 0;
+        assert __sign std.array.sort([-0.0,0.0])[0] == -1;
+        assert std.array.sortu([1.5,-0.0,0.0,-2.5,1.5]) == [-2.5,0.0,1.5];
+        assert __sign std.array.sortu([-0.0,1.5,0.0])[0] == -1;
+        var zeroes = std.array.generate(func(i, p) = ((i * 7) % 5 == 0) ? -0.0 : ((i % 3 == 0) ? 0.0 : i * 1.5 - 40), 50);
+        var signs = [];
+        for(each k, v : zeroes) if(v == 0) signs[$] = __sign v;
+        var sorted_signs = [];
+        for(each k, v : std.array.sort(zeroes)) if(v == 0) sorted_signs[$] = __sign v;
+        assert sorted_signs == signs;
+        assert __sign std.array.sortu(zeroes)[std.array.find(std.array.sortu(zeroes), 0)] == signs[0];
+        assert std.array.sortu([4,2,4,-1,2,3,4]) == [-1,2,3,4];
+        assert std.array.sortu([0x7FFFFFFFFFFFFFFF,-0x7FFFFFFFFFFFFFFF-1,0x7FFFFFFFFFFFFFFF])
+                            == [-0x7FFFFFFFFFFFFFFF-1,0x7FFFFFFFFFFFFFFF];
+        assert std.array.sort(std.array.generate(func(i, p) = (i * 7919) % 1000, 1000))
+                           == std.array.generate(func(i, p) = i, 1000);
+        assert std.array.is_sorted([1.5,2.5,2.5,3]) == true;
+        assert std.array.is_sorted([1.5,2.5,2.4,3.5]) == false;
+        assert std.array.is_sorted([1.5,2.5,3,3.5]) == true;
+        assert std.array.is_sorted([1.5,2.5,3,2.4]) == false;
+        assert std.array.is_sorted([1.5,nan,3.5]) == false;
+        assert std.array.max_of([5,1,3,7,4]) == 7;
+        assert std.array.max_of([5,1,3,7.5,4]) == 7.5;
+        assert std.array.max_of([0.5,1.5,-3.5]) == 1.5;
+        assert __sign std.array.max_of([-0.0,0.0]) == -1;
+        assert std.array.min_of([5,1,3,7,4]) == 1;
+        assert std.array.min_of([0.5,1.5,-3.5]) == -3.5;
+        assert __sign std.array.min_of([0.0,-0.0]) == 0;
+        try { std.array.sort([1.5,nan,3.5]);  assert false;  }
+          catch(e) { assert std.string.find(e, "unordered") != null;  }
+
         assert std.array.max_of([ ]) == null;
         assert std.array.max_of([5,null,3,"meow",7,4]) == 7;
         assert std.array.max_of([ ], func(x,y) = y<=> x) == null;
@@ -51,6 +51,62 @@ int main()
         assert h.finish() == 0x8731D904;
         q.update("2");
         assert q.finish() == 0x1E3888BE;
+        // long
+        assert std.checksum.crc32(s * 10000) == 0xC0B5BC1A;
+        assert std.checksum.crc32("x" + s * 10000) == 0xBC782B03;
+        assert std.checksum.crc32(s * 3511) == 0x96DB1BA2;
+        h = std.checksum.crc32_new();
+        h.update("x");
+        h.update(s * 5000);
+        h.update(s * 5000);
+        assert h.finish() == 0xBC782B03;
+
+        // CRC-32C
+        const crc32c_results = [
+          0x00000000, 0xE627F441, 0x482A0938, 0x75335E90, 0xA75CE107, 0x82DE0E43, 0x43FC572E, 0x8929891F,
+          0x25F556E6, 0xE25D2BF8, 0x6399CCED, 0x15C3BB8A, 0xDEEB39A6, 0x7C56574D, 0x678AB2D8, 0x879039AF,
+          0x1D34A41D, 0x1F33AF25, 0xB3B5D56D, 0x817FD1D5, 0x44598112, 0xCCC38AEC, 0x7D4A8231, 0xAF700A1C,
+          0xE321360B, 0x53361CDC, 0x289AF232, 0x6EFDA9AC, 0x4DDD18D4, 0xC028497F, 0xC8A3C709, 0x6637108B,
+          0xA157C15E, 0x8EF99D9E, 0x05B01578, 0xB23B81B0, 0x8B297F88, 0xD0CF6C86, 0x1B2C9938, 0x19B0DF73,
+          0x8997BE72, 0x8D4E77D4, 0xFD227208, 0xC4947545, 0xC4AB9600, 0x29209858, 0x156803BB, 0xD6403E61,
+          0x6639AA6F, 0x014FCD7C, 0x7E97DF2D, 0x82ED6A09, 0x42DCEAF6, 0x76584D9F, 0xC3ABBA9C, 0xE5DFD5A7,
+          0x8FB68B00, 0x793EE271, 0x668B7169, 0x7819807B, 0xC64729A4, 0x23543912, 0x8D852ABD, 0xBB8C0C67,
+          0xDDDA094C, 0xDBBE6D1F, 0xB4ABECB1, 0x70DCFCAA, 0x532AA97C, 0x4E9A6682, 0xECA437C2, 0x4C4370BC,
+          0x4BDA11DC, 0x6D00DB1C, 0x3BAB8A62, 0x8436B21B, 0x2347FAEA, 0x0CD051BB, 0x3EEE875D, 0x025FE252,
+          0xF6BC2757, 0xC29BC6D1, 0xCC66EA9B, 0x9DB6B0A8, 0xB867F5A1, 0x520A1DF2, 0xADD7B099, 0x5BCDB591,
+          0x714080AA, 0xD3C2505A, 0x0B7908FD, 0xE1FDB849, 0xA06432CA, 0x20986381, 0x37C4FB54, 0x3892C939,
+          0xA5946E7D, 0x1EF61067, 0xFA593A06, 0xA6D2EA26, 0x65DB676E, 0x16D8153C, 0x0FB4AF77, 0xAAEF1B04,
+          0x349D40C8, 0x9007A130, 0x2259315E, 0xBC8F7D6F, 0x6608EA60, 0xF0186065, 0x6ADA8DD5, 0x4FB91C34,
+          0xB384B6F3, 0xC0567901, 0x9BFC2A9A, 0xE8BE460B, 0x003D3A01, 0xF9EF48EF, 0xAA63851C, 0x78102F03,
+          0xD1188B42, 0x834629A7, 0xAE81E74A, 0xF23D4735, 0xF310DDE3, 0x292448DC, 0x77A3AA2D, 0xCB1AE855,
+        ];
+        h = std.checksum.crc32c_new();
+        for(each k, v : crc32c_results) {
+          // split
+          for(var i = 0; i < k; ++i) {
+            h.update(s);
+          }
+          assert h.finish() == v;
+          // simple
+          assert std.checksum.crc32c(s * k) == v;
+        }
+        h = std.checksum.crc32c_new();
+        h.update("hello");
+        q = h;
+        h.update("1");
+        assert h.finish() == 0x9C573A34;
+        q.update("2");
+        assert q.finish() == 0x8F07C9C0;
+        assert std.checksum.crc32c("123456789") == 0xE3069283;
+        // long
+        assert std.checksum.crc32c(s * 10000) == 0x47D8E046;
+        assert std.checksum.crc32c("x" + s * 10000) == 0xE115514D;
+        assert std.checksum.crc32c(s * 3511) == 0x71E6E90A;
+        h = std.checksum.crc32c_new();
+        h.update("x");
+        h.update(s * 5000);
+        h.update(s * 5000);
+        assert h.finish() == 0xE115514D;
 
         // FNV1a-32
         const fnv1a32_results = [
@@ -89,6 +145,56 @@ int main()
         q.update("2");
         assert q.finish() == 0xF09334DB;
 
+        // XXH3-64
+        const xxh3_64_results = [
+          3244421341483603138, 6503440028625798447, -8536430400166261301, -7933672650433457895,
+          5772877241841224648, 7266573198372227320, -2553244555032068394, -6949066870687662915,
+          6348711326614422779, -7761779792877300227, -2736070512470086262, 6372068951673104692,
+          2117242989997360440, -2893639986051777683, 7785554575506053583, 1893515954396735408,
+          -5718792271887105902, -7459605285305761682, 674592035612969933, 1370840725730236696,
+          -7298424598565463760, -8868654398570206133, 3980241007337513123, 6422340048025801324,
+          1130788537411591428, 4825460083230483328, 236056000518878973, 7341341719975637465,
+          1377116675133847777, -5979279962615204734, 566266011422492936, -4785904178332459121,
+          -8480409531167184590, -7791910581289550279, -4552508587450189246, -3581213790372170436,
+          -2949991550464699574, 3534391229144297379, 155844484058446992, 5104481465935211906,
+          -5004938563909277378, 52044020995297434, 8894878678032512445, -7419849079049058921,
+          5383665016921426733, 4676416459734690622, 9113463313933071898, 7499522993493630967,
+          8398382461290403390, 6430742419500950986, -1212257048288968701, -2955648635528217477,
+          2063778963745077292, 4843492307293163894, 7467131644774265338, 6252748200862543674,
+          2148921376873845915, 6049174751657609125, 1061529628172570991, 6593522543027145552,
+          -8410261335181965199, -2626135831076198115, 518063437967520702, 5828489922311065549,
+        ];
+        h = std.checksum.xxh3_64_new();
+        for(each k, v : xxh3_64_results) {
+          // split
+          for(var i = 0; i < k; ++i) {
+            h.update(s);
+          }
+          assert h.finish() == v;
+          // simple
+          assert std.checksum.xxh3_64(s * k) == v;
+        }
+        for(each j, n : [1, 3, 64, 100, 255, 256, 257, 1024, 7000]) {
+          for(var i = 0; i < 7000; i += n) {
+            h.update(std.string.slice(s * 1000, i, n));
+          }
+          assert h.finish() == 4237682365008331759;
+        }
+        assert std.checksum.xxh3_64(s * 1000) == 4237682365008331759;
+        h = std.checksum.xxh3_64_new();
+        h.update("hello");
+        q = h;
+        h.update("1");
+        assert h.finish() == -786165164824643293;
+        q.update("2");
+        assert q.finish() == 2062167118575320067;
+        h.update("hello" * 100);
+        q = h;
+        h.update("1");
+        assert h.finish() == 1199242562720974945;
+        q.update("2");
+        assert q.finish() == -1840568380976033610;
+
         // MD5
         const md5_results = [
           "D41D8CD98F00B204E9800998ECF8427E", "7AC66C0F148DE9519B8BD264312C4D64",
@@ -251,6 +357,25 @@ int main()
           // simple
           assert std.checksum.sha1(s * k) == v;
         }
+        q = [];
+        for(each k, v : sha1_results)
+          q[$] = s * k;
+        assert std.checksum.sha1_many(q) == sha1_results;
+        for(var n = 4;  n < 20;  ++n) {
+          var r = std.array.slice(q, 100 - n, n);
+          var t = std.array.slice(sha1_results, 100 - n, n);
+          assert std.checksum.sha1_many(r) == t;
+          assert std.checksum.sha1_many(std.array.reverse(r)) == std.array.reverse(t);
+        }
+        assert std.checksum.sha1_many([]) == [];
+        q = [];
+        for(var n = 0;  n < 150;  ++n)
+          q[$] = std.string.slice("0123456789ABCDEF" * 20, n % 7, n * 37 % 200);
+        var sha1_many_results = std.checksum.sha1_many(q);
+        for(each k, v : q)
+          assert sha1_many_results[k] == std.checksum.sha1(v);
+        try { std.checksum.sha1_many(["a",1]);  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
         h = std.checksum.sha1_new();
         h.update("hello");
         q = h;
@@ -400,6 +525,23 @@ int main()
           // simple
           assert std.checksum.sha256(s * k) == v;
         }
+        q = [];
+        for(each k, v : sha256_results)
+          q[$] = s * k;
+        assert std.checksum.sha256_many(q) == sha256_results;
+        for(var n = 4;  n < 20;  ++n) {
+          var r = std.array.slice(q, 100 - n, n);
+          var t = std.array.slice(sha256_results, 100 - n, n);
+          assert std.checksum.sha256_many(r) == t;
+          assert std.checksum.sha256_many(std.array.reverse(r)) == std.array.reverse(t);
+        }
+        assert std.checksum.sha256_many([]) == [];
+        q = [];
+        for(var n = 0;  n < 150;  ++n)
+          q[$] = std.string.slice("0123456789ABCDEF" * 20, n % 7, n * 37 % 200);
+        var sha256_many_results = std.checksum.sha256_many(q);
+        for(each k, v : q)
+          assert sha256_many_results[k] == std.checksum.sha256(v);
         h = std.checksum.sha256_new();
         h.update("hello");
         q = h;
@@ -408,9 +550,53 @@ int main()
         q.update("2");
         assert q.finish() == "87298CC2F31FBA73181EA2A9E6EF10DCE21ED95E98BDAC9C4E1504EA16F486E4";
 
+        // files
+        const chars = "0123456789abcdefghijklmnopqrstuvwxyz";
+        // We presume this random string will never match any real file.
+        var fname = ".checksum-test_file_" + std.string.implode(std.array.shuffle(std.string.explode(chars)));
+        const fdata = s * 300000;
+        std.filesystem.file_write(fname, fdata);
+        for(each k, a : ["crc32", "crc32c", "fnv1a32", "xxh3_64", "md5", "sha1", "sha256"]) {
+          const f = std.checksum[a + "_file"];
+          assert f(fname) == std.checksum[a](fdata);
+          assert f(fname, 1000) == std.checksum[a](std.string.slice(fdata, 1000));
+          assert f(fname, 1000, 1500000) == std.checksum[a](std.string.slice(fdata, 1000, 1500000));
+          assert f(fname, null, 5) == std.checksum[a](std.string.slice(fdata, 0, 5));
+          assert f(fname, 3000000) == std.checksum[a]("");
+          assert f(fname, 0, 0) == std.checksum[a]("");
+          assert f(fname + "_nonexistent") == null;
+          try { f(fname, -1);  assert false;  }
+            catch(e) { assert std.string.find(e, "negative file offset") != null;  }
+        }
+        std.filesystem.file_remove(fname);
+
+        // SHA-256 tree
+        const tdata = s * 800000;
+        assert std.checksum.sha256_tree("") == "E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855";
+        assert std.checksum.sha256_tree(s) == "6B43F785B72386E132B275BC918C25DBC687AB8427836BEF6CE4509B64F4F54D";
+        assert std.checksum.sha256_tree(std.string.slice(tdata, 0, 1048576)) ==
+               "083D4B03022593CC5F14034EBB969E10CEE45D4C187D9CC9B05777BECEC4A1B8";
+        assert std.checksum.sha256_tree(std.string.slice(tdata, 0, 1048577)) ==
+               "C597DE6F22C040B9961BBEF0E74D78244A33515BEBEF13A71B79279474BD8EF8";
+        assert std.checksum.sha256_tree(std.string.slice(tdata, 0, 3145728)) ==
+               "A33B1B4F969E6B7662A8EB7E92F2BC9C7BA1E288F54D39672432DACDDE82AFAC";
+        assert std.checksum.sha256_tree(tdata) == "B899AC45AB9EDAC0EB6FF0BD8351622339744A7156E099AFBA665EC680C61576";
+
+        std.filesystem.file_write(fname, tdata);
+        assert std.checksum.sha256_tree_file(fname) == "B899AC45AB9EDAC0EB6FF0BD8351622339744A7156E099AFBA665EC680C61576";
+        std.filesystem.file_write(fname, "");
+        assert std.checksum.sha256_tree_file(fname) == "E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855";
+        std.filesystem.file_remove(fname);
+        assert std.checksum.sha256_tree_file(fname) == null;
       )__"), tinybuf::open_read);
 
     Simple_Script code(cbuf, ::rocket::sref(__FILE__));
     Global_Context global;
-    code.execute(global);
+    // Run the script again with fewer CPU features, so each code path is tested against the
+    // same results: SSE4.2, PCLMUL and SHA-NI, then AVX2 lanes, then plain C++.
+    for(uint32_t mask : { UINT32_MAX, uint32_t(cpu_feature_avx2), uint32_t(0) }) {
+      cpu_set_feature_mask(mask);
+      code.execute(global);
+    }
+    cpu_set_feature_mask(UINT32_MAX);
   }
@@ -42,6 +42,36 @@ int main()
         assert std.json.format({a:1,bc:2}, 2) == "{\n  \"a\": 1,\n  \"bc\": 2\n}" ||
                std.json.format({a:1,bc:2}, 2) == "{\n  \"bc\": 2,\n  \"a\": 1\n}";
 
+        assert std.json.format(0.3) == "0.3";
+        assert std.json.format(0.1 + 0.2) == "0.30000000000000004";
+        assert std.json.format(-0.0) == "-0";
+        assert std.json.format(0x1.0p-1074) == "5e-324";
+        assert std.json.format(0x1.0p100) == "1.2676506002282294e+30";
+        assert std.json.format(-1.5e-7) == "-1.5e-07";
+        assert std.json.format(0.0001) == "0.0001";
+        assert std.json.format(1e16) == "10000000000000000";
+        assert std.json.format(123456789.125) == "123456789.125";
+
+        assert std.json.parse("9007199254740993") == 0x1.0p53;
+        assert std.json.parse("2.2250738585072011e-308") == 0x0.fffffffffffffp-1022;
+        for(each k, r : [ 1.4186433412250291e+224, 9.0225115701117536e-311, 0x1.0p-1074, 0x0.fffffffffffffp-1022,
+                          0x1.0p-1022, 0x1.fffffffffffffp1023, 0x1.fffffffffffffp52, 0x1.0000000000001p53,
+                          0x1.0p53 - 3, 0x1.0p63, 1.0e23, 8.98846567431158e307, 5.0e-324 * 3, 0.1, 2 / 3.0 ])
+          assert std.json.parse(std.json.format(r)) == r;
+        for(var e = -1080;  e <= 1024;  ++e) {
+          var r = std.numeric.ldexp(std.numeric.random(), e);
+          assert std.json.parse(std.json.format(r)) == r;
+        }
+
+        assert std.json.format("abcdefghijklmnop\x7F\"qrstuvwxyz\\") == "\"abcdefghijklmnop\\u007F\\\"qrstuvwxyz\\\\\"";
+
+        const fname = ".json-test_file_" + std.string.implode(std.array.shuffle(std.string.explode("0123456789abcdefghijklmnopqrstuvwxyz")));
+        std.json.format_to_file(fname, {a:[1,0.5,"x"]});
+        assert std.filesystem.file_read(fname) == "{\"a\":[1,0.5,\"x\"]}";
+        std.json.format5_to_file(fname, [["x" * 5000]], 2);
+        assert std.filesystem.file_read(fname) == std.json.format5([["x" * 5000]], 2);
+        std.filesystem.file_remove(fname);
+
         assert std.json.format5(null) == "null";
         assert std.json.format5(true) == "true";
         assert std.json.format5(false) == "false";
@@ -98,6 +128,22 @@ int main()
         assert std.json.parse("{c:1,d:2,}").c == 1;
         assert std.json.parse("{c:1,d:2,}").d == 2;
 
+        assert std.json.parse("[ -0.5e2, +1`000, 0x1p4, 0b101, - Infinity ]") == [-50,1000,16,5,-infinity];
+        assert std.json.parse("9007199254740992") == 9007199254740992;
+        assert std.json.parse("0.1") == 0.1;
+        assert std.json.parse("123.456e-7") == 123.456e-7;
+        assert std.json.parse("1.7976931348623157e308") == 1.7976931348623157e308;
+        assert std.json.parse("{ /* a */ k: // b\n 'v\\x41' }").k == "vA";
+        assert std.json.parse("\"" + "abcdefg" * 10 + "\\u00e9\"") == "abcdefg" * 10 + "é";
+        try { std.json.parse("[1,\n 2 @]");  assert false;  }
+          catch(e) { assert std.string.find(e, "line 2, offset 3") != null;  }
+        try { std.json.parse("{\n  a: 'b\n'}");  assert false;  }
+          catch(e) { assert std.string.find(e, "line 2, offset 5") != null;  }
+        try { std.json.parse("[1, /* 2");  assert false;  }
+          catch(e) { assert std.string.find(e, "line 1, offset 4") != null;  }
+        try { std.json.parse("[1] ]");  assert false;  }
+          catch(e) { assert std.string.find(e, "excess text") != null;  }
+
         var r = std.json.parse("[{a:1,b:[]},{c:{},d:4}]");
         assert r[0].a == 1;
         assert r[0].b == [];
@@ -111,9 +157,145 @@ int main()
           r = [r];
         }
         assert std.json.format(r) == '[' * depth + ']' * depth;
+
+        var p = std.json.parser_new();
+        assert p.next() == null;
+        const text = "{\"a\":[1,2,\"x]\"]}\n[3]'q' 12 true /* c } */ null\n- Infinity{b:2}// end\n\"s\\\"t\" 7";
+        for(var n = 1; n < 8; ++n) {
+          r = [];
+          for(var i = 0; i < lengthof text; i += n) {
+            p.feed(std.string.slice(text, i, n));
+            for(var v = p.next(); v != null; v = p.next())
+              r[$] = v[0];
+          }
+          assert lengthof r == 9;
+          p.finish();
+          for(var v = p.next(); v != null; v = p.next())
+            r[$] = v[0];
+          assert r[6] == -infinity;
+          r[6] = null;
+          assert std.json.format5(r) == "[{a:[1,2,\"x]\"]},[3],\"q\",12,true,null,null,{b:2},\"s\\\"t\",7]";
+        }
+        p.feed("[1, @]\n{x:1}");
+        try { p.next();  assert false;  }
+          catch(e) { assert std.string.find(e, "line 1, offset 4") != null;  }
+        assert p.next()[0].x == 1;
+        assert p.next() == null;
+        p.feed(" [2,\n /* 3");
+        assert p.next() == null;
+        p.finish();
+        try { p.next();  assert false;  }
+          catch(e) { assert std.string.find(e, "line 3, offset 1") != null;  }
+        assert p.next() == null;
+
+        r = [];
+        std.json.parse_events("{a:[1,{x:2}],b:{c:[3]},d:'e'}", func(e, v) { r[$] = [e, v];  return e != "key" || v != "b";  });
+        assert r == [["start_object",null],["key","a"],["start_array",null],["scalar",1],["start_object",null],["key","x"],["scalar",2],
+                     ["end_object",null],["end_array",null],["key","b"],["key","d"],["scalar","e"],["end_object",null]];
+        r = [];
+        std.json.parse_events("[[1,2],[3]]", func(e, v) { r[$] = e;  return lengthof r != 2;  });
+        assert r == ["start_array","start_array","start_array","scalar","end_array","end_array"];
+        try { std.json.parse_events("[[1,2],[3}]", func(e, v) { });  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+        try { std.json.parse_events("[1,[1x]]", func(e, v) = false);  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+        try { std.json.parse_events("{a:'\\q'}", func(e, v) = e != "key");  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+        try { std.json.parse_events("[{1:2}]", func(e, v) = false);  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+        r = [];
+        std.json.parse_events("{a:[1e999,'\\u0041',{'b':-Infinity}],c:2}", func(e, v) { r[$] = e;  return e != "key" || v != "a";  });
+        assert r == ["start_object","key","key","scalar","end_object"];
+
+        p.feed("[4] {y:5}");
+        r = [];
+        assert p.next_events(func(e, v) { r[$] = e;  }) == true;
+        assert r == ["start_array","scalar","end_array"];
+        assert p.next_events(func(e, v) { return false;  }) == true;
+        assert p.next_events(func(e, v) { assert false;  }) == false;
+
+        var d = std.json.parse_lazy("{ \"a\" : [1, 'x\\ty', {b: true, 'c\\u0041': null}], d: { }, \"a\": [9, 8], e: - Infinity, f: 1x }");
+        assert d.get("a") == [9,8];
+        assert d.get("a", -1) == 8;
+        assert d.get("a", 2) == null;
+        assert d.get("zz", 1) == null;
+        assert d.get("e") == -infinity;
+        assert d.type() == "object";
+        assert d.type("a") == "array";
+        assert d.type("e") == "real";
+        assert d.type("d", 0) == null;
+        assert d.count() == 5;
+        assert d.count("d") == 0;
+        assert d.count("e") == null;
+        assert d.keys() == ["a","d","a","e","f"];
+        assert d.keys("a") == null;
+        try { d.get("f");  assert false;  }
+          catch(e) { assert std.string.find(e, "line 1, offset 88") != null;  }
+        try { d.get(1.5);  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+
+        d = std.json.parse_lazy("[1,\n {'k\\x41': 'v', b: 'c\\q'}, [[], {}], \"s\"]");
+        assert d.get(1, "kA") == "v";
+        assert d.keys(1) == ["kA","b"];
+        assert d.count(2) == 2;
+        assert std.json.format(d.get(2)) == "[[],{}]";
+        assert d.get(3) == "s";
+        try { d.get(1, "b");  assert false;  }
+          catch(e) { assert std.string.find(e, "line 2, offset 19") != null;  }
+        assert std.json.parse_lazy(" 42 ").get() == 42;
+
+        var segs = [];
+        for(var i = 0;  i < 10000;  ++i)
+          segs[$] = std.string.format("{ \"x$1\": [$1], 'k\\u00$2': $1 }", i, i % 10 + 30);
+        d = std.json.parse_lazy("[" + std.string.implode(segs, ",") + "]");
+        assert d.count() == 10000;
+        for(var i = 0;  i < 10000;  ++i) {
+          assert d.get(i, "x" + std.numeric.format(i), 0) == i;
+          assert d.get(-10000 + i, "k" + std.numeric.format(i % 10)) == i;
+        }
+        segs = [];
+        for(var i = 0;  i < 10000;  ++i)
+          segs[$] = std.string.format("\"k$1\": $1", i);
+        d = std.json.parse_lazy("{" + std.string.implode(segs, ",") + ", k777: -1 }");
+        assert d.count() == 10001;
+        for(var i = 0;  i < 10000;  ++i)
+          assert d.get("k" + std.numeric.format(i)) == ((i == 777) ? -1 : i);
+        assert d.get("k10000") == null;
+        try { std.json.parse_lazy("[1,\n 2 @]");  assert false;  }
+          catch(e) { assert std.string.find(e, "line 2, offset 3") != null;  }
+        try { std.json.parse_lazy("[1] ]");  assert false;  }
+          catch(e) { assert std.string.find(e, "excess text") != null;  }
+
+        // Long strings and runs of spaces are scanned in blocks. Put a byte that stops a block
+        // at every position.
+        var pad = "abcdefghij" * 14;
+        var spaces = " \t\r\v\f " * 24;
+        for(var i = 0;  i < 140;  ++i) {
+          var l = std.string.slice(pad, 0, i);
+          var r = std.string.slice(pad, i);
+          for(each k, p : [["\"","\\\""], ["\\","\\\\"], ["\n","\\n"], ["\x7F","\\u007F"], ["\x01","\\u0001"], ["é","\\u00E9"]]) {
+            assert std.json.format(l + p[0] + r) == "\"" + l + p[1] + r + "\"";
+            assert std.json.parse("\"" + l + p[1] + r + "\"") == l + p[0] + r;
+            assert std.json.parse_lazy("[\"" + l + p[1] + r + "\", 1]").get(1) == 1;
+          }
+          assert std.json.parse("'" + l + "\"é" + r + "'") == l + "\"é" + r;
+          try { std.json.parse("\"" + l + "\n" + r + "\"");  assert false;  }
+            catch(e) { assert std.string.find(e, "line 1, offset 0") != null;  }
+
+          var s = std.string.slice(spaces, 0, i);
+          assert std.json.parse(s + "[" + s + "1" + s + "," + s + "2" + s + "]" + s) == [1,2];
+          try { std.json.parse(s + "\n" + s + "@");  assert false;  }
+            catch(e) { assert std.string.find(e, std.string.format("line 2, offset $1", i)) != null;  }
+        }
       )__"), tinybuf::open_read);
 
     Simple_Script code(cbuf, ::rocket::sref(__FILE__));
     Global_Context global;
-    code.execute(global);
+    // Run the script again with fewer CPU features, so each code path is tested against the
+    // same results: AVX2, then SSE2 or plain C++.
+    for(uint32_t mask : { UINT32_MAX, uint32_t(0) }) {
+      cpu_set_feature_mask(mask);
+      code.execute(global);
+    }
+    cpu_set_feature_mask(UINT32_MAX);
   }
@@ -0,0 +1,94 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2020, LH_Mouse. All wrongs reserved.
+
+#include "utilities.hpp"
+#include "../src/simple_script.hpp"
+#include "../src/runtime/global_context.hpp"
+
+using namespace Asteria;
+
+int main()
+  {
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(::rocket::sref(
+      R"__(
+        assert std.msgpack.format(null) == "\xC0";
+        assert std.msgpack.format(false) == "\xC2";
+        assert std.msgpack.format(true) == "\xC3";
+        assert std.msgpack.format(1) == "\x01";
+        assert std.msgpack.format(-1) == "\xFF";
+        assert std.msgpack.format(200) == "\xCC\xC8";
+        assert std.msgpack.format(-200) == "\xD1\xFF\x38";
+        assert std.msgpack.format(0x12345678) == "\xCE\x12\x34\x56\x78";
+        assert std.msgpack.format(1.0) == "\xCB\x3F\xF0\x00\x00\x00\x00\x00\x00";
+        assert std.msgpack.format("ab") == "\xA2ab";
+        assert std.msgpack.format("\xFF") == "\xC4\x01\xFF";
+        assert std.msgpack.format([1,[]]) == "\x92\x01\x90";
+        assert std.msgpack.format({a:true}) == "\x81\xA1a\xC3";
+        assert std.msgpack.format(std.msgpack.format) == "\xC0";
+
+        assert typeof std.msgpack.parse(std.msgpack.format(1)) == "integer";
+        assert typeof std.msgpack.parse(std.msgpack.format(1.0)) == "real";
+        assert std.msgpack.parse("\xCA\x3F\xC0\x00\x00") == 1.5;
+        assert std.msgpack.parse("\xD9\x01x") == "x";
+        assert std.msgpack.parse("\xDC\x00\x02\xC0\xC3") == [null,true];
+        assert std.msgpack.parse("\x82\xA1k\x01\xA1k\x02").k == 2;
+
+        var v = [0, -1, 127, 128, -32, -33, 65535, 65536, std.numeric.integer_max, std.numeric.integer_min,
+                 1.5, -0.25, "x" * 40, "y" * 300, "\x80\x81" * 40000, [[[[]]]], {}];
+        var r = std.msgpack.parse(std.msgpack.format(v));
+        assert lengthof r == lengthof v;
+        for(var i = 0; i < lengthof v; ++i)
+          if(typeof v[i] != "object")
+            assert typeof r[i] == typeof v[i] && r[i] == v[i];
+        v = {a:[1,{b:null}],c:"d",e:{}};
+        assert std.json.format(std.msgpack.parse(std.msgpack.format(v))) == std.json.format(v);
+
+        try { std.msgpack.parse("");  assert false;  }
+          catch(e) { assert std.string.find(e, "end of data") != null;  }
+        try { std.msgpack.parse("\x92\x01");  assert false;  }
+          catch(e) { assert std.string.find(e, "end of data") != null;  }
+        try { std.msgpack.parse("\x01\x02");  assert false;  }
+          catch(e) { assert std.string.find(e, "excess data") != null;  }
+        try { std.msgpack.parse("\xC1");  assert false;  }
+          catch(e) { assert std.string.find(e, "invalid type byte") != null;  }
+        try { std.msgpack.parse("\xCF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF");  assert false;  }
+          catch(e) { assert std.string.find(e, "out of range") != null;  }
+        try { std.msgpack.parse("\x81\x01\x02");  assert false;  }
+          catch(e) { assert std.string.find(e, "not a string") != null;  }
+        try { std.msgpack.parse("\xD4\x01\x00");  assert false;  }
+          catch(e) { assert std.string.find(e, "extension") != null;  }
+        try { std.msgpack.parse("\xDD\xFF\xFF\xFF\xFF");  assert false;  }
+          catch(e) { assert std.string.find(e, "end of data") != null;  }
+
+        assert std.msgpack.parse_prefix("\x92\x01") == null;
+        assert std.msgpack.parse_prefix("\x92\x01\x02\x03") == [[1,2],3];
+
+        const data = std.msgpack.format([1,"abc"]) + std.msgpack.format(2.5) + std.msgpack.format({x:"y" * 100});
+        var buf = "";
+        r = [];
+        for(var i = 0; i < lengthof data; ++i) {
+          buf += std.string.slice(data, i, 1);
+          var p = std.msgpack.parse_prefix(buf);
+          if(p != null) {
+            r[$] = p[0];
+            buf = std.string.slice(buf, p[1]);
+          }
+        }
+        assert buf == "";
+        assert std.json.format(r) == std.json.format([[1,"abc"],2.5,{x:"y" * 100}]);
+
+        const depth = 10000;
+        r = [];
+        for(var i = 1; i < depth; ++i) {
+          r = [r];
+        }
+        var s = std.msgpack.format(r);
+        assert s == "\x91" * (depth - 1) + "\x90";
+        assert std.msgpack.format(std.msgpack.parse(s)) == s;
+      )__"), tinybuf::open_read);
+
+    Simple_Script code(cbuf, ::rocket::sref(__FILE__));
+    Global_Context global;
+    code.execute(global);
+  }
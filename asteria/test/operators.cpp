@@ -413,6 +413,23 @@ int main()
         assert ("987654321" ^ "abcdefg") == "XZTRPRT21";
         assert ("987654" ^ "abcdefghi") == "XZTRPRghi";
 
+        s = "a";
+        var t = s;
+        s += "bc";
+        assert s == "abc";
+        assert t == "a";
+        s += s;
+        assert s == "abcabc";
+        a = [ "x" ];
+        a[0] += "yz";
+        assert a[0] == "xyz";
+        for(var k = 0;  k < 1000;  ++k) {
+          t += "0123456789";
+        }
+        assert std.string.find(t, "0123456789") == 1;
+        assert std.string.rfind(t, "0123456789") == 9991;
+        assert lengthof t == 10001;
+
       )__"), tinybuf::open_read);
     Simple_Script code(cbuf, ::rocket::sref(__FILE__));
     Global_Context global;
@@ -47,6 +47,17 @@ int main()
         assert std.string.slice("hello", std.numeric.integer_min) == "hello";
         assert std.string.slice("hello", std.numeric.integer_min, std.numeric.integer_max) == "hell";
 
+        var p = "abcdefgh" * 100;
+        var q = std.string.slice(p, 16);
+        assert lengthof q == 784;
+        q += "!";
+        assert lengthof p == 800;
+        assert std.string.slice(p, -2) == "gh";
+        assert std.string.slice(q, -3) == "gh!";
+        p = std.string.slice(p, 1, 4) + std.string.slice(p, -5);
+        assert p == "bcdedefgh";
+        assert q == ("abcdefgh" * 98) + "!";
+
         assert std.string.replace_slice("hello", 2, "##") == "he##";
         assert std.string.replace_slice("hello", 2, 1, "##") == "he##lo";
         assert std.string.replace_slice("hello", 9, "##") == "hello##";
@@ -147,6 +158,44 @@ int main()
         assert std.string.rfind_not_of("hello", 4, 2, "aeiou") == null;
         assert std.string.rfind_not_of("hello", "") == 4;
 
+        var long = "x" * 37 + "ab" + "y" * 29 + "ba" + "x" * 41;
+        assert std.string.find_any_of(long, "a") == 37;
+        assert std.string.find_any_of(long, "ba") == 37;
+        assert std.string.find_any_of(long, "zyb") == 38;
+        assert std.string.find_any_of(long, 39, "ab") == 68;
+        assert std.string.find_any_of(long, "q") == null;
+        assert std.string.find_any_of(long, "qr") == null;
+        assert std.string.rfind_any_of(long, "a") == 69;
+        assert std.string.rfind_any_of(long, "ab") == 69;
+        assert std.string.rfind_any_of(long, 0, 68, "ab") == 38;
+        assert std.string.rfind_any_of(long, "qr") == null;
+        assert std.string.find_not_of(long, "x") == 37;
+        assert std.string.find_not_of(long, "xa") == 38;
+        assert std.string.find_not_of(long, 39, "y") == 68;
+        assert std.string.find_not_of("x" * 100, "xy") == null;
+        assert std.string.rfind_not_of(long, "x") == 69;
+        assert std.string.rfind_not_of(long, 0, 68, "xy") == 38;
+        assert std.string.rfind_not_of("x" * 100, "x") == null;
+
+        // Sets of more than two bytes, or with non-ASCII bytes, are tested in blocks.
+        var filler = "xy\xC0z" * 20;
+        for(var n = 0;  n < 72;  ++n) {
+          var s = std.string.slice(filler, 0, n);
+          assert std.string.find_any_of(s, ":q\x80") == null;
+          assert std.string.rfind_any_of(s, ":q\x80") == null;
+          assert std.string.find_not_of(s, "xyz\xC0") == null;
+          assert std.string.rfind_not_of(s, "xyz\xC0") == null;
+          for(each k, c : [":", "\x80", "\xFF"])
+            for(var i = 0;  i < n;  ++i) {
+              s = std.string.slice(filler, 0, i) + c + std.string.slice(filler, i + 1, n - i - 1);
+              assert std.string.find_any_of(s, ":q\x80\xFF") == i;
+              assert std.string.rfind_any_of(s, ":q\x80\xFF") == i;
+              assert std.string.find_not_of(s, "xyz\xC0") == i;
+              assert std.string.rfind_not_of(s, "xyz\xC0") == i;
+              assert std.string.trim(s, "xyz\xC0") == c;
+            }
+        }
+
         assert std.string.reverse("") == "";
         assert std.string.reverse("h") == "h";
         assert std.string.reverse("he") == "eh";
@@ -169,6 +218,11 @@ int main()
         assert std.string.trimr("\t hello   ") == "\t hello";
         assert std.string.trimr("hello", "hlo") == "he";
 
+        assert std.string.trim(" \t" * 20 + "hello world" + "\t " * 20) == "hello world";
+        assert std.string.triml(" " * 40 + "hello " * 2) == "hello hello ";
+        assert std.string.trimr("hello" + " " * 40) == "hello";
+        assert std.string.trim(" " * 40) == "";
+
         assert std.string.padl("hello", -9, "#") == "hello";
         assert std.string.padl("hello", 10, "#") == "#####hello";
         assert std.string.padl("hello", 10, "#!") == "#!#!hello";
@@ -184,6 +238,8 @@ int main()
         assert std.string.to_lower("") == "";
         assert std.string.to_lower("hElLo") == "hello";
         assert std.string.to_lower("hello") == "hello";
+        assert std.string.to_upper("@az[`AZ{ hello, WORLD! \xC1\xE1 0123456789") == "@AZ[`AZ{ HELLO, WORLD! \xC1\xE1 0123456789";
+        assert std.string.to_lower("@az[`AZ{ hello, WORLD! \xC1\xE1 0123456789") == "@az[`az{ hello, world! \xC1\xE1 0123456789";
 
         assert std.string.explode("", "``") == [ ];
         assert std.string.explode("aa", "``") == [ "aa" ];
@@ -193,11 +249,22 @@ int main()
         assert std.string.explode("aa", "``", 2) == [ "aa" ];
         assert std.string.explode("aa``bb", "``", 2) == [ "aa", "bb" ];
         assert std.string.explode("aa``bb``cc", "``", 2) == [ "aa", "bb``cc" ];
+        assert std.string.explode("a,b,,c,", ",") == [ "a", "b", "", "c", "" ];
+        assert std.string.explode("a,b,,c,", ",", 3) == [ "a", "b", ",c," ];
+        assert std.string.explode("a``b`c", "``") == [ "a", "b`c" ];
+        assert std.string.explode("a,b,c", ",", 1) == [ "a,b,c" ];
+        assert std.string.explode("abc") == [ "a", "b", "c" ];
+        assert std.string.explode("abc", "", 2) == [ "a", "bc" ];
+        assert std.string.explode("abc", null, 3) == [ "a", "b", "c" ];
+        assert std.string.explode("abc", null, 1) == [ "abc" ];
 
         assert std.string.implode([ ], "``") == "";
         assert std.string.implode([ "aa" ], "``") == "aa";
         assert std.string.implode([ "aa", "bb" ], "``") == "aa``bb";
         assert std.string.implode([ "aa", "bb", "cc" ], "``") == "aa``bb``cc";
+        assert std.string.implode([ "aa", "bb", "cc" ]) == "aabbcc";
+        try { std.string.implode([ "aa", 42 ]);  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
 
         assert std.string.hex_encode("hello") == "68656C6C6F";
         assert std.string.hex_encode("hello", true) == "68656c6c6f";
@@ -282,8 +349,108 @@ int main()
         try { std.string.url_decode_query("无效的");  assert false;  }
           catch(e) { assert std.string.find(e, "assertion failure") == null;  }
 
+        var bytes = std.string.pack_8(std.array.generate(func(i, p) = i, 256));
+        for(var k = 250;  k <= 256;  ++k) {
+          var t = std.string.slice(bytes, 0, k);
+          assert std.string.hex_decode(std.string.hex_encode(t)) == t;
+          assert std.string.hex_decode(std.string.hex_encode(t, true, " ")) == t;
+          assert std.string.base32_decode(std.string.base32_encode(t)) == t;
+          assert std.string.base32_decode(std.string.base32_encode(t, true)) == t;
+          assert std.string.base64_decode(std.string.base64_encode(t)) == t;
+          assert std.string.url_decode(std.string.url_encode(t)) == t;
+          assert std.string.url_decode_query(std.string.url_encode_query(t)) == t;
+        }
+
+        // These are long enough for SIMD kernels, and are checked against known digests.
+        var long = bytes * 3;
+        var words = "The quick brown fox jumps over the lazy dog; 0123456789 ~-_. /?#[]@!$&'()*+,=% " * 4;
+        var r = ["", "", "", "", ""];
+        for(var k = 0;  k < 100;  ++k) {
+          var t = std.string.slice(long, k * 5, k);
+          var u = std.string.slice(words, k, k * 2);
+          r[0] += std.string.hex_encode(t);
+          r[1] += std.string.hex_encode(t, true);
+          r[2] += std.string.base64_encode(t) + std.string.base64_encode(u);
+          r[3] += std.string.url_encode(t) + std.string.url_encode(u);
+          r[4] += std.string.url_encode_query(t) + std.string.url_encode_query(u, true);
+          assert std.string.hex_decode(std.string.hex_encode(t, k % 2 == 0)) == t;
+          assert std.string.base64_decode(std.string.base64_encode(t)) == t;
+          assert std.string.url_decode(std.string.url_encode(u)) == u;
+          assert std.string.url_decode_query(std.string.url_encode_query(u)) == u;
+        }
+        assert std.checksum.sha256(r[0]) == "830F6760B8AB10EBA2A014CE829F922D0ECA73FB42B4E3672BE666569DCDC027";
+        assert std.checksum.sha256(r[1]) == "E349AC8F564E2C25F4955D0B23157D507DE7AF0C959FB686C0E20CD752A6E831";
+        assert std.checksum.sha256(r[2]) == "C5D151B3EB9EE71547314DF10C9AF1FDD650F231EC8B6E26B0A46B1241D81774";
+        assert std.checksum.sha256(r[3]) == "22DBBD13299F1DBA0BC03C3A4B27510B753EAE9506F145881C882132EE875B9C";
+        assert std.checksum.sha256(r[4]) == "47BBC1082E73AC2688DF36E765538B3839223273614E3C2AD0806FB7CD9F8CE2";
+        var h64 = std.string.hex_encode(std.string.slice(long, 0, 64));
+        var b64 = std.string.base64_encode(std.string.slice(long, 0, 96));
+        var e = std.string.url_encode(words);
+        for(var k = 0;  k < 128;  ++k) {
+          // whitespace at every position
+          var t = std.string.slice(h64, 0, k) + " " + std.string.slice(h64, k);
+          if(k % 2 == 0)
+            assert std.string.hex_decode(t) == std.string.slice(long, 0, 64);
+          else
+            try { std.string.hex_decode(t);  assert false;  }
+              catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+          t = std.string.slice(b64, 0, k) + "\n" + std.string.slice(b64, k);
+          if(k % 4 == 0)
+            assert std.string.base64_decode(t) == std.string.slice(long, 0, 96);
+          else
+            try { std.string.base64_decode(t);  assert false;  }
+              catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+          // invalid character at every position
+          try { std.string.hex_decode(std.string.replace_slice(h64, k, 1, "g"));  assert false;  }
+            catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+          try { std.string.base64_decode(std.string.replace_slice(b64, k, 1, "-"));  assert false;  }
+            catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+          try { std.string.url_decode(std.string.replace_slice(e, k, 1, "\""));  assert false;  }
+            catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+        }
+
+        var he = std.string.hex_encoder_new(true, ":");
+        assert he.update("he") == "68:65";
+        assert he.update("") == "";
+        assert he.update("llo") == ":6c:6c:6f";
+        assert he.finish() == "";
+        assert he.update("!") == "21";
+        var hd = std.string.hex_decoder_new();
+        assert hd.update("686") == "h";
+        assert hd.update("56c 6") == "el";
+        try { hd.update("c6x");  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+        assert hd.update("c6f") == "lo";
+        assert hd.finish() == "";
+        assert hd.update("6") == "";
+        try { hd.finish();  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+        assert hd.update("21") == "!";
+
+        var be = std.string.base64_encoder_new();
+        var bd = std.string.base64_decoder_new();
+        for(var n = 1;  n <= 7;  ++n) {
+          var text = "";
+          var data = "";
+          for(var k = 0;  k < 256;  k += n)
+            text += be.update(std.string.slice(bytes, k, n));
+          text += be.finish();
+          assert text == std.string.base64_encode(bytes);
+          for(var k = 0;  k < lengthof text;  k += n)
+            data += bd.update(std.string.slice(text, k, n));
+          data += bd.finish();
+          assert data == bytes;
+        }
+        assert bd.update("aGVsbG") == "hel";
+        try { bd.finish();  assert false;  }
+          catch(e) { assert std.string.find(e, "assertion failure") == null;  }
+        assert bd.update("aGVs") == "hel";
+
         assert std.string.translate("hello", "el") == "ho";
         assert std.string.translate("hello", "el", "a") == "hao";
+        assert std.string.translate("hello", "lel", "LEx") == "hELLo";
+        assert std.string.translate("a-b-c-" * 100, "-") == "abc" * 100;
+        assert std.string.translate("a-b-c-" * 100, "-b", "+") == "a++c+" * 100;
 
         assert std.string.utf8_validate("abcdАВГД甲乙丙丁") == true;
         assert std.string.utf8_validate("\xC0\x80\x61") == false;
@@ -305,6 +472,12 @@ int main()
         try { std.string.utf8_decode("\xFF\xFE\x62");  assert false;  }
           catch(e) { assert std.string.find(e, "assertion failure") == null;  }
         assert std.string.utf8_decode("\xFF\xFE\x62", true) == [ 255, 254, 98 ];
+        var u = "abcdefghijklmnopqrstuvwxyz" * 4 + "甲" + "0123456789" * 3;
+        assert std.string.utf8_validate(u) == true;
+        assert std.string.utf8_validate(u + "\xE7\x94") == false;
+        assert lengthof std.string.utf8_decode(u) == 135;
+        assert std.string.utf8_encode(std.string.utf8_decode(u)) == u;
+        assert std.string.utf8_decode(u + "\x80", true)[135] == 128;
 
         assert std.string.pack_8(0x1234) == "\x34";
         assert std.string.pack_8([ 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF ]) == "\x01\x23\x45\x67\x89\xAB\xCD\xEF";
@@ -334,12 +507,52 @@ int main()
         assert std.string.pack_64le([ 0x0123456789ABCDEF, 0x7EDCBA9876543210 ]) == "\xEF\xCD\xAB\x89\x67\x45\x23\x01\x10\x32\x54\x76\x98\xBA\xDC\x7E";
         assert std.string.unpack_64le("\xEF\xCD\xAB\x89\x67\x45\x23\x01\x10\x32\x54\x76\x98\xBA\xDC\x7E") == [ 0x0123456789ABCDEF, 0x7EDCBA9876543210 ];
 
+        assert std.string.pack(">BHI", 1, 0x0203, 0x04050607) == "\x01\x02\x03\x04\x05\x06\x07";
+        assert std.string.pack("<h 2B", -2, 3, 0x104) == "\xFE\xFF\x03\x04";
+        assert std.string.pack("4s x 2s", "ab", "xyz") == "ab\x00\x00\x00xy";
+        assert std.string.pack(">f <d", 1.5, 2) == "\x3F\xC0\x00\x00\x00\x00\x00\x00\x00\x00\x00\x40";
+        assert std.string.pack("") == "";
+        assert std.string.unpack(">bB", "\xFF\xFF") == [ -1, 255 ];
+        assert std.string.unpack(">hH<hH", "\x80\x00\x80\x00\x00\x80\x00\x80") == [ -32768, 32768, -32768, 32768 ];
+        assert std.string.unpack("<iIqQ", "\xFF" * 24) == [ -1, 0xFFFFFFFF, -1, -1 ];
+        assert std.string.unpack("<d >f", std.string.pack("<d >f", 0.1, 0.5)) == [ 0.1, 0.5 ];
+        assert std.string.unpack("2s x B", "abcdef", 1) == [ "bc", 0x65 ];
+        assert std.string.unpack("3B", "abc", 3 - 3) == [ 0x61, 0x62, 0x63 ];
+        try { std.string.unpack("I", "abc");  assert false;  }
+          catch(e)  { assert std.string.find(e, "too short") != null;  }
+        try { std.string.unpack("B", "abc", 4);  assert false;  }
+          catch(e)  { assert std.string.find(e, "out of range") != null;  }
+        try { std.string.pack("2B", 1);  assert false;  }
+          catch(e)  { assert std.string.find(e, "number of values") != null;  }
+        try { std.string.pack("12");  assert false;  }
+          catch(e)  { assert std.string.find(e, "repeat count") != null;  }
+        try { std.string.pack("z", 1);  assert false;  }
+          catch(e)  { assert std.string.find(e, "invalid type") != null;  }
+
+        var pf = std.string.pack_compile("<I 2s");
+        assert pf.pack(1, "hi") == "\x01\x00\x00\x00hi";
+        assert pf.unpack("..\x02\x00\x00\x00ok", 2) == [ 2, "ok" ];
+
         assert std.string.format("1$$2") == "1$2";
         assert std.string.format("hello $1 $2", "world", '!') == "hello world !";
         assert std.string.format("${1} + $1 = ${2}", 5, 10) == "5 + 5 = 10";
         assert std.string.format("funny $0 string") == "funny funny $0 string string";
         assert std.string.format("$2345", 'x', 'y') == "y345";
 
+        var ft = std.string.format_compile("${1} + $1 = ${2}, $$ $0");
+        assert std.string.format(ft, 5, 10) == "5 + 5 = 10, $ ${1} + $1 = ${2}, $$ $0";
+        assert std.string.format(ft, "a", "b", "c") == "a + a = b, $ ${1} + $1 = ${2}, $$ $0";
+        assert std.string.format(std.string.format_compile("")) == "";
+        assert std.string.format(std.string.format_compile("$2345"), 'x', 'y') == "y345";
+        try { std.string.format(ft, 5);  assert false;  }
+          catch(e)  { assert std.string.find(e, "no enough arguments") != null;  }
+        try { std.string.format_compile("$x");  assert false;  }
+          catch(e)  { assert std.string.find(e, "invalid placeholder") != null;  }
+        try { std.string.format_compile("${12");  assert false;  }
+          catch(e)  { assert std.string.find(e, "no matching") != null;  }
+        try { std.string.format_compile("abc$");  assert false;  }
+          catch(e)  { assert std.string.find(e, "dangling") != null;  }
+
         assert std.string.regex_find("a11b2c333d4e555", '\d+\w') == [1,3];
         assert std.string.regex_find("a11b2c333d4e555", '\d{3}\w') == [6,4];
         assert std.string.regex_find("a11b2c333d4e555", '\d{34}\w') == null;
@@ -354,9 +567,87 @@ int main()
         assert std.string.regex_replace("a11b2c333d4e555", '\d{34}\w', '#') == "a11b2c333d4e555";
         assert std.string.regex_replace("a11b2c333d4e555", '(\w\d+)*', '$&$&') == "a11b2c333d4e555a11b2c333d4e555";
 
+        var re = std.string.regex_compile('(\w+)@(\w+)\.com');
+        assert re.find("mail someone@example.com now") == [5,19];
+        assert re.find("mail someone@example.com now", 6) == [6,18];
+        assert re.find("mail someone@example.com now", 6, 10) == null;
+        assert re.match("someone@example.com") == [ "someone@example.com", "someone", "example" ];
+        assert re.match("mail someone@example.com", 5) == [ "someone@example.com", "someone", "example" ];
+        assert re.match("someone@example.org") == null;
+        assert re.replace("a@b.com, c@d.com", '$2@$1.com') == "b@a.com, d@c.com";
+        try { std.string.regex_compile('(a');  assert false;  }
+          catch(e) { assert std.string.find(e, "invalid regular expression") != null;  }
+
+        assert std.string.regex_find("a" * 40, '(a|aa)*c') == null;
+        assert std.string.regex_match("a" * 40, '(a|aa)*') == [ "a" * 40, "a" ];
+        assert std.string.regex_match("abcd", '(?:(a)|b)+(c)?(x)?d') == [ "abcd", "a", "c", null ];
+        assert std.string.regex_find("hello world", '\bw\w+$') == [6,5];
+        assert std.string.regex_find("hello world", '^w') == null;
+        assert std.string.regex_find("line1\nline2", '\d.*') == [4,1];
+        assert std.string.regex_find("aaaa", 'a{2,3}?') == [0,2];
+        assert std.string.regex_find("x-y_z", '[^\w-]') == null;
+
+        // Nullable repetitions with optional iterations are handed over to the standard library.
+        assert std.string.regex_find("aaaa", '(a?){2,3}') == [0,3];
+        assert std.string.regex_match("a", '(a?){2,3}') != null;
+        assert std.string.regex_match("aaa", '(a?){3}') == [ "aaa", "a" ];
+        assert std.string.regex_replace("baab", '(a?){1,2}', '<$1>') == std.string.regex_replace("baab", '(?:(a?){1,2})(?=)', '<$1>');
+
+        // The linear engine shall agree with the standard library, which is forced by `(?=)`.
+        var rfmt = '<$&|$1|$`|$$|$9|$>' + "$'";
+        for(each i, p : [ 'a*', 'x?', '\d+\w', '(\d{3})(\w)', '\b\w', '(a|ab)(c|bcd)?d*', '(a)|b' ])
+          for(each j, t : [ "", "baaac", "a11b2c333d4e555", "abcd abc", "xaxx" ]) {
+            var q = '(?:' + p + ')(?=)';
+            assert std.string.regex_find(t, p) == std.string.regex_find(t, q);
+            assert std.string.regex_match(t, p) == std.string.regex_match(t, q);
+            assert std.string.regex_replace(t, p, rfmt) == std.string.regex_replace(t, q, rfmt);
+            assert std.string.regex_compile(p).replace(t, rfmt) == std.string.regex_replace(t, q, rfmt);
+          }
+        assert std.string.regex_replace("baaac", 'a*', '-') == "-b--c-";
+        assert std.string.regex_replace("abc", 'x*', '$`|') == "|aa|bb|cc|";
+
+        assert std.string.find_any_pattern("ushers", ["he","she","his","hers"]) == [1,3,1];
+        assert std.string.find_any_pattern("ushers", 2, ["he","she","his","hers"]) == [2,4,3];
+        assert std.string.find_any_pattern("ushers", 2, 3, ["he","she","his","hers"]) == [2,2,0];
+        assert std.string.find_any_pattern("abcde", ["bc","abcd"]) == [0,4,1];
+        assert std.string.find_any_pattern("abcd", ["a","ab","abc","x"]) == [0,3,2];
+        assert std.string.find_any_pattern("abcd", ["x","yz"]) == null;
+        assert std.string.find_any_pattern("", ["x"]) == null;
+        try { std.string.find_any_pattern("abcd", ["a",""]);  assert false;  }
+          catch(e)  { assert std.string.find(e, "empty pattern") != null;  }
+        assert std.string.find_and_replace_all("ushers", { he: "H", she: "S", hers: "R" }) == "uSrs";
+        assert std.string.find_and_replace_all("a-b-c", 2, { "-": "+", b: "B" }) == "a-B+c";
+        assert std.string.find_and_replace_all("a-b-c", 1, 2, { "-": "+", b: "B" }) == "a+B-c";
+        assert std.string.find_and_replace_all("a-b-c", { x: "y" }) == "a-b-c";
+        assert std.string.find_and_replace_all("aaaa", { a: "aa" }) == "aaaaaaaa";
+
+        var ps = std.string.pattern_set_compile(["cat","dog","catalog"]);
+        assert ps.find("hotdog catalogue") == [3,3,1];
+        assert ps.find("hotdog catalogue", 6) == [7,7,2];
+        assert ps.replace("hotdog catalogue", ["C","D","L"]) == "hotD Lue";
+        assert ps.replace("hotdog catalogue", 0, 6, ["C","D","L"]) == "hotD catalogue";
+        try { ps.replace("cat", ["C"]);  assert false;  }
+          catch(e)  { assert std.string.find(e, "mismatch") != null;  }
+
+        var pats = ["he","she","his","hers"];
+        for(var i = 0;  i < 4000;  ++i)
+          pats[$] = std.string.pack_8([0x80 + i % 128, 0x80 + i / 128, 0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9]);
+        ps = std.string.pattern_set_compile(pats);
+        assert ps.find("ushers") == [1,3,1];
+        assert ps.find("ushers", 2) == [2,4,3];
+        assert ps.find("xx" + pats[1234] + "he") == [2,12,1234];
+        assert ps.find("xx" + std.string.slice(pats[1234], 0, 11) + "she") == [13,3,1];
+        assert ps.replace("ushers" + pats[4000], pats) == "ushers" + pats[4000];
+
       )__"), tinybuf::open_read);
 
     Simple_Script code(cbuf, ::rocket::sref(__FILE__));
     Global_Context global;
-    code.execute(global);
+    // Run the script again with fewer CPU features, so each code path is tested against the
+    // same results: AVX2, then SSSE3, then plain C++.
+    for(uint32_t mask : { UINT32_MAX, uint32_t(cpu_feature_ssse3), uint32_t(0) }) {
+      cpu_set_feature_mask(mask);
+      code.execute(global);
+    }
+    cpu_set_feature_mask(UINT32_MAX);
   }
@@ -15,4 +15,24 @@ int main()
     catch(exception& e) {
       ASTERIA_TEST_CHECK(::std::strstr(e.what(), "test exception: 42 $/end") != nullptr);
     }
+
+    String_Pool pool;
+    auto s1 = pool.intern(cow_string("hello interned world"));
+    auto s2 = pool.intern(cow_string("hello interned world"));
+    auto s3 = pool.intern(cow_string("hello other world"));
+    ASTERIA_TEST_CHECK(s1 == s2);
+    ASTERIA_TEST_CHECK(s1.data() == s2.data());
+    ASTERIA_TEST_CHECK(s1 != s3);
+    ASTERIA_TEST_CHECK(s3 == ::rocket::sref("hello other world"));
+
+    cow_string u8str(100, 'a');
+    ASTERIA_TEST_CHECK(utf8_ascii_prefix(u8str.data(), u8str.size()) == 100);
+    u8str.replace(67, 1, "\xE7\x94\xB2");
+    ASTERIA_TEST_CHECK(utf8_ascii_prefix(u8str.data(), u8str.size()) == 67);
+    size_t offset = 12345;
+    ASTERIA_TEST_CHECK(utf8_validate(offset, u8str.data(), u8str.size()) == true);
+    ASTERIA_TEST_CHECK(offset == 12345);
+    u8str.replace(88, 1, "\xC0\x80");
+    ASTERIA_TEST_CHECK(utf8_validate(offset, u8str.data(), u8str.size()) == false);
+    ASTERIA_TEST_CHECK(offset == 88);
   }
@@ -143,4 +143,27 @@ int main()
     ASTERIA_TEST_CHECK(value.compare(cmp) == compare_unordered);
     swap(value, cmp);
     ASTERIA_TEST_CHECK(value.compare(cmp) == compare_unordered);
+
+    array.clear();
+    array.emplace_back(nullptr);
+    object.clear();
+    object.try_emplace(phsh_string(::rocket::sref("k")), ::std::move(array));
+    array.clear();
+    array.emplace_back(V_integer(1));
+    array.emplace_back(V_string("two"));
+    array.emplace_back(::std::move(object));
+    array.emplace_back(V_array());
+    value = ::std::move(array);
+    ::rocket::tinyfmt_str fmt;
+    value.print(fmt);
+    ASTERIA_TEST_CHECK(fmt.get_string() == R"([ 1, "two", { "k" = [ null, ], }, [ ], ])");
+    fmt.clear_string();
+    value.dump(fmt, 0);
+    ASTERIA_TEST_CHECK(fmt.get_string() ==
+        R"(array(4) [ 0 = integer 1; 1 = string(3) "two"; 2 = object(1) { "k" = array(1) [ 0 = null; ]; }; 3 = array(0) [ ]; ])");
+    fmt.clear_string();
+    value.dump(fmt, 2);
+    ASTERIA_TEST_CHECK(fmt.get_string() ==
+        "array(4)\n [\n  0 = integer 1;\n  1 = string(3) \"two\";\n  2 = object(1)\n   {\n    \"k\" = array(1)"
+        "\n     [\n      0 = null;\n     ];\n   };\n  3 = array(0)\n   [\n   ];\n ]");
   }